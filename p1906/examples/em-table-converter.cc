@@ -0,0 +1,190 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *  Copyright � 2014 by IEEE.
+ *
+ *  This source file is an essential part of IEEE P1906.1,
+ *  Recommended Practice for Nanoscale and Molecular
+ *  Communication Framework.
+ *  Verbatim copies of this source file may be used and
+ *  distributed without restriction. Modifications to this source
+ *  file as permitted in IEEE P1906.1 may also be made and
+ *  distributed. All other uses require permission from the IEEE
+ *  Standards Department (stds-ipr@ieee.org). All other rights
+ *  reserved.
+ *
+ *  This source file is provided on an AS IS basis.
+ *  The IEEE disclaims ANY WARRANTY EXPRESS OR IMPLIED INCLUDING
+ *  ANY WARRANTY OF MERCHANTABILITY AND FITNESS FOR USE FOR A
+ *  PARTICULAR PURPOSE.
+ *  The user of the source file shall indemnify and hold
+ *  IEEE harmless from any damages or liability arising out of
+ *  the use thereof.
+ *
+ * Author: Giuseppe Piro - Telematics Lab Research Group
+ *                         Politecnico di Bari
+ *                         giuseppe.piro@poliba.it
+ *                         telematics.poliba.it/piro
+ */
+
+/*
+ * Description:
+ * this program converts a CSV spectral table (e.g., path loss or molecular
+ * absorption noise of the EM example) into the binary format loaded by
+ * P1906EMSpectralTable, which is selected through the PathLossTable attribute
+ * of P1906EMMotion and the MolecularNoiseTable attribute of P1906EMSpecificity.
+ *
+ * The first line of the CSV file holds the central frequency [Hz] of each
+ * sub-channel after a leading label, each following line holds a distance [m]
+ * followed by one value per sub-channel:
+ *
+ *   distance, 5e11, 6e11, ..., 1.5e12
+ *   0.0001, 12.3394, 14.5749, ..., 24.2721
+ *   ...
+ *
+ * Distances must lie on a uniform grid. The built-in tables can be exported
+ * as a starting point with --builtin=pathloss or --builtin=noise.
+ */
+
+#include "ns3/core-module.h"
+#include "ns3/p1906-em-spectral-table.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace ns3;
+
+static bool
+ParseRow (std::string line, std::vector<double> &row, std::string &label)
+{
+  std::stringstream ss (line);
+  std::string cell;
+  row.clear ();
+  bool first = true;
+  while (std::getline (ss, cell, ','))
+    {
+      char *end;
+      double v = strtod (cell.c_str (), &end);
+      if (end == cell.c_str ())
+        {
+          if (!first)
+            return false;
+          label = cell;
+          first = false;
+          continue;
+        }
+      row.push_back (v);
+      first = false;
+    }
+  return !row.empty ();
+}
+
+int main (int argc, char *argv[])
+{
+  std::string input = "";
+  std::string output = "em-table.bin";
+  std::string builtin = "";
+  bool singlePrecision = false;
+
+  CommandLine cmd;
+  cmd.AddValue("input", "CSV table to convert", input);
+  cmd.AddValue("output", "binary table to write", output);
+  cmd.AddValue("builtin", "export a built-in table instead of a CSV (pathloss or noise)", builtin);
+  cmd.AddValue("float", "store the values in single precision", singlePrecision);
+  cmd.Parse(argc, argv);
+
+  double dMin, dStep;
+  std::vector<double> frequencies;
+  std::vector<double> values;
+
+  if (builtin != "")
+    {
+      Ptr<const P1906EMSpectralTable> t;
+      if (builtin == "pathloss")
+        t = P1906EMSpectralTable::GetDefaultPathLoss ();
+      else if (builtin == "noise")
+        t = P1906EMSpectralTable::GetDefaultMolecularNoise ();
+      else
+        {
+          printf ("unknown built-in table %s (use pathloss or noise)\n", builtin.c_str ());
+          return 1;
+        }
+      dMin = t->GetDistance (0);
+      dStep = t->GetDistance (1) - t->GetDistance (0);
+      for (uint32_t c = 0; c < t->GetNSubChannels (); c++)
+        frequencies.push_back (t->GetFrequency (c));
+      for (uint32_t i = 0; i < t->GetNDistances (); i++)
+        for (uint32_t c = 0; c < t->GetNSubChannels (); c++)
+          values.push_back (t->GetValueAt (i, c));
+    }
+  else
+    {
+      std::ifstream in (input.c_str ());
+      if (!in)
+        {
+          printf ("unable to open %s\n", input.c_str ());
+          return 1;
+        }
+
+      std::string line, label;
+      std::vector<double> row;
+      std::vector<double> distances;
+      bool header = true;
+      uint32_t lineNumber = 0;
+      while (std::getline (in, line))
+        {
+          lineNumber++;
+          if (line.find_first_not_of (" \t\r") == std::string::npos)
+            continue;
+          if (!ParseRow (line, row, label))
+            {
+              printf ("%s:%u: malformed row\n", input.c_str (), lineNumber);
+              return 1;
+            }
+          if (header)
+            {
+              frequencies = row;
+              header = false;
+              continue;
+            }
+          if (row.size () != frequencies.size () + 1)
+            {
+              printf ("%s:%u: expected %lu values, found %lu\n", input.c_str (), lineNumber,
+                      (unsigned long) frequencies.size () + 1, (unsigned long) row.size ());
+              return 1;
+            }
+          distances.push_back (row[0]);
+          values.insert (values.end (), row.begin () + 1, row.end ());
+        }
+
+      if (distances.size () < 2)
+        {
+          printf ("%s: at least two distances are required\n", input.c_str ());
+          return 1;
+        }
+      dMin = distances.front ();
+      dStep = (distances.back () - distances.front ()) / (distances.size () - 1);
+      for (uint32_t i = 0; i < distances.size (); i++)
+        {
+          if (fabs (distances[i] - (dMin + i * dStep)) > 1e-3 * dStep)
+            {
+              printf ("%s: distance %g is not on a uniform grid (step %g)\n", input.c_str (), distances[i], dStep);
+              return 1;
+            }
+        }
+    }
+
+  if (!P1906EMSpectralTable::Write (output, dMin, dStep, frequencies, values, singlePrecision))
+    {
+      printf ("unable to write %s\n", output.c_str ());
+      return 1;
+    }
+
+  printf ("%s: %lu distances x %lu sub-channels, grid %g:%g:%g m\n", output.c_str (),
+          (unsigned long) (values.size () / frequencies.size ()), (unsigned long) frequencies.size (),
+          dMin, dStep, dMin + dStep * (values.size () / frequencies.size () - 1));
+  return 0;
+}
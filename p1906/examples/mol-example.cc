@@ -48,6 +48,8 @@
 #include "ns3/p1906-mol-communication-interface.h"
 #include "ns3/p1906-mol-transmitter-communication-interface.h"
 #include "ns3/p1906-mol-receiver-communication-interface.h"
+#include "ns3/p1906-mol-diffusion-field.h"
+#include "ns3/p1906-mol-diffusion-motion.h"
 
 using namespace ns3;
 
@@ -60,12 +62,14 @@ int main (int argc, char *argv[])
   double nbOfMoleculas = 50000; 							//  [pJ]
   double pulseInterval = 1.;								//  [ms]
   double diffusionCoefficient = 1;							//  [nm^2/ns]
+  bool compartment = false;								//  finite volume compartment instead of Fick's law
 
   CommandLine cmd;
   cmd.AddValue("nodeDistance", "nodeDistance", nodeDistance);
   cmd.AddValue("nbOfMoleculas", "nbOfMoleculas", nbOfMoleculas);
   cmd.AddValue("diffusionCoefficient", "diffusionCoefficient", diffusionCoefficient);
   cmd.AddValue("pulseInterval", "pulseInterval", pulseInterval);
+  cmd.AddValue("compartment", "solve a closed compartment around the nodes by finite volumes", compartment);
   cmd.Parse(argc, argv);
 
 
@@ -83,6 +87,10 @@ int main (int argc, char *argv[])
   // Create a medium and the Motion component
   Ptr<P1906Medium> medium = CreateObject<P1906Medium> ();
   Ptr<P1906MOLMotion> motion = CreateObject<P1906MOLMotion> ();
+  if (compartment)
+    {
+	  motion = CreateObject<P1906MOL_DiffusionMotion> ();
+    }
   motion->SetDiffusionCoefficient (diffusionCoefficient);
   medium->SetP1906Motion (motion);
 
@@ -91,6 +99,16 @@ int main (int argc, char *argv[])
   Ptr<P1906MOLCommunicationInterface> c1 = CreateObject<P1906MOLCommunicationInterface> ();
   Ptr<P1906MOLSpecificity> s1 = CreateObject<P1906MOLSpecificity> ();
   Ptr<P1906MOLField> fi1 = CreateObject<P1906MOLField> ();
+  if (compartment)
+    {
+	  // one field shared by both nodes, bounded by a reflective sphere around them
+	  Ptr<P1906MOL_DiffusionField> field = CreateObject<P1906MOL_DiffusionField> ();
+	  P1906MOL_MOTOR_Pos center;
+	  center.setPos (nodeDistance / 2, 0, 0);
+	  field->addVolumeSurface (center, nodeDistance, P1906MOL_MOTOR_VolSurface::ReflectiveBarrier);
+	  field->setDiffusionCoefficient (diffusionCoefficient);
+	  fi1 = field;
+    }
   Ptr<P1906MOLPerturbation> p1 = CreateObject<P1906MOLPerturbation> ();
   p1->SetPulseInterval (MilliSeconds(pulseInterval));
   p1->SetMolecules (nbOfMoleculas);
@@ -100,7 +118,7 @@ int main (int argc, char *argv[])
   Ptr<P1906NetDevice> dev2 = CreateObject<P1906NetDevice> ();
   Ptr<P1906MOLCommunicationInterface> c2 = CreateObject<P1906MOLCommunicationInterface> ();
   Ptr<P1906MOLSpecificity> s2 = CreateObject<P1906MOLSpecificity> ();
-  Ptr<P1906MOLField> fi2 = CreateObject<P1906MOLField> ();
+  Ptr<P1906MOLField> fi2 = compartment ? fi1 : CreateObject<P1906MOLField> ();
   Ptr<P1906MOLPerturbation> p2 = CreateObject<P1906MOLPerturbation> ();
   p2->SetPulseInterval (MilliSeconds(pulseInterval));
   p2->SetMolecules (nbOfMoleculas);
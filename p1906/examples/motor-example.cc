@@ -186,6 +186,8 @@ int main (int argc, char *argv[])
   fi1->setTubeDensity (mean_tube_density);
   fi1->setTubePersistenceLength (tube_persistenceLength);
   fi1->setTubeSegments (segPerTube);
+  //! generate the tubes once, with the properties above
+  fi1->Build ();
   
   //! this class creates the motor (message carrier)
   Ptr<P1906MOL_MOTOR_Perturbation> p1 = CreateObject<P1906MOL_MOTOR_Perturbation> ();
@@ -202,6 +204,8 @@ int main (int argc, char *argv[])
   Ptr<P1906MOLSpecificity> s2 = CreateObject<P1906MOLSpecificity> ();
   //! SFB: this class creates the microtubules
   Ptr<P1906MOL_MOTOR_MicrotubulesField> fi2 = CreateObject<P1906MOL_MOTOR_MicrotubulesField> ();
+  //! both nodes live in the same cytoskeleton: share the tubes of Device 1
+  fi2->setTubeNetwork (fi1->getTubeNetwork ());
   //! this class creates the motor (message carrier)
   Ptr<P1906MOL_MOTOR_Perturbation> p2 = CreateObject<P1906MOL_MOTOR_Perturbation> ();
   //! don't need these properties...
@@ -0,0 +1,288 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *  Copyright � 2014 by IEEE.
+ *
+ *  This source file is an essential part of IEEE P1906.1,
+ *  Recommended Practice for Nanoscale and Molecular
+ *  Communication Framework.
+ *  Verbatim copies of this source file may be used and
+ *  distributed without restriction. Modifications to this source
+ *  file as permitted in IEEE P1906.1 may also be made and
+ *  distributed. All other uses require permission from the IEEE
+ *  Standards Department (stds-ipr@ieee.org). All other rights
+ *  reserved.
+ *
+ *  This source file is provided on an AS IS basis.
+ *  The IEEE disclaims ANY WARRANTY EXPRESS OR IMPLIED INCLUDING
+ *  ANY WARRANTY OF MERCHANTABILITY AND FITNESS FOR USE FOR A
+ *  PARTICULAR PURPOSE.
+ *  The user of the source file shall indemnify and hold
+ *  IEEE harmless from any damages or liability arising out of
+ *  the use thereof.
+ *
+ * Author: Stephen F Bush - GE Global Research
+ *                      bushsf@research.ge.com
+ *                      http://www.amazon.com/author/stephenbush
+ */
+
+/*
+ * Description:
+ * this program converts a binary trace file written by the molecular motor
+ * model (see P1906MOL_MOTOR_Trace) into the text files the model used to
+ * write directly. By default the MathematicaHelper and MATLABHelper append
+ * every plot to motor.p1906trc and the Stream trajectories go to
+ * trajectories.p1906trc; text is only written when asked for here, or by
+ * setting the Format attribute of the helpers to Text.
+ *
+ *   --format=auto    each chunk becomes the file it was labelled with (.mma, or rows for MATLAB)
+ *   --format=mma     Mathematica, as written by P1906MOL_MOTOR_MathematicaHelper
+ *   --format=matlab  rows of numbers loadable by MATLAB, as written by P1906MOL_MOTOR_MATLABHelper
+ *   --format=csv     comma separated values with a header naming the columns
+ *
+ * The chunks of a Stream trajectory are gathered per motor into trajectory-<motor id>.
+ * --list prints the chunks of the file without converting them.
+ */
+
+#include "ns3/core-module.h"
+#include "ns3/p1906-mol-motor-trace.h"
+#include "ns3/p1906-mol-motor-MathematicaHelper.h"
+#include "ns3/p1906-mol-motor-pos.h"
+#include "ns3/p1906-mol-motor-vec3.h"
+#include <cstdio>
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace ns3;
+
+//! replace the extension of name by extension, or append it
+static std::string
+ReplaceExtension (std::string name, std::string extension)
+{
+  size_t slash = name.find_last_of ('/');
+  size_t dot = name.find_last_of ('.');
+  if (dot != std::string::npos && (slash == std::string::npos || dot > slash))
+    name.erase (dot);
+  return name + extension;
+}
+
+//! the rows of the given chunks, one after the other; 0 if they are empty
+static gsl_matrix *
+GatherRows (Ptr<P1906MOL_MOTOR_TraceReader> reader, const std::vector<size_t> &chunks)
+{
+  uint64_t rows = 0;
+  uint32_t columns = reader->getChunk (chunks[0]).columns;
+  for (size_t i = 0; i < chunks.size (); i++)
+    rows += reader->getChunk (chunks[i]).rows;
+  if (rows == 0 || columns == 0)
+    return 0;
+
+  gsl_matrix *m = gsl_matrix_alloc (rows, columns);
+  uint64_t row = 0;
+  for (size_t i = 0; i < chunks.size (); i++)
+    {
+      const P1906MOL_MOTOR_TraceReader::Chunk &c = reader->getChunk (chunks[i]);
+      for (uint32_t col = 0; col < columns && col < c.columns; col++)
+        {
+          const double *column = c.column (col);
+          for (uint64_t r = 0; r < c.rows; r++)
+            gsl_matrix_set (m, row + r, col, column[r]);
+        }
+      row += c.rows;
+    }
+  return m;
+}
+
+//! the points of columns first, first + 1, first + 2 of m
+static std::vector<P1906MOL_MOTOR_Vec3>
+GatherPoints (const gsl_matrix *m, size_t first)
+{
+  std::vector<P1906MOL_MOTOR_Vec3> pts (m->size1);
+  for (size_t i = 0; i < m->size1; i++)
+    pts[i] = vec3 (gsl_matrix_get (m, i, first),
+                   gsl_matrix_get (m, i, first + 1),
+                   gsl_matrix_get (m, i, first + 2));
+  return pts;
+}
+
+//! rows of full precision values separated by separator, after a header naming the columns if separator is a comma
+static bool
+WriteRows (const gsl_matrix *m, uint32_t kind, std::string fileName, char separator)
+{
+  FILE *fp = fopen (fileName.c_str (), "w");
+  if (fp == NULL)
+    return false;
+
+  char buffer[16];
+  if (separator == ',')
+    {
+      for (size_t c = 0; c < m->size2; c++)
+        fprintf (fp, "%s%s", c > 0 ? "," : "", P1906MOL_MOTOR_Trace::columnName (kind, c, buffer));
+      fprintf (fp, "\n");
+    }
+  for (size_t i = 0; i < m->size1; i++)
+    {
+      for (size_t c = 0; c < m->size2; c++)
+        {
+          if (c > 0)
+            fputc (separator, fp);
+          fprintf (fp, "%.17g", gsl_matrix_get (m, i, c));
+        }
+      fprintf (fp, "\n");
+    }
+  return fclose (fp) == 0;
+}
+
+//! draw m, holding the rows of a chunk of kind, with the MathematicaHelper into fileName
+static bool
+WriteMma (const gsl_matrix *m, const P1906MOL_MOTOR_TraceReader::Chunk &chunk, std::string fileName)
+{
+  P1906MOL_MOTOR_MathematicaHelper mathematica;
+  mathematica.setFormat (P1906MOL_MOTOR_MathematicaHelper::Text);
+  gsl_matrix *vals = const_cast<gsl_matrix *> (m);
+
+  switch (chunk.kind)
+    {
+    case P1906MOL_MOTOR_Trace::Trajectory:
+      mathematica.connectedPoints2Mma (GatherPoints (m, 1), fileName.c_str ());
+      return true;
+    case P1906MOL_MOTOR_Trace::Path:
+      mathematica.connectedPoints2Mma (GatherPoints (m, 0), fileName.c_str ());
+      return true;
+    case P1906MOL_MOTOR_Trace::Points:
+      mathematica.points2Mma (GatherPoints (m, 0), fileName.c_str ());
+      return true;
+    case P1906MOL_MOTOR_Trace::Tubes:
+      if (chunk.tag == 0)
+        return false;
+      mathematica.tubes2Mma (vals, chunk.tag, fileName.c_str ());
+      return true;
+    case P1906MOL_MOTOR_Trace::VectorField:
+      if (chunk.style == P1906MOL_MOTOR_Trace::Arrows)
+        mathematica.vectorPlotMma (vals, fileName.c_str ());
+      else
+        mathematica.vectorFieldPlotMma (vals, fileName.c_str ());
+      return true;
+    case P1906MOL_MOTOR_Trace::Series:
+      mathematica.plot2Mma (vals, fileName.c_str (),
+                            chunk.labels.size () > 1 ? chunk.labels[1].c_str () : "",
+                            chunk.labels.size () > 2 ? chunk.labels[2].c_str () : "");
+      return true;
+    case P1906MOL_MOTOR_Trace::Sphere:
+      {
+        P1906MOL_MOTOR_Pos center;
+        center.setPos (gsl_matrix_get (m, 0, 0), gsl_matrix_get (m, 0, 1), gsl_matrix_get (m, 0, 2));
+        mathematica.volSurfacePlot (center, gsl_matrix_get (m, 0, 3), fileName.c_str ());
+        return true;
+      }
+    }
+  return false;
+}
+
+//! convert the given chunks, which share a kind, into one file derived from name
+static bool
+Convert (Ptr<P1906MOL_MOTOR_TraceReader> reader, const std::vector<size_t> &chunks,
+         std::string name, std::string format, std::string prefix)
+{
+  const P1906MOL_MOTOR_TraceReader::Chunk &first = reader->getChunk (chunks[0]);
+  std::string fileName;
+
+  if (format == "auto")
+    {
+      format = (first.style == P1906MOL_MOTOR_Trace::MATLABRows) ? "matlab" : "mma";
+      fileName = prefix + (name.find ('.') == std::string::npos ? name + "." + format : name);
+    }
+  else
+    fileName = prefix + ReplaceExtension (name, format == "matlab" ? ".dat" : "." + format);
+
+  gsl_matrix *m = GatherRows (reader, chunks);
+  if (m == 0)
+    {
+      printf ("%s: empty %s, skipped\n", name.c_str (), P1906MOL_MOTOR_Trace::kindName (first.kind));
+      return true;
+    }
+
+  bool ok;
+  if (format == "mma")
+    ok = WriteMma (m, first, fileName);
+  else
+    ok = WriteRows (m, first.kind, fileName, format == "csv" ? ',' : ' ');
+  if (ok)
+    printf ("%s: %s, %lu rows\n", fileName.c_str (), P1906MOL_MOTOR_Trace::kindName (first.kind), (unsigned long) m->size1);
+  else
+    printf ("unable to write %s as %s\n", name.c_str (), format.c_str ());
+
+  gsl_matrix_free (m);
+  return ok;
+}
+
+int main (int argc, char *argv[])
+{
+  std::string input = "motor.p1906trc";
+  std::string format = "auto";
+  std::string select = "";
+  std::string prefix = "";
+  bool list = false;
+
+  CommandLine cmd;
+  cmd.AddValue("input", "trace file to convert", input);
+  cmd.AddValue("format", "auto, mma, matlab or csv", format);
+  cmd.AddValue("select", "convert only the chunks of this name (e.g. tubes.mma or trajectory-3)", select);
+  cmd.AddValue("prefix", "prepended to the name of every file written (e.g. a directory)", prefix);
+  cmd.AddValue("list", "list the chunks of the trace file instead of converting them", list);
+  cmd.Parse(argc, argv);
+
+  if (format != "auto" && format != "mma" && format != "matlab" && format != "csv")
+    {
+      printf ("unknown format %s (use auto, mma, matlab or csv)\n", format.c_str ());
+      return 1;
+    }
+
+  Ptr<P1906MOL_MOTOR_TraceReader> reader = P1906MOL_MOTOR_TraceReader::Load (input);
+  if (!reader)
+    {
+      printf ("unable to read the trace file %s\n", input.c_str ());
+      return 1;
+    }
+  if (reader->isTruncated ())
+    printf ("%s ends inside a chunk (interrupted run?), converting the %lu complete chunks\n",
+            input.c_str (), (unsigned long) reader->getNumChunks ());
+
+  if (list)
+    {
+      for (size_t i = 0; i < reader->getNumChunks (); i++)
+        {
+          const P1906MOL_MOTOR_TraceReader::Chunk &c = reader->getChunk (i);
+          printf ("%6lu  %-12s  %8lu x %u  tag %lu  %s\n", (unsigned long) i,
+                  P1906MOL_MOTOR_Trace::kindName (c.kind), (unsigned long) c.rows, c.columns,
+                  (unsigned long) c.tag, c.labels[0].c_str ());
+        }
+      return 0;
+    }
+
+  //! a trajectory is spread over the chunks of its motor; other chunks are converted on their own, later ones of the same name overwriting earlier ones as the text files did
+  std::map<uint64_t, std::vector<size_t> > motors;
+  bool ok = true;
+  for (size_t i = 0; i < reader->getNumChunks (); i++)
+    {
+      const P1906MOL_MOTOR_TraceReader::Chunk &c = reader->getChunk (i);
+      if (c.kind == P1906MOL_MOTOR_Trace::Trajectory)
+        {
+          motors[c.tag].push_back (i);
+          continue;
+        }
+      if (select != "" && c.labels[0] != select)
+        continue;
+      ok = Convert (reader, std::vector<size_t> (1, i), c.labels[0], format, prefix) && ok;
+    }
+  for (std::map<uint64_t, std::vector<size_t> >::iterator it = motors.begin (); it != motors.end (); it++)
+    {
+      char name[32];
+      snprintf (name, sizeof (name), "trajectory-%lu", (unsigned long) it->first);
+      if (select != "" && select != name)
+        continue;
+      ok = Convert (reader, it->second, name, format, prefix) && ok;
+    }
+
+  return ok ? 0 : 1;
+}
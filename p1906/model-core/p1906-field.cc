@@ -43,6 +43,7 @@ TypeId P1906Field::GetTypeId (void)
 }
 
 P1906Field::P1906Field ()
+  : m_parametersVersion (0)
 {
   NS_LOG_FUNCTION (this);
   NS_LOG_FUNCTION (this << "Created default Field Component");
@@ -53,4 +54,18 @@ P1906Field::~P1906Field ()
   NS_LOG_FUNCTION (this);
 }
 
+uint32_t
+P1906Field::GetParametersVersion (void)
+{
+  NS_LOG_FUNCTION (this);
+  return m_parametersVersion;
+}
+
+void
+P1906Field::NotifyParametersChanged (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_parametersVersion++;
+}
+
 } // namespace ns3
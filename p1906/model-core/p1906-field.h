@@ -53,7 +53,17 @@ public:
   P1906Field ();
   virtual ~P1906Field ();
 
+  /**
+   * \return a counter incremented every time a parameter affecting the
+   * propagation through the field is changed
+   */
+  uint32_t GetParametersVersion (void);
+
+protected:
+  void NotifyParametersChanged (void);
+
 private:
+  uint32_t m_parametersVersion;
 };
 
 }
@@ -34,6 +34,12 @@
 #include "ns3/node.h"
 #include "ns3/log.h"
 #include "ns3/pointer.h"
+#include "ns3/double.h"
+#include "ns3/boolean.h"
+#include "ns3/uinteger.h"
+#include "ns3/mobility-model.h"
+#include <algorithm>
+#include <cmath>
 #include "p1906-medium.h"
 #include "p1906-communication-interface.h"
 #include "p1906-field.h"
@@ -41,6 +47,7 @@
 #include "p1906-receiver-communication-interface.h"
 #include "p1906-specificity.h"
 #include "p1906-motion.h"
+#include "p1906-net-device.h"
 
 
 NS_LOG_COMPONENT_DEFINE ("P1906Medium");
@@ -54,7 +61,25 @@ P1906Medium::GetTypeId ()
 {
   static TypeId tid = TypeId ("ns3::P1906Medium")
     .SetParent<Channel> ()
-    .AddConstructor<P1906Medium> ();
+    .AddConstructor<P1906Medium> ()
+    .AddAttribute ("SpatialIndexCellSize",
+                   "Edge [m] of the grid cells used to cull receivers out of the Motion range (<= 0 disables the index)",
+                   DoubleValue (0.0),
+                   MakeDoubleAccessor (&P1906Medium::SetSpatialIndexCellSize,
+                                       &P1906Medium::GetSpatialIndexCellSize),
+                   MakeDoubleChecker<double> ())
+    .AddAttribute ("LinkCache",
+                   "Memoize the propagation delay and the received carrier of each link",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&P1906Medium::SetLinkCacheEnabled,
+                                        &P1906Medium::GetLinkCacheEnabled),
+                   MakeBooleanChecker ())
+    .AddAttribute ("MotionThreads",
+                   "Number of threads computing the propagation delays of the receivers (< 2 keeps the serial evaluation)",
+                   UintegerValue (0),
+                   MakeUintegerAccessor (&P1906Medium::SetMotionThreads,
+                                         &P1906Medium::GetMotionThreads),
+                   MakeUintegerChecker<uint32_t> ());
 
   return tid;
 }
@@ -65,6 +90,14 @@ P1906Medium::P1906Medium ()
   NS_LOG_FUNCTION (this);
   m_communicationInterfaces = new P1906CommunicationInterfaces ();
   m_motion = 0;
+  m_cellSize = 0.;
+  m_indexDirty = true;
+  m_linkCacheEnabled = false;
+  m_linkCacheMotionVersion = 0;
+  m_transmissions = 0;
+  m_motionJobNext = 0;
+  m_motionMessage = 0;
+  m_motionField = 0;
 }
 
 P1906Medium::~P1906Medium ()
@@ -78,6 +111,8 @@ void
 P1906Medium::DoDispose ()
 {
   Channel::DoDispose ();
+  ClearSpatialIndex ();
+  m_motionPool.Stop ();
   m_communicationInterfaces = 0;
   m_motion = 0;
   NS_LOG_FUNCTION (this);
@@ -102,6 +137,8 @@ P1906Medium::SetP1906Motion (Ptr<P1906Motion> f)
 {
   NS_LOG_FUNCTION (this);
   m_motion = f;
+  m_linkCache.clear ();
+  m_linkCacheMotionVersion = f ? f->GetParametersVersion () : 0;
 }
 
 Ptr<P1906Motion>
@@ -118,16 +155,86 @@ P1906Medium::HandleTransmission (Ptr<P1906CommunicationInterface> src,
 {
   NS_LOG_FUNCTION (this);
 
-  std::vector< Ptr<P1906CommunicationInterface> >::iterator it;
-  for (it = m_communicationInterfaces->begin (); it != m_communicationInterfaces->end (); it++)
+  double range = m_motion ? m_motion->GetMaxEffectiveRange () : -1.;
+  std::vector<uint32_t> receivers;
+  bool culled = (range >= 0. && m_cellSize > 0. && GetReceiversInRange (src, range, receivers));
+
+  if (!culled)
+    {
+      receivers.resize (m_communicationInterfaces->size ());
+      for (uint32_t i = 0; i < receivers.size (); i++)
+        {
+          receivers[i] = i;
+        }
+    }
+
+  NS_LOG_FUNCTION (this << "[candidates,interfaces]" << receivers.size () << m_communicationInterfaces->size ());
+
+  uint64_t signature = 0;
+  bool cacheable = m_linkCacheEnabled && m_motion && m_motion->IsCacheable () && message->GetSignature (signature);
+  if (cacheable)
+    {
+      if (m_indexDirty)
+        {
+          BuildSpatialIndex ();
+        }
+      if (m_linkCacheMotionVersion != m_motion->GetParametersVersion ())
+        {
+          m_linkCache.clear ();
+          m_linkCacheMotionVersion = m_motion->GetParametersVersion ();
+        }
+    }
+
+  std::vector<double> delays;
+  bool parallel = !cacheable && ComputePropagationDelays (src, message, field, receivers, delays);
+
+  for (uint32_t k = 0; k < receivers.size (); k++)
     {
-	  Ptr<P1906CommunicationInterface> dst = *it;
+	  Ptr<P1906CommunicationInterface> dst = m_communicationInterfaces->at (receivers[k]);
 	  if (dst != src)
 	    {
           Ptr<P1906MessageCarrier> receivedMessageCarrier;
           double delay;
 
-          if (m_motion)
+          if (cacheable)
+            {
+              LinkKey key;
+              key.src = src;
+              key.dst = dst;
+              key.field = field;
+              key.signature = signature;
+              uint32_t fieldVersion = field ? field->GetParametersVersion () : 0;
+              LinkCache::iterator ci = m_linkCache.find (key);
+              if (ci == m_linkCache.end () || ci->second.fieldVersion != fieldVersion)
+                {
+                  LinkState state;
+                  state.delay = m_motion->ComputePropagationDelay (src, dst, message, field);
+                  state.carrier = m_motion->CalculateReceivedMessageCarrier(src, dst, message, field)->Copy ();
+                  state.fieldVersion = fieldVersion;
+                  if (ci == m_linkCache.end ())
+                    {
+                      ci = m_linkCache.insert (std::make_pair (key, state)).first;
+                    }
+                  else
+                    {
+                      NS_LOG_FUNCTION (this << "field parameters changed");
+                      ci->second = state;
+                    }
+                }
+              else
+                {
+                  NS_LOG_FUNCTION (this << "link cache hit");
+                }
+              delay = ci->second.delay;
+              receivedMessageCarrier = ci->second.carrier->Copy ();
+              receivedMessageCarrier->CopyTransmissionState (message);
+            }
+          else if (parallel)
+            {
+              delay = delays[k];
+              receivedMessageCarrier = m_motion->CalculateReceivedMessageCarrier(src, dst, message, field);
+            }
+          else if (m_motion)
             {
         	   delay = m_motion->ComputePropagationDelay (src, dst, message, field);
                receivedMessageCarrier = m_motion->CalculateReceivedMessageCarrier(src, dst, message, field);
@@ -144,6 +251,90 @@ P1906Medium::HandleTransmission (Ptr<P1906CommunicationInterface> src,
     }
 }
 
+bool
+P1906Medium::ComputePropagationDelays (Ptr<P1906CommunicationInterface> src,
+                                       Ptr<P1906MessageCarrier> message,
+                                       Ptr<P1906Field> field,
+                                       const std::vector<uint32_t> &receivers,
+                                       std::vector<double> &delays)
+{
+  NS_LOG_FUNCTION (this);
+
+  if (m_motionPool.GetThreads () < 2 || receivers.size () < 2 || !m_motion || !m_motion->IsThreadSafe ())
+    {
+      return false;
+    }
+
+  // serial phase: everything touching reference counted objects
+  Ptr<MobilityModel> srcMobility = GetMobility (src);
+  if (!srcMobility)
+    {
+      return false;
+    }
+  m_transmissions++;
+  m_motionJobs.clear ();
+  for (uint32_t k = 0; k < receivers.size (); k++)
+    {
+      Ptr<P1906CommunicationInterface> dst = m_communicationInterfaces->at (receivers[k]);
+      if (dst == src)
+        {
+          continue;
+        }
+      Ptr<MobilityModel> dstMobility = GetMobility (dst);
+      if (!dstMobility)
+        {
+          m_motionJobs.clear ();
+          return false;
+        }
+      MotionJob job;
+      job.receiver = k;
+      job.srcPosition = srcMobility->GetPosition ();
+      job.dstPosition = dstMobility->GetPosition ();
+      job.stream = (m_transmissions << 32) | receivers[k];
+      job.delay = 0.;
+      m_motionJobs.push_back (job);
+    }
+  m_motionJobNext = 0;
+  m_motionMessage = PeekPointer (message);
+  m_motionField = PeekPointer (field);
+
+  // parallel phase: the calling thread takes part as one of the workers
+  NS_LOG_FUNCTION (this << "[jobs,threads]" << m_motionJobs.size () << m_motionPool.GetThreads ());
+  m_motionPool.Run (MakeCallback (&P1906Medium::MotionWorker, this));
+
+  delays.assign (receivers.size (), 0.);
+  for (uint32_t j = 0; j < m_motionJobs.size (); j++)
+    {
+      delays[m_motionJobs[j].receiver] = m_motionJobs[j].delay;
+    }
+  m_motionJobs.clear ();
+  m_motionMessage = 0;
+  m_motionField = 0;
+  return true;
+}
+
+void
+P1906Medium::MotionWorker (void)
+{
+  // no logging here: this runs outside the simulator thread
+  while (true)
+    {
+      uint32_t j;
+      {
+        CriticalSection cs (m_motionJobMutex);
+        if (m_motionJobNext >= m_motionJobs.size ())
+          {
+            return;
+          }
+        j = m_motionJobNext++;
+      }
+      MotionJob &job = m_motionJobs[j];
+      job.delay = m_motion->ComputePropagationDelayConcurrent (job.srcPosition, job.dstPosition,
+                                                               m_motionMessage, m_motionField,
+                                                               job.stream);
+    }
+}
+
 void
 P1906Medium::HandleReception (Ptr<P1906CommunicationInterface> src, Ptr<P1906CommunicationInterface> dst, Ptr<P1906MessageCarrier> message)
 {
@@ -157,6 +348,7 @@ P1906Medium::AddP1906CommunicationInterface (Ptr<P1906CommunicationInterface> i)
 {
   NS_LOG_FUNCTION (this);
   m_communicationInterfaces->push_back (i);
+  m_indexDirty = true;
 }
 
 void
@@ -164,6 +356,8 @@ P1906Medium::SetP1906CommunicationInterfaces (P1906CommunicationInterfaces* i)
 {
   NS_LOG_FUNCTION (this);
   m_communicationInterfaces = i;
+  m_linkCache.clear ();
+  m_indexDirty = true;
 }
 
 P1906Medium::P1906CommunicationInterfaces*
@@ -173,6 +367,279 @@ P1906Medium::GetP1906CommunicationInterfaces ()
   return m_communicationInterfaces;
 }
 
+void
+P1906Medium::SetSpatialIndexCellSize (double s)
+{
+  NS_LOG_FUNCTION (this << s);
+  m_cellSize = s;
+  m_indexDirty = true;
+}
+
+double
+P1906Medium::GetSpatialIndexCellSize (void)
+{
+  NS_LOG_FUNCTION (this);
+  return m_cellSize;
+}
+
+void
+P1906Medium::SetLinkCacheEnabled (bool e)
+{
+  NS_LOG_FUNCTION (this << e);
+  m_linkCacheEnabled = e;
+  m_linkCache.clear ();
+}
+
+bool
+P1906Medium::GetLinkCacheEnabled (void)
+{
+  NS_LOG_FUNCTION (this);
+  return m_linkCacheEnabled;
+}
+
+void
+P1906Medium::SetMotionThreads (uint32_t n)
+{
+  NS_LOG_FUNCTION (this << n);
+  m_motionPool.SetThreads (n);
+}
+
+uint32_t
+P1906Medium::GetMotionThreads (void)
+{
+  NS_LOG_FUNCTION (this);
+  return m_motionPool.GetThreads ();
+}
+
+bool
+P1906Medium::LinkKey::operator< (const LinkKey &o) const
+{
+  if (src != o.src)
+    return PeekPointer (src) < PeekPointer (o.src);
+  if (dst != o.dst)
+    return PeekPointer (dst) < PeekPointer (o.dst);
+  if (field != o.field)
+    return PeekPointer (field) < PeekPointer (o.field);
+  return signature < o.signature;
+}
+
+bool
+P1906Medium::GridCell::operator< (const GridCell &o) const
+{
+  if (x != o.x)
+    return x < o.x;
+  if (y != o.y)
+    return y < o.y;
+  return z < o.z;
+}
+
+P1906Medium::GridCell
+P1906Medium::GetGridCell (const Vector &p)
+{
+  GridCell c;
+  c.x = (int64_t) std::floor (p.x / m_cellSize);
+  c.y = (int64_t) std::floor (p.y / m_cellSize);
+  c.z = (int64_t) std::floor (p.z / m_cellSize);
+  return c;
+}
+
+Ptr<MobilityModel>
+P1906Medium::GetMobility (Ptr<P1906CommunicationInterface> i)
+{
+  Ptr<P1906NetDevice> dev = i->GetP1906NetDevice ();
+  if (dev == 0 || dev->GetNode () == 0)
+    {
+      return 0;
+    }
+  return dev->GetNode ()->GetObject<MobilityModel> ();
+}
+
+void
+P1906Medium::ClearSpatialIndex (void)
+{
+  NS_LOG_FUNCTION (this);
+  MobilityInterfaces::iterator it;
+  for (it = m_mobilityInterfaces.begin (); it != m_mobilityInterfaces.end (); it++)
+    {
+      Ptr<MobilityModel> mobility = ConstCast<MobilityModel> (it->first);
+      mobility->TraceDisconnectWithoutContext ("CourseChange", MakeCallback (&P1906Medium::HandleCourseChange, this));
+    }
+  m_mobilityInterfaces.clear ();
+  m_grid.clear ();
+  m_cellOf.clear ();
+  m_unindexed.clear ();
+  m_linkCache.clear ();
+  m_indexDirty = true;
+}
+
+void
+P1906Medium::BuildSpatialIndex (void)
+{
+  NS_LOG_FUNCTION (this);
+  ClearSpatialIndex ();
+
+  // Mobility models are usually installed after the devices have been connected
+  // to the medium, so the index is built lazily at the first transmission
+  m_cellOf.resize (m_communicationInterfaces->size ());
+  for (uint32_t i = 0; i < m_communicationInterfaces->size (); i++)
+    {
+      Ptr<MobilityModel> mobility = GetMobility (m_communicationInterfaces->at (i));
+      if (mobility == 0)
+        {
+          m_unindexed.push_back (i);
+          continue;
+        }
+      if (m_mobilityInterfaces.find (mobility) == m_mobilityInterfaces.end ())
+        {
+          mobility->TraceConnectWithoutContext ("CourseChange", MakeCallback (&P1906Medium::HandleCourseChange, this));
+        }
+      m_mobilityInterfaces[mobility].push_back (i);
+      if (m_cellSize > 0.)
+        {
+          m_cellOf[i] = GetGridCell (mobility->GetPosition ());
+          m_grid[m_cellOf[i]].push_back (i);
+        }
+    }
+  m_indexDirty = false;
+
+  NS_LOG_FUNCTION (this << "[cells,indexed,unindexed]" << m_grid.size () << m_communicationInterfaces->size () - m_unindexed.size () << m_unindexed.size ());
+}
+
+void
+P1906Medium::HandleCourseChange (Ptr<const MobilityModel> mobility)
+{
+  NS_LOG_FUNCTION (this);
+  MobilityInterfaces::iterator mi = m_mobilityInterfaces.find (mobility);
+  if (m_indexDirty || mi == m_mobilityInterfaces.end ())
+    {
+      return;
+    }
+
+  InvalidateLinks (mi->second);
+  if (m_cellSize <= 0.)
+    {
+      return;
+    }
+
+  GridCell c = GetGridCell (mobility->GetPosition ());
+  std::vector<uint32_t>::iterator it;
+  for (it = mi->second.begin (); it != mi->second.end (); it++)
+    {
+      GridCell old = m_cellOf[*it];
+      if (!(old < c) && !(c < old))
+        {
+          continue;
+        }
+      std::vector<uint32_t> &members = m_grid[old];
+      members.erase (std::find (members.begin (), members.end (), *it));
+      if (members.empty ())
+        {
+          m_grid.erase (old);
+        }
+      m_grid[c].push_back (*it);
+      m_cellOf[*it] = c;
+    }
+}
+
+void
+P1906Medium::InvalidateLinks (const std::vector<uint32_t> &interfaces)
+{
+  NS_LOG_FUNCTION (this);
+  if (m_linkCache.empty ())
+    {
+      return;
+    }
+
+  std::vector<P1906CommunicationInterface *> moved;
+  for (uint32_t i = 0; i < interfaces.size (); i++)
+    {
+      moved.push_back (PeekPointer (m_communicationInterfaces->at (interfaces[i])));
+    }
+
+  LinkCache::iterator it = m_linkCache.begin ();
+  while (it != m_linkCache.end ())
+    {
+      if (std::find (moved.begin (), moved.end (), PeekPointer (it->first.src)) != moved.end ()
+          || std::find (moved.begin (), moved.end (), PeekPointer (it->first.dst)) != moved.end ())
+        {
+          m_linkCache.erase (it++);
+        }
+      else
+        {
+          it++;
+        }
+    }
+}
+
+bool
+P1906Medium::GetReceiversInRange (Ptr<P1906CommunicationInterface> src, double range, std::vector<uint32_t> &receivers)
+{
+  NS_LOG_FUNCTION (this << range);
+  if (m_indexDirty)
+    {
+      BuildSpatialIndex ();
+    }
+
+  Ptr<MobilityModel> srcMobility = GetMobility (src);
+  if (srcMobility == 0)
+    {
+      return false;
+    }
+  Vector p = srcMobility->GetPosition ();
+  Vector lo (p.x - range, p.y - range, p.z - range);
+  Vector hi (p.x + range, p.y + range, p.z + range);
+  GridCell clo = GetGridCell (lo);
+  GridCell chi = GetGridCell (hi);
+
+  double nCells = (double)(chi.x - clo.x + 1) * (double)(chi.y - clo.y + 1) * (double)(chi.z - clo.z + 1);
+  std::vector<const std::vector<uint32_t> *> cells;
+  if (nCells > m_grid.size ())
+    {
+      // the range covers more cells than those occupied: visit the occupied ones
+      Grid::iterator git;
+      for (git = m_grid.begin (); git != m_grid.end (); git++)
+        {
+          const GridCell &c = git->first;
+          if (c.x >= clo.x && c.x <= chi.x && c.y >= clo.y && c.y <= chi.y && c.z >= clo.z && c.z <= chi.z)
+            {
+              cells.push_back (&git->second);
+            }
+        }
+    }
+  else
+    {
+      GridCell c;
+      for (c.x = clo.x; c.x <= chi.x; c.x++)
+        for (c.y = clo.y; c.y <= chi.y; c.y++)
+          for (c.z = clo.z; c.z <= chi.z; c.z++)
+            {
+              Grid::iterator git = m_grid.find (c);
+              if (git != m_grid.end ())
+                {
+                  cells.push_back (&git->second);
+                }
+            }
+    }
+
+  receivers = m_unindexed;
+  for (uint32_t k = 0; k < cells.size (); k++)
+    {
+      std::vector<uint32_t>::const_iterator it;
+      for (it = cells[k]->begin (); it != cells[k]->end (); it++)
+        {
+          Ptr<MobilityModel> dstMobility = GetMobility (m_communicationInterfaces->at (*it));
+          if (CalculateDistance (p, dstMobility->GetPosition ()) <= range)
+            {
+              receivers.push_back (*it);
+            }
+        }
+    }
+
+  // keep the scheduling order of the exhaustive scan
+  std::sort (receivers.begin (), receivers.end ());
+  return true;
+}
+
 
 
 } // namespace ns3
@@ -33,6 +33,11 @@
 #include "ns3/net-device.h"
 #include "ns3/channel.h"
 #include "ns3/packet.h"
+#include "ns3/vector.h"
+#include "ns3/system-mutex.h"
+#include "p1906-worker-pool.h"
+#include <map>
+#include <vector>
 
 
 namespace ns3 {
@@ -41,6 +46,7 @@ class P1906CommunicationInterface;
 class P1906MessageCarrier;
 class P1906Field;
 class P1906Motion;
+class MobilityModel;
 
 
 /**
@@ -92,10 +98,118 @@ public:
   void SetP1906CommunicationInterfaces (P1906CommunicationInterfaces* i);
   P1906CommunicationInterfaces* GetP1906CommunicationInterfaces ();
 
+  /**
+   * \param s the edge [m] of the cells of the uniform grid indexing the node positions
+   *
+   * A value lower or equal to 0 (the default) disables the spatial index.
+   * When enabled, and the Motion component declares a bounded maximum
+   * effective range, only the receivers within that range are evaluated.
+   * Grid cells are updated on the MobilityModel CourseChange trace; devices
+   * without a MobilityModel are always evaluated.
+   */
+  void SetSpatialIndexCellSize (double s);
+  double GetSpatialIndexCellSize (void);
+
+  /**
+   * \param e true to memoize the propagation delay and the received carrier per link
+   *
+   * Results are stored per (src, dst, field, carrier signature) only when the
+   * Motion component is cacheable and the carrier provides a signature.
+   * Entries of a node are dropped when its MobilityModel notifies a course
+   * change, all entries are dropped when the Motion parameters change, and
+   * an entry is recomputed when the parameters of its Field have changed.
+   * All entries are dropped when the communication interfaces are replaced.
+   */
+  void SetLinkCacheEnabled (bool e);
+  bool GetLinkCacheEnabled (void);
+
+  /**
+   * \param n the number of threads computing the propagation delays of a transmission
+   *
+   * A value lower than 2 (the default) keeps the serial evaluation. Otherwise,
+   * when the Motion component is thread-safe and is not served by the link
+   * cache, the delays of all the receivers are computed concurrently from the
+   * node positions; the received carriers are then calculated and the
+   * receptions scheduled in receiver order, so that the event sequence does
+   * not depend on the thread schedule. The n - 1 worker threads are started
+   * by the first parallel transmission and kept until the medium is
+   * disposed or the value changes.
+   */
+  void SetMotionThreads (uint32_t n);
+  uint32_t GetMotionThreads (void);
+
 private:
+  struct GridCell
+  {
+    int64_t x;
+    int64_t y;
+    int64_t z;
+    bool operator< (const GridCell &o) const;
+  };
+  typedef std::map<GridCell, std::vector<uint32_t> > Grid;
+  typedef std::map<Ptr<const MobilityModel>, std::vector<uint32_t> > MobilityInterfaces;
+  //! holds the components it refers to, so that their addresses can not be
+  //! reused by new components while the entry is cached
+  struct LinkKey
+  {
+    Ptr<P1906CommunicationInterface> src;
+    Ptr<P1906CommunicationInterface> dst;
+    Ptr<P1906Field> field;
+    uint64_t signature;
+    bool operator< (const LinkKey &o) const;
+  };
+  struct LinkState
+  {
+    double delay;
+    Ptr<P1906MessageCarrier> carrier;
+    uint32_t fieldVersion;
+  };
+  typedef std::map<LinkKey, LinkState> LinkCache;
+  struct MotionJob
+  {
+    uint32_t receiver;
+    Vector srcPosition;
+    Vector dstPosition;
+    uint64_t stream;
+    double delay;
+  };
+
+  GridCell GetGridCell (const Vector &p);
+  Ptr<MobilityModel> GetMobility (Ptr<P1906CommunicationInterface> i);
+  void BuildSpatialIndex (void);
+  void ClearSpatialIndex (void);
+  void HandleCourseChange (Ptr<const MobilityModel> mobility);
+  bool GetReceiversInRange (Ptr<P1906CommunicationInterface> src, double range, std::vector<uint32_t> &receivers);
+  void InvalidateLinks (const std::vector<uint32_t> &interfaces);
+  bool ComputePropagationDelays (Ptr<P1906CommunicationInterface> src,
+                                 Ptr<P1906MessageCarrier> message,
+                                 Ptr<P1906Field> field,
+                                 const std::vector<uint32_t> &receivers,
+                                 std::vector<double> &delays);
+  void MotionWorker (void);
+
   P1906CommunicationInterfaces* m_communicationInterfaces;
   Ptr<P1906Motion> m_motion;
 
+  double m_cellSize;
+  bool m_indexDirty;
+  Grid m_grid;
+  std::vector<GridCell> m_cellOf;
+  std::vector<uint32_t> m_unindexed;
+  MobilityInterfaces m_mobilityInterfaces;
+
+  bool m_linkCacheEnabled;
+  LinkCache m_linkCache;
+  uint32_t m_linkCacheMotionVersion;
+
+  P1906WorkerPool m_motionPool;
+  uint64_t m_transmissions;
+  std::vector<MotionJob> m_motionJobs;
+  uint32_t m_motionJobNext;
+  P1906MessageCarrier *m_motionMessage;
+  P1906Field *m_motionField;
+  SystemMutex m_motionJobMutex;
+
 protected:
   virtual void DoDispose ();
 };
@@ -30,6 +30,7 @@
 #include "ns3/log.h"
 #include "ns3/packet.h"
 #include "p1906-message-carrier.h"
+#include <cstring>
 
 
 namespace ns3 {
@@ -69,5 +70,49 @@ P1906MessageCarrier::GetMessage ()
   return m_message;
 }
 
+bool
+P1906MessageCarrier::GetSignature (uint64_t &signature)
+{
+  NS_LOG_FUNCTION (this);
+  return false;
+}
+
+Ptr<P1906MessageCarrier>
+P1906MessageCarrier::Copy (void)
+{
+  NS_LOG_FUNCTION (this);
+  Ptr<P1906MessageCarrier> c = CreateObject<P1906MessageCarrier> ();
+  c->SetMessage (m_message);
+  return c;
+}
+
+void
+P1906MessageCarrier::CopyTransmissionState (Ptr<P1906MessageCarrier> c)
+{
+  NS_LOG_FUNCTION (this);
+  m_message = c->GetMessage ();
+}
+
+void
+P1906MessageCarrier::Reset (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_message = 0;
+}
+
+uint64_t
+P1906MessageCarrier::HashSignature (uint64_t h, double v)
+{
+  // FNV-1a over the bytes of the value
+  unsigned char b[sizeof (double)];
+  std::memcpy (b, &v, sizeof (double));
+  for (uint32_t i = 0; i < sizeof (double); i++)
+    {
+      h ^= b[i];
+      h *= 1099511628211ULL;
+    }
+  return h;
+}
+
 
 } // namespace ns3
@@ -57,6 +57,36 @@ public:
   void SetMessage (Ptr<Packet> message);
   Ptr<Packet> GetMessage ();
 
+  /**
+   * \param signature filled with a hash of the physical parameters of the carrier
+   * \return false if the carrier can not be identified by a signature (the default)
+   *
+   * Two carriers sharing the same signature are expected to produce the same
+   * propagation delay and received carrier on a given link; the message and
+   * the start time are not part of the signature.
+   */
+  virtual bool GetSignature (uint64_t &signature);
+
+  /**
+   * \return a copy of the carrier that does not share any state with it
+   */
+  virtual Ptr<P1906MessageCarrier> Copy (void);
+
+  /**
+   * \param c the carrier from which the per-transmission state (message, start time) is taken
+   */
+  virtual void CopyTransmissionState (Ptr<P1906MessageCarrier> c);
+
+  /**
+   * Bring the carrier back to the state of a newly created one, so that it
+   * can be recycled by the Perturbation component; a subclass adding state
+   * must override it, clear all of that state and call the parent method
+   */
+  virtual void Reset (void);
+
+protected:
+  static uint64_t HashSignature (uint64_t h, double v);
+
 private:
 
   Ptr<Packet> m_message;
@@ -0,0 +1,104 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *  Copyright � 2014 by IEEE.
+ *
+ *  This source file is an essential part of IEEE P1906.1,
+ *  Recommended Practice for Nanoscale and Molecular
+ *  Communication Framework.
+ *  Verbatim copies of this source file may be used and
+ *  distributed without restriction. Modifications to this source
+ *  file as permitted in IEEE P1906.1 may also be made and
+ *  distributed. All other uses require permission from the IEEE
+ *  Standards Department (stds-ipr@ieee.org). All other rights
+ *  reserved.
+ *
+ *  This source file is provided on an AS IS basis.
+ *  The IEEE disclaims ANY WARRANTY EXPRESS OR IMPLIED INCLUDING
+ *  ANY WARRANTY OF MERCHANTABILITY AND FITNESS FOR USE FOR A
+ *  PARTICULAR PURPOSE.
+ *  The user of the source file shall indemnify and hold
+ *  IEEE harmless from any damages or liability arising out of
+ *  the use thereof.
+ *
+ * Author: Giuseppe Piro - Telematics Lab Research Group
+ *                         Politecnico di Bari
+ *                         giuseppe.piro@poliba.it
+ *                         telematics.poliba.it/piro
+ */
+
+
+#include "ns3/fatal-error.h"
+#include "p1906-monitor.h"
+
+
+namespace ns3 {
+
+P1906Monitor::P1906Monitor ()
+{
+  if (pthread_mutex_init (&m_mutex, 0) != 0)
+    {
+      NS_FATAL_ERROR ("P1906Monitor: pthread_mutex_init failed");
+    }
+  if (pthread_cond_init (&m_cond, 0) != 0)
+    {
+      NS_FATAL_ERROR ("P1906Monitor: pthread_cond_init failed");
+    }
+}
+
+P1906Monitor::~P1906Monitor ()
+{
+  pthread_cond_destroy (&m_cond);
+  pthread_mutex_destroy (&m_mutex);
+}
+
+void
+P1906Monitor::Lock (void)
+{
+  if (pthread_mutex_lock (&m_mutex) != 0)
+    {
+      NS_FATAL_ERROR ("P1906Monitor: pthread_mutex_lock failed");
+    }
+}
+
+void
+P1906Monitor::Unlock (void)
+{
+  if (pthread_mutex_unlock (&m_mutex) != 0)
+    {
+      NS_FATAL_ERROR ("P1906Monitor: pthread_mutex_unlock failed");
+    }
+}
+
+void
+P1906Monitor::Wait (void)
+{
+  if (pthread_cond_wait (&m_cond, &m_mutex) != 0)
+    {
+      NS_FATAL_ERROR ("P1906Monitor: pthread_cond_wait failed");
+    }
+}
+
+void
+P1906Monitor::Signal (void)
+{
+  pthread_cond_signal (&m_cond);
+}
+
+void
+P1906Monitor::Broadcast (void)
+{
+  pthread_cond_broadcast (&m_cond);
+}
+
+P1906Monitor::Guard::Guard (P1906Monitor &m)
+  : m_monitor (m)
+{
+  m_monitor.Lock ();
+}
+
+P1906Monitor::Guard::~Guard ()
+{
+  m_monitor.Unlock ();
+}
+
+} // namespace ns3
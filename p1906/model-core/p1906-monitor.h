@@ -0,0 +1,106 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *  Copyright � 2014 by IEEE.
+ *
+ *  This source file is an essential part of IEEE P1906.1,
+ *  Recommended Practice for Nanoscale and Molecular
+ *  Communication Framework.
+ *  Verbatim copies of this source file may be used and
+ *  distributed without restriction. Modifications to this source
+ *  file as permitted in IEEE P1906.1 may also be made and
+ *  distributed. All other uses require permission from the IEEE
+ *  Standards Department (stds-ipr@ieee.org). All other rights
+ *  reserved.
+ *
+ *  This source file is provided on an AS IS basis.
+ *  The IEEE disclaims ANY WARRANTY EXPRESS OR IMPLIED INCLUDING
+ *  ANY WARRANTY OF MERCHANTABILITY AND FITNESS FOR USE FOR A
+ *  PARTICULAR PURPOSE.
+ *  The user of the source file shall indemnify and hold
+ *  IEEE harmless from any damages or liability arising out of
+ *  the use thereof.
+ *
+ * Author: Giuseppe Piro - Telematics Lab Research Group
+ *                         Politecnico di Bari
+ *                         giuseppe.piro@poliba.it
+ *                         telematics.poliba.it/piro
+ */
+
+
+#ifndef P1906_MONITOR_H
+#define P1906_MONITOR_H
+
+#include <pthread.h>
+
+namespace ns3 {
+
+/**
+ * \ingroup P1906 framework
+ *
+ * \class P1906Monitor
+ *
+ * \brief A mutex paired with a condition variable, for handing work
+ * between threads.
+ *
+ * SystemCondition keeps its own flag and clears it when Wait is entered,
+ * so a Signal issued before the other thread waits is lost. Here the
+ * waiting thread instead tests the shared state it is waiting for, with
+ * the lock held, in a loop around Wait:
+ *
+ * \code
+ *   P1906Monitor::Guard g (m);
+ *   while (!ready)
+ *     {
+ *       m.Wait ();
+ *     }
+ * \endcode
+ *
+ * and the notifying thread changes that state with the lock held before
+ * calling Signal or Broadcast, so no notification can be missed.
+ */
+class P1906Monitor
+{
+public:
+  P1906Monitor ();
+  ~P1906Monitor ();
+
+  void Lock (void);
+  void Unlock (void);
+
+  /**
+   * Atomically releases the lock and blocks until notified, then takes
+   * the lock again. Must be called with the lock held; wakeups may be
+   * spurious, so the awaited state has to be tested again on return.
+   */
+  void Wait (void);
+  void Signal (void);
+  void Broadcast (void);
+
+  /**
+   * \brief Holds the lock of a P1906Monitor for its lifetime, as
+   * CriticalSection does for a SystemMutex.
+   */
+  class Guard
+  {
+  public:
+    Guard (P1906Monitor &m);
+    ~Guard ();
+
+  private:
+    Guard (const Guard &);
+    Guard &operator= (const Guard &);
+
+    P1906Monitor &m_monitor;
+  };
+
+private:
+  P1906Monitor (const P1906Monitor &);
+  P1906Monitor &operator= (const P1906Monitor &);
+
+  pthread_mutex_t m_mutex;
+  pthread_cond_t m_cond;
+};
+
+}
+
+#endif /* P1906_MONITOR_H */
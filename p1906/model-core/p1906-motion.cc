@@ -28,6 +28,7 @@
 
 
 #include "ns3/log.h"
+#include "ns3/double.h"
 
 #include "p1906-motion.h"
 #include "p1906-communication-interface.h"
@@ -41,11 +42,18 @@ NS_LOG_COMPONENT_DEFINE ("P1906Motion");
 TypeId P1906Motion::GetTypeId (void)
 {
   static TypeId tid = TypeId ("ns3::P1906Motion")
-    .SetParent<Object> ();
+    .SetParent<Object> ()
+    .AddAttribute ("MaxEffectiveRange",
+                   "Maximum distance [m] at which a receiver can be reached (negative means unbounded)",
+                   DoubleValue (-1.0),
+                   MakeDoubleAccessor (&P1906Motion::m_maxEffectiveRange),
+                   MakeDoubleChecker<double> ());
   return tid;
 }
 
 P1906Motion::P1906Motion ()
+  : m_maxEffectiveRange (-1.0),
+    m_parametersVersion (0)
 {
   NS_LOG_FUNCTION (this);
 }
@@ -77,5 +85,57 @@ P1906Motion::CalculateReceivedMessageCarrier(Ptr<P1906CommunicationInterface> sr
   return message;
 }
 
+void
+P1906Motion::SetMaxEffectiveRange (double r)
+{
+  NS_LOG_FUNCTION (this << r);
+  m_maxEffectiveRange = r;
+}
+
+double
+P1906Motion::GetMaxEffectiveRange (void)
+{
+  NS_LOG_FUNCTION (this);
+  return m_maxEffectiveRange;
+}
+
+bool
+P1906Motion::IsCacheable (void)
+{
+  NS_LOG_FUNCTION (this);
+  return false;
+}
+
+bool
+P1906Motion::IsThreadSafe (void)
+{
+  NS_LOG_FUNCTION (this);
+  return false;
+}
+
+double
+P1906Motion::ComputePropagationDelayConcurrent (const Vector &srcPosition,
+                                                const Vector &dstPosition,
+                                                P1906MessageCarrier *message,
+                                                P1906Field *field,
+                                                uint64_t stream)
+{
+  return 0.;
+}
+
+uint32_t
+P1906Motion::GetParametersVersion (void)
+{
+  NS_LOG_FUNCTION (this);
+  return m_parametersVersion;
+}
+
+void
+P1906Motion::NotifyParametersChanged (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_parametersVersion++;
+}
+
 
 } // namespace ns3
@@ -33,6 +33,7 @@
 #include "ns3/object.h"
 #include "ns3/nstime.h"
 #include "ns3/ptr.h"
+#include "ns3/vector.h"
 
 namespace ns3 {
 
@@ -68,8 +69,61 @@ public:
   		                                                           Ptr<P1906MessageCarrier> message,
   		                                                           Ptr<P1906Field> field);
 
-private:
+  /**
+   * \param r the maximum distance [m] at which a receiver can still be affected
+   *
+   * A negative value (the default) means that the range is unbounded.
+   * The P1906Medium uses this value to skip receivers that cannot be reached.
+   */
+  void SetMaxEffectiveRange (double r);
+  virtual double GetMaxEffectiveRange (void);
+
+  /**
+   * \return true if the delay and the received carrier only depend on the
+   * node positions and on the carrier signature, so that the P1906Medium
+   * may memoize them per link (false by default)
+   */
+  virtual bool IsCacheable (void);
+
+  /**
+   * \return true if ComputePropagationDelayConcurrent may be invoked from
+   * several worker threads at the same time (false by default)
+   */
+  virtual bool IsThreadSafe (void);
+
+  /**
+   * \param srcPosition the position of the transmitter
+   * \param dstPosition the position of the receiver
+   * \param message the transmitted carrier
+   * \param field the field in which the carrier propagates (may be null)
+   * \param stream an identifier unique to this transmission and receiver,
+   * usable to seed the random numbers of stochastic Motion components
+   * \return the propagation delay [s]
+   *
+   * Invoked by the P1906Medium from its worker threads when the parallel
+   * Motion evaluation is enabled and IsThreadSafe returns true. Reference
+   * counts are not atomic, so the arguments are raw pointers and the
+   * implementation must neither copy them into a Ptr nor log, schedule
+   * events or modify the state shared with the other receivers.
+   */
+  virtual double ComputePropagationDelayConcurrent (const Vector &srcPosition,
+                                                    const Vector &dstPosition,
+                                                    P1906MessageCarrier *message,
+                                                    P1906Field *field,
+                                                    uint64_t stream);
 
+  /**
+   * \return a counter incremented every time a parameter affecting the
+   * delay or the received carrier is changed
+   */
+  uint32_t GetParametersVersion (void);
+
+protected:
+  void NotifyParametersChanged (void);
+
+private:
+  double m_maxEffectiveRange;
+  uint32_t m_parametersVersion;
 };
 
 }
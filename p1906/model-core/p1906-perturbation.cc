@@ -32,6 +32,7 @@
 #include "ns3/packet.h"
 #include "p1906-perturbation.h"
 #include "p1906-message-carrier.h"
+#include "ns3/uinteger.h"
 
 namespace ns3 {
 
@@ -40,11 +41,19 @@ NS_LOG_COMPONENT_DEFINE ("P1906Perturbation");
 TypeId P1906Perturbation::GetTypeId (void)
 {
   static TypeId tid = TypeId ("ns3::P1906Perturbation")
-    .SetParent<Object> ();
+    .SetParent<Object> ()
+    .AddAttribute ("CarrierPoolSize",
+                   "Maximum number of message carriers recycled by the perturbation (0, the default, disables the recycling)",
+                   UintegerValue (0),
+                   MakeUintegerAccessor (&P1906Perturbation::SetCarrierPoolSize,
+                                         &P1906Perturbation::GetCarrierPoolSize),
+                   MakeUintegerChecker<uint32_t> ());
   return tid;
 }
 
 P1906Perturbation::P1906Perturbation ()
+  : m_carrierPoolSize (0),
+    m_carrierPoolNext (0)
 {
   NS_LOG_FUNCTION (this);
 }
@@ -52,6 +61,15 @@ P1906Perturbation::P1906Perturbation ()
 P1906Perturbation::~P1906Perturbation ()
 {
   NS_LOG_FUNCTION (this);
+  m_carrierPool.clear ();
+}
+
+void
+P1906Perturbation::DoDispose (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_carrierPool.clear ();
+  Object::DoDispose ();
 }
 
 Ptr<P1906MessageCarrier>
@@ -59,9 +77,56 @@ P1906Perturbation::CreateMessageCarrier (Ptr<Packet> p)
 {
   NS_LOG_FUNCTION (this);
 
-  Ptr<P1906MessageCarrier> carrier = CreateObject<P1906MessageCarrier> ();
+  Ptr<P1906MessageCarrier> carrier = AllocateMessageCarrier<P1906MessageCarrier> ();
   carrier->SetMessage (p);
   return carrier;
 }
 
+void
+P1906Perturbation::SetCarrierPoolSize (uint32_t n)
+{
+  NS_LOG_FUNCTION (this << n);
+  m_carrierPoolSize = n;
+  if (m_carrierPool.size () > n)
+    {
+      m_carrierPool.resize (n);
+    }
+  m_carrierPoolNext = 0;
+}
+
+uint32_t
+P1906Perturbation::GetCarrierPoolSize (void)
+{
+  NS_LOG_FUNCTION (this);
+  return m_carrierPoolSize;
+}
+
+Ptr<P1906MessageCarrier>
+P1906Perturbation::GetFreeMessageCarrier (void)
+{
+  NS_LOG_FUNCTION (this);
+  for (uint32_t k = 0; k < m_carrierPool.size (); k++)
+    {
+      m_carrierPoolNext = (m_carrierPoolNext + 1) % m_carrierPool.size ();
+      if (PeekPointer (m_carrierPool[m_carrierPoolNext])->GetReferenceCount () == 1)
+        {
+          Ptr<P1906MessageCarrier> carrier = m_carrierPool[m_carrierPoolNext];
+          carrier->Reset ();
+          NS_LOG_FUNCTION (this << "recycled carrier" << carrier);
+          return carrier;
+        }
+    }
+  return 0;
+}
+
+void
+P1906Perturbation::AddMessageCarrier (Ptr<P1906MessageCarrier> c)
+{
+  NS_LOG_FUNCTION (this << c);
+  if (m_carrierPool.size () < m_carrierPoolSize)
+    {
+      m_carrierPool.push_back (c);
+    }
+}
+
 } // namespace ns3
@@ -34,12 +34,13 @@
 #include "ns3/object.h"
 #include "ns3/nstime.h"
 #include "ns3/ptr.h"
+#include "ns3/p1906-message-carrier.h"
+#include <vector>
 
 namespace ns3 {
 
 class P1906NetDevice;
 class Packet;
-class P1906MessageCarrier;
 
 /**
  * \ingroup P1906 framework
@@ -60,9 +61,53 @@ public:
 
   virtual Ptr<P1906MessageCarrier> CreateMessageCarrier (Ptr<Packet> p);
 
+  /**
+   * \param n the maximum number of message carriers recycled by this
+   * perturbation (0, the default, disables the recycling)
+   *
+   * Recycling is only safe when the Reset method of the carrier type
+   * clears all of its per-transmission state.
+   */
+  void SetCarrierPoolSize (uint32_t n);
+  uint32_t GetCarrierPoolSize (void);
+
+protected:
+  virtual void DoDispose (void);
+
+  /**
+   * \return a message carrier of type T, either recycled or newly created
+   *
+   * The perturbation keeps a reference to every carrier it creates, up to
+   * the pool size. A carrier is recycled, after a call to Reset, once the
+   * pool holds the only reference to it, i.e., once every receiver has
+   * completed the reception and released it. With a pool size of 0 a new
+   * carrier is created at every call.
+   */
+  template <typename T>
+  Ptr<T> AllocateMessageCarrier (void);
+
 private:
+  Ptr<P1906MessageCarrier> GetFreeMessageCarrier (void);
+  void AddMessageCarrier (Ptr<P1906MessageCarrier> c);
+
+  std::vector<Ptr<P1906MessageCarrier> > m_carrierPool;
+  uint32_t m_carrierPoolSize;
+  uint32_t m_carrierPoolNext;
 };
 
+template <typename T>
+Ptr<T>
+P1906Perturbation::AllocateMessageCarrier (void)
+{
+  Ptr<T> carrier = DynamicCast<T> (GetFreeMessageCarrier ());
+  if (carrier == 0)
+    {
+      carrier = CreateObject<T> ();
+      AddMessageCarrier (carrier);
+    }
+  return carrier;
+}
+
 }
 
 #endif /* P1906_PERTURBATION */
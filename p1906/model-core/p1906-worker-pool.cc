@@ -0,0 +1,169 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *  Copyright � 2014 by IEEE.
+ *
+ *  This source file is an essential part of IEEE P1906.1,
+ *  Recommended Practice for Nanoscale and Molecular
+ *  Communication Framework.
+ *  Verbatim copies of this source file may be used and
+ *  distributed without restriction. Modifications to this source
+ *  file as permitted in IEEE P1906.1 may also be made and
+ *  distributed. All other uses require permission from the IEEE
+ *  Standards Department (stds-ipr@ieee.org). All other rights
+ *  reserved.
+ *
+ *  This source file is provided on an AS IS basis.
+ *  The IEEE disclaims ANY WARRANTY EXPRESS OR IMPLIED INCLUDING
+ *  ANY WARRANTY OF MERCHANTABILITY AND FITNESS FOR USE FOR A
+ *  PARTICULAR PURPOSE.
+ *  The user of the source file shall indemnify and hold
+ *  IEEE harmless from any damages or liability arising out of
+ *  the use thereof.
+ *
+ * Author: Giuseppe Piro - Telematics Lab Research Group
+ *                         Politecnico di Bari
+ *                         giuseppe.piro@poliba.it
+ *                         telematics.poliba.it/piro
+ */
+
+
+#include "ns3/log.h"
+#include "p1906-worker-pool.h"
+
+
+NS_LOG_COMPONENT_DEFINE ("P1906WorkerPool");
+
+namespace ns3 {
+
+P1906WorkerPool::P1906WorkerPool ()
+  : m_threads (0),
+    m_generation (0),
+    m_startGeneration (0),
+    m_running (0),
+    m_stop (false)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+P1906WorkerPool::~P1906WorkerPool ()
+{
+  NS_LOG_FUNCTION (this);
+  Stop ();
+}
+
+void
+P1906WorkerPool::SetThreads (uint32_t n)
+{
+  NS_LOG_FUNCTION (this << n);
+  if (n != m_threads)
+    {
+      Stop ();
+    }
+  m_threads = n;
+}
+
+uint32_t
+P1906WorkerPool::GetThreads (void) const
+{
+  NS_LOG_FUNCTION (this);
+  return m_threads;
+}
+
+void
+P1906WorkerPool::Run (Callback<void> job)
+{
+  NS_LOG_FUNCTION (this << m_threads);
+
+  if (m_threads < 2)
+    {
+      job ();
+      return;
+    }
+
+  if (m_workers.empty ())
+    {
+      // a worker started now skips the generations already run, even if
+      // it only gets to the lock after the generation below is published
+      {
+        P1906Monitor::Guard g (m_monitor);
+        m_startGeneration = m_generation;
+      }
+      for (uint32_t i = 1; i < m_threads; i++)
+        {
+          Ptr<SystemThread> t = Create<SystemThread> (MakeCallback (&P1906WorkerPool::Worker, this));
+          t->Start ();
+          m_workers.push_back (t);
+        }
+    }
+
+  {
+    P1906Monitor::Guard g (m_monitor);
+    m_job = job;
+    m_generation++;
+    m_running = m_workers.size ();
+    m_monitor.Broadcast ();
+  }
+
+  job ();
+
+  P1906Monitor::Guard g (m_monitor);
+  while (m_running > 0)
+    {
+      m_monitor.Wait ();
+    }
+  m_job = Callback<void> ();
+}
+
+void
+P1906WorkerPool::Stop (void)
+{
+  NS_LOG_FUNCTION (this << m_workers.size ());
+
+  if (m_workers.empty ())
+    {
+      return;
+    }
+  {
+    P1906Monitor::Guard g (m_monitor);
+    m_stop = true;
+    m_monitor.Broadcast ();
+  }
+  for (uint32_t i = 0; i < m_workers.size (); i++)
+    {
+      m_workers[i]->Join ();
+    }
+  m_workers.clear ();
+  m_stop = false;
+}
+
+void
+P1906WorkerPool::Worker (void)
+{
+  // no logging here: this runs outside the simulator thread
+  P1906Monitor::Guard g (m_monitor);
+  uint64_t seen = m_startGeneration;
+  while (true)
+    {
+      while (m_generation == seen && !m_stop)
+        {
+          m_monitor.Wait ();
+        }
+      if (m_stop)
+        {
+          return;
+        }
+      seen = m_generation;
+
+      // m_job is not copied: reference counts are not atomic
+      m_monitor.Unlock ();
+      m_job ();
+      m_monitor.Lock ();
+
+      if (--m_running == 0)
+        {
+          m_monitor.Broadcast ();
+        }
+    }
+}
+
+} // namespace ns3
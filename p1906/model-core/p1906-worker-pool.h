@@ -0,0 +1,102 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *  Copyright � 2014 by IEEE.
+ *
+ *  This source file is an essential part of IEEE P1906.1,
+ *  Recommended Practice for Nanoscale and Molecular
+ *  Communication Framework.
+ *  Verbatim copies of this source file may be used and
+ *  distributed without restriction. Modifications to this source
+ *  file as permitted in IEEE P1906.1 may also be made and
+ *  distributed. All other uses require permission from the IEEE
+ *  Standards Department (stds-ipr@ieee.org). All other rights
+ *  reserved.
+ *
+ *  This source file is provided on an AS IS basis.
+ *  The IEEE disclaims ANY WARRANTY EXPRESS OR IMPLIED INCLUDING
+ *  ANY WARRANTY OF MERCHANTABILITY AND FITNESS FOR USE FOR A
+ *  PARTICULAR PURPOSE.
+ *  The user of the source file shall indemnify and hold
+ *  IEEE harmless from any damages or liability arising out of
+ *  the use thereof.
+ *
+ * Author: Giuseppe Piro - Telematics Lab Research Group
+ *                         Politecnico di Bari
+ *                         giuseppe.piro@poliba.it
+ *                         telematics.poliba.it/piro
+ */
+
+
+#ifndef P1906_WORKER_POOL_H
+#define P1906_WORKER_POOL_H
+
+#include "ns3/callback.h"
+#include "ns3/ptr.h"
+#include "ns3/system-thread.h"
+#include <vector>
+#include "p1906-monitor.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup P1906 framework
+ *
+ * \class P1906WorkerPool
+ *
+ * \brief A set of threads kept alive between parallel sections.
+ *
+ * Run hands a job to the workers and to the calling thread and returns
+ * once all of them have returned from it. The job must share out its
+ * work by itself, e.g. taking items from a counter under a lock, since
+ * every thread calls it exactly once per Run. The workers are started by
+ * the first Run and wait for the next one until Stop is called, the
+ * number of threads changes or the pool is destroyed.
+ *
+ * Run, SetThreads and Stop must be called from a single thread.
+ */
+class P1906WorkerPool
+{
+public:
+  P1906WorkerPool ();
+  ~P1906WorkerPool ();
+
+  /**
+   * \param n the number of threads running a job, the calling one included
+   *
+   * A value lower than 2 (the default) runs the job on the calling
+   * thread only.
+   */
+  void SetThreads (uint32_t n);
+  uint32_t GetThreads (void) const;
+
+  /**
+   * \param job the function called once by each thread
+   */
+  void Run (Callback<void> job);
+
+  /**
+   * Stops and joins the workers; the next Run starts them again.
+   */
+  void Stop (void);
+
+private:
+  P1906WorkerPool (const P1906WorkerPool &);
+  P1906WorkerPool &operator= (const P1906WorkerPool &);
+
+  void Worker (void);
+
+  uint32_t m_threads;
+  std::vector<Ptr<SystemThread> > m_workers;
+
+  // all guarded by m_monitor
+  P1906Monitor m_monitor;
+  Callback<void> m_job;
+  uint64_t m_generation;
+  uint64_t m_startGeneration;
+  uint32_t m_running;
+  bool m_stop;
+};
+
+}
+
+#endif /* P1906_WORKER_POOL_H */
@@ -168,4 +168,90 @@ P1906EMMessageCarrier::GetSubChannel (void)
   return m_subChannel;
 }
 
+Ptr<P1906EMMessageCarrier>
+P1906EMMessageCarrier::CreateReceivedView (Ptr<SpectrumValue> rxPsd)
+{
+  NS_LOG_FUNCTION (this << rxPsd);
+  Ptr<P1906EMMessageCarrier> c = CreateObject<P1906EMMessageCarrier> ();
+  c->SetMessage (GetMessage ());
+  c->SetSpectrumValue (rxPsd);
+  c->SetDuration (m_duration);
+  c->SetPulseDuration (m_pulseDuration);
+  c->SetPulseInterval (m_pulseInterval);
+  c->SetStartTime (m_startTime);
+  c->SetCentralFrequency (m_centralFrequency);
+  c->SetBandwidth (m_bandwidth);
+  c->SetSubChannel (m_subChannel);
+  return c;
+}
+
+bool
+P1906EMMessageCarrier::GetSignature (uint64_t &signature)
+{
+  NS_LOG_FUNCTION (this);
+  uint64_t h = 14695981039346656037ULL;
+  h = HashSignature (h, m_duration.GetSeconds ());
+  h = HashSignature (h, m_pulseDuration.GetSeconds ());
+  h = HashSignature (h, m_pulseInterval.GetSeconds ());
+  h = HashSignature (h, m_centralFrequency);
+  h = HashSignature (h, m_bandwidth);
+  h = HashSignature (h, m_subChannel);
+  if (m_spectrumValue)
+    {
+      for (Values::const_iterator it = m_spectrumValue->ConstValuesBegin (); it != m_spectrumValue->ConstValuesEnd (); it++)
+        {
+          h = HashSignature (h, *it);
+        }
+    }
+  signature = h;
+  return true;
+}
+
+Ptr<P1906MessageCarrier>
+P1906EMMessageCarrier::Copy (void)
+{
+  NS_LOG_FUNCTION (this);
+  Ptr<P1906EMMessageCarrier> c = CreateObject<P1906EMMessageCarrier> ();
+  c->SetMessage (GetMessage ());
+  // the PSD is read-only, so the two carriers can share it
+  c->SetSpectrumValue (m_spectrumValue);
+  c->SetDuration (m_duration);
+  c->SetPulseDuration (m_pulseDuration);
+  c->SetPulseInterval (m_pulseInterval);
+  c->SetStartTime (m_startTime);
+  c->SetCentralFrequency (m_centralFrequency);
+  c->SetBandwidth (m_bandwidth);
+  c->SetSubChannel (m_subChannel);
+  return c;
+}
+
+void
+P1906EMMessageCarrier::CopyTransmissionState (Ptr<P1906MessageCarrier> c)
+{
+  NS_LOG_FUNCTION (this);
+  P1906MessageCarrier::CopyTransmissionState (c);
+  Ptr<P1906EMMessageCarrier> m = c->GetObject<P1906EMMessageCarrier> ();
+  if (m)
+    {
+      m_startTime = m->GetStartTime ();
+    }
+}
+
+
+void
+P1906EMMessageCarrier::Reset (void)
+{
+  NS_LOG_FUNCTION (this);
+  P1906MessageCarrier::Reset ();
+  m_spectrumValue = 0;
+  m_duration = Seconds (0);
+  m_pulseDuration = Seconds (0);
+  m_pulseInterval = Seconds (0);
+  m_startTime = Seconds (0);
+  m_centralFrequency = 0;
+  m_bandwidth = 0;
+  m_subChannel = 0;
+}
+
+
 } // namespace ns3
@@ -58,6 +58,11 @@ public:
   P1906EMMessageCarrier ();
   virtual ~P1906EMMessageCarrier ();
 
+  /**
+   * The PSD may be shared by several carriers: the value returned by
+   * GetSpectrumValue must be treated as read-only, and a component
+   * changing it sets a new PSD instead.
+   */
   void SetSpectrumValue (Ptr<SpectrumValue>);
   Ptr<SpectrumValue> GetSpectrumValue (void);
 
@@ -77,6 +82,20 @@ public:
   void SetSubChannel (double c);
   double GetSubChannel (void);
 
+  /**
+   * \param rxPsd the PSD observed by a receiver
+   * \return a received view of this (transmitted) carrier: a carrier sharing
+   * the message and the parameters, holding rxPsd as its only own state;
+   * the transmitted carrier is left untouched, so a transmission can fan out
+   * to many receivers without aliasing
+   */
+  Ptr<P1906EMMessageCarrier> CreateReceivedView (Ptr<SpectrumValue> rxPsd);
+
+  virtual bool GetSignature (uint64_t &signature);
+  virtual Ptr<P1906MessageCarrier> Copy (void);
+  virtual void CopyTransmissionState (Ptr<P1906MessageCarrier> c);
+  virtual void Reset (void);
+
 private:
   Ptr<SpectrumValue> m_spectrumValue;
   Time m_duration;
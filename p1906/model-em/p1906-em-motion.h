@@ -34,6 +34,10 @@
 #include "ns3/nstime.h"
 #include "ns3/ptr.h"
 #include "ns3/p1906-motion.h"
+#include "ns3/p1906-em-spectral-table.h"
+#include "ns3/spectrum-value.h"
+#include <string>
+#include <vector>
 
 namespace ns3 {
 
@@ -64,11 +68,46 @@ public:
   		                                                           Ptr<P1906MessageCarrier> message,
   		                                                           Ptr<P1906Field> field);
 
+  virtual bool IsCacheable (void);
+  virtual bool IsThreadSafe (void);
+  virtual double ComputePropagationDelayConcurrent (const Vector &srcPosition,
+                                                    const Vector &dstPosition,
+                                                    P1906MessageCarrier *message,
+                                                    P1906Field *field,
+                                                    uint64_t stream);
+
   void SetWaveSpeed (double s);
   double GetWaveSpeed (void);
 
+  /**
+   * \param i true to interpolate the path loss between the distances of the table
+   */
+  void SetInterpolation (bool i);
+  bool GetInterpolation (void);
+
+  /**
+   * \param fileName binary spectral table holding the path loss [dB];
+   * an empty name selects the built-in table
+   */
+  void SetPathLossTable (std::string fileName);
+  std::string GetPathLossTable (void);
+
 private:
+  /**
+   * \return a PSD holding a copy of txPsd, taken from a fixed-size pool of
+   * received PSDs when one of them is no longer referenced by any carrier
+   */
+  Ptr<SpectrumValue> AllocateRxPsd (Ptr<const SpectrumValue> txPsd);
+
+  static const uint32_t RX_PSD_POOL_SIZE = 64;
+
   double m_waveSpeed;
+  bool m_interpolation;
+  Ptr<const P1906EMSpectralTable> m_pathLoss;
+  std::string m_pathLossTable;
+  std::vector<Ptr<SpectrumValue> > m_rxPsdPool;
+  uint32_t m_rxPsdPoolNext;
+  uint32_t m_pathLossModelUid; //!< last spectrum model matched against the path loss table (0 if none)
 };
 
 }
@@ -36,6 +36,7 @@
 #include "p1906-em-message-carrier.h"
 #include "ns3/simulator.h"
 #include "ns3/spectrum-value.h"
+#include <map>
 
 namespace ns3 {
 
@@ -56,6 +57,7 @@ P1906EMPerturbation::P1906EMPerturbation ()
 P1906EMPerturbation::~P1906EMPerturbation ()
 {
   NS_LOG_FUNCTION (this);
+  m_txPsd = 0;
 }
 
 void
@@ -63,6 +65,7 @@ P1906EMPerturbation::SetPowerTransmission (double ptx)
 {
   NS_LOG_FUNCTION (this << ptx);
   m_powerTx = ptx;
+  m_txPsd = 0;
 }
 
 double
@@ -105,6 +108,7 @@ P1906EMPerturbation::SetCentralFrequency (double f)
 {
   NS_LOG_FUNCTION (this << f);
   m_centralFrequency = f;
+  m_txPsd = 0;
 }
 
 double
@@ -119,6 +123,7 @@ P1906EMPerturbation::SetBandwidth (double b)
 {
   NS_LOG_FUNCTION (this << b);
   m_bandwidth = b;
+  m_txPsd = 0;
 }
 
 double
@@ -133,6 +138,7 @@ P1906EMPerturbation::SetSubChannel (double c)
 {
   NS_LOG_FUNCTION (this << c);
   m_subChannel = c;
+  m_txPsd = 0;
 }
 
 double
@@ -146,7 +152,7 @@ Ptr<P1906MessageCarrier>
 P1906EMPerturbation::CreateMessageCarrier (Ptr<Packet> p)
 {
   NS_LOG_FUNCTION (this);
-  Ptr<P1906EMMessageCarrier> carrier = CreateObject<P1906EMMessageCarrier> ();
+  Ptr<P1906EMMessageCarrier> carrier = AllocateMessageCarrier<P1906EMMessageCarrier> ();
 
   double duration = m_pulseInterval.GetSeconds () * p->GetSize () * 8;
   double now = Simulator::Now ().GetSeconds ();
@@ -155,26 +161,8 @@ P1906EMPerturbation::CreateMessageCarrier (Ptr<Packet> p)
 		  << m_pulseDuration << m_pulseInterval
 		  << duration);
 
-  //create the vector of frequencies
-  std::vector<double> freqs;
-  int nb_of_subchannels = GetBandwidth ()/GetSubChannel ();
-  double startFrequency = GetCentralFrequency () - (GetSubChannel() * nb_of_subchannels/2) + GetSubChannel()/2;
-  for (int i = 0; i < nb_of_subchannels; ++i)
-    {
-	  NS_LOG_FUNCTION (this << "[i,f]"<< i << startFrequency + (i*GetSubChannel ()));
-      freqs.push_back (startFrequency + (i*GetSubChannel ()));
-    }
-
-  Ptr<SpectrumModel> NanoSpectrumModel = Create<SpectrumModel> (freqs);
-  Ptr<SpectrumValue> txPsd = Create <SpectrumValue> (NanoSpectrumModel);
-
-  NS_LOG_FUNCTION (this << "[ptx,numChannels]" << m_powerTx << txPsd->GetSpectrumModel ()->GetNumBands ());
-
-  double txPowerDensity = (m_powerTx / txPsd->GetSpectrumModel ()->GetNumBands ())/
-		  GetSubChannel ();
-  (*txPsd) = txPowerDensity;
-
-  NS_LOG_FUNCTION (this << "[txPsd]" << *txPsd);
+  Ptr<SpectrumValue> txPsd = GetTxPsd ();
+  NS_LOG_FUNCTION (this << "[txPsd,uid]" << *txPsd << txPsd->GetSpectrumModelUid ());
 
   carrier->SetPulseDuration (m_pulseDuration);
   carrier->SetPulseInterval (m_pulseInterval);
@@ -189,4 +177,55 @@ P1906EMPerturbation::CreateMessageCarrier (Ptr<Packet> p)
   return carrier;
 }
 
+Ptr<const SpectrumModel>
+P1906EMPerturbation::GetSpectrumModel (double f, double b, double c)
+{
+  NS_LOG_FUNCTION (f << b << c);
+
+  typedef std::pair<double, std::pair<double, double> > Key;
+  static std::map<Key, Ptr<const SpectrumModel> > models;
+
+  Key key = std::make_pair (f, std::make_pair (b, c));
+  std::map<Key, Ptr<const SpectrumModel> >::iterator it = models.find (key);
+  if (it != models.end ())
+    {
+      return it->second;
+    }
+
+  //create the vector of frequencies
+  std::vector<double> freqs;
+  int nb_of_subchannels = b/c;
+  double startFrequency = f - (c * nb_of_subchannels/2) + c/2;
+  for (int i = 0; i < nb_of_subchannels; ++i)
+    {
+	  NS_LOG_FUNCTION ("[i,f]"<< i << startFrequency + (i*c));
+      freqs.push_back (startFrequency + (i*c));
+    }
+
+  Ptr<const SpectrumModel> model = Create<SpectrumModel> (freqs);
+  models[key] = model;
+  return model;
+}
+
+Ptr<SpectrumValue>
+P1906EMPerturbation::GetTxPsd (void)
+{
+  NS_LOG_FUNCTION (this);
+  if (m_txPsd)
+    {
+      return m_txPsd;
+    }
+
+  Ptr<const SpectrumModel> model = GetSpectrumModel (GetCentralFrequency (), GetBandwidth (), GetSubChannel ());
+  m_txPsd = Create <SpectrumValue> (model);
+
+  NS_LOG_FUNCTION (this << "[ptx,numChannels]" << m_powerTx << model->GetNumBands ());
+
+  double txPowerDensity = (m_powerTx / model->GetNumBands ())/
+		  GetSubChannel ();
+  (*m_txPsd) = txPowerDensity;
+
+  return m_txPsd;
+}
+
 } // namespace ns3
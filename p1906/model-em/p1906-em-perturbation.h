@@ -35,6 +35,7 @@
 #include "ns3/nstime.h"
 #include "ns3/ptr.h"
 #include "ns3/p1906-perturbation.h"
+#include "ns3/spectrum-value.h"
 
 namespace ns3 {
 
@@ -71,14 +72,27 @@ public:
   void SetSubChannel (double c);
   double GetSubChannel (void);
 
+  /**
+   * \return the SpectrumModel of the sub-channels centered in f, spanning b
+   * with steps of c; models are interned, so that the same parameters always
+   * return the same model (and the same SpectrumModel UID)
+   */
+  static Ptr<const SpectrumModel> GetSpectrumModel (double f, double b, double c);
 
 private:
+  /**
+   * \return the PSD shared (copy-on-write) by all the carriers created with
+   * the current parameters; it is rebuilt only when a parameter changes
+   */
+  Ptr<SpectrumValue> GetTxPsd (void);
+
   double m_powerTx;
   Time m_pulseDuration;
   Time m_pulseInterval;
   double m_centralFrequency;
   double m_bandwidth;
   double m_subChannel;
+  Ptr<SpectrumValue> m_txPsd;
 };
 
 }
@@ -34,6 +34,8 @@
 #include "ns3/nstime.h"
 #include "ns3/ptr.h"
 #include "ns3/p1906-specificity.h"
+#include "ns3/p1906-em-spectral-table.h"
+#include <string>
 
 namespace ns3 {
 
@@ -56,8 +58,18 @@ public:
 
   virtual bool CheckRxCompatibility (Ptr<P1906CommunicationInterface> src, Ptr<P1906CommunicationInterface> dst, Ptr<P1906MessageCarrier> message);
 
-private:
+  /**
+   * \param fileName binary spectral table holding the molecular noise temperature [K];
+   * an empty name selects the built-in table
+   */
+  void SetMolecularNoiseTable (std::string fileName);
+  std::string GetMolecularNoiseTable (void);
 
+private:
+  bool m_interpolation;
+  Ptr<const P1906EMSpectralTable> m_molecularNoise;
+  std::string m_molecularNoiseTable;
+  uint32_t m_molecularNoiseModelUid; //!< last spectrum model matched against the molecular noise table (0 if none)
 };
 
 }
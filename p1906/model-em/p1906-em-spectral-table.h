@@ -0,0 +1,190 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *  Copyright � 2014 by IEEE.
+ *
+ *  This source file is an essential part of IEEE P1906.1,
+ *  Recommended Practice for Nanoscale and Molecular
+ *  Communication Framework.
+ *  Verbatim copies of this source file may be used and
+ *  distributed without restriction. Modifications to this source
+ *  file as permitted in IEEE P1906.1 may also be made and
+ *  distributed. All other uses require permission from the IEEE
+ *  Standards Department (stds-ipr@ieee.org). All other rights
+ *  reserved.
+ *
+ *  This source file is provided on an AS IS basis.
+ *  The IEEE disclaims ANY WARRANTY EXPRESS OR IMPLIED INCLUDING
+ *  ANY WARRANTY OF MERCHANTABILITY AND FITNESS FOR USE FOR A
+ *  PARTICULAR PURPOSE.
+ *  The user of the source file shall indemnify and hold
+ *  IEEE harmless from any damages or liability arising out of
+ *  the use thereof.
+ *
+ * Author: Giuseppe Piro - Telematics Lab Research Group
+ *                         Politecnico di Bari
+ *                         giuseppe.piro@poliba.it
+ *                         telematics.poliba.it/piro
+ */
+
+
+#ifndef P1906_EM_SPECTRAL_TABLE
+#define P1906_EM_SPECTRAL_TABLE
+
+#include "ns3/simple-ref-count.h"
+#include "ns3/ptr.h"
+#include "ns3/attribute.h"
+#include <string>
+#include <vector>
+
+namespace ns3 {
+
+class SpectrumModel;
+
+/**
+ * \ingroup P1906 framework
+ *
+ * \class P1906EMSpectralTable
+ *
+ * \brief Read-only table of per sub-channel values (e.g., path loss or
+ * molecular absorption noise) sampled on a uniform distance grid,
+ * shared by all the EM components.
+ *
+ * The default tables of the EM example (1000 distances from 0.1 mm to 0.5 m,
+ * 11 sub-channels from 0.5 THz to 1.5 THz) are built once and returned by
+ * GetDefaultPathLoss and GetDefaultMolecularNoise.
+ *
+ * Other bands and media are loaded from binary table files, which are
+ * memory mapped read-only and used in place, so that they are shared through
+ * the page cache and nothing is parsed or computed when they are loaded.
+ * The gains 10^(-v/10) are precomputed into the file next to the values.
+ * All the fields are stored in the native byte order:
+ * <pre>
+ *  offset  size          field
+ *  0       8             magic "P1906SPT"
+ *  8       4             format version (2)
+ *  12      4             value type (0 = double, 1 = float)
+ *  16      4             number of distances (D)
+ *  20      4             number of sub-channels (S)
+ *  24      8             first distance of the grid [m]
+ *  32      8             step of the distance grid [m]
+ *  40      8 * S         central frequency of each sub-channel [Hz]
+ *  40+8*S  D * S values  values stored by rows (one row per distance)
+ *  ...     D * S values  gains 10^(-v/10) of the values, stored the same way
+ * </pre>
+ * Files are produced from CSV by the em-table-converter example program.
+ */
+class P1906EMSpectralTable : public SimpleRefCount<P1906EMSpectralTable>
+{
+public:
+  /**
+   * \param dMin the first distance of the grid [m]
+   * \param dStep the step of the grid [m]
+   * \param nDistances the number of distances
+   * \param nSubChannels the number of sub-channels
+   * \param data the nDistances x nSubChannels values, stored by rows; it is
+   * not copied and must outlive the table
+   */
+  P1906EMSpectralTable (double dMin, double dStep, uint32_t nDistances, uint32_t nSubChannels, const double *data);
+  /**
+   * \param dMin the first distance of the grid [m]
+   * \param dStep the step of the grid [m]
+   * \param nDistances the number of distances
+   * \param nSubChannels the number of sub-channels
+   * \param singlePrecision the values and gains are float instead of double
+   * \param values the nDistances x nSubChannels values, stored by rows
+   * \param gains their gains 10^(-v/10), stored the same way
+   *
+   * Neither array is copied; both must outlive the table.
+   */
+  P1906EMSpectralTable (double dMin, double dStep, uint32_t nDistances, uint32_t nSubChannels,
+                        bool singlePrecision, const void *values, const void *gains);
+  virtual ~P1906EMSpectralTable ();
+
+  static Ptr<const P1906EMSpectralTable> GetDefaultPathLoss (void);
+  static Ptr<const P1906EMSpectralTable> GetDefaultMolecularNoise (void);
+
+  /**
+   * \param fileName the binary table file
+   * \return the table, or 0 if the file can not be mapped or is malformed;
+   * a file is mapped only once per process
+   */
+  static Ptr<const P1906EMSpectralTable> Load (std::string fileName);
+
+  /**
+   * \return a checker of string attributes naming a table file, accepting
+   * the empty string (the built-in table) and the files Load can map
+   */
+  static Ptr<const AttributeChecker> MakeChecker (void);
+
+  /**
+   * \param fileName the binary table file to write
+   * \param dMin the first distance of the grid [m]
+   * \param dStep the step of the grid [m]
+   * \param frequencies the central frequency of each sub-channel [Hz]
+   * \param values the distances x sub-channels values, stored by rows
+   * \param singlePrecision store the values and their gains as float instead of double
+   * \return true on success
+   */
+  static bool Write (std::string fileName, double dMin, double dStep,
+                     const std::vector<double> &frequencies,
+                     const std::vector<double> &values,
+                     bool singlePrecision);
+
+  uint32_t GetNDistances (void) const;
+  uint32_t GetNSubChannels (void) const;
+  double GetDistance (uint32_t i) const;
+  double GetFrequency (uint32_t c) const;
+
+  /**
+   * \param model the spectrum model of a carrier
+   * \return true if the sub-channels of the table are the bands of the model:
+   * same number, and same central frequencies up to a relative error of 1e-6
+   */
+  bool MatchesSpectrumModel (Ptr<const SpectrumModel> model) const;
+
+  /**
+   * \param d the distance [m]
+   * \return the index of the last grid distance lower or equal to d,
+   * clamped to the grid bounds
+   */
+  uint32_t GetDistanceIndex (double d) const;
+
+  /**
+   * \return the value of the sub-channel c at the grid distance i
+   */
+  double GetValueAt (uint32_t i, uint32_t c) const;
+
+  /**
+   * \param d the distance [m]
+   * \param c the sub-channel
+   * \param interpolate if true, interpolate linearly between the two closest
+   * grid distances, otherwise return the value of the lower bin
+   */
+  double GetValue (double d, uint32_t c, bool interpolate) const;
+
+  /**
+   * \return the gain 10^(-v/10) of the sub-channel c at the grid distance i,
+   * i.e., the table value read as an attenuation in dB
+   */
+  double GetGainAt (uint32_t i, uint32_t c) const;
+
+protected:
+  double m_dMin;
+  double m_dStep;
+  uint32_t m_nDistances;
+  uint32_t m_nSubChannels;
+  bool m_singlePrecision;
+  const void *m_values;
+  const void *m_gains;
+  std::vector<double> m_frequencies;
+
+private:
+  void *m_mapping;
+  size_t m_mappingSize;
+  //! gains of the built-in tables, which are not backed by a file
+  std::vector<double> m_builtinGains;
+};
+
+}
+
+#endif /* P1906_EM_SPECTRAL_TABLE */
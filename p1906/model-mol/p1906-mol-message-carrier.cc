@@ -111,4 +111,54 @@ P1906MOLMessageCarrier::GetMolecules (void)
   return m_molecules;
 }
 
+bool
+P1906MOLMessageCarrier::GetSignature (uint64_t &signature)
+{
+  NS_LOG_FUNCTION (this);
+  uint64_t h = 14695981039346656037ULL;
+  h = HashSignature (h, m_duration.GetSeconds ());
+  h = HashSignature (h, m_pulseInterval.GetSeconds ());
+  h = HashSignature (h, m_molecules);
+  signature = h;
+  return true;
+}
+
+Ptr<P1906MessageCarrier>
+P1906MOLMessageCarrier::Copy (void)
+{
+  NS_LOG_FUNCTION (this);
+  Ptr<P1906MOLMessageCarrier> c = CreateObject<P1906MOLMessageCarrier> ();
+  c->SetMessage (GetMessage ());
+  c->SetDuration (m_duration);
+  c->SetPulseInterval (m_pulseInterval);
+  c->SetStartTime (m_startTime);
+  c->SetMolecules (m_molecules);
+  return c;
+}
+
+void
+P1906MOLMessageCarrier::CopyTransmissionState (Ptr<P1906MessageCarrier> c)
+{
+  NS_LOG_FUNCTION (this);
+  P1906MessageCarrier::CopyTransmissionState (c);
+  Ptr<P1906MOLMessageCarrier> m = c->GetObject<P1906MOLMessageCarrier> ();
+  if (m)
+    {
+      m_startTime = m->GetStartTime ();
+    }
+}
+
+
+void
+P1906MOLMessageCarrier::Reset (void)
+{
+  NS_LOG_FUNCTION (this);
+  P1906MessageCarrier::Reset ();
+  m_duration = Seconds (0);
+  m_pulseInterval = Seconds (0);
+  m_startTime = Seconds (0);
+  m_molecules = 0;
+}
+
+
 } // namespace ns3
@@ -68,6 +68,11 @@ public:
   void SetMolecules (double q);
   double GetMolecules (void);
 
+  virtual bool GetSignature (uint64_t &signature);
+  virtual Ptr<P1906MessageCarrier> Copy (void);
+  virtual void CopyTransmissionState (Ptr<P1906MessageCarrier> c);
+  virtual void Reset (void);
+
 private:
   Time m_duration;
   Time m_pulseInterval;
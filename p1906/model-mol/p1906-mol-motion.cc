@@ -106,6 +106,7 @@ P1906MOLMotion::SetDiffusionCoefficient (double d)
 {
   NS_LOG_FUNCTION (this << d);
   m_diffusionCoefficient = d;
+  NotifyParametersChanged ();
 }
 
 double
@@ -116,4 +117,30 @@ P1906MOLMotion::GetDiffusionConefficient (void)
 }
 
 
+bool
+P1906MOLMotion::IsCacheable (void)
+{
+  NS_LOG_FUNCTION (this);
+  return true;
+}
+
+bool
+P1906MOLMotion::IsThreadSafe (void)
+{
+  NS_LOG_FUNCTION (this);
+  return true;
+}
+
+double
+P1906MOLMotion::ComputePropagationDelayConcurrent (const Vector &srcPosition,
+                                                   const Vector &dstPosition,
+                                                   P1906MessageCarrier *message,
+                                                   P1906Field *field,
+                                                   uint64_t stream)
+{
+  double distance = CalculateDistance (srcPosition, dstPosition);
+  return pow(distance,2)/(m_diffusionCoefficient*6);
+}
+
+
 } // namespace ns3
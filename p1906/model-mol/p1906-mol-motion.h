@@ -64,10 +64,18 @@ public:
   		                                                           Ptr<P1906MessageCarrier> message,
   		                                                           Ptr<P1906Field> field);
 
+  virtual bool IsCacheable (void);
+  virtual bool IsThreadSafe (void);
+  virtual double ComputePropagationDelayConcurrent (const Vector &srcPosition,
+                                                    const Vector &dstPosition,
+                                                    P1906MessageCarrier *message,
+                                                    P1906Field *field,
+                                                    uint64_t stream);
+
   void SetDiffusionCoefficient (double d);
   double GetDiffusionConefficient (void);
 
-private:
+protected:
   double m_diffusionCoefficient;
 };
 
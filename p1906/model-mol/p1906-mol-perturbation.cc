@@ -91,7 +91,7 @@ Ptr<P1906MessageCarrier>
 P1906MOLPerturbation::CreateMessageCarrier (Ptr<Packet> p)
 {
   NS_LOG_FUNCTION (this);
-  Ptr<P1906MOLMessageCarrier> carrier = CreateObject<P1906MOLMessageCarrier> ();
+  Ptr<P1906MOLMessageCarrier> carrier = AllocateMessageCarrier<P1906MOLMessageCarrier> ();
 
   double duration = m_pulseInterval.GetSeconds () * p->GetSize () * 8;
   double now = Simulator::Now ().GetSeconds ();
@@ -38,6 +38,10 @@
 #include "ns3/p1906-transmitter-communication-interface.h"
 #include "p1906-mol-perturbation.h"
 #include "ns3/mobility-model.h"
+#include "ns3/simulator.h"
+#include "ns3/double.h"
+#include "ns3/uinteger.h"
+#include "ns3/enum.h"
 
 
 namespace ns3 {
@@ -47,11 +51,42 @@ NS_LOG_COMPONENT_DEFINE ("P1906MOLSpecificity");
 TypeId P1906MOLSpecificity::GetTypeId (void)
 {
   static TypeId tid = TypeId ("ns3::P1906MOLSpecificity")
-    .SetParent<P1906Specificity> ();
+    .SetParent<P1906Specificity> ()
+    .AddAttribute ("Detection",
+                   "How a message is detected: the pulse rate respects Fick's bound, or the signal dominates the residue of the earlier releases",
+                   EnumValue (P1906MOLSpecificity::FickBound),
+                   MakeEnumAccessor (&P1906MOLSpecificity::SetDetection,
+                                     &P1906MOLSpecificity::GetDetection),
+                   MakeEnumChecker (P1906MOLSpecificity::FickBound, "FickBound",
+                                    P1906MOLSpecificity::InterSymbolInterference, "InterSymbolInterference"))
+    .AddAttribute ("InterferenceFloor",
+                   "Fraction of the signal of a reception below which a past release no longer interferes and is dropped (0 keeps them all)",
+                   DoubleValue (1e-6),
+                   MakeDoubleAccessor (&P1906MOLSpecificity::SetInterferenceFloor,
+                                       &P1906MOLSpecificity::GetInterferenceFloor),
+                   MakeDoubleChecker<double> (0.0))
+    .AddAttribute ("MaxReleases",
+                   "Largest number of past releases kept, the oldest received being dropped first (0 for no limit)",
+                   UintegerValue (4096),
+                   MakeUintegerAccessor (&P1906MOLSpecificity::SetMaxReleases,
+                                         &P1906MOLSpecificity::GetMaxReleases),
+                   MakeUintegerChecker<uint32_t> ())
+    .AddAttribute ("SirThreshold",
+                   "Smallest ratio of the signal to the inter-symbol interference for a detection",
+                   DoubleValue (1.0),
+                   MakeDoubleAccessor (&P1906MOLSpecificity::m_sirThreshold),
+                   MakeDoubleChecker<double> (0.0));
   return tid;
 }
 
 P1906MOLSpecificity::P1906MOLSpecificity ()
+  : m_diffusionCoefficient (0),
+    m_detection (FickBound),
+    m_interferenceFloor (1e-6),
+    m_maxReleases (4096),
+    m_sirThreshold (1.0),
+    m_lastSignal (0),
+    m_lastInterference (0)
 {
   NS_LOG_FUNCTION (this << "MOL Specificity Component");
 }
@@ -76,6 +111,17 @@ P1906MOLSpecificity::CheckRxCompatibility (Ptr<P1906CommunicationInterface> src,
   NS_LOG_FUNCTION (this);
   Ptr<P1906MOLMessageCarrier> m = message->GetObject <P1906MOLMessageCarrier>();
 
+  if (m_detection == InterSymbolInterference)
+    {
+      return CheckInterSymbolInterference (src, dst, m);
+    }
+  return CheckFickBound (src, dst, m);
+}
+
+bool
+P1906MOLSpecificity::CheckFickBound (Ptr<P1906CommunicationInterface> src, Ptr<P1906CommunicationInterface> dst, Ptr<P1906MOLMessageCarrier> m)
+{
+  NS_LOG_FUNCTION (this);
   double transmissionRate = 1. / m->GetPulseInterval ().GetSeconds ();
 
   Ptr<MobilityModel> srcMobility = src->GetP1906NetDevice ()->GetNode ()->GetObject<MobilityModel> ();
@@ -101,6 +147,61 @@ P1906MOLSpecificity::CheckRxCompatibility (Ptr<P1906CommunicationInterface> src,
 	}
 }
 
+bool
+P1906MOLSpecificity::CheckInterSymbolInterference (Ptr<P1906CommunicationInterface> src, Ptr<P1906CommunicationInterface> dst, Ptr<P1906MOLMessageCarrier> m)
+{
+  /*
+   * The released molecules spread as a Gaussian wave and the waves of
+   * successive releases superpose at the receiver: the message is detected
+   * when its own wave dominates what is left of the earlier ones.
+   */
+
+  NS_LOG_FUNCTION (this);
+
+  if (!(m_diffusionCoefficient > 0))
+    {
+      NS_LOG_FUNCTION (this << "no diffusion, the molecules never reach the receiver");
+      m_lastSignal = 0;
+      m_lastInterference = 0;
+      return false;
+    }
+
+  Vector source = src->GetP1906NetDevice ()->GetNode ()->GetObject<MobilityModel> ()->GetPosition ();
+  Vector destination = dst->GetP1906NetDevice ()->GetNode ()->GetObject<MobilityModel> ()->GetPosition ();
+  P1906MOL_MOTOR_Vec3 transmitter = vec3 (source.x, source.y, source.z);
+  P1906MOL_MOTOR_Vec3 receiver = vec3 (destination.x, destination.y, destination.z);
+  P1906MOL_MOTOR_Vec3 d = receiver - transmitter;
+  double start = m->GetStartTime ().GetSeconds ();
+  double now = Simulator::Now ().GetSeconds ();
+
+  double signal = P1906MOL_ExtendedDiffusionWaves::kernel (m->GetMolecules (), m_diffusionCoefficient, now - start, vec3Dot (d, d));
+
+  // the earlier releases of every transmitter, those faded below the floor being dropped first
+  m_releases.setCullThreshold (m_interferenceFloor * signal);
+  double interference = m_releases.concentration (receiver, now);
+  m_releases.add (start, m_diffusionCoefficient, m->GetMolecules (), transmitter);
+  if (m_maxReleases > 0)
+    {
+      m_releases.keepLast (m_maxReleases);
+    }
+
+  m_lastSignal = signal;
+  m_lastInterference = interference;
+
+  NS_LOG_FUNCTION (this << "[signal,interference,threshold,releases]" << signal << interference << m_sirThreshold << m_releases.size ());
+
+  if (signal > 0 && signal >= m_sirThreshold * interference)
+    {
+      NS_LOG_FUNCTION (this << "the signal dominates the inter-symbol interference");
+      return true;
+    }
+  else
+    {
+      NS_LOG_FUNCTION (this << "the inter-symbol interference hides the signal --> transmission failed");
+      return false;
+    }
+}
+
 void
 P1906MOLSpecificity::SetDiffusionCoefficient (double d)
 {
@@ -115,4 +216,72 @@ P1906MOLSpecificity::GetDiffusionConefficient (void)
   return m_diffusionCoefficient;
 }
 
+void
+P1906MOLSpecificity::SetDetection (Detection d)
+{
+  NS_LOG_FUNCTION (this << d);
+  m_detection = d;
+}
+
+P1906MOLSpecificity::Detection
+P1906MOLSpecificity::GetDetection (void) const
+{
+  return m_detection;
+}
+
+void
+P1906MOLSpecificity::SetInterferenceFloor (double f)
+{
+  NS_LOG_FUNCTION (this << f);
+  m_interferenceFloor = f;
+}
+
+double
+P1906MOLSpecificity::GetInterferenceFloor (void) const
+{
+  return m_interferenceFloor;
+}
+
+void
+P1906MOLSpecificity::SetMaxReleases (uint32_t n)
+{
+  NS_LOG_FUNCTION (this << n);
+  m_maxReleases = n;
+  if (m_maxReleases > 0)
+    {
+      m_releases.keepLast (m_maxReleases);
+    }
+}
+
+uint32_t
+P1906MOLSpecificity::GetMaxReleases (void) const
+{
+  return m_maxReleases;
+}
+
+double
+P1906MOLSpecificity::GetLastSignal (void) const
+{
+  return m_lastSignal;
+}
+
+double
+P1906MOLSpecificity::GetLastInterference (void) const
+{
+  return m_lastInterference;
+}
+
+uint32_t
+P1906MOLSpecificity::GetNReleases (void) const
+{
+  return m_releases.size ();
+}
+
+void
+P1906MOLSpecificity::ClearReleases (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_releases.clear ();
+}
+
 } // namespace ns3
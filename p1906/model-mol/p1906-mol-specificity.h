@@ -33,10 +33,14 @@
 #include "ns3/object.h"
 #include "ns3/nstime.h"
 #include "ns3/ptr.h"
+#include "ns3/vector.h"
 #include "ns3/p1906-specificity.h"
+#include "ns3/p1906-mol-diffusion-waves.h"
 
 namespace ns3 {
 
+class P1906MOLMessageCarrier;
+
 /**
  * \ingroup P1906 framework
  *
@@ -44,6 +48,26 @@ namespace ns3 {
  *
  * \brief Base class implementing the Specificity component of
  * the P1906 framework, dedicated to the MOLECULAR Example
+ *
+ * By default a message is detected when the pulse rate respects Fick's
+ * bound. With the InterSymbolInterference detection the receiver keeps the
+ * releases it has received, from every transmitter, and a message is
+ * detected when its own wave at the receiver at detection time is at least
+ * SirThreshold times the residue of all the earlier waves there. A release
+ * of N molecules at x0 and t0 spreads in free space as the Gaussian wave
+ *
+ * <pre>
+ *   c (x, t) = N / (4 pi D (t - t0))^(3/2) exp (-|x - x0|^2 / (4 D (t - t0)))
+ * </pre>
+ *
+ * with the positions of the MobilityModel [m], the times [s] and the
+ * diffusion coefficient D [m^2/s], giving c in molecules/m^3; the waves are
+ * summed by a P1906MOL_ExtendedDiffusionWaves. At each reception the
+ * releases whose wave can no longer exceed InterferenceFloor times the
+ * signal anywhere are dropped, the peak of a wave only decreasing with
+ * time, and at most MaxReleases releases are kept, the oldest received
+ * being dropped first, so the cost of a reception is bounded however long
+ * the pulse train.
  */
 
 class P1906MOLSpecificity : public P1906Specificity
@@ -54,13 +78,52 @@ public:
   P1906MOLSpecificity ();
   virtual ~P1906MOLSpecificity ();
 
+  //! FickBound - the pulse rate must respect Fick's bound
+  //! InterSymbolInterference - the signal must dominate the residue of the earlier releases
+  enum Detection { FickBound, InterSymbolInterference };
+
   virtual bool CheckRxCompatibility (Ptr<P1906CommunicationInterface> src, Ptr<P1906CommunicationInterface> dst, Ptr<P1906MessageCarrier> message);
 
   void SetDiffusionCoefficient (double d);
   double GetDiffusionConefficient (void);
 
+  void SetDetection (Detection d);
+  Detection GetDetection (void) const;
+  /**
+   * \param f fraction of the signal of a reception below which a past
+   * release no longer interferes; it is dropped once its peak falls below
+   * f times that signal (0 keeps them all)
+   */
+  void SetInterferenceFloor (double f);
+  double GetInterferenceFloor (void) const;
+  /**
+   * \param n the largest number of past releases kept (0 for no limit)
+   */
+  void SetMaxReleases (uint32_t n);
+  uint32_t GetMaxReleases (void) const;
+
+  //! the concentration of the last detected release at the receiver [molecules/m^3]
+  double GetLastSignal (void) const;
+  //! the residue of the earlier releases at the receiver at the last detection [molecules/m^3]
+  double GetLastInterference (void) const;
+  //! the number of past releases kept
+  uint32_t GetNReleases (void) const;
+  //! forget all the past releases
+  void ClearReleases (void);
+
 private:
+  bool CheckFickBound (Ptr<P1906CommunicationInterface> src, Ptr<P1906CommunicationInterface> dst, Ptr<P1906MOLMessageCarrier> m);
+  bool CheckInterSymbolInterference (Ptr<P1906CommunicationInterface> src, Ptr<P1906CommunicationInterface> dst, Ptr<P1906MOLMessageCarrier> m);
+
   double m_diffusionCoefficient;
+  Detection m_detection;
+  double m_interferenceFloor;
+  uint32_t m_maxReleases;
+  double m_sirThreshold;
+  double m_lastSignal;
+  double m_lastInterference;
+  //! the waves of the releases received so far, in reception order
+  P1906MOL_ExtendedDiffusionWaves m_releases;
 
 };
 
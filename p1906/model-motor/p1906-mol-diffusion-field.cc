@@ -0,0 +1,342 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *  Copyright � 2015 by IEEE.
+ *
+ *  This source file is an essential part of IEEE Std 1906.1,
+ *  Recommended Practice for Nanoscale and Molecular
+ *  Communication Framework.
+ *  Verbatim copies of this source file may be used and
+ *  distributed without restriction. Modifications to this source
+ *  file as permitted in IEEE Std 1906.1 may also be made and
+ *  distributed. All other uses require permission from the IEEE
+ *  Standards Department (stds-ipr@ieee.org). All other rights
+ *  reserved.
+ *
+ *  This source file is provided on an AS IS basis.
+ *  The IEEE disclaims ANY WARRANTY EXPRESS OR IMPLIED INCLUDING
+ *  ANY WARRANTY OF MERCHANTABILITY AND FITNESS FOR USE FOR A
+ *  PARTICULAR PURPOSE.
+ *  The user of the source file shall indemnify and hold
+ *  IEEE harmless from any damages or liability arising out of
+ *  the use thereof.
+ *
+ * Author: Stephen F Bush - GE Global Research
+ *                      bushsf@research.ge.com
+ *                      http://www.amazon.com/author/stephenbush
+ */
+
+
+/* \details The field of a compartment solved by finite volumes
+ *
+ * <pre>
+ *   release (cell s, q molecules, t0)  +  response (s -> r)  ->  c (r, t) = sum q response (t - t0)
+ * </pre>
+ */
+
+#include <algorithm>
+#include <cmath>
+
+#include "ns3/log.h"
+#include "ns3/double.h"
+#include "ns3/uinteger.h"
+#include "ns3/p1906-mol-diffusion-field.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("P1906MOL_DiffusionField");
+
+NS_OBJECT_ENSURE_REGISTERED (P1906MOL_DiffusionField);
+
+TypeId P1906MOL_DiffusionField::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::P1906MOL_DiffusionField")
+    .SetParent<P1906MOLField> ()
+    .AddConstructor<P1906MOL_DiffusionField> ()
+    .AddAttribute ("DiffusionCoefficient",
+                   "Diffusion coefficient of the molecules in the compartment [m^2/s]",
+                   DoubleValue (1.0),
+                   MakeDoubleAccessor (&P1906MOL_DiffusionField::setDiffusionCoefficient,
+                                       &P1906MOL_DiffusionField::getDiffusionCoefficient),
+                   MakeDoubleChecker<double> (0.0))
+    .AddAttribute ("Velocity",
+                   "Uniform drift velocity of the compartment [m/s]",
+                   VectorValue (Vector (0, 0, 0)),
+                   MakeVectorAccessor (&P1906MOL_DiffusionField::setVelocity,
+                                       &P1906MOL_DiffusionField::getVelocity),
+                   MakeVectorChecker ())
+    .AddAttribute ("Threads",
+                   "Number of threads sweeping the slabs of the grid (< 2 keeps the serial evaluation)",
+                   UintegerValue (0),
+                   MakeUintegerAccessor (&P1906MOL_DiffusionField::setThreads,
+                                         &P1906MOL_DiffusionField::getThreads),
+                   MakeUintegerChecker<uint32_t> ())
+    .AddAttribute ("Horizon",
+                   "Duration of the responses [s] (0 for the time to diffuse across the grid)",
+                   DoubleValue (0.0),
+                   MakeDoubleAccessor (&P1906MOL_DiffusionField::setHorizon,
+                                       &P1906MOL_DiffusionField::getHorizon),
+                   MakeDoubleChecker<double> (0.0));
+  return tid;
+}
+
+//! by default 32^3 cells of 0.1 mm covering [-1, 2.2] mm on each axis, around the nodes of the examples
+P1906MOL_DiffusionField::P1906MOL_DiffusionField ()
+  : m_origin (-1e-3, -1e-3, -1e-3),
+    m_cellSize (1e-4),
+    m_nx (32),
+    m_ny (32),
+    m_nz (32),
+    m_diffusionCoefficient (1),
+    m_velocity (0, 0, 0),
+    m_threads (0),
+    m_horizon (0),
+    m_dirty (true),
+    m_step (0),
+    m_steps (0)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+P1906MOL_DiffusionField::~P1906MOL_DiffusionField ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void P1906MOL_DiffusionField::setGrid (const Vector & origin, double cellSize, uint32_t nx, uint32_t ny, uint32_t nz)
+{
+  NS_LOG_FUNCTION (this << origin << cellSize << nx << ny << nz);
+  m_origin = origin;
+  m_cellSize = cellSize;
+  m_nx = nx;
+  m_ny = ny;
+  m_nz = nz;
+  m_dirty = true;
+  NotifyParametersChanged ();
+  //! the probes and the releases are recorded by cell
+  m_probes.clear ();
+  m_releases.clear ();
+}
+
+void P1906MOL_DiffusionField::addVolumeSurface(P1906MOL_MOTOR_Pos v_c, double v_radius, P1906MOL_MOTOR_VolSurface::typeOfVolume v_type)
+{
+  P1906MOL_MOTOR_VolSurface vs;
+  
+  vs.setVolume(v_c, v_radius);
+  vs.setType (v_type);
+  m_vsl.push_back (vs);
+  m_dirty = true;
+  NotifyParametersChanged ();
+}
+
+void P1906MOL_DiffusionField::clearVolumeSurfaces ()
+{
+  m_vsl.clear ();
+  m_dirty = true;
+  NotifyParametersChanged ();
+}
+
+void P1906MOL_DiffusionField::setDiffusionCoefficient (double D)
+{
+  if (D == m_diffusionCoefficient)
+    return;
+  NS_LOG_FUNCTION (this << D);
+  m_diffusionCoefficient = D;
+  m_dirty = true;
+  NotifyParametersChanged ();
+}
+
+double P1906MOL_DiffusionField::getDiffusionCoefficient ()
+{
+  return m_diffusionCoefficient;
+}
+
+void P1906MOL_DiffusionField::setVelocity (const Vector & u)
+{
+  m_velocity = u;
+  m_dirty = true;
+  NotifyParametersChanged ();
+}
+
+Vector P1906MOL_DiffusionField::getVelocity ()
+{
+  return m_velocity;
+}
+
+//! the responses do not depend on the number of threads
+void P1906MOL_DiffusionField::setThreads (uint32_t threads)
+{
+  m_threads = threads;
+  m_grid.setThreads (threads);
+}
+
+uint32_t P1906MOL_DiffusionField::getThreads ()
+{
+  return m_threads;
+}
+
+void P1906MOL_DiffusionField::setHorizon (double horizon)
+{
+  m_horizon = horizon;
+  m_dirty = true;
+  NotifyParametersChanged ();
+}
+
+double P1906MOL_DiffusionField::getHorizon ()
+{
+  return m_horizon;
+}
+
+//! the responses are dropped; the releases are kept, the cells being the same
+void P1906MOL_DiffusionField::update ()
+{
+  if (!m_dirty)
+    return;
+  NS_LOG_FUNCTION (this << "rebuilding the grid");
+  
+  P1906MOL_MOTOR_Vec3 u = vec3 (m_velocity.x, m_velocity.y, m_velocity.z);
+  double extent = m_cellSize * max (m_nx, max (m_ny, m_nz));
+  double horizon = m_horizon;
+  
+  m_grid.setGrid (vec3 (m_origin.x, m_origin.y, m_origin.z), m_cellSize, m_nx, m_ny, m_nz);
+  m_grid.setBarriers (m_vsl);
+  m_grid.setTransport (m_diffusionCoefficient, u);
+  m_grid.setThreads (m_threads);
+  
+  //! long enough to spread over the grid, or to be carried across it without diffusion
+  if (horizon == 0 && m_diffusionCoefficient > 0)
+    horizon = extent * extent / (2 * m_diffusionCoefficient);
+  else if (horizon == 0 && vec3Asum (u) > 0)
+    horizon = extent / vec3Asum (u);
+  
+  m_step = m_grid.stableStep ();
+  m_steps = 0;
+  if (m_step < horizon)
+    m_steps = (size_t) ceil (horizon / m_step);
+  else
+    m_step = horizon;
+  
+  m_responses.clear ();
+  m_dirty = false;
+  NS_LOG_FUNCTION (this << "[horizon,step,steps]" << horizon << m_step << m_steps);
+}
+
+bool P1906MOL_DiffusionField::cellOf (const Vector & pt, size_t & cell)
+{
+  update ();
+  return m_grid.cellOf (vec3 (pt.x, pt.y, pt.z), cell);
+}
+
+const vector<double> * P1906MOL_DiffusionField::getResponse (const Vector & src, const Vector & dst)
+{
+  size_t s, r;
+  
+  if (!cellOf (src, s) || !cellOf (dst, r))
+    return 0;
+  return &response (s, r);
+}
+
+double P1906MOL_DiffusionField::getResponseStep ()
+{
+  update ();
+  return m_step;
+}
+
+const vector<double> & P1906MOL_DiffusionField::response (size_t src, size_t dst)
+{
+  map<size_t, map<size_t, vector<double> > >::iterator it = m_responses.find (src);
+  
+  if (it == m_responses.end () || it->second.find (dst) == it->second.end ())
+  {
+    m_probes.insert (dst);
+    computeResponses (src);
+  }
+  return m_responses[src][dst];
+}
+
+//! one run of the grid records every probe, so a transmitter heard by several receivers is run once
+void P1906MOL_DiffusionField::computeResponses (size_t src)
+{
+  NS_LOG_FUNCTION (this << src << m_probes.size () << m_steps);
+  vector<size_t> probes (m_probes.begin (), m_probes.end ());
+  vector<vector<double> *> out;
+  
+  for (size_t p = 0; p < probes.size (); p++)
+  {
+    vector<double> & r = m_responses[src][probes[p]];
+    r.assign (m_steps + 1, 0);
+    out.push_back (&r);
+  }
+  
+  m_grid.clear ();
+  if (!m_grid.deposit (src, 1))
+    return;
+  for (size_t s = 0; s <= m_steps; s++)
+  {
+    if (s > 0)
+      m_grid.step (m_step);
+    for (size_t p = 0; p < probes.size (); p++)
+      (*out[p])[s] = m_grid.concentration (probes[p]);
+  }
+}
+
+double P1906MOL_DiffusionField::sample (const vector<double> & r, double t)
+{
+  if (!(t > 0))
+    return 0;
+  if (m_steps == 0 || t >= m_steps * m_step)
+    return r.back ();
+  
+  double x = t / m_step;
+  size_t s = (size_t) x;
+  double f = x - s;
+  
+  return (1 - f) * r[s] + f * r[s + 1];
+}
+
+bool P1906MOL_DiffusionField::release (const Vector & pt, double molecules, double time)
+{
+  size_t cell;
+  
+  if (!cellOf (pt, cell))
+  {
+    NS_LOG_FUNCTION (this << "release outside the grid" << pt);
+    return false;
+  }
+  
+  for (size_t k = m_releases.size (); k > 0 && m_releases[k - 1].time == time; k--)
+    if (m_releases[k - 1].cell == cell)
+    {
+      m_releases[k - 1].molecules += molecules;
+      NS_LOG_FUNCTION (this << "[cell,molecules,time]" << cell << m_releases[k - 1].molecules << time);
+      return true;
+    }
+  
+  Release r;
+  r.cell = cell;
+  r.molecules = molecules;
+  r.time = time;
+  m_releases.push_back (r);
+  NS_LOG_FUNCTION (this << "[cell,molecules,time]" << cell << molecules << time);
+  return true;
+}
+
+double P1906MOL_DiffusionField::getConcentration (const Vector & pt, double time)
+{
+  size_t cell;
+  double c = 0;
+  
+  if (!cellOf (pt, cell))
+    return 0;
+  for (size_t k = 0; k < m_releases.size (); k++)
+    if (m_releases[k].time < time)
+      c += m_releases[k].molecules * sample (response (m_releases[k].cell, cell), time - m_releases[k].time);
+  return c;
+}
+
+void P1906MOL_DiffusionField::clearReleases ()
+{
+  NS_LOG_FUNCTION (this);
+  m_releases.clear ();
+}
+
+} // namespace ns3
@@ -0,0 +1,159 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *  Copyright � 2015 by IEEE.
+ *
+ *  This source file is an essential part of IEEE Std 1906.1,
+ *  Recommended Practice for Nanoscale and Molecular
+ *  Communication Framework.
+ *  Verbatim copies of this source file may be used and
+ *  distributed without restriction. Modifications to this source
+ *  file as permitted in IEEE Std 1906.1 may also be made and
+ *  distributed. All other uses require permission from the IEEE
+ *  Standards Department (stds-ipr@ieee.org). All other rights
+ *  reserved.
+ *
+ *  This source file is provided on an AS IS basis.
+ *  The IEEE disclaims ANY WARRANTY EXPRESS OR IMPLIED INCLUDING
+ *  ANY WARRANTY OF MERCHANTABILITY AND FITNESS FOR USE FOR A
+ *  PARTICULAR PURPOSE.
+ *  The user of the source file shall indemnify and hold
+ *  IEEE harmless from any damages or liability arising out of
+ *  the use thereof.
+ *
+ * Author: Stephen F Bush - GE Global Research
+ *                      bushsf@research.ge.com
+ *                      http://www.amazon.com/author/stephenbush
+ */
+
+
+#ifndef P1906MOL_DIFFUSION_FIELD
+#define P1906MOL_DIFFUSION_FIELD
+
+#include <stdint.h>
+#include <map>
+#include <set>
+#include <vector>
+using namespace std;
+
+#include "ns3/object.h"
+#include "ns3/ptr.h"
+#include "ns3/vector.h"
+#include "ns3/p1906-mol-field.h"
+#include "ns3/p1906-mol-motor-pos.h"
+#include "ns3/p1906-mol-motor-vol-surface.h"
+#include "ns3/p1906-mol-diffusion-grid.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup IEEE P1906 framework
+ *
+ * \class P1906MOL_DiffusionField
+ *
+ * \brief Field of a bounded compartment in which the molecules diffuse and drift
+ *
+ * Unlike P1906MOL_ExtendedDiffusion, which superposes free space Gaussian
+ * waves, the compartment is solved on a P1906MOL_DiffusionGrid: its
+ * ReflectiveBarrier volume surfaces and the walls of the grid reflect the
+ * molecules, and a uniform drift (Velocity) carries them.
+ *
+ * The solution is linear and does not change with time, so the field keeps
+ * the response of a receiver cell to one molecule released in a transmitter
+ * cell, computed once over Horizon and every cell asked for so far recorded
+ * in the same run. Releases are recorded with their time and the
+ * concentration anywhere at any time is the superposition of the responses,
+ * interpolated between steps and held at their last value past the horizon,
+ * where a closed compartment has reached its equilibrium.
+ *
+ * Positions are in m, as given by the MobilityModel, the diffusion
+ * coefficient in m^2/s and the velocity in m/s. Paired with
+ * P1906MOL_DiffusionMotion, one field shared by all the nodes of a
+ * compartment is the medium their receivers sample.
+ */
+class P1906MOL_DiffusionField : public P1906MOLField
+{
+public:
+  static TypeId GetTypeId (void);
+  
+  P1906MOL_DiffusionField ();
+  virtual ~P1906MOL_DiffusionField ();
+  
+  /*
+   * Methods related to the compartment
+   */
+  //! nx x ny x nz cubic cells of edge cellSize from origin
+  void setGrid (const Vector & origin, double cellSize, uint32_t nx, uint32_t ny, uint32_t nz);
+  //! add a volume surface; only the ReflectiveBarrier ones bound the compartment, which is inside all of them
+  void addVolumeSurface(P1906MOL_MOTOR_Pos v_c, double v_radius, P1906MOL_MOTOR_VolSurface::typeOfVolume v_type);
+  //! remove all the volume surfaces
+  void clearVolumeSurfaces ();
+  //! the diffusion coefficient of the molecules in the compartment [m^2/s]
+  void setDiffusionCoefficient (double D);
+  double getDiffusionCoefficient ();
+  //! the drift velocity [m/s]
+  void setVelocity (const Vector & u);
+  Vector getVelocity ();
+  //! number of threads sweeping the grid (< 2 keeps the serial evaluation)
+  void setThreads (uint32_t threads);
+  uint32_t getThreads ();
+  //! duration of the responses [s]; 0 for the time to diffuse across the grid
+  void setHorizon (double horizon);
+  double getHorizon ();
+  
+  /*
+   * Methods related to the responses and the releases
+   */
+  //! the concentration at dst after one molecule released at src, one value every getResponseStep () from the release; NULL if src or dst is outside the grid
+  const vector<double> * getResponse (const Vector & src, const Vector & dst);
+  //! time between the values of a response [s]
+  double getResponseStep ();
+  //! record the release of molecules at pt at time; releases at the same time in the same cell add up
+  bool release (const Vector & pt, double molecules, double time);
+  //! the concentration at pt at time of all the releases before it
+  double getConcentration (const Vector & pt, double time);
+  //! forget all the releases
+  void clearReleases ();
+  
+private:
+  struct Release
+  {
+    size_t cell;
+    double molecules;
+    double time;
+  };
+  
+  //! rebuild the grid after a change of the compartment or of the transport
+  void update ();
+  //! the cell holding pt; false outside the grid
+  bool cellOf (const Vector & pt, size_t & cell);
+  //! the response of dst to src, computed on first use
+  const vector<double> & response (size_t src, size_t dst);
+  //! run a release in src and record the response of every probe cell
+  void computeResponses (size_t src);
+  //! value of response r at t [s] after the release
+  double sample (const vector<double> & r, double t);
+  
+  Vector m_origin;
+  double m_cellSize;
+  uint32_t m_nx, m_ny, m_nz;
+  vector<P1906MOL_MOTOR_VolSurface> m_vsl;
+  double m_diffusionCoefficient;
+  Vector m_velocity;
+  uint32_t m_threads;
+  double m_horizon;
+  
+  P1906MOL_DiffusionGrid m_grid;
+  //! the grid no longer matches the parameters
+  bool m_dirty;
+  double m_step;
+  size_t m_steps;
+  //! the cells whose response is recorded
+  set<size_t> m_probes;
+  //! m_responses[src][dst]
+  map<size_t, map<size_t, vector<double> > > m_responses;
+  vector<Release> m_releases;
+};
+
+}
+
+#endif /* P1906MOL_DIFFUSION_FIELD */
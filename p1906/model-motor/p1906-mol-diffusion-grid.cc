@@ -0,0 +1,302 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *  Copyright � 2015 by IEEE.
+ *
+ *  This source file is an essential part of IEEE Std 1906.1,
+ *  Recommended Practice for Nanoscale and Molecular
+ *  Communication Framework.
+ *  Verbatim copies of this source file may be used and
+ *  distributed without restriction. Modifications to this source
+ *  file as permitted in IEEE Std 1906.1 may also be made and
+ *  distributed. All other uses require permission from the IEEE
+ *  Standards Department (stds-ipr@ieee.org). All other rights
+ *  reserved.
+ *
+ *  This source file is provided on an AS IS basis.
+ *  The IEEE disclaims ANY WARRANTY EXPRESS OR IMPLIED INCLUDING
+ *  ANY WARRANTY OF MERCHANTABILITY AND FITNESS FOR USE FOR A
+ *  PARTICULAR PURPOSE.
+ *  The user of the source file shall indemnify and hold
+ *  IEEE harmless from any damages or liability arising out of
+ *  the use thereof.
+ *
+ * Author: Stephen F Bush - GE Global Research
+ *                      bushsf@research.ge.com
+ *                      http://www.amazon.com/author/stephenbush
+ */
+
+
+/* \details Explicit finite volume convection-diffusion in a compartment bounded by reflective barriers
+ *
+ * <pre>
+ *   c'(n) = c(n) + D dt / h^2 sum_faces open(m) (c(m) - c(n))
+ *                - dt / h sum_faces (outflow - inflow)
+ * </pre>
+ */
+
+#include <algorithm>
+#include <cmath>
+
+#include "ns3/p1906-mol-diffusion-grid.h"
+
+namespace ns3 {
+
+//! rows of a plane swept together, so that the three planes of a tile stay in cache
+static const size_t tileCells = 16384;
+//! planes per slab handed out to a thread
+static const size_t slabPlanes = 4;
+//! fraction of the positivity bound taken as step: at the bound itself a cell keeps nothing of its own content and odd and even cells decouple
+static const double stepRatio = 0.5;
+
+P1906MOL_DiffusionGrid::P1906MOL_DiffusionGrid ()
+  : m_h (1),
+    m_nx (0),
+    m_ny (0),
+    m_nz (0),
+    m_sy (0),
+    m_sz (0),
+    m_D (0),
+    m_rd (0),
+    m_ra (0),
+    m_nextSlab (0),
+    m_slabs (0)
+{
+  m_origin = vec3 (0, 0, 0);
+  m_u = vec3 (0, 0, 0);
+}
+
+P1906MOL_DiffusionGrid::~P1906MOL_DiffusionGrid ()
+{
+  m_pool.Stop ();
+}
+
+void P1906MOL_DiffusionGrid::setGrid (const P1906MOL_MOTOR_Vec3 & origin, double cellSize, size_t nx, size_t ny, size_t nz)
+{
+  m_origin = origin;
+  m_h = cellSize;
+  m_nx = nx;
+  m_ny = ny;
+  m_nz = nz;
+  m_sy = nx + 2;
+  //! planes start on 64 byte boundaries
+  m_sz = (m_sy * (ny + 2) + 7) & ~(size_t) 7;
+  
+  size_t stored = m_sz * (nz + 2);
+  m_c.assign (stored, 0);
+  m_next.assign (stored, 0);
+  m_open.assign (stored, 0);
+  for (size_t n = 0; n < size (); n++)
+    m_open[index (n)] = 1;
+}
+
+void P1906MOL_DiffusionGrid::setBarriers (vector<P1906MOL_MOTOR_VolSurface> & vsl)
+{
+  for (size_t n = 0; n < size (); n++)
+  {
+    P1906MOL_MOTOR_Vec3 pt = center (n);
+    double open = 1;
+    for (size_t b = 0; b < vsl.size (); b++)
+      if (vsl.at(b).getType () == P1906MOL_MOTOR_VolSurface::ReflectiveBarrier && !vsl.at(b).isInsideVolSurf (pt))
+        open = 0;
+    m_open[index (n)] = open;
+    m_c[index (n)] *= open;
+  }
+}
+
+void P1906MOL_DiffusionGrid::setTransport (double D, const P1906MOL_MOTOR_Vec3 & u)
+{
+  m_D = D;
+  m_u = u;
+}
+
+void P1906MOL_DiffusionGrid::setThreads (uint32_t threads)
+{
+  m_pool.SetThreads (threads);
+}
+
+uint32_t P1906MOL_DiffusionGrid::getThreads () const
+{
+  return m_pool.GetThreads ();
+}
+
+size_t P1906MOL_DiffusionGrid::getNx () const
+{
+  return m_nx;
+}
+
+size_t P1906MOL_DiffusionGrid::getNy () const
+{
+  return m_ny;
+}
+
+size_t P1906MOL_DiffusionGrid::getNz () const
+{
+  return m_nz;
+}
+
+double P1906MOL_DiffusionGrid::getCellSize () const
+{
+  return m_h;
+}
+
+size_t P1906MOL_DiffusionGrid::size () const
+{
+  return m_nx * m_ny * m_nz;
+}
+
+size_t P1906MOL_DiffusionGrid::index (size_t cell) const
+{
+  size_t i = cell % m_nx;
+  size_t j = (cell / m_nx) % m_ny;
+  size_t k = cell / (m_nx * m_ny);
+  
+  return (i + 1) + (j + 1) * m_sy + (k + 1) * m_sz;
+}
+
+bool P1906MOL_DiffusionGrid::cellOf (const P1906MOL_MOTOR_Vec3 & pt, size_t & cell) const
+{
+  double x = floor ((pt.x - m_origin.x) / m_h);
+  double y = floor ((pt.y - m_origin.y) / m_h);
+  double z = floor ((pt.z - m_origin.z) / m_h);
+  
+  //! also false for NaN coordinates
+  if (!(x >= 0 && x < m_nx && y >= 0 && y < m_ny && z >= 0 && z < m_nz))
+    return false;
+  cell = (size_t) x + m_nx * ((size_t) y + m_ny * (size_t) z);
+  return true;
+}
+
+P1906MOL_MOTOR_Vec3 P1906MOL_DiffusionGrid::center (size_t cell) const
+{
+  size_t i = cell % m_nx;
+  size_t j = (cell / m_nx) % m_ny;
+  size_t k = cell / (m_nx * m_ny);
+  
+  return m_origin + vec3 (i + 0.5, j + 0.5, k + 0.5) * m_h;
+}
+
+bool P1906MOL_DiffusionGrid::isOpen (size_t cell) const
+{
+  return m_open[index (cell)] != 0;
+}
+
+double P1906MOL_DiffusionGrid::stableStep () const
+{
+  double rate = 6 * m_D / (m_h * m_h) + vec3Asum (m_u) / m_h;
+  
+  return rate > 0 ? stepRatio / rate : GSL_POSINF;
+}
+
+void P1906MOL_DiffusionGrid::clear ()
+{
+  fill (m_c.begin (), m_c.end (), 0.0);
+}
+
+bool P1906MOL_DiffusionGrid::deposit (size_t cell, double amount)
+{
+  if (!isOpen (cell))
+    return false;
+  m_c[index (cell)] += amount / (m_h * m_h * m_h);
+  return true;
+}
+
+//! the slabs are shared by Threads threads; the calling thread takes part as one of the workers
+void P1906MOL_DiffusionGrid::step (double dt)
+{
+  m_rd = m_D * dt / (m_h * m_h);
+  m_ra = dt / m_h;
+  m_nextSlab = 0;
+  m_slabs = (m_nz + slabPlanes - 1) / slabPlanes;
+  
+  m_pool.Run (MakeCallback (&P1906MOL_DiffusionGrid::sweepSlabs, this));
+  
+  m_c.swap (m_next);
+}
+
+void P1906MOL_DiffusionGrid::advance (double duration)
+{
+  if (!(duration > 0))
+    return;
+  
+  double steps = ceil (duration / stableStep ());
+  double dt = duration / steps;
+  
+  for (double s = 0; s < steps; s++)
+    step (dt);
+}
+
+void P1906MOL_DiffusionGrid::sweepSlabs (void)
+{
+  while (true)
+  {
+    size_t s;
+    {
+      CriticalSection cs (m_mutex);
+      if (m_nextSlab >= m_slabs)
+        return;
+      s = m_nextSlab++;
+    }
+    sweep (s * slabPlanes, min ((s + 1) * slabPlanes, m_nz));
+  }
+}
+
+//! every row is updated by the same loop: the layer of closed cells around the grid stands in for the walls
+void P1906MOL_DiffusionGrid::sweep (size_t k0, size_t k1)
+{
+  const double rd = m_rd, ra = m_ra;
+  //! upwind fluxes: u c of the cell the flow leaves
+  const double pxu = max (m_u.x, 0.0) * ra, nxu = min (m_u.x, 0.0) * ra;
+  const double pyu = max (m_u.y, 0.0) * ra, nyu = min (m_u.y, 0.0) * ra;
+  const double pzu = max (m_u.z, 0.0) * ra, nzu = min (m_u.z, 0.0) * ra;
+  const size_t sy = m_sy, sz = m_sz, nx = m_nx;
+  const size_t tileRows = max ((size_t) 1, tileCells / sy);
+  const double * c = &m_c[0];
+  const double * o = &m_open[0];
+  double * next = &m_next[0];
+  
+  for (size_t j0 = 0; j0 < m_ny; j0 += tileRows)
+  {
+    size_t j1 = min (j0 + tileRows, m_ny);
+    for (size_t k = k0; k < k1; k++)
+      for (size_t j = j0; j < j1; j++)
+      {
+        size_t row = 1 + (j + 1) * sy + (k + 1) * sz;
+        for (size_t i = row; i < row + nx; i++)
+        {
+          double ci = c[i];
+          double diffusion = o[i - 1] * (c[i - 1] - ci) + o[i + 1] * (c[i + 1] - ci)
+                           + o[i - sy] * (c[i - sy] - ci) + o[i + sy] * (c[i + sy] - ci)
+                           + o[i - sz] * (c[i - sz] - ci) + o[i + sz] * (c[i + sz] - ci);
+          double outflow = o[i + 1] * (pxu * ci + nxu * c[i + 1]) - o[i - 1] * (pxu * c[i - 1] + nxu * ci)
+                         + o[i + sy] * (pyu * ci + nyu * c[i + sy]) - o[i - sy] * (pyu * c[i - sy] + nyu * ci)
+                         + o[i + sz] * (pzu * ci + nzu * c[i + sz]) - o[i - sz] * (pzu * c[i - sz] + nzu * ci);
+          next[i] = o[i] * (ci + rd * diffusion - outflow);
+        }
+      }
+  }
+}
+
+double P1906MOL_DiffusionGrid::concentration (size_t cell) const
+{
+  return m_c[index (cell)];
+}
+
+double P1906MOL_DiffusionGrid::concentration (const P1906MOL_MOTOR_Vec3 & pt) const
+{
+  size_t cell;
+  
+  if (!cellOf (pt, cell))
+    return 0;
+  return concentration (cell);
+}
+
+double P1906MOL_DiffusionGrid::total () const
+{
+  double sum = 0;
+  
+  for (size_t n = 0; n < size (); n++)
+    sum += m_c[index (n)];
+  return sum * m_h * m_h * m_h;
+}
+
+} // namespace ns3
@@ -0,0 +1,169 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *  Copyright � 2015 by IEEE.
+ *
+ *  This source file is an essential part of IEEE Std 1906.1,
+ *  Recommended Practice for Nanoscale and Molecular
+ *  Communication Framework.
+ *  Verbatim copies of this source file may be used and
+ *  distributed without restriction. Modifications to this source
+ *  file as permitted in IEEE Std 1906.1 may also be made and
+ *  distributed. All other uses require permission from the IEEE
+ *  Standards Department (stds-ipr@ieee.org). All other rights
+ *  reserved.
+ *
+ *  This source file is provided on an AS IS basis.
+ *  The IEEE disclaims ANY WARRANTY EXPRESS OR IMPLIED INCLUDING
+ *  ANY WARRANTY OF MERCHANTABILITY AND FITNESS FOR USE FOR A
+ *  PARTICULAR PURPOSE.
+ *  The user of the source file shall indemnify and hold
+ *  IEEE harmless from any damages or liability arising out of
+ *  the use thereof.
+ *
+ * Author: Stephen F Bush - GE Global Research
+ *                      bushsf@research.ge.com
+ *                      http://www.amazon.com/author/stephenbush
+ */
+
+
+#ifndef P1906MOL_DIFFUSION_GRID
+#define P1906MOL_DIFFUSION_GRID
+
+#include <stdint.h>
+#include <cstddef>
+#include <vector>
+using namespace std;
+
+#include "ns3/ptr.h"
+#include "ns3/system-mutex.h"
+#include "ns3/p1906-worker-pool.h"
+#include "ns3/p1906-mol-motor-vec3.h"
+#include "ns3/p1906-mol-motor-segment-arrays.h"
+#include "ns3/p1906-mol-motor-vol-surface.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup IEEE P1906 framework
+ *
+ * \class P1906MOL_DiffusionGrid
+ *
+ * \brief Finite volume solution of the convection-diffusion equation in a bounded compartment
+ *
+ * <pre>
+ *   dc/dt = D laplacian (c) - div (u c)
+ * </pre>
+ *
+ * is integrated with explicit Euler steps on nx x ny x nz cubic cells of edge
+ * h, cell (i, j, k) covering origin + h [i, i + 1] x [j, j + 1] x [k, k + 1].
+ * The flux through each face is D (c' - c) / h by diffusion and u c by first
+ * order upwind convection, so the total amount is conserved and stays non
+ * negative for steps up to
+ *
+ * <pre>
+ *   dt = 1 / (6 D / h^2 + (|ux| + |uy| + |uz|) / h)
+ * </pre>
+ *
+ * A cell is open when its center lies inside every ReflectiveBarrier volume
+ * surface; the faces between an open and a closed cell, like the faces of the
+ * grid, carry no flux, so the barriers reflect all the molecules. The other
+ * kinds of volume surface do not bound the compartment.
+ *
+ * The cells are stored plane after plane with a layer of closed cells around
+ * the grid and every plane 64 byte aligned, so that one loop without bounds
+ * checks updates any row. A step sweeps tiles of rows of planes, the three
+ * planes of a tile staying in cache, and with Threads threads the slabs of
+ * planes are shared out between them, the calling thread taking part as one
+ * of the workers. The other threads are started by the first step and wait
+ * for the next one until the grid is destroyed or Threads changes, so advance ()
+ * and the steps of a run create none. The result does not depend on the
+ * number of threads.
+ */
+class P1906MOL_DiffusionGrid
+{
+public:
+  P1906MOL_DiffusionGrid ();
+  //! stop the threads
+  ~P1906MOL_DiffusionGrid ();
+  
+  //! nx x ny x nz cells of edge cellSize from origin, all open and empty
+  void setGrid (const P1906MOL_MOTOR_Vec3 & origin, double cellSize, size_t nx, size_t ny, size_t nz);
+  //! close the cells outside the ReflectiveBarrier surfaces of vsl; their content is lost
+  void setBarriers (vector<P1906MOL_MOTOR_VolSurface> & vsl);
+  //! diffusion coefficient D and drift velocity u, in the units of the grid
+  void setTransport (double D, const P1906MOL_MOTOR_Vec3 & u);
+  //! number of threads sweeping the slabs (< 2 keeps them on the calling thread); the running ones are stopped
+  void setThreads (uint32_t threads);
+  uint32_t getThreads () const;
+  
+  size_t getNx () const;
+  size_t getNy () const;
+  size_t getNz () const;
+  double getCellSize () const;
+  //! number of cells, the layer around the grid excluded
+  size_t size () const;
+  //! the cell holding pt; false if pt is outside the grid
+  bool cellOf (const P1906MOL_MOTOR_Vec3 & pt, size_t & cell) const;
+  //! the center of a cell
+  P1906MOL_MOTOR_Vec3 center (size_t cell) const;
+  //! true if the cell is inside the compartment
+  bool isOpen (size_t cell) const;
+  
+  //! the step taken by advance (): half the bound above, which keeps part of its content in every cell
+  double stableStep () const;
+  //! empty all the cells
+  void clear ();
+  //! add amount to the cell, spread over its volume; false (and nothing added) if the cell is closed
+  bool deposit (size_t cell, double amount);
+  //! one step of dt, no longer than twice stableStep ()
+  void step (double dt);
+  //! steps of at most stableStep () covering duration exactly
+  void advance (double duration);
+  
+  //! the mean concentration of a cell
+  double concentration (size_t cell) const;
+  //! the concentration of the cell holding pt; 0 outside the grid
+  double concentration (const P1906MOL_MOTOR_Vec3 & pt) const;
+  //! the amount in the whole compartment
+  double total () const;
+  
+private:
+  typedef vector<double, P1906MOL_MOTOR_AlignedAllocator<double> > Cells;
+  
+  //! the stored index of cell (i, j, k) counted without the layer
+  size_t index (size_t cell) const;
+  //! take slabs until none is left; run by every thread of a step, no logging here
+  void sweepSlabs (void);
+  //! update planes [k0, k1) of m_next from m_c
+  void sweep (size_t k0, size_t k1);
+  
+  P1906MOL_MOTOR_Vec3 m_origin;
+  double m_h;
+  size_t m_nx, m_ny, m_nz;
+  //! strides of the stored rows and planes
+  size_t m_sy, m_sz;
+  double m_D;
+  P1906MOL_MOTOR_Vec3 m_u;
+  
+  //! concentrations now and after the step
+  Cells m_c, m_next;
+  //! 1 for an open cell, 0 for a closed one
+  Cells m_open;
+  
+  //! the step being swept
+  double m_rd, m_ra;
+  size_t m_nextSlab;
+  size_t m_slabs;
+  SystemMutex m_mutex;
+  
+  //! the threads besides the calling one, kept between the steps
+  P1906WorkerPool m_pool;
+  
+  //! the threads hold this
+  P1906MOL_DiffusionGrid (const P1906MOL_DiffusionGrid &);
+  P1906MOL_DiffusionGrid & operator= (const P1906MOL_DiffusionGrid &);
+};
+
+}
+
+#endif /* P1906MOL_DIFFUSION_GRID */
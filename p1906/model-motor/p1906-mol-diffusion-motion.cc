@@ -0,0 +1,164 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *  Copyright � 2015 by IEEE.
+ *
+ *  This source file is an essential part of IEEE Std 1906.1,
+ *  Recommended Practice for Nanoscale and Molecular
+ *  Communication Framework.
+ *  Verbatim copies of this source file may be used and
+ *  distributed without restriction. Modifications to this source
+ *  file as permitted in IEEE Std 1906.1 may also be made and
+ *  distributed. All other uses require permission from the IEEE
+ *  Standards Department (stds-ipr@ieee.org). All other rights
+ *  reserved.
+ *
+ *  This source file is provided on an AS IS basis.
+ *  The IEEE disclaims ANY WARRANTY EXPRESS OR IMPLIED INCLUDING
+ *  ANY WARRANTY OF MERCHANTABILITY AND FITNESS FOR USE FOR A
+ *  PARTICULAR PURPOSE.
+ *  The user of the source file shall indemnify and hold
+ *  IEEE harmless from any damages or liability arising out of
+ *  the use thereof.
+ *
+ * Author: Stephen F Bush - GE Global Research
+ *                      bushsf@research.ge.com
+ *                      http://www.amazon.com/author/stephenbush
+ */
+
+
+/* \details The Motion component of a compartment solved by finite volumes
+ *
+ * <pre>
+ *   transmission -> release in the P1906MOL_DiffusionField -> response of the receiver cell -> delay
+ * </pre>
+ */
+
+#include "ns3/log.h"
+#include "ns3/double.h"
+#include "ns3/simulator.h"
+#include "ns3/mobility-model.h"
+#include "ns3/p1906-net-device.h"
+#include "ns3/p1906-communication-interface.h"
+#include "ns3/p1906-mol-message-carrier.h"
+#include "ns3/p1906-mol-diffusion-field.h"
+#include "ns3/p1906-mol-diffusion-motion.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("P1906MOL_DiffusionMotion");
+
+NS_OBJECT_ENSURE_REGISTERED (P1906MOL_DiffusionMotion);
+
+TypeId P1906MOL_DiffusionMotion::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::P1906MOL_DiffusionMotion")
+    .SetParent<P1906MOLMotion> ()
+    .AddConstructor<P1906MOL_DiffusionMotion> ()
+    .AddAttribute ("DetectionThreshold",
+                   "Concentration [molecules/m^3] detected by the receiver (0 for the peak of the response)",
+                   DoubleValue (0.0),
+                   MakeDoubleAccessor (&P1906MOL_DiffusionMotion::setDetectionThreshold,
+                                       &P1906MOL_DiffusionMotion::getDetectionThreshold),
+                   MakeDoubleChecker<double> (0.0));
+  return tid;
+}
+
+P1906MOL_DiffusionMotion::P1906MOL_DiffusionMotion ()
+  : m_detectionThreshold (0),
+    m_releasedSrc (0),
+    m_releasedMessage (0),
+    m_releasedTime (0)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+P1906MOL_DiffusionMotion::~P1906MOL_DiffusionMotion ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+double P1906MOL_DiffusionMotion::ComputePropagationDelay (Ptr<P1906CommunicationInterface> src,
+  		                                  Ptr<P1906CommunicationInterface> dst,
+  		                                  Ptr<P1906MessageCarrier> message,
+  		                                  Ptr<P1906Field> field)
+{
+  Ptr<P1906MOL_DiffusionField> compartment;
+  
+  if (field)
+    compartment = field->GetObject<P1906MOL_DiffusionField> ();
+  if (!compartment)
+  {
+    NS_LOG_FUNCTION (this << "no compartment: Fick's law");
+    return P1906MOLMotion::ComputePropagationDelay (src, dst, message, field);
+  }
+  
+  Vector sv = src->GetP1906NetDevice ()->GetNode ()->GetObject<MobilityModel> ()->GetPosition ();
+  Vector dv = dst->GetP1906NetDevice ()->GetNode ()->GetObject<MobilityModel> ()->GetPosition ();
+  Ptr<P1906MOLMessageCarrier> m = message->GetObject<P1906MOLMessageCarrier> ();
+  double molecules = m ? m->GetMolecules () : 1;
+  
+  const vector<double> * response = compartment->getResponse (sv, dv);
+  if (!response)
+  {
+    NS_LOG_FUNCTION (this << "outside the compartment grid: Fick's law");
+    return P1906MOLMotion::ComputePropagationDelay (src, dst, message, field);
+  }
+  //! the medium asks once per receiver: the molecules are released once per transmission
+  double now = Simulator::Now ().GetSeconds ();
+  if (PeekPointer (src) != m_releasedSrc || PeekPointer (message) != m_releasedMessage || now != m_releasedTime)
+  {
+    compartment->release (sv, molecules, now);
+    m_releasedSrc = PeekPointer (src);
+    m_releasedMessage = PeekPointer (message);
+    m_releasedTime = now;
+  }
+  
+  //! the first step reaching the threshold, or the first peak
+  size_t s = 0;
+  size_t peak = 0;
+  for (; s < response->size (); s++)
+  {
+    if (m_detectionThreshold > 0 && molecules * (*response)[s] >= m_detectionThreshold)
+      break;
+    if ((*response)[s] > (*response)[peak])
+      peak = s;
+  }
+  
+  double step = compartment->getResponseStep ();
+  double horizon = (response->size () - 1) * step;
+  double delay = (m_detectionThreshold > 0 ? s : peak) * step;
+  
+  if (m_detectionThreshold > 0 ? s == response->size () : (*response)[peak] == 0)
+  {
+    NS_LOG_FUNCTION (this << "the receiver is not reached within the horizon" << horizon);
+    delay = horizon;
+  }
+  
+  NS_LOG_FUNCTION (this << "[molecules,step,delay]" << molecules << step << delay);
+  return delay;
+}
+
+bool P1906MOL_DiffusionMotion::IsCacheable (void)
+{
+  NS_LOG_FUNCTION (this);
+  return false;
+}
+
+bool P1906MOL_DiffusionMotion::IsThreadSafe (void)
+{
+  NS_LOG_FUNCTION (this);
+  return false;
+}
+
+void P1906MOL_DiffusionMotion::setDetectionThreshold (double c)
+{
+  m_detectionThreshold = c;
+  NotifyParametersChanged ();
+}
+
+double P1906MOL_DiffusionMotion::getDetectionThreshold ()
+{
+  return m_detectionThreshold;
+}
+
+} // namespace ns3
@@ -0,0 +1,88 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *  Copyright � 2015 by IEEE.
+ *
+ *  This source file is an essential part of IEEE Std 1906.1,
+ *  Recommended Practice for Nanoscale and Molecular
+ *  Communication Framework.
+ *  Verbatim copies of this source file may be used and
+ *  distributed without restriction. Modifications to this source
+ *  file as permitted in IEEE Std 1906.1 may also be made and
+ *  distributed. All other uses require permission from the IEEE
+ *  Standards Department (stds-ipr@ieee.org). All other rights
+ *  reserved.
+ *
+ *  This source file is provided on an AS IS basis.
+ *  The IEEE disclaims ANY WARRANTY EXPRESS OR IMPLIED INCLUDING
+ *  ANY WARRANTY OF MERCHANTABILITY AND FITNESS FOR USE FOR A
+ *  PARTICULAR PURPOSE.
+ *  The user of the source file shall indemnify and hold
+ *  IEEE harmless from any damages or liability arising out of
+ *  the use thereof.
+ *
+ * Author: Stephen F Bush - GE Global Research
+ *                      bushsf@research.ge.com
+ *                      http://www.amazon.com/author/stephenbush
+ */
+
+
+#ifndef P1906MOL_DIFFUSION_MOTION
+#define P1906MOL_DIFFUSION_MOTION
+
+#include "ns3/object.h"
+#include "ns3/ptr.h"
+#include "ns3/p1906-mol-motion.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup IEEE P1906 framework
+ *
+ * \class P1906MOL_DiffusionMotion
+ *
+ * \brief Motion of molecules diffusing and drifting in a bounded compartment
+ *
+ * The alternative to the Fick's law delay of P1906MOLMotion for a field that
+ * is a P1906MOL_DiffusionField. Each transmission is recorded once as a
+ * release of the molecules of the carrier at the transmitter in the field,
+ * whose own DiffusionCoefficient governs the compartment, and the delay is
+ * the time at which the response of the receiver cell peaks, the time of
+ * Fick's law in free space; with a DetectionThreshold, it is the time at which the
+ * concentration of the release first reaches it. A receiver the molecules do
+ * not reach within the horizon of the field gets the horizon as delay.
+ *
+ * Any other field, and a transmitter or receiver outside the grid, fall back
+ * to P1906MOLMotion.
+ */
+class P1906MOL_DiffusionMotion : public P1906MOLMotion
+{
+public:
+  static TypeId GetTypeId (void);
+  
+  P1906MOL_DiffusionMotion ();
+  virtual ~P1906MOL_DiffusionMotion ();
+  
+  virtual double ComputePropagationDelay (Ptr<P1906CommunicationInterface> src,
+  		                                  Ptr<P1906CommunicationInterface> dst,
+  		                                  Ptr<P1906MessageCarrier> message,
+  		                                  Ptr<P1906Field> field);
+  //! each transmission is a release recorded in the field
+  virtual bool IsCacheable (void);
+  //! the grid of the field is shared by all the receivers
+  virtual bool IsThreadSafe (void);
+  
+  //! concentration [molecules/m^3] detected by the receiver; 0 for the peak of the response
+  void setDetectionThreshold (double c);
+  double getDetectionThreshold ();
+  
+private:
+  double m_detectionThreshold;
+  //! the last transmission released in a field, heard by every receiver in turn
+  P1906CommunicationInterface * m_releasedSrc;
+  P1906MessageCarrier * m_releasedMessage;
+  double m_releasedTime;
+};
+
+}
+
+#endif /* P1906MOL_DIFFUSION_MOTION */
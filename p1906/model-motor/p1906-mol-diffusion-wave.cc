@@ -77,16 +77,13 @@ P1906MOL_ExtendedDiffusionWave::P1906MOL_ExtendedDiffusionWave ()
 //! configure a transmission
 void P1906MOL_ExtendedDiffusionWave::prepare_transmission(double tt, double Cd, double ic, P1906MOL_MOTOR_Pos ip)
 {
-  gsl_vector * p = gsl_vector_alloc(3);
-  
   //! time the concentration was released [s]
   transmission_time = tt;
   D = Cd;
   //! initial concentration [nmol/nm^3]
   c_0 = ic;
-  ip.getPos (p);
   //! location of the initial release [nm] (x,y,z)
-  transmitter.setPos (p);
+  transmitter.setPos (ip.getVec3 ());
 }
 
 //! trigger a release using last configures values
@@ -121,33 +118,17 @@ void P1906MOL_ExtendedDiffusionWave::transmit(double tt)
 //
 //*********************************************************************
 // sample the concentration at location receiver and time
+//! c(r, t) = c_0 (4 pi D t)^(-3/2) exp (-r^2 / (4 D t)), t being the time since transmission_time; nothing before it
 double P1906MOL_ExtendedDiffusionWave::concentration_wave (P1906MOL_MOTOR_Pos receiver, double time)
 {
-  //! receiver 3D position [nm] (x,y,z)
-  float D = 1.0; //! diffusion coefficient [nm^2/s]
-  double r; //! radius from source [nm]
-  gsl_vector *xpos = gsl_vector_alloc(3);
-  gsl_vector *rpos = gsl_vector_alloc(3);
-  double t; //! [s]
-  double c; //! [nmol / nm^3]
-
-  transmitter.setPos (0, 0, 0);
-  transmitter.getPos (xpos);
-  receiver.setPos (10, 0, 0);
-  receiver.getPos (rpos);
+  double t = time - transmission_time; //! [s]
+  P1906MOL_MOTOR_Vec3 d = receiver.getVec3 () - transmitter.getVec3 ();
+  double r2 = vec3Dot (d, d); //! squared radius from source [nm^2]
 
-  gsl_vector_sub (rpos, xpos);
-  r = gsl_blas_dnrm2(rpos);
-  
-  //! if multiple transmissions, then take the super-position of all transmissions
-  for (t = 1.0; t < 100.0; t = t + 1.0)
-  {
-    //! proportion of initial concentration
-	c = c_0 * pow((4.0 * M_PI * D * t), -3.0/2.0) * gsl_sf_exp (-pow(r, 2.0)/(4.0 * D * t));
-	printf ("(concentration_wave) c(t): %lf(%lf)\n", c, t);
-  }
-  
-  return 0;
+  if (!(t > 0))
+    return 0;
+  //! proportion of initial concentration [nmol / nm^3]; exp rather than gsl_sf_exp, whose underflow far from the source is an error
+  return c_0 * pow((4.0 * M_PI * D * t), -3.0/2.0) * exp (-r2/(4.0 * D * t));
 }
 
 P1906MOL_ExtendedDiffusionWave::~P1906MOL_ExtendedDiffusionWave ()
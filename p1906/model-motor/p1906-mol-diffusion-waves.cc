@@ -0,0 +1,416 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *  Copyright � 2015 by IEEE.
+ *
+ *  This source file is an essential part of IEEE Std 1906.1,
+ *  Recommended Practice for Nanoscale and Molecular
+ *  Communication Framework.
+ *  Verbatim copies of this source file may be used and
+ *  distributed without restriction. Modifications to this source
+ *  file as permitted in IEEE Std 1906.1 may also be made and
+ *  distributed. All other uses require permission from the IEEE
+ *  Standards Department (stds-ipr@ieee.org). All other rights
+ *  reserved.
+ *
+ *  This source file is provided on an AS IS basis.
+ *  The IEEE disclaims ANY WARRANTY EXPRESS OR IMPLIED INCLUDING
+ *  ANY WARRANTY OF MERCHANTABILITY AND FITNESS FOR USE FOR A
+ *  PARTICULAR PURPOSE.
+ *  The user of the source file shall indemnify and hold
+ *  IEEE harmless from any damages or liability arising out of
+ *  the use thereof.
+ *
+ * Author: Stephen F Bush - GE Global Research
+ *                      bushsf@research.ge.com
+ *                      http://www.amazon.com/author/stephenbush
+ */
+
+
+/* \details The batched diffusion wave superposition kernel
+ *
+ * <pre>
+ *   dt  = t - t0                      (no contribution unless dt > 0)
+ *   s   = 4 D dt
+ *   c   = c0 pi^(-3/2) s^(-3/2) exp (-r^2 / s)
+ *   exp (x) = 2^n exp (g),  n = round (x / ln 2),  g = x - n ln 2   (Cephes rational approximation of exp (g))
+ * </pre>
+ */
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <stdint.h>
+
+//! the vector kernels are compiled for their instruction sets whatever the flags of the build, and picked at run time
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define P1906_DIFFUSION_WAVES_DISPATCH
+#include <immintrin.h>
+//! the kernels must not be contracted into fused multiply-adds (AVX-512F has them), so that they match waveExp and kernel
+#if defined(__clang__)
+#define P1906_DIFFUSION_WAVES_TARGET(isa) __attribute__ ((target (isa)))
+#else
+#define P1906_DIFFUSION_WAVES_TARGET(isa) __attribute__ ((target (isa), optimize ("fp-contract=off")))
+#endif
+#endif
+
+#include "ns3/p1906-mol-diffusion-waves.h"
+
+namespace ns3 {
+
+//! pi^(-3/2)
+static const double g_invPi15 = 0.17958712212516656;
+//! below this exp (x) is subnormal and taken as 0; above the upper bound it is clamped
+static const double g_expMin = -708.39641853226408;
+static const double g_expMax = 709.0;
+static const double g_log2e = 1.4426950408889634;
+//! ln 2 split in two, so that n ln 2 is subtracted exactly
+static const double g_ln2Hi = 0.693145751953125;
+static const double g_ln2Lo = 1.42860682030941723212e-6;
+static const double g_expP0 = 1.26177193074810590878e-4;
+static const double g_expP1 = 3.02994407707441961300e-2;
+static const double g_expP2 = 9.99999999999999999910e-1;
+static const double g_expQ0 = 3.00198505138664455042e-6;
+static const double g_expQ1 = 2.52448340349684104192e-3;
+static const double g_expQ2 = 2.27265548208155028766e-1;
+static const double g_expQ3 = 2.00000000000000000009e0;
+
+//! the exponential computed as the vector kernels do, operation for operation
+static inline double
+waveExp (double x)
+{
+  if (x < g_expMin)
+    return 0;
+  x = x > g_expMax ? g_expMax : x;
+  double n = std::nearbyint (x * g_log2e);
+  double g = x - n * g_ln2Hi;
+  g = g - n * g_ln2Lo;
+  double gg = g * g;
+  double p = g * ((g_expP0 * gg + g_expP1) * gg + g_expP2);
+  double q = ((g_expQ0 * gg + g_expQ1) * gg + g_expQ2) * gg + g_expQ3;
+  double e = p / (q - p);
+  e = 1.0 + (e + e);
+  uint64_t bits = (uint64_t) ((int64_t) n + 1023) << 52;
+  double scale;
+  memcpy (&scale, &bits, sizeof (scale));
+  return e * scale;
+}
+
+#ifdef P1906_DIFFUSION_WAVES_DISPATCH
+//! some GCC versions warn about the deliberately undefined pass-through operand inside the AVX-512 min, max and round
+#if !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+P1906_DIFFUSION_WAVES_TARGET ("avx512f") static inline __m512d
+waveExp8 (__m512d x)
+{
+  const __mmask8 inRange = _mm512_cmp_pd_mask (x, _mm512_set1_pd (g_expMin), _CMP_GE_OQ);
+  x = _mm512_min_pd (x, _mm512_set1_pd (g_expMax));
+  __m512d n = _mm512_roundscale_pd (_mm512_mul_pd (x, _mm512_set1_pd (g_log2e)), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+  __m512d g = _mm512_sub_pd (x, _mm512_mul_pd (n, _mm512_set1_pd (g_ln2Hi)));
+  g = _mm512_sub_pd (g, _mm512_mul_pd (n, _mm512_set1_pd (g_ln2Lo)));
+  __m512d gg = _mm512_mul_pd (g, g);
+  __m512d p = _mm512_mul_pd (g, _mm512_add_pd (_mm512_mul_pd (_mm512_add_pd (_mm512_mul_pd (_mm512_set1_pd (g_expP0), gg), _mm512_set1_pd (g_expP1)), gg), _mm512_set1_pd (g_expP2)));
+  __m512d q = _mm512_add_pd (_mm512_mul_pd (_mm512_add_pd (_mm512_mul_pd (_mm512_add_pd (_mm512_mul_pd (_mm512_set1_pd (g_expQ0), gg), _mm512_set1_pd (g_expQ1)), gg), _mm512_set1_pd (g_expQ2)), gg), _mm512_set1_pd (g_expQ3));
+  __m512d e = _mm512_div_pd (p, _mm512_sub_pd (q, p));
+  e = _mm512_add_pd (_mm512_set1_pd (1.0), _mm512_add_pd (e, e));
+  //! 2^n: n sits in the low mantissa bits of n + 1.5 * 2^52
+  __m512i bits = _mm512_castpd_si512 (_mm512_add_pd (n, _mm512_set1_pd (6755399441055744.0)));
+  bits = _mm512_slli_epi64 (_mm512_add_epi64 (bits, _mm512_set1_epi64 (1023)), 52);
+  return _mm512_maskz_mov_pd (inRange, _mm512_mul_pd (e, _mm512_castsi512_pd (bits)));
+}
+
+P1906_DIFFUSION_WAVES_TARGET ("avx2") static inline __m256d
+waveExp4 (__m256d x)
+{
+  const __m256d inRange = _mm256_cmp_pd (x, _mm256_set1_pd (g_expMin), _CMP_GE_OQ);
+  x = _mm256_min_pd (x, _mm256_set1_pd (g_expMax));
+  __m256d n = _mm256_round_pd (_mm256_mul_pd (x, _mm256_set1_pd (g_log2e)), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+  __m256d g = _mm256_sub_pd (x, _mm256_mul_pd (n, _mm256_set1_pd (g_ln2Hi)));
+  g = _mm256_sub_pd (g, _mm256_mul_pd (n, _mm256_set1_pd (g_ln2Lo)));
+  __m256d gg = _mm256_mul_pd (g, g);
+  __m256d p = _mm256_mul_pd (g, _mm256_add_pd (_mm256_mul_pd (_mm256_add_pd (_mm256_mul_pd (_mm256_set1_pd (g_expP0), gg), _mm256_set1_pd (g_expP1)), gg), _mm256_set1_pd (g_expP2)));
+  __m256d q = _mm256_add_pd (_mm256_mul_pd (_mm256_add_pd (_mm256_mul_pd (_mm256_add_pd (_mm256_mul_pd (_mm256_set1_pd (g_expQ0), gg), _mm256_set1_pd (g_expQ1)), gg), _mm256_set1_pd (g_expQ2)), gg), _mm256_set1_pd (g_expQ3));
+  __m256d e = _mm256_div_pd (p, _mm256_sub_pd (q, p));
+  e = _mm256_add_pd (_mm256_set1_pd (1.0), _mm256_add_pd (e, e));
+  //! 2^n: n sits in the low mantissa bits of n + 1.5 * 2^52
+  __m256i bits = _mm256_castpd_si256 (_mm256_add_pd (n, _mm256_set1_pd (6755399441055744.0)));
+  bits = _mm256_slli_epi64 (_mm256_add_epi64 (bits, _mm256_set1_epi64x (1023)), 52);
+  return _mm256_and_pd (inRange, _mm256_mul_pd (e, _mm256_castsi256_pd (bits)));
+}
+
+//! the partial sums of all the waves, 8 at a time; the arrays are padded to a multiple of 8 entries
+P1906_DIFFUSION_WAVES_TARGET ("avx512f") static void
+sumAvx512 (const P1906MOL_MOTOR_Vec3 & receiver, double t, const double * t0, const double * D, const double * c0,
+          const double * x, const double * y, const double * z, size_t end, double * acc)
+{
+  size_t i = 0;
+  const __m512d rx = _mm512_set1_pd (receiver.x), ry = _mm512_set1_pd (receiver.y), rz = _mm512_set1_pd (receiver.z);
+  const __m512d tq = _mm512_set1_pd (t), zero = _mm512_setzero_pd (), one = _mm512_set1_pd (1.0);
+  __m512d a = zero;
+  for (; i < end; i += 8)
+    {
+      __m512d dt = _mm512_sub_pd (tq, _mm512_load_pd (t0 + i));
+      __mmask8 released = _mm512_cmp_pd_mask (dt, zero, _CMP_GT_OQ);
+      dt = _mm512_mask_blend_pd (released, one, dt);
+      __m512d dx = _mm512_sub_pd (rx, _mm512_load_pd (x + i));
+      __m512d dy = _mm512_sub_pd (ry, _mm512_load_pd (y + i));
+      __m512d dz = _mm512_sub_pd (rz, _mm512_load_pd (z + i));
+      __m512d r2 = _mm512_add_pd (_mm512_add_pd (_mm512_mul_pd (dx, dx), _mm512_mul_pd (dy, dy)), _mm512_mul_pd (dz, dz));
+      __m512d s = _mm512_mul_pd (_mm512_mul_pd (_mm512_load_pd (D + i), _mm512_set1_pd (4.0)), dt);
+      __m512d inv = _mm512_div_pd (one, s);
+      __m512d e = waveExp8 (_mm512_sub_pd (zero, _mm512_mul_pd (r2, inv)));
+      __m512d k = _mm512_mul_pd (_mm512_mul_pd (_mm512_mul_pd (_mm512_mul_pd (_mm512_load_pd (c0 + i), _mm512_set1_pd (g_invPi15)), inv), _mm512_sqrt_pd (inv)), e);
+      a = _mm512_add_pd (a, _mm512_maskz_mov_pd (released, k));
+    }
+  _mm512_storeu_pd (acc, a);
+}
+#if !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+//! as sumAvx512, 4 waves at a time into the same 8 partial sums
+P1906_DIFFUSION_WAVES_TARGET ("avx2") static void
+sumAvx2 (const P1906MOL_MOTOR_Vec3 & receiver, double t, const double * t0, const double * D, const double * c0,
+        const double * x, const double * y, const double * z, size_t end, double * acc)
+{
+  size_t i = 0;
+  const __m256d rx = _mm256_set1_pd (receiver.x), ry = _mm256_set1_pd (receiver.y), rz = _mm256_set1_pd (receiver.z);
+  const __m256d tq = _mm256_set1_pd (t), zero = _mm256_setzero_pd (), one = _mm256_set1_pd (1.0);
+  __m256d a[2] = { zero, zero };
+  for (; i < end; i += 4)
+    {
+      __m256d dt = _mm256_sub_pd (tq, _mm256_load_pd (t0 + i));
+      __m256d released = _mm256_cmp_pd (dt, zero, _CMP_GT_OQ);
+      dt = _mm256_blendv_pd (one, dt, released);
+      __m256d dx = _mm256_sub_pd (rx, _mm256_load_pd (x + i));
+      __m256d dy = _mm256_sub_pd (ry, _mm256_load_pd (y + i));
+      __m256d dz = _mm256_sub_pd (rz, _mm256_load_pd (z + i));
+      __m256d r2 = _mm256_add_pd (_mm256_add_pd (_mm256_mul_pd (dx, dx), _mm256_mul_pd (dy, dy)), _mm256_mul_pd (dz, dz));
+      __m256d s = _mm256_mul_pd (_mm256_mul_pd (_mm256_load_pd (D + i), _mm256_set1_pd (4.0)), dt);
+      __m256d inv = _mm256_div_pd (one, s);
+      __m256d e = waveExp4 (_mm256_sub_pd (zero, _mm256_mul_pd (r2, inv)));
+      __m256d k = _mm256_mul_pd (_mm256_mul_pd (_mm256_mul_pd (_mm256_mul_pd (_mm256_load_pd (c0 + i), _mm256_set1_pd (g_invPi15)), inv), _mm256_sqrt_pd (inv)), e);
+      //! lanes 0 - 3 and 4 - 7 of a block of 8 waves
+      a[(i / 4) & 1] = _mm256_add_pd (a[(i / 4) & 1], _mm256_and_pd (released, k));
+    }
+  _mm256_storeu_pd (acc, a[0]);
+  _mm256_storeu_pd (acc + 4, a[1]);
+}
+
+//! 0 until the static initializers have run, so that a sum taken before then takes the scalar path
+enum DiffusionWavesKernel { ScalarWavesKernel = 0, Avx2WavesKernel, Avx512WavesKernel };
+
+static DiffusionWavesKernel
+selectDiffusionWavesKernel (void)
+{
+  __builtin_cpu_init ();
+  if (__builtin_cpu_supports ("avx512f"))
+    return Avx512WavesKernel;
+  if (__builtin_cpu_supports ("avx2"))
+    return Avx2WavesKernel;
+  return ScalarWavesKernel;
+}
+
+static const DiffusionWavesKernel g_diffusionWavesKernel = selectDiffusionWavesKernel ();
+#endif
+
+P1906MOL_ExtendedDiffusionWaves::P1906MOL_ExtendedDiffusionWaves ()
+  : m_size (0),
+    m_threshold (0)
+{
+}
+
+double P1906MOL_ExtendedDiffusionWaves::kernel (double c0, double D, double dt, double r2)
+{
+  if (!(dt > 0))
+    return 0;
+  double s = (D * 4.0) * dt;
+  double inv = 1.0 / s;
+  return (((c0 * g_invPi15) * inv) * std::sqrt (inv)) * waveExp (-(r2 * inv));
+}
+
+//! padding waves are released at +infinity, so they never contribute
+void P1906MOL_ExtendedDiffusionWaves::resize (size_t n)
+{
+  m_t0.resize (n, std::numeric_limits<double>::infinity ());
+  m_D.resize (n, 1.0);
+  m_c0.resize (n, 0.0);
+  m_x.resize (n, 0.0);
+  m_y.resize (n, 0.0);
+  m_z.resize (n, 0.0);
+}
+
+void P1906MOL_ExtendedDiffusionWaves::add (double t0, double D, double c0, const P1906MOL_MOTOR_Vec3 & x)
+{
+  if (m_size == m_t0.size ())
+    resize (m_size + lanes);
+  m_t0[m_size] = t0;
+  m_D[m_size] = D;
+  m_c0[m_size] = c0;
+  m_x[m_size] = x.x;
+  m_y[m_size] = x.y;
+  m_z[m_size] = x.z;
+  m_size++;
+}
+
+size_t P1906MOL_ExtendedDiffusionWaves::size () const
+{
+  return m_size;
+}
+
+void P1906MOL_ExtendedDiffusionWaves::clear ()
+{
+  m_size = 0;
+  resize (0);
+}
+
+void P1906MOL_ExtendedDiffusionWaves::setCullThreshold (double c)
+{
+  m_threshold = c;
+}
+
+double P1906MOL_ExtendedDiffusionWaves::getCullThreshold () const
+{
+  return m_threshold;
+}
+
+size_t P1906MOL_ExtendedDiffusionWaves::compact (const vector<bool> & keep)
+{
+  size_t j = 0;
+  
+  for (size_t i = 0; i < m_size; i++)
+    {
+      if (!keep[i])
+        continue;
+      m_t0[j] = m_t0[i];
+      m_D[j] = m_D[i];
+      m_c0[j] = m_c0[i];
+      m_x[j] = m_x[i];
+      m_y[j] = m_y[i];
+      m_z[j] = m_z[i];
+      j++;
+    }
+  
+  size_t removed = m_size - j;
+  m_size = j;
+  resize (m_size);
+  resize ((m_size + lanes - 1) / lanes * lanes);
+  return removed;
+}
+
+//! the peak of a wave is at its release point, and it only decreases with time
+size_t P1906MOL_ExtendedDiffusionWaves::cull (double horizon)
+{
+  if (!(m_threshold > 0))
+    return 0;
+  
+  vector<bool> keep (m_size, true);
+  bool any = false;
+  for (size_t i = 0; i < m_size; i++)
+    {
+      double dt = horizon - m_t0[i];
+      if (dt > 0 && kernel (m_c0[i], m_D[i], dt, 0) < m_threshold)
+        {
+          keep[i] = false;
+          any = true;
+        }
+    }
+  return any ? compact (keep) : 0;
+}
+
+size_t P1906MOL_ExtendedDiffusionWaves::removeBelow (const P1906MOL_MOTOR_Vec3 & receiver, double t, double min)
+{
+  vector<bool> keep (m_size, true);
+  bool any = false;
+  
+  for (size_t i = 0; i < m_size; i++)
+    {
+      if (contribution (i, receiver, t) < min)
+        {
+          keep[i] = false;
+          any = true;
+        }
+    }
+  return any ? compact (keep) : 0;
+}
+
+//! compact keeps the order in which the waves were added
+size_t P1906MOL_ExtendedDiffusionWaves::keepLast (size_t n)
+{
+  if (m_size <= n)
+    return 0;
+  
+  vector<bool> keep (m_size, false);
+  for (size_t i = m_size - n; i < m_size; i++)
+    keep[i] = true;
+  return compact (keep);
+}
+
+double P1906MOL_ExtendedDiffusionWaves::contribution (size_t i, const P1906MOL_MOTOR_Vec3 & receiver, double t) const
+{
+  double dx = receiver.x - m_x[i], dy = receiver.y - m_y[i], dz = receiver.z - m_z[i];
+  
+  return kernel (m_c0[i], m_D[i], t - m_t0[i], dx * dx + dy * dy + dz * dz);
+}
+
+void P1906MOL_ExtendedDiffusionWaves::concentration (const P1906MOL_MOTOR_Vec3 * receivers, const double * times, size_t n, double * c)
+{
+  if (n == 0)
+    return;
+  
+  double horizon = times[0];
+  for (size_t q = 1; q < n; q++)
+    horizon = times[q] < horizon ? times[q] : horizon;
+  cull (horizon);
+  
+  for (size_t q = 0; q < n; q++)
+    c[q] = sum (receivers[q], times[q]);
+}
+
+double P1906MOL_ExtendedDiffusionWaves::concentration (const P1906MOL_MOTOR_Vec3 & receiver, double t)
+{
+  double c;
+  
+  concentration (&receiver, &t, 1, &c);
+  return c;
+}
+
+//! wave i goes to partial sum i % lanes whatever the kernel, and the partial sums are added in order
+double P1906MOL_ExtendedDiffusionWaves::sum (const P1906MOL_MOTOR_Vec3 & receiver, double t) const
+{
+  double acc[lanes] = { 0 };
+  size_t end = m_t0.size ();
+  
+  if (end == 0)
+    return 0;
+  
+  const double * t0 = &m_t0[0], * D = &m_D[0], * c0 = &m_c0[0];
+  const double * x = &m_x[0], * y = &m_y[0], * z = &m_z[0];
+  size_t i = 0;
+
+#ifdef P1906_DIFFUSION_WAVES_DISPATCH
+  if (g_diffusionWavesKernel == Avx512WavesKernel)
+    {
+      sumAvx512 (receiver, t, t0, D, c0, x, y, z, end, acc);
+      i = end;
+    }
+  else if (g_diffusionWavesKernel == Avx2WavesKernel)
+    {
+      sumAvx2 (receiver, t, t0, D, c0, x, y, z, end, acc);
+      i = end;
+    }
+#endif
+  for (; i < end; i++)
+    {
+      double dx = receiver.x - x[i], dy = receiver.y - y[i], dz = receiver.z - z[i];
+      acc[i % lanes] += kernel (c0[i], D[i], t - t0[i], dx * dx + dy * dy + dz * dz);
+    }
+
+  double c = 0;
+  for (size_t j = 0; j < lanes; j++)
+    c += acc[j];
+  return c;
+}
+
+} // namespace ns3
@@ -0,0 +1,120 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *  Copyright � 2015 by IEEE.
+ *
+ *  This source file is an essential part of IEEE Std 1906.1,
+ *  Recommended Practice for Nanoscale and Molecular
+ *  Communication Framework.
+ *  Verbatim copies of this source file may be used and
+ *  distributed without restriction. Modifications to this source
+ *  file as permitted in IEEE Std 1906.1 may also be made and
+ *  distributed. All other uses require permission from the IEEE
+ *  Standards Department (stds-ipr@ieee.org). All other rights
+ *  reserved.
+ *
+ *  This source file is provided on an AS IS basis.
+ *  The IEEE disclaims ANY WARRANTY EXPRESS OR IMPLIED INCLUDING
+ *  ANY WARRANTY OF MERCHANTABILITY AND FITNESS FOR USE FOR A
+ *  PARTICULAR PURPOSE.
+ *  The user of the source file shall indemnify and hold
+ *  IEEE harmless from any damages or liability arising out of
+ *  the use thereof.
+ *
+ * Author: Stephen F Bush - GE Global Research
+ *                      bushsf@research.ge.com
+ *                      http://www.amazon.com/author/stephenbush
+ */
+
+
+#ifndef P1906MOL_EXTENDED_DIFFUSION_WAVES
+#define P1906MOL_EXTENDED_DIFFUSION_WAVES
+
+#include <cstddef>
+#include <vector>
+using namespace std;
+
+#include "ns3/p1906-mol-motor-vec3.h"
+#include "ns3/p1906-mol-motor-segment-arrays.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup IEEE P1906 framework
+ *
+ * \class P1906MOL_ExtendedDiffusionWaves
+ *
+ * \brief A superposition of free diffusion waves evaluated in batches
+ *
+ * Wave i, released at time t0 with concentration c0 at (x, y, z) in a medium
+ * of diffusion coefficient D, contributes
+ *
+ * <pre>
+ *   c_i(r, t) = c0 (4 pi D (t - t0))^(-3/2) exp (-|r - (x, y, z)|^2 / (4 D (t - t0)))
+ * </pre>
+ *
+ * for t > t0 and nothing before. The waves are stored in structure of arrays
+ * layout (t0, D, c0, x, y, z), each array 64 byte aligned and padded to a
+ * multiple of lanes, and a query sums them 8 (AVX-512), 4 (AVX2) or 1
+ * (scalar fallback) at a time, the widest the processor supports being picked
+ * at run time as for P1906MOL_MOTOR_SegmentArrays. All kernels use the same
+ * exponential and accumulate wave i into partial sum i % lanes, so they agree
+ * bit for bit unless the scalar path is built with contracted multiply-adds.
+ *
+ * With a cull threshold, a batch first drops the waves that can no longer
+ * exceed it anywhere: after its release a wave is everywhere at most
+ * c0 (4 pi D (t - t0))^(-3/2), which only decreases with t. Queries are
+ * expected to move forward in time, as the simulation does.
+ */
+class P1906MOL_ExtendedDiffusionWaves
+{
+public:
+  //! the waves are padded to a multiple of this
+  static const size_t lanes = 8;
+  
+  P1906MOL_ExtendedDiffusionWaves ();
+  
+  //! release concentration c0 at position x at time t0 in a medium of diffusion coefficient D
+  void add (double t0, double D, double c0, const P1906MOL_MOTOR_Vec3 & x);
+  //! number of waves, padding excluded
+  size_t size () const;
+  void clear ();
+  
+  //! waves that cannot exceed c anywhere at the earliest time of a batch are dropped; 0 (the default) keeps all waves
+  void setCullThreshold (double c);
+  double getCullThreshold () const;
+  //! drop the waves that cannot exceed the cull threshold anywhere at or after horizon; return how many were dropped
+  size_t cull (double horizon);
+  //! drop the waves contributing less than min at receiver at time t; return how many were dropped
+  size_t removeBelow (const P1906MOL_MOTOR_Vec3 & receiver, double t, double min);
+  //! drop all but the last n waves added; return how many were dropped
+  size_t keepLast (size_t n);
+  
+  //! total concentration c[q] at receivers[q] at times[q], for q < n
+  void concentration (const P1906MOL_MOTOR_Vec3 * receivers, const double * times, size_t n, double * c);
+  //! total concentration at receiver at time t
+  double concentration (const P1906MOL_MOTOR_Vec3 & receiver, double t);
+  //! the contribution of wave i at receiver at time t
+  double contribution (size_t i, const P1906MOL_MOTOR_Vec3 & receiver, double t) const;
+  
+  //! the Gaussian kernel: the concentration at squared distance r2 from a release of c0, dt after it
+  static double kernel (double c0, double D, double dt, double r2);
+  
+private:
+  typedef vector<double, P1906MOL_MOTOR_AlignedAllocator<double> > Lane;
+  
+  //! sum of all the waves at receiver at time t
+  double sum (const P1906MOL_MOTOR_Vec3 & receiver, double t) const;
+  //! keep the waves i with keep[i], in order, and re-pad
+  size_t compact (const vector<bool> & keep);
+  //! size the arrays to n entries, the new ones being padding
+  void resize (size_t n);
+  
+  Lane m_t0, m_D, m_c0;
+  Lane m_x, m_y, m_z;
+  size_t m_size;
+  double m_threshold;
+};
+
+}
+
+#endif /* P1906MOL_EXTENDED_DIFFUSION_WAVES */
@@ -29,8 +29,8 @@
  *
  */
  
-#include <algorithm>    // std::remove_if
- 
+#include <algorithm>
+
 #include "ns3/log.h"
 
 #include "gsl/gsl_sf_exp.h"
@@ -70,48 +70,41 @@ P1906MOL_ExtendedDiffusion::P1906MOL_ExtendedDiffusion ()
 }
 
 //! trigger a release of a vector wave at time tt
-//! \todo wv is a growing list of waves, will need to remove waves that have reached equilibrium (or disseminated)
+//! waves that have reached equilibrium (or disseminated) are dropped through setCullThreshold or clean_wavevector
 void P1906MOL_ExtendedDiffusion::transmit(double tt, double D, double ic, P1906MOL_MOTOR_Pos ip)
 {
-  P1906MOL_ExtendedDiffusionWave wave;
-  
   //! record the time [s], concentration [nmol/nm^3], and location of transmission
-  wave.prepare_transmission(tt, D, ic, ip);
-  //! store the wave
-  wv.insert (wv.end(), wave);
+  waves.add (tt, D, ic, ip.getVec3 ());
 }
 
-bool IsDissipated(const P1906MOL_ExtendedDiffusionWave & o)
+void P1906MOL_ExtendedDiffusion::transmit(const P1906MOL_ExtendedDiffusionWave & wave)
 {
-    return o.low_concentration;
+  waves.add (wave.transmission_time, wave.D, wave.c_0, wave.transmitter.getVec3 ());
 }
 
 //! check for waves below the minimum and remove (this needs to be a specific time and LOCATION)
 void P1906MOL_ExtendedDiffusion::clean_wavevector(double min_concentration, P1906MOL_MOTOR_Pos receiver, double time)
 {
-
-  for (size_t i; i < wv.size(); i++)
-  {
-    if (wv.at(i).concentration_wave (receiver, time) < min_concentration)
-	  wv.at(i).low_concentration = true;
-  }
-
-  wv.erase( std::remove_if( wv.begin(), wv.end(), IsDissipated ), wv.end() );
+  waves.removeBelow (receiver.getVec3 (), time, min_concentration);
 }
 
 //! sample the concentration at time rt and location rp
-//! \todo wv is a growing list of waves, will need to remove waves that have reached equilibrium (or disseminated)
 double P1906MOL_ExtendedDiffusion::receive(double rt, P1906MOL_MOTOR_Pos rp)
 {
   //! the accumulated concentration
-  double c = 0;
-  
-  for (size_t i = 0; i < wv.size(); i++)
-  {
-    c += wv.at(i).concentration_wave (rp, rt);
-  }
-  
-  return c;
+  return waves.concentration (rp.getVec3 (), rt);
+}
+
+void P1906MOL_ExtendedDiffusion::receive(const vector<P1906MOL_MOTOR_Vec3> & receivers, const vector<double> & times, vector<double> & c)
+{
+  c.resize (receivers.size ());
+  if (!receivers.empty ())
+    waves.concentration (&receivers[0], &times[0], receivers.size (), &c[0]);
+}
+
+void P1906MOL_ExtendedDiffusion::setCullThreshold(double c)
+{
+  waves.setCullThreshold (c);
 }
 
 // The goal is to solve for diffusion concentration in 3D given:
@@ -139,6 +132,7 @@ double P1906MOL_ExtendedDiffusion::receive(double rt, P1906MOL_MOTOR_Pos rp)
 //
 //*********************************************************************
 
+//! release one wave and return the largest difference between the superposition and the wave itself over 99 s
 double P1906MOL_ExtendedDiffusion::unitTest_diffusion ()
 {
   P1906MOL_ExtendedDiffusionWave wave;
@@ -164,9 +158,16 @@ double P1906MOL_ExtendedDiffusion::unitTest_diffusion ()
   receiver.setPos (10, 0, 0);
   receiver.getPos (rpos);
 
-  transmit(0, D, c_0, transmitter);
+  wave.prepare_transmission(0, D, c_0, transmitter);
+  transmit(wave);
+  
+  double error = 0;
+  for (double t = 1.0; t < 100.0; t = t + 1.0)
+    error = max (error, fabs (receive(t, receiver) - wave.concentration_wave(receiver, t)));
   
-  return 0;
+  gsl_vector_free (xpos);
+  gsl_vector_free (rpos);
+  return error;
 }
 
 void P1906MOL_ExtendedDiffusion::displayODE ()
@@ -51,6 +51,7 @@ using namespace std;
 
 #include "ns3/p1906-mol-motor-pos.h"
 #include "ns3/p1906-mol-diffusion-wave.h"
+#include "ns3/p1906-mol-diffusion-waves.h"
 
 namespace ns3 {
 
@@ -80,8 +81,8 @@ class P1906MOL_ExtendedDiffusion : public Object
 public:
   static TypeId GetTypeId (void);
   
-  //! an array of diffusion waves
-  vector<P1906MOL_ExtendedDiffusionWave> wv;
+  //! the released diffusion waves, in structure of arrays form
+  P1906MOL_ExtendedDiffusionWaves waves;
   
   P1906MOL_ExtendedDiffusion (void);
 
@@ -96,8 +97,16 @@ public:
   double unitTest_diffusion ();
   //! trigger a release using last configures values
   void transmit(double tt, double D, double ic, P1906MOL_MOTOR_Pos ip);
+  //! release a prepared wave
+  void transmit(const P1906MOL_ExtendedDiffusionWave & wave);
+  //! remove the waves contributing less than min_concentration at receiver and time
   void clean_wavevector(double min_concentration, P1906MOL_MOTOR_Pos receiver, double time);
+  //! the concentration of all the waves at time rt and location rp
   double receive(double rt, P1906MOL_MOTOR_Pos rp);
+  //! the concentration c[q] of all the waves at receivers[q] and times[q], in one batch
+  void receive(const vector<P1906MOL_MOTOR_Vec3> & receivers, const vector<double> & times, vector<double> & c);
+  //! drop the waves that can no longer exceed c anywhere before each batch of receptions; 0 keeps them all
+  void setCullThreshold(double c);
   
   //! consider addition operator
   //X& operator+=(const X& rhs)
@@ -34,6 +34,8 @@
  * |   NS-3    | +-> | *.dat   |  +-> | MATLAB |
  * |           |     +---------+      |        |
  * +-----------+                      +--------+
+ *
+ * or, by default, into a binary trace converted on demand by motor-trace-converter
  * </pre>
  */
  
@@ -41,6 +43,8 @@
 #include "ns3/object.h"
 #include "ns3/nstime.h"
 #include "ns3/ptr.h"
+#include "ns3/enum.h"
+#include "ns3/string.h"
 
 #include "ns3/p1906-mol-motor-MATLABHelper.h"
 #include "ns3/p1906-mol-motor-tube.h"
@@ -52,11 +56,30 @@ NS_LOG_COMPONENT_DEFINE ("P1906MOL_MOTOR_MATLABHelper");
 TypeId P1906MOL_MOTOR_MATLABHelper::GetTypeId (void)
 {
   static TypeId tid = TypeId ("ns3::P1906MOL_MOTOR_MATLABHelper")
-    .SetParent<Object> ();
+    .SetParent<Object> ()
+    .AddAttribute ("Format",
+                   "Append the rows to TraceFile (Binary) or write them as a text file (Text)",
+                   EnumValue (P1906MOL_MOTOR_MATLABHelper::Binary),
+                   MakeEnumAccessor (&P1906MOL_MOTOR_MATLABHelper::setFormat,
+                                     &P1906MOL_MOTOR_MATLABHelper::getFormat),
+                   MakeEnumChecker (P1906MOL_MOTOR_MATLABHelper::Binary, "Binary",
+                                    P1906MOL_MOTOR_MATLABHelper::Text, "Text"))
+    .AddAttribute ("TraceFile",
+                   "Trace file receiving the rows in the Binary format (see P1906MOL_MOTOR_Trace)",
+                   StringValue ("motor.p1906trc"),
+                   MakeStringAccessor (&P1906MOL_MOTOR_MATLABHelper::m_traceFile),
+                   MakeStringChecker ());
   return tid;
 }
 
+TypeId P1906MOL_MOTOR_MATLABHelper::GetInstanceTypeId (void) const
+{
+  return GetTypeId ();
+}
+
 P1906MOL_MOTOR_MATLABHelper::P1906MOL_MOTOR_MATLABHelper ()
+  : m_format (Binary),
+    m_traceFile ("motor.p1906trc")
 {
   /** This class implements persistence length as described in:
 	  Bush, S. F., & Goel, S. (2013). Persistence Length as a Metric for Modeling and 
@@ -73,11 +96,41 @@ P1906MOL_MOTOR_MATLABHelper::P1906MOL_MOTOR_MATLABHelper ()
 	  
   */
 
+  //! see P1906MOL_MOTOR_MathematicaHelper
+  ObjectBase::ConstructSelf (AttributeConstructionList ());
+}
+
+void P1906MOL_MOTOR_MATLABHelper::setFormat(Format format)
+{
+  m_format = format;
+}
+
+P1906MOL_MOTOR_MATLABHelper::Format P1906MOL_MOTOR_MATLABHelper::getFormat() const
+{
+  return m_format;
+}
+
+bool P1906MOL_MOTOR_MATLABHelper::trace(const string & label, const gsl_matrix * vf)
+{
+  if (!m_trace)
+    m_trace = P1906MOL_MOTOR_TraceWriter::Get (m_traceFile);
+  if (!m_trace)
+    return false;
+  
+  bool ok = m_trace->write (P1906MOL_MOTOR_Trace::VectorField, P1906MOL_MOTOR_Trace::MATLABRows, 0, label, vf);
+  m_trace->flush ();
+  return ok;
 }
 
 //! write a list of vectors into file fname in MATLAB loadable format
 void P1906MOL_MOTOR_MATLABHelper::vectorFieldPlotMATLAB(gsl_matrix * vf, const char * fname)
 {
+  if (m_format == Binary)
+  {
+    trace (fname, vf);
+    return;
+  }
+  
   FILE * pFile;
 
   pFile = fopen (fname,"w");
@@ -102,8 +155,8 @@ void P1906MOL_MOTOR_MATLABHelper::vectorFieldPlotMATLAB(gsl_matrix * vf, const c
 void P1906MOL_MOTOR_MATLABHelper::vectorFieldMeshMATLAB(gsl_matrix * vf, const char * fname)
 {
   FILE * pFile;
-
-  pFile = fopen (fname,"w");
+  //! the rows x, y, z, u, v, w of the mesh
+  vector<double> mesh;
   
   // find the mesh volume limits
   double xMin, xMax;
@@ -148,6 +201,10 @@ void P1906MOL_MOTOR_MATLABHelper::vectorFieldMeshMATLAB(gsl_matrix * vf, const c
   double yStepsize = (yMax - yMin) / 10.0;
   double zStepsize = (zMax - zMin) / 10.0;
   
+  //! every mesh point looks up its closest vector location, so bin the locations once
+  P1906MOL_MOTOR_SegmentIndex index;
+  index.buildFromVectorField (vf, GSL_MAX (xStepsize, GSL_MAX (yStepsize, zStepsize)));
+  
   //printf ("xStepsize: %f yStepsize: %f zStepsize: %f\n", xStepsize, yStepsize, zStepsize);
   
   //! step through equidistant points in a volume and store the vector values at each point
@@ -159,7 +216,7 @@ void P1906MOL_MOTOR_MATLABHelper::vectorFieldMeshMATLAB(gsl_matrix * vf, const c
 	    P1906MOL_MOTOR_Field::point (pt1, i, j, k);
 		// printf ("pt1\n");
 		// displayPoint (pt1);
-	    P1906MOL_MOTOR_Field::findClosestPoint (pt1, vf, closest);
+	    P1906MOL_MOTOR_Field::findClosestPoint (pt1, vf, index, closest);
 		//printf ("(findClosestPoint) closest vector: %f %f %f %f %f %f\n",
         //  gsl_vector_get (closest, 0),
 	    //  gsl_vector_get (closest, 1),
@@ -191,15 +248,32 @@ void P1906MOL_MOTOR_MATLABHelper::vectorFieldMeshMATLAB(gsl_matrix * vf, const c
 	        gsl_vector_get (closest, 5));
 		  // displayPoint (vec);
 		}
-		//! print current location and stored vector value
-        fprintf (pFile, "%f %f %f %f %f %f\n",
-	      i, 
-		  j,
-		  k, 
-		  gsl_vector_get (vec, 0),
-          gsl_vector_get (vec, 1),
-          gsl_vector_get (vec, 2));
+		//! keep current location and stored vector value
+		mesh.push_back (i);
+		mesh.push_back (j);
+		mesh.push_back (k);
+		mesh.push_back (gsl_vector_get (vec, 0));
+		mesh.push_back (gsl_vector_get (vec, 1));
+		mesh.push_back (gsl_vector_get (vec, 2));
       }
+  
+  if (m_format == Binary)
+  {
+    if (!mesh.empty ())
+    {
+      gsl_matrix_const_view rows = gsl_matrix_const_view_array (&mesh[0], mesh.size () / 6, 6);
+      trace (fname, &rows.matrix);
+    }
+    return;
+  }
+  
+  pFile = fopen (fname,"w");
+  
+  for (size_t r = 0; r < mesh.size (); r += 6)
+  {
+    fprintf (pFile, "%f %f %f %f %f %f\n",
+      mesh[r], mesh[r + 1], mesh[r + 2], mesh[r + 3], mesh[r + 4], mesh[r + 5]);
+  }
 	  
   fclose(pFile);
 }
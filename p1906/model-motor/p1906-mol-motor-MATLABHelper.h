@@ -45,6 +45,7 @@ using namespace std;
 #include "ns3/object.h"
 #include "ns3/nstime.h"
 #include "ns3/ptr.h"
+#include "ns3/p1906-mol-motor-trace.h"
 
 namespace ns3 {
 
@@ -67,15 +68,25 @@ namespace ns3 {
  *  Each tube is comprised of a list of segments within a gsl_matrix * of size s x 6 -> s x ((x1, y1, z1), (x2, y2, z2)).
  *  A set of tubes is also a gsl_matrix * of size (s * t) x 6, where s is the number of segments and t the number of tubes.
  *  All random number are derived from gsl_rng *.
+ *
+ * As with P1906MOL_MOTOR_MathematicaHelper, the default Binary format appends
+ * the rows to the trace file TraceFile and the Text format writes them as text.
  */
 
 class P1906MOL_MOTOR_MATLABHelper : public Object
 {
 public:
   static TypeId GetTypeId (void);
+  virtual TypeId GetInstanceTypeId (void) const;
+  
+  enum Format {Binary, Text};
   
   P1906MOL_MOTOR_MATLABHelper ();
   
+  //! write the trace file (Binary) or the text files themselves (Text)
+  void setFormat(Format format);
+  Format getFormat() const;
+  
   //! write the vector field in MATLAB format using regular spacing between samples
   void vectorFieldMeshMATLAB(gsl_matrix * vf, const char * fname);
   //! write a list of vectors into file fname in MATLAB loadable format
@@ -83,6 +94,14 @@ public:
   
   virtual ~P1906MOL_MOTOR_MATLABHelper ();
 
+private:
+  //! append the rows of vf as a vector field chunk of the trace file; false if it cannot be written
+  bool trace(const string & label, const gsl_matrix * vf);
+  
+  Format m_format;
+  //! see the TraceFile attribute
+  string m_traceFile;
+  Ptr<P1906MOL_MOTOR_TraceWriter> m_trace;
 };
 
 }
@@ -34,6 +34,11 @@
  * |   NS-3  +--->  |  *.mma   +---> | Mathematica |
  * |         |      +----------+     |             |
  * +---------+                       +-------------+
+ *
+ * or, by default, a binary trace converted on demand
+ * +---------+   +------------+   +-----------------------+   +----------+
+ * |   NS-3  +-->| *.p1906trc +-->| motor-trace-converter +-->|  *.mma   |
+ * +---------+   +------------+   +-----------------------+   +----------+
  * </pre>
  */
 
@@ -41,6 +46,8 @@
 #include "ns3/object.h"
 #include "ns3/nstime.h"
 #include "ns3/ptr.h"
+#include "ns3/enum.h"
+#include "ns3/string.h"
 
 #include "ns3/p1906-mol-motor-MathematicaHelper.h"
 #include "ns3/p1906-mol-motor-pos.h"
@@ -52,11 +59,30 @@ NS_LOG_COMPONENT_DEFINE ("P1906MOL_MOTOR_MathematicaHelper");
 TypeId P1906MOL_MOTOR_MathematicaHelper::GetTypeId (void)
 {
   static TypeId tid = TypeId ("ns3::P1906MOL_MOTOR_MathematicaHelper")
-    .SetParent<Object> ();
+    .SetParent<Object> ()
+    .AddAttribute ("Format",
+                   "Append each plot to TraceFile (Binary) or write it as a .mma file (Text)",
+                   EnumValue (P1906MOL_MOTOR_MathematicaHelper::Binary),
+                   MakeEnumAccessor (&P1906MOL_MOTOR_MathematicaHelper::setFormat,
+                                     &P1906MOL_MOTOR_MathematicaHelper::getFormat),
+                   MakeEnumChecker (P1906MOL_MOTOR_MathematicaHelper::Binary, "Binary",
+                                    P1906MOL_MOTOR_MathematicaHelper::Text, "Text"))
+    .AddAttribute ("TraceFile",
+                   "Trace file receiving the plots in the Binary format (see P1906MOL_MOTOR_Trace)",
+                   StringValue ("motor.p1906trc"),
+                   MakeStringAccessor (&P1906MOL_MOTOR_MathematicaHelper::m_traceFile),
+                   MakeStringChecker ());
   return tid;
 }
 
+TypeId P1906MOL_MOTOR_MathematicaHelper::GetInstanceTypeId (void) const
+{
+  return GetTypeId ();
+}
+
 P1906MOL_MOTOR_MathematicaHelper::P1906MOL_MOTOR_MathematicaHelper ()
+  : m_format (Binary),
+    m_traceFile ("motor.p1906trc")
 {
   /** This class implements persistence length as described in:
 	  Bush, S. F., & Goel, S. (2013). Persistence Length as a Metric for Modeling and 
@@ -73,11 +99,66 @@ P1906MOL_MOTOR_MathematicaHelper::P1906MOL_MOTOR_MathematicaHelper ()
 	  
   */
 
+  //! helpers are mostly created on the stack, so take the attribute defaults (and Config::SetDefault) here
+  ObjectBase::ConstructSelf (AttributeConstructionList ());
+}
+
+void P1906MOL_MOTOR_MathematicaHelper::setFormat(Format format)
+{
+  m_format = format;
+}
+
+P1906MOL_MOTOR_MathematicaHelper::Format P1906MOL_MOTOR_MathematicaHelper::getFormat() const
+{
+  return m_format;
+}
+
+//! the trace file is shared with every other helper of the process, and flushed after each plot
+bool P1906MOL_MOTOR_MathematicaHelper::trace(uint32_t kind, uint32_t style, uint64_t tag, const string & label, const gsl_matrix * m)
+{
+  if (!m_trace)
+    m_trace = P1906MOL_MOTOR_TraceWriter::Get (m_traceFile);
+  if (!m_trace)
+    return false;
+  
+  bool ok = m_trace->write (kind, style, tag, label, m);
+  m_trace->flush ();
+  return ok;
+}
+
+bool P1906MOL_MOTOR_MathematicaHelper::trace(uint32_t kind, const string & label, const vector<P1906MOL_MOTOR_Vec3> & pts)
+{
+  if (!m_trace)
+    m_trace = P1906MOL_MOTOR_TraceWriter::Get (m_traceFile);
+  if (!m_trace)
+    return false;
+  
+  vector<double> x (pts.size ()), y (pts.size ()), z (pts.size ());
+  vector<const double *> columns;
+  for (size_t i = 0; i < pts.size (); i++)
+  {
+    x[i] = pts[i].x;
+    y[i] = pts[i].y;
+    z[i] = pts[i].z;
+  }
+  columns.push_back (pts.empty () ? 0 : &x[0]);
+  columns.push_back (pts.empty () ? 0 : &y[0]);
+  columns.push_back (pts.empty () ? 0 : &z[0]);
+  
+  bool ok = m_trace->write (kind, P1906MOL_MOTOR_Trace::Default, 0, label, columns, pts.size ());
+  m_trace->flush ();
+  return ok;
 }
 
 //! display the vector field in Mathematica format for VectorPlot3D in file fname
 void P1906MOL_MOTOR_MathematicaHelper::vectorFieldPlotMma(gsl_matrix * vf, const char * fname)
 {
+  if (m_format == Binary)
+  {
+    trace (P1906MOL_MOTOR_Trace::VectorField, P1906MOL_MOTOR_Trace::Default, 0, fname, vf);
+    return;
+  }
+  
   FILE * pFile;
 
   pFile = fopen (fname,"w");
@@ -106,6 +187,12 @@ void P1906MOL_MOTOR_MathematicaHelper::vectorFieldPlotMma(gsl_matrix * vf, const
 //! write the vector field in Mathematica format using regular spacing between samples in file fname
 void P1906MOL_MOTOR_MathematicaHelper::vectorFieldMeshMma(gsl_matrix * vf, const char * fname)
 {
+  if (m_format == Binary)
+  {
+    trace (P1906MOL_MOTOR_Trace::VectorField, P1906MOL_MOTOR_Trace::Default, 0, fname, vf);
+    return;
+  }
+  
   FILE * pFile;
 
   pFile = fopen (fname,"w");
@@ -134,6 +221,12 @@ void P1906MOL_MOTOR_MathematicaHelper::vectorFieldMeshMma(gsl_matrix * vf, const
 //! write the vector field in Mathematica format using regular spacing between samples in file fname
 void P1906MOL_MOTOR_MathematicaHelper::vectorPlotMma(gsl_matrix * vf, const char * fname)
 {
+  if (m_format == Binary)
+  {
+    trace (P1906MOL_MOTOR_Trace::VectorField, P1906MOL_MOTOR_Trace::Arrows, 0, fname, vf);
+    return;
+  }
+  
   FILE * pFile;
 
   pFile = fopen (fname,"w");
@@ -159,8 +252,23 @@ void P1906MOL_MOTOR_MathematicaHelper::vectorPlotMma(gsl_matrix * vf, const char
 //! print the points (vertices) in pts in Mathematica format into file fname and include edges between the vertices
 void P1906MOL_MOTOR_MathematicaHelper::connectedPoints2Mma(vector<P1906MOL_MOTOR_Pos> pts, const char * fname)
 {
+  vector<P1906MOL_MOTOR_Vec3> v;
+  
+  for (size_t i = 0; i < pts.size(); i++)
+    v.push_back (pts.at(i).getVec3 ());
+  connectedPoints2Mma (v, fname);
+}
+
+//! print the points pts, connected in order, in Mathematica format in file fname
+void P1906MOL_MOTOR_MathematicaHelper::connectedPoints2Mma(const vector<P1906MOL_MOTOR_Vec3> & pts, const char * fname)
+{
+  if (m_format == Binary)
+  {
+    trace (P1906MOL_MOTOR_Trace::Path, fname, pts);
+    return;
+  }
+  
   FILE * pFile;
-  double x, y, z;
   
   pFile = fopen (fname,"w");
   size_t pt = 1;
@@ -178,8 +286,7 @@ void P1906MOL_MOTOR_MathematicaHelper::connectedPoints2Mma(vector<P1906MOL_MOTOR
   fprintf (pFile, "VertexCoordinateRules ->{");
   for (size_t i = 0; i < pts.size(); i++)
   {
-	pts.at(i).getPos (&x, &y, &z);
-    fprintf (pFile, "%ld -> {%f, %f, %f}", pt, x, y, z);
+    fprintf (pFile, "%ld -> {%f, %f, %f}", pt, pts[i].x, pts[i].y, pts[i].z);
     pt++;
 	if (i < (pts.size() - 1)) fprintf (pFile, ", ");
   }
@@ -195,18 +302,30 @@ void P1906MOL_MOTOR_MathematicaHelper::connectedPoints2Mma(vector<P1906MOL_MOTOR
 //! print the first numPts points pts in Mathematica format in file fname
 void P1906MOL_MOTOR_MathematicaHelper::points2Mma(vector<P1906MOL_MOTOR_Pos> & pts, const char * fname)
 {
+  vector<P1906MOL_MOTOR_Vec3> v;
+  
+  for (size_t i = 0; i < pts.size(); i++)
+    v.push_back (pts.at(i).getVec3 ());
+  points2Mma (v, fname);
+}
+
+//! print the points pts in Mathematica format in file fname
+void P1906MOL_MOTOR_MathematicaHelper::points2Mma(const vector<P1906MOL_MOTOR_Vec3> & pts, const char * fname)
+{
+  if (m_format == Binary)
+  {
+    trace (P1906MOL_MOTOR_Trace::Points, fname, pts);
+    return;
+  }
+  
   FILE * pFile;
-  P1906MOL_MOTOR_Pos pt;
-  double x, y, z;
   
   pFile = fopen (fname,"w");
   
   fprintf (pFile, "Graphics3D[{PointSize[Large], Blue, ");
   for (size_t i = 0; i < pts.size(); i++)
   {
-	pt = pts.at(i);
-	pt.getPos(&x, &y, &z);
-    fprintf (pFile, "Point[{%f, %f, %f}]", x, y, z);
+    fprintf (pFile, "Point[{%f, %f, %f}]", pts[i].x, pts[i].y, pts[i].z);
 	if (i < pts.size() - 1) fprintf (pFile, ", ");
   }
   fprintf (pFile, "}]\n");
@@ -220,9 +339,21 @@ void P1906MOL_MOTOR_MathematicaHelper::volSurfacePlot(P1906MOL_MOTOR_Pos center,
   FILE * pFile;
   double x, y, z;
   
+  center.getPos (&x, &y, &z);
+  if (m_format == Binary)
+  {
+    gsl_matrix * sphere = gsl_matrix_alloc (1, 4);
+    gsl_matrix_set (sphere, 0, 0, x);
+    gsl_matrix_set (sphere, 0, 1, y);
+    gsl_matrix_set (sphere, 0, 2, z);
+    gsl_matrix_set (sphere, 0, 3, radius);
+    trace (P1906MOL_MOTOR_Trace::Sphere, P1906MOL_MOTOR_Trace::Default, 0, fname, sphere);
+    gsl_matrix_free (sphere);
+    return;
+  }
+  
   pFile = fopen (fname,"w");
   
-  center.getPos (&x, &y, &z);
   fprintf (pFile, "Graphics3D[{Opacity[0.5], Sphere[{%lf, %lf, %lf}, %lf]}, Axes -> True]\n", x, y, z, radius);
     
   fclose(pFile);
@@ -231,6 +362,12 @@ void P1906MOL_MOTOR_MathematicaHelper::volSurfacePlot(P1906MOL_MOTOR_Pos center,
 //! print a plot of x,y values in vals in Mathematica format into file fname
 void P1906MOL_MOTOR_MathematicaHelper::plot2Mma(gsl_matrix * vals, const char * fname, const char * xlabel, const char * ylabel)
 {
+  if (m_format == Binary)
+  {
+    trace (P1906MOL_MOTOR_Trace::Series, P1906MOL_MOTOR_Trace::Default, 0, string (fname) + "\n" + xlabel + "\n" + ylabel, vals);
+    return;
+  }
+  
   FILE * pFile;
   size_t numVals = vals->size1;
   
@@ -254,6 +391,12 @@ void P1906MOL_MOTOR_MathematicaHelper::plot2Mma(gsl_matrix * vals, const char *
 //! print all tubes in tubeMatrix into a Mathematica file fname with segments per tube of segPerTube
 void P1906MOL_MOTOR_MathematicaHelper::tubes2Mma(gsl_matrix * tubeMatrix, size_t segPerTube, const char * fname)
 {
+  if (m_format == Binary)
+  {
+    trace (P1906MOL_MOTOR_Trace::Tubes, P1906MOL_MOTOR_Trace::Default, segPerTube, fname, tubeMatrix);
+    return;
+  }
+  
   /** save tubes to file in the form of 
     GraphPlot3D[{1 -> 2, 1 -> 4, 1 -> 5, 2 -> 3, 2 -> 6, 3 -> 4, 3 -> 7, 4 -> 8, 5 -> 6, 5 -> 8, 6 -> 7, 7 -> 8}, 
 	VertexCoordinateRules -> {1 -> {0, 1, 2}, 2 -> {-1, 0, 2}, 3 -> {0, -1, 2}, 4 -> {1, 0, 2}, 5 -> {0, 2, 0}, 6 -> {-2, 0, 0}, 7 -> {0, -2, 0}, 8 -> {2, 0, 0}}]
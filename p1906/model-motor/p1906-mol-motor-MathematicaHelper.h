@@ -49,6 +49,8 @@ using namespace std;
 #include "ns3/ptr.h"
 
 #include "ns3/p1906-mol-motor-pos.h"
+#include "ns3/p1906-mol-motor-vec3.h"
+#include "ns3/p1906-mol-motor-trace.h"
 
 namespace ns3 {
 
@@ -71,15 +73,27 @@ namespace ns3 {
  *  Each tube is comprised of a list of segments within a gsl_matrix * of size s x 6 -> s x ((x1, y1, z1), (x2, y2, z2)).
  *  A set of tubes is also a gsl_matrix * of size (s * t) x 6, where s is the number of segments and t the number of tubes.
  *  All random number are derived from gsl_rng *.
+ *
+ * With the default Binary format every method appends its data as one chunk
+ * of the trace file TraceFile, labelled with the file name it was given; the
+ * motor-trace-converter example turns the chunks back into the same .mma files
+ * (or into CSV or MATLAB rows). The Text format writes the .mma files directly.
  */
 
 class P1906MOL_MOTOR_MathematicaHelper : public Object
 {
 public:
   static TypeId GetTypeId (void);
+  virtual TypeId GetInstanceTypeId (void) const;
+  
+  enum Format {Binary, Text};
   
   P1906MOL_MOTOR_MathematicaHelper ();
   
+  //! write the trace file (Binary) or the .mma files themselves (Text)
+  void setFormat(Format format);
+  Format getFormat() const;
+  
   /*
    * Vector field plotting methods
    */
@@ -95,8 +109,12 @@ public:
    */
   //! write a list of points into file fname in Mathematica format
   void points2Mma(vector<P1906MOL_MOTOR_Pos> & pts, const char * fname);
+  //! print the points pts in Mathematica format in file fname
+  void points2Mma(const vector<P1906MOL_MOTOR_Vec3> & pts, const char * fname);
   //! write a list of connected points into file fname in Mathematica format
   void connectedPoints2Mma(vector<P1906MOL_MOTOR_Pos> pts, const char * fname);
+  //! print the points pts, connected in order, in Mathematica format in file fname
+  void connectedPoints2Mma(const vector<P1906MOL_MOTOR_Vec3> & pts, const char * fname);
   
   /*
    * Plot and segment display methods
@@ -114,6 +132,16 @@ public:
   
   virtual ~P1906MOL_MOTOR_MathematicaHelper ();
 
+private:
+  //! append m as a chunk of the trace file; false if it cannot be written
+  bool trace(uint32_t kind, uint32_t style, uint64_t tag, const string & label, const gsl_matrix * m);
+  //! append the points pts as the x, y, z columns of a chunk of the trace file
+  bool trace(uint32_t kind, const string & label, const vector<P1906MOL_MOTOR_Vec3> & pts);
+  
+  Format m_format;
+  //! see the TraceFile attribute
+  string m_traceFile;
+  Ptr<P1906MOL_MOTOR_TraceWriter> m_trace;
 };
 
 }
@@ -0,0 +1,337 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *  Copyright � 2015 by IEEE.
+ *
+ *  This source file is an essential part of IEEE Std 1906.1,
+ *  Recommended Practice for Nanoscale and Molecular
+ *  Communication Framework.
+ *  Verbatim copies of this source file may be used and
+ *  distributed without restriction. Modifications to this source
+ *  file as permitted in IEEE Std 1906.1 may also be made and
+ *  distributed. All other uses require permission from the IEEE
+ *  Standards Department (stds-ipr@ieee.org). All other rights
+ *  reserved.
+ *
+ *  This source file is provided on an AS IS basis.
+ *  The IEEE disclaims ANY WARRANTY EXPRESS OR IMPLIED INCLUDING
+ *  ANY WARRANTY OF MERCHANTABILITY AND FITNESS FOR USE FOR A
+ *  PARTICULAR PURPOSE.
+ *  The user of the source file shall indemnify and hold
+ *  IEEE harmless from any damages or liability arising out of
+ *  the use thereof.
+ *
+ * Author: Stephen F Bush - GE Global Research
+ *                      bushsf@research.ge.com
+ *                      http://www.amazon.com/author/stephenbush
+ */
+
+/* \details Monte Carlo ensembles of motors floating from a transmitter to a receiver
+ *
+ * <pre>
+ *   ensemble e, motor k  ->  stream (e, k, Ensemble)  ->  delay[k]
+ *   sorted delays        ->  mean, variance, quantiles, histogram, per packet samples
+ * </pre>
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+#include <gsl/gsl_statistics_double.h>
+
+#include "ns3/log.h"
+#include "ns3/uinteger.h"
+#include "ns3/system-thread.h"
+#include "ns3/p1906-mol-motor-delay-ensemble.h"
+#include "ns3/p1906-mol-motor-motion.h"
+#include "ns3/p1906-mol-motor-rng-streams.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("P1906MOL_MOTOR_DelayEnsemble");
+
+NS_OBJECT_ENSURE_REGISTERED (P1906MOL_MOTOR_DelayEnsemble);
+
+P1906MOL_MOTOR_DelayDistribution::P1906MOL_MOTOR_DelayDistribution ()
+  : m_mean (0),
+    m_variance (0)
+{
+}
+
+void P1906MOL_MOTOR_DelayDistribution::assign (const vector<double> & delays, size_t bins)
+{
+  m_delays = delays;
+  sort (m_delays.begin (), m_delays.end ());
+  m_mean = 0;
+  m_variance = 0;
+  m_binEdges.clear ();
+  m_binCounts.clear ();
+  
+  if (m_delays.empty ())
+    return;
+  
+  m_mean = gsl_stats_mean (&m_delays[0], 1, m_delays.size ());
+  if (m_delays.size () > 1)
+    m_variance = gsl_stats_variance_m (&m_delays[0], 1, m_delays.size (), m_mean);
+  
+  if (bins == 0)
+    return;
+  
+  //! all the delays are equal for a degenerate range: one bin holds them
+  double lo = m_delays.front ();
+  double hi = m_delays.back ();
+  if (hi <= lo)
+    bins = 1;
+  double width = (hi - lo) / bins;
+  
+  m_binCounts.assign (bins, 0);
+  for (size_t b = 0; b <= bins; b++)
+    m_binEdges.push_back (lo + b * width);
+  m_binEdges.back () = hi;
+  
+  for (size_t i = 0; i < m_delays.size (); i++)
+  {
+    size_t b = (width > 0) ? (size_t) ((m_delays[i] - lo) / width) : 0;
+    m_binCounts[min (b, bins - 1)]++;
+  }
+}
+
+size_t P1906MOL_MOTOR_DelayDistribution::size () const
+{
+  return m_delays.size ();
+}
+
+bool P1906MOL_MOTOR_DelayDistribution::empty () const
+{
+  return m_delays.empty ();
+}
+
+double P1906MOL_MOTOR_DelayDistribution::getMean () const
+{
+  return m_mean;
+}
+
+double P1906MOL_MOTOR_DelayDistribution::getVariance () const
+{
+  return m_variance;
+}
+
+double P1906MOL_MOTOR_DelayDistribution::getMin () const
+{
+  return m_delays.empty () ? 0 : m_delays.front ();
+}
+
+double P1906MOL_MOTOR_DelayDistribution::getMax () const
+{
+  return m_delays.empty () ? 0 : m_delays.back ();
+}
+
+double P1906MOL_MOTOR_DelayDistribution::getQuantile (double p) const
+{
+  if (m_delays.empty ())
+    return 0;
+  p = min (max (p, 0.0), 1.0);
+  return gsl_stats_quantile_from_sorted_data (&m_delays[0], 1, m_delays.size (), p);
+}
+
+double P1906MOL_MOTOR_DelayDistribution::getCdf (double delay) const
+{
+  if (m_delays.empty ())
+    return 0;
+  return (double) (upper_bound (m_delays.begin (), m_delays.end (), delay) - m_delays.begin ()) / m_delays.size ();
+}
+
+double P1906MOL_MOTOR_DelayDistribution::sample (double u) const
+{
+  if (m_delays.empty ())
+    return 0;
+  size_t k = (size_t) (u * m_delays.size ());
+  return m_delays[min (k, m_delays.size () - 1)];
+}
+
+const vector<double> & P1906MOL_MOTOR_DelayDistribution::getDelays () const
+{
+  return m_delays;
+}
+
+const vector<double> & P1906MOL_MOTOR_DelayDistribution::getBinEdges () const
+{
+  return m_binEdges;
+}
+
+const vector<size_t> & P1906MOL_MOTOR_DelayDistribution::getBinCounts () const
+{
+  return m_binCounts;
+}
+
+void P1906MOL_MOTOR_DelayDistribution::display () const
+{
+  printf ("(DelayDistribution) motors: %lu mean: %g variance: %g min: %g max: %g\n", 
+    (unsigned long) m_delays.size (), m_mean, m_variance, getMin (), getMax ());
+  printf ("(DelayDistribution) quantiles 0.1: %g 0.5: %g 0.9: %g 0.99: %g\n", 
+    getQuantile (0.1), getQuantile (0.5), getQuantile (0.9), getQuantile (0.99));
+  for (size_t b = 0; b < m_binCounts.size (); b++)
+    printf ("(DelayDistribution) [%g, %g) %lu\n", m_binEdges[b], m_binEdges[b + 1], (unsigned long) m_binCounts[b]);
+}
+
+TypeId P1906MOL_MOTOR_DelayEnsemble::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::P1906MOL_MOTOR_DelayEnsemble")
+    .SetParent<Object> ()
+    .AddConstructor<P1906MOL_MOTOR_DelayEnsemble> ()
+    .AddAttribute ("Motors",
+                   "Number of independent motors floated per ensemble",
+                   UintegerValue (100),
+                   MakeUintegerAccessor (&P1906MOL_MOTOR_DelayEnsemble::setMotors,
+                                         &P1906MOL_MOTOR_DelayEnsemble::getMotors),
+                   MakeUintegerChecker<uint32_t> (1))
+    .AddAttribute ("Threads",
+                   "Number of threads floating the motors of an ensemble (< 2 keeps the serial evaluation)",
+                   UintegerValue (0),
+                   MakeUintegerAccessor (&P1906MOL_MOTOR_DelayEnsemble::setThreads,
+                                         &P1906MOL_MOTOR_DelayEnsemble::getThreads),
+                   MakeUintegerChecker<uint32_t> ())
+    .AddAttribute ("HistogramBins",
+                   "Number of bins of the delay histogram",
+                   UintegerValue (20),
+                   MakeUintegerAccessor (&P1906MOL_MOTOR_DelayEnsemble::setHistogramBins,
+                                         &P1906MOL_MOTOR_DelayEnsemble::getHistogramBins),
+                   MakeUintegerChecker<uint32_t> ());
+  return tid;
+}
+
+P1906MOL_MOTOR_DelayEnsemble::P1906MOL_MOTOR_DelayEnsemble ()
+  : m_motors (100),
+    m_threads (0),
+    m_histogramBins (20),
+    m_motion (0),
+    m_ensemble (0),
+    m_nextMotor (0)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+P1906MOL_MOTOR_DelayEnsemble::~P1906MOL_MOTOR_DelayEnsemble ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+//! the motors are shared by Threads threads; the calling thread takes part as the last worker
+void P1906MOL_MOTOR_DelayEnsemble::run (P1906MOL_MOTOR_Motion * motion, const Vector & src, const Vector & dst, P1906MOL_MOTOR_DelayDistribution & result)
+{
+  m_motion = motion;
+  m_src = src;
+  m_dst = dst;
+  m_ensemble = P1906MOL_MOTOR_RngStreams::NextId (P1906MOL_MOTOR_RngStreams::Ensemble);
+  m_nextMotor = 0;
+  m_delays.assign (m_motors, 0);
+  
+  uint32_t numThreads = min (m_threads, m_motors);
+  vector<Ptr<SystemThread> > threads;
+  
+  NS_LOG_FUNCTION (this << m_ensemble << m_motors << numThreads);
+  for (uint32_t t = 1; t < numThreads; t++)
+  {
+    Ptr<SystemThread> thread = Create<SystemThread> (MakeCallback (&P1906MOL_MOTOR_DelayEnsemble::runMotors, this));
+    thread->Start ();
+    threads.push_back (thread);
+  }
+  runMotors ();
+  for (size_t t = 0; t < threads.size (); t++)
+    threads[t]->Join ();
+  
+  result.assign (m_delays, m_histogramBins);
+  m_delays.clear ();
+  m_motion = 0;
+}
+
+void P1906MOL_MOTOR_DelayEnsemble::runMotors (void)
+{
+  while (true)
+  {
+    uint32_t k;
+    {
+      CriticalSection cs (m_mutex);
+      if (m_nextMotor >= m_delays.size ())
+        return;
+      k = m_nextMotor++;
+    }
+    m_delays[k] = m_motion->floatDelay (m_src, m_dst, m_ensemble, k, P1906MOL_MOTOR_RngStreams::Ensemble);
+  }
+}
+
+const P1906MOL_MOTOR_DelayDistribution & P1906MOL_MOTOR_DelayEnsemble::getDistribution (P1906MOL_MOTOR_Motion * motion, const Vector & src, const Vector & dst)
+{
+  LinkKey key;
+  key.motion = motion;
+  key.diffusionCoefficient = motion->GetDiffusionConefficient ();
+  key.src = src;
+  key.dst = dst;
+  
+  map<LinkKey, P1906MOL_MOTOR_DelayDistribution>::iterator it = m_links.find (key);
+  if (it == m_links.end ())
+  {
+    it = m_links.insert (make_pair (key, P1906MOL_MOTOR_DelayDistribution ())).first;
+    run (motion, src, dst, it->second);
+  }
+  return it->second;
+}
+
+void P1906MOL_MOTOR_DelayEnsemble::clear ()
+{
+  NS_LOG_FUNCTION (this);
+  m_links.clear ();
+}
+
+void P1906MOL_MOTOR_DelayEnsemble::setMotors (uint32_t motors)
+{
+  m_motors = motors;
+  m_links.clear ();
+}
+
+uint32_t P1906MOL_MOTOR_DelayEnsemble::getMotors ()
+{
+  return m_motors;
+}
+
+void P1906MOL_MOTOR_DelayEnsemble::setThreads (uint32_t threads)
+{
+  m_threads = threads;
+}
+
+uint32_t P1906MOL_MOTOR_DelayEnsemble::getThreads ()
+{
+  return m_threads;
+}
+
+void P1906MOL_MOTOR_DelayEnsemble::setHistogramBins (uint32_t bins)
+{
+  m_histogramBins = bins;
+  m_links.clear ();
+}
+
+uint32_t P1906MOL_MOTOR_DelayEnsemble::getHistogramBins ()
+{
+  return m_histogramBins;
+}
+
+bool P1906MOL_MOTOR_DelayEnsemble::LinkKey::operator< (const LinkKey & o) const
+{
+  if (motion != o.motion)
+    return motion < o.motion;
+  if (diffusionCoefficient != o.diffusionCoefficient)
+    return diffusionCoefficient < o.diffusionCoefficient;
+  if (src.x != o.src.x)
+    return src.x < o.src.x;
+  if (src.y != o.src.y)
+    return src.y < o.src.y;
+  if (src.z != o.src.z)
+    return src.z < o.src.z;
+  if (dst.x != o.dst.x)
+    return dst.x < o.dst.x;
+  if (dst.y != o.dst.y)
+    return dst.y < o.dst.y;
+  return dst.z < o.dst.z;
+}
+
+} // namespace ns3
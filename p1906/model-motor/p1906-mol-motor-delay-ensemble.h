@@ -0,0 +1,163 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *  Copyright � 2015 by IEEE.
+ *
+ *  This source file is an essential part of IEEE Std 1906.1,
+ *  Recommended Practice for Nanoscale and Molecular
+ *  Communication Framework.
+ *  Verbatim copies of this source file may be used and
+ *  distributed without restriction. Modifications to this source
+ *  file as permitted in IEEE Std 1906.1 may also be made and
+ *  distributed. All other uses require permission from the IEEE
+ *  Standards Department (stds-ipr@ieee.org). All other rights
+ *  reserved.
+ *
+ *  This source file is provided on an AS IS basis.
+ *  The IEEE disclaims ANY WARRANTY EXPRESS OR IMPLIED INCLUDING
+ *  ANY WARRANTY OF MERCHANTABILITY AND FITNESS FOR USE FOR A
+ *  PARTICULAR PURPOSE.
+ *  The user of the source file shall indemnify and hold
+ *  IEEE harmless from any damages or liability arising out of
+ *  the use thereof.
+ *
+ * Author: Stephen F Bush - GE Global Research
+ *                      bushsf@research.ge.com
+ *                      http://www.amazon.com/author/stephenbush
+ */
+
+#ifndef P1906_MOL_MOTOR_DELAY_ENSEMBLE
+#define P1906_MOL_MOTOR_DELAY_ENSEMBLE
+
+#include <stdint.h>
+#include <map>
+#include <vector>
+using namespace std;
+
+#include "ns3/object.h"
+#include "ns3/ptr.h"
+#include "ns3/vector.h"
+#include "ns3/system-mutex.h"
+
+namespace ns3 {
+
+class P1906MOL_MOTOR_Motion;
+
+/**
+ * \ingroup IEEE P1906 framework
+ *
+ * \class P1906MOL_MOTOR_DelayDistribution
+ *
+ * \brief The empirical distribution of the propagation delays of an ensemble of motors
+ */
+class P1906MOL_MOTOR_DelayDistribution
+{
+public:
+  P1906MOL_MOTOR_DelayDistribution ();
+  
+  //! take the delays, in any order, and compute the statistics and a histogram of bins bins over [min, max]
+  void assign (const vector<double> & delays, size_t bins);
+  //! number of delays
+  size_t size () const;
+  bool empty () const;
+  
+  double getMean () const;
+  //! sample variance (0 for fewer than two delays)
+  double getVariance () const;
+  double getMin () const;
+  double getMax () const;
+  //! the p quantile, 0 <= p <= 1, interpolated between the sorted delays
+  double getQuantile (double p) const;
+  //! fraction of the motors that arrived within delay
+  double getCdf (double delay) const;
+  //! one of the delays, chosen by the uniform variate u in [0, 1); use it to draw a delay per packet
+  double sample (double u) const;
+  
+  //! the delays in increasing order
+  const vector<double> & getDelays () const;
+  //! bin b counts the delays in [edges[b], edges[b + 1]); the last bin also holds the maximum
+  const vector<double> & getBinEdges () const;
+  const vector<size_t> & getBinCounts () const;
+  //! print the statistics and the histogram
+  void display () const;
+  
+private:
+  vector<double> m_delays;
+  double m_mean;
+  double m_variance;
+  vector<double> m_binEdges;
+  vector<size_t> m_binCounts;
+};
+
+/**
+ * \ingroup IEEE P1906 framework
+ *
+ * \class P1906MOL_MOTOR_DelayEnsemble
+ *
+ * \brief Monte Carlo estimate of the first passage time of free-floating motors from a transmitter to a receiver
+ *
+ * A single packet yields one delay sample; the channel capacity depends on the
+ * whole distribution. run () floats Motors independent motors with the walk of
+ * P1906MOL_MOTOR_Motion::ComputePropagationDelayConcurrent and collects their
+ * delays. Motor k of an ensemble draws from its own P1906MOL_MOTOR_RngStreams
+ * stream (ensemble, k), so the distribution does not depend on Threads.
+ *
+ * Given to P1906MOL_MOTOR_Motion::setDelayEnsemble, the ensemble is run once
+ * per link and every packet then draws its delay from the distribution
+ * instead of simulating a trajectory.
+ */
+class P1906MOL_MOTOR_DelayEnsemble : public Object
+{
+public:
+  static TypeId GetTypeId (void);
+  
+  P1906MOL_MOTOR_DelayEnsemble ();
+  virtual ~P1906MOL_MOTOR_DelayEnsemble ();
+  
+  //! float the motors of a new ensemble from src to dst (positions in m, as given by the MobilityModel) and put their delays in result
+  void run (P1906MOL_MOTOR_Motion * motion, const Vector & src, const Vector & dst, P1906MOL_MOTOR_DelayDistribution & result);
+  //! as run (), but each (motion, diffusion coefficient, src, dst) link is only run the first time it is asked for
+  const P1906MOL_MOTOR_DelayDistribution & getDistribution (P1906MOL_MOTOR_Motion * motion, const Vector & src, const Vector & dst);
+  //! forget the distributions kept by getDistribution ()
+  void clear ();
+  
+  //! number of motors per ensemble
+  void setMotors (uint32_t motors);
+  uint32_t getMotors ();
+  //! number of threads floating the motors (< 2 keeps them on the calling thread)
+  void setThreads (uint32_t threads);
+  uint32_t getThreads ();
+  //! number of histogram bins
+  void setHistogramBins (uint32_t bins);
+  uint32_t getHistogramBins ();
+  
+private:
+  struct LinkKey
+  {
+    P1906MOL_MOTOR_Motion * motion;
+    double diffusionCoefficient;
+    Vector src;
+    Vector dst;
+    bool operator< (const LinkKey & o) const;
+  };
+  
+  //! take motors until none is left; no logging here, this may run outside the simulator thread
+  void runMotors (void);
+  
+  uint32_t m_motors;
+  uint32_t m_threads;
+  uint32_t m_histogramBins;
+  map<LinkKey, P1906MOL_MOTOR_DelayDistribution> m_links;
+  
+  //! the ensemble being run
+  P1906MOL_MOTOR_Motion * m_motion;
+  Vector m_src;
+  Vector m_dst;
+  uint32_t m_ensemble;
+  uint32_t m_nextMotor;
+  vector<double> m_delays;
+  SystemMutex m_mutex;
+};
+
+}
+
+#endif /* P1906_MOL_MOTOR_DELAY_ENSEMBLE */
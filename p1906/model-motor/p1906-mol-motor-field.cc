@@ -51,6 +51,11 @@
 #include "ns3/object.h"
 #include "ns3/nstime.h"
 #include "ns3/ptr.h"
+#include "ns3/uinteger.h"
+#include "ns3/system-mutex.h"
+#include "ns3/system-thread.h"
+
+#include <algorithm>
 
 #include "ns3/p1906-mol-motor.h"
 #include "ns3/p1906-mol-field.h"
@@ -65,11 +70,20 @@ NS_LOG_COMPONENT_DEFINE ("P1906MOL_MOTOR_Field");
 TypeId P1906MOL_MOTOR_Field::GetTypeId (void)
 {
   static TypeId tid = TypeId ("ns3::P1906MOL_MOTOR_Field")
-    .SetParent<P1906MOLField> ();
+    .SetParent<P1906MOLField> ()
+    .AddAttribute ("OverlapThreads",
+                   "Number of threads sharing the segment pairs of getAllOverlaps3D (< 2 keeps the serial evaluation)",
+                   UintegerValue (0),
+                   MakeUintegerAccessor (&P1906MOL_MOTOR_Field::setOverlapThreads,
+                                         &P1906MOL_MOTOR_Field::getOverlapThreads),
+                   MakeUintegerChecker<uint32_t> ());
   return tid;
 }
 
+const double P1906MOL_MOTOR_Field::overlapTolerance = 1e-6;
+
 P1906MOL_MOTOR_Field::P1906MOL_MOTOR_Field ()
+  : m_overlapThreads (0)
 {
   /** This class implements persistence length as described in:
 	  Bush, S. F., & Goel, S. (2013). Persistence Length as a Metric for Modeling and 
@@ -167,15 +181,24 @@ void P1906MOL_MOTOR_Field::line(gsl_matrix * line, size_t mp, gsl_vector * pt1,
 //! set the segment with the given end points
 void P1906MOL_MOTOR_Field::line(gsl_vector * line, P1906MOL_MOTOR_Pos p1, P1906MOL_MOTOR_Pos p2)
 {
-  gsl_vector * p = gsl_vector_alloc (3);
+  P1906MOL_MOTOR_Vec3 a = p1.getVec3 ();
+  P1906MOL_MOTOR_Vec3 b = p2.getVec3 ();
+  
+  gsl_vector_set (line, 0, a.x);
+  gsl_vector_set (line, 1, a.y);
+  gsl_vector_set (line, 2, a.z);
+  gsl_vector_set (line, 3, b.x);
+  gsl_vector_set (line, 4, b.y);
+  gsl_vector_set (line, 5, b.z);
+}
+
+//! retrieve the end points of segment mp from tubeMatrix without allocating a gsl_vector
+void P1906MOL_MOTOR_Field::line(gsl_matrix * tubeMatrix, size_t mp, P1906MOL_MOTOR_Vec3 & p1, P1906MOL_MOTOR_Vec3 & p2)
+{
+  const double * row = gsl_matrix_const_ptr (tubeMatrix, mp, 0);
   
-  p1.getPos (p);
-  for (size_t i = 0; i < 3; i++)
-    gsl_vector_set (line, i, gsl_vector_get (p, i));
-	
-  p2.getPos (p);
-  for (size_t i = 3; i < 6; i++)
-    gsl_vector_set (line, i, gsl_vector_get (p, i - 3));
+  p1 = vec3 (row[0], row[1], row[2]);
+  p2 = vec3 (row[3], row[4], row[5]);
 }
 
 //! display the segment
@@ -314,95 +337,80 @@ void P1906MOL_MOTOR_Field::tubes2VectorField(gsl_matrix * tubeMatrix, gsl_matrix
 
 //! return the index of the nearest tube in tubeMatrix within a given radius from pt, otherwise return -1 
 size_t P1906MOL_MOTOR_Field::findNearestTube(gsl_vector * pt, gsl_matrix * tubeMatrix, double radius)
+{
+  return findNearestTube (vec3 (gsl_vector_get (pt, 0), gsl_vector_get (pt, 1), gsl_vector_get (pt, 2)), tubeMatrix, radius);
+}
+
+//! return the index of the nearest tube in tubeMatrix within a given radius from pt, otherwise return -1 
+//! the distance is measured to the segment itself, not to the infinite line through it, so that a point
+//! beyond the end of a segment does not bind to it; this is also what makes the segment index exact
+//! this fallback runs at every step of a motor when there is no index: it reads the rows in place and
+//! allocates nothing, copying them into the arrays of the batched kernel would cost more than it saves
+size_t P1906MOL_MOTOR_Field::findNearestTube(const P1906MOL_MOTOR_Vec3 & pt, gsl_matrix * tubeMatrix, double radius)
 {
   double shortestDistance = GSL_POSINF;
-  double d = 0;
   size_t closestSegment = -1;
-  gsl_vector *segment = gsl_vector_alloc (6);
+  P1906MOL_MOTOR_Vec3 p1, p2;
   
   for (size_t i = 0; i < tubeMatrix->size1; i++)
   {
-    line(segment, tubeMatrix, i);
-	d = distance(pt, segment);
-	if ((d < shortestDistance) && (d <= radius))
-	{
-	  shortestDistance = d;
-	  closestSegment = i;
-	}
+    line(tubeMatrix, i, p1, p2);
+    //! the same operations as the kernel of the segment index, so both pick the same segment
+    double d2 = vec3SegmentDistance2 (pt, p1, p2);
+    if ((d2 < shortestDistance) && (d2 <= radius * radius))
+    {
+      shortestDistance = d2;
+      closestSegment = i;
+    }
   }
   
   // printf ("shortestDistance: %f\n", shortestDistance);
   return closestSegment;
 }
 
+//! same result as the linear scan above, but only the segments binned near pt are tested
+size_t P1906MOL_MOTOR_Field::findNearestTube(const P1906MOL_MOTOR_Vec3 & pt, const P1906MOL_MOTOR_SegmentIndex & index, double radius)
+{
+  return index.nearestSegment (pt, radius);
+}
+
 //! return the shortest distance between point pt and the line or point segment_or_point
 //! if segment_or_point is a vector of length 3, then it is a point
 //! if segment_or_point is a vector of length 6, then it is a line segment described by two end points
 double P1906MOL_MOTOR_Field::distance(gsl_vector *pt, gsl_vector *segment_or_point)
 {
-  gsl_vector * td = gsl_vector_alloc (3);
-  gsl_vector * segment = gsl_vector_alloc (6);
-  gsl_vector * pt1 = gsl_vector_alloc (3);
-  gsl_vector * pt2 = gsl_vector_alloc (3);
-  gsl_vector * res = gsl_vector_alloc (3);
-  gsl_vector * res1 = gsl_vector_alloc (3);
-  gsl_vector * res2 = gsl_vector_alloc (3);
-  double d;
-	  
+  P1906MOL_MOTOR_Vec3 p = vec3 (gsl_vector_get (pt, 0), gsl_vector_get (pt, 1), gsl_vector_get (pt, 2));
+  
   switch (segment_or_point->size)
   {
     case 3:
-      gsl_vector_memcpy (pt1, pt);
-      gsl_vector_memcpy (pt2, segment_or_point);
-      gsl_vector_memcpy (td, pt1);
-      gsl_vector_sub (td, pt2);
-      return gsl_blas_dnrm2 (td);
+      return vec3Norm (p - vec3 (gsl_vector_get (segment_or_point, 0),
+                                 gsl_vector_get (segment_or_point, 1),
+                                 gsl_vector_get (segment_or_point, 2)));
     case 6:
-   	  gsl_vector_memcpy (segment, segment_or_point);
-	  
-      //! distance = |pt - pt1| x |pt - pt2| / |pt2 - pt1| where x is the cross product
-      //! \f$|\vec{pt} - \vec{pt1}| \times |\vec{pt} - \vec{pt2}| / |\vec{pt2} - \vec{pt1}|\f$
-      point (pt1,
-        gsl_vector_get (segment, 0),
-	    gsl_vector_get (segment, 1),
-	    gsl_vector_get (segment, 2));
-      point (pt2,
-        gsl_vector_get (segment, 3),
-	    gsl_vector_get (segment, 4),
-	    gsl_vector_get (segment, 5));
-	
-      gsl_vector_memcpy (res1, pt);
-      gsl_vector_sub (res1, pt1);
-  
-      // printf ("res1\n");
-      // displayPoint (res1);
-  
-      gsl_vector_memcpy (res2, pt);
-      gsl_vector_sub (res2, pt2);
-  
-      // printf ("res2\n");
-      // displayPoint (res2);
-  
-      cross_product (res1, res2, res);
-      // printf ("res\n");
-      // displayPoint (res);
-  
-      gsl_vector_memcpy (res1, pt2);
-      gsl_vector_sub (res1, pt1);
-      // printf ("res1\n");
-      // displayPoint (res1);
-  
-      d = gsl_blas_dasum (res) / gsl_blas_dasum (res1);
-      // printf ("distance: %g\n", d);
-  
-      return d;
-      /* gsl_blas_sdsdot (0, x, y, result); */
+      return distance (p,
+        vec3 (gsl_vector_get (segment_or_point, 0),
+              gsl_vector_get (segment_or_point, 1),
+              gsl_vector_get (segment_or_point, 2)),
+        vec3 (gsl_vector_get (segment_or_point, 3),
+              gsl_vector_get (segment_or_point, 4),
+              gsl_vector_get (segment_or_point, 5)));
     default:
       printf ("(distance) invalid argument to distance\n");
 	  return -1;
   }
 }
 
+//! return the shortest distance between point pt and the line segment with end points pt1 and pt2
+double P1906MOL_MOTOR_Field::distance(const P1906MOL_MOTOR_Vec3 & pt, const P1906MOL_MOTOR_Vec3 & pt1, const P1906MOL_MOTOR_Vec3 & pt2)
+{
+  //! distance = |pt - pt1| x |pt - pt2| / |pt2 - pt1| where x is the cross product
+  //! \f$|\vec{pt} - \vec{pt1}| \times |\vec{pt} - \vec{pt2}| / |\vec{pt2} - \vec{pt1}|\f$
+  P1906MOL_MOTOR_Vec3 res = vec3Cross (pt - pt1, pt - pt2);
+  
+  return vec3Asum (res) / vec3Asum (pt2 - pt1);
+}
+
 //! the vector cross product is normal to the input vectors and has magnitude equivalent to the 
 //! volume of a parallelogram formed by the input vectors, u and v are the input vectors and 
 //! product is the output vector
@@ -460,35 +468,153 @@ bool P1906MOL_MOTOR_Field::unitTest_getOverlap()
 }
 
 //! return all overlapping points in tubeMatrix in the list of points pts
+//! each pair of overlapping segments contributes one point, the midpoint of their closest approach
 void P1906MOL_MOTOR_Field::getAllOverlaps3D(gsl_matrix *tubeMatrix, vector<P1906MOL_MOTOR_Pos> & pts)
+{
+  vector<P1906MOL_MOTOR_Overlap> overlaps;
+  
+  getAllOverlaps3D(tubeMatrix, overlapTolerance, overlaps);
+  
+  //! store overlapping points
+  for (size_t k = 0; k < overlaps.size(); k++)
+  {
+    P1906MOL_MOTOR_Pos Pos;
+    Pos.setPos (overlaps[k].pt);
+    pts.insert(pts.end(), Pos);
+  }
+}
+
+/**
+ * The segment pairs of getAllOverlaps3D, shared between threads in chunks of consecutive segments.
+ * Chunk c holds the overlaps of its segments with every later segment; the chunks are
+ * concatenated in order afterwards, so the result does not depend on the number of threads.
+ */
+class P1906MOL_MOTOR_OverlapSweep
+{
+public:
+  P1906MOL_MOTOR_OverlapSweep (const P1906MOL_MOTOR_SegmentIndex & index, double tolerance)
+    : m_index (index),
+      m_tolerance (tolerance),
+      m_nextChunk (0),
+      m_results ((index.size () + chunkSize - 1) / chunkSize)
+  {
+  }
+  
+  //! take chunks until none is left; no logging here, this may run outside the simulator thread
+  void Run (void)
+  {
+    vector<size_t> candidates;
+    P1906MOL_MOTOR_Vec3 c1, c2;
+    
+    while (true)
+    {
+      size_t c;
+      {
+        CriticalSection cs (m_mutex);
+        if (m_nextChunk >= m_results.size ())
+          return;
+        c = m_nextChunk++;
+      }
+      
+      vector<P1906MOL_MOTOR_Overlap> & out = m_results[c];
+      size_t last = min (m_index.size (), (c + 1) * chunkSize);
+      for (size_t i = c * chunkSize; i < last; i++)
+      {
+        const P1906MOL_MOTOR_Vec3 & p1 = m_index.getStart (i);
+        const P1906MOL_MOTOR_Vec3 & q1 = m_index.getEnd (i);
+        P1906MOL_MOTOR_Vec3 lo = vec3 (min (p1.x, q1.x), min (p1.y, q1.y), min (p1.z, q1.z));
+        P1906MOL_MOTOR_Vec3 hi = vec3 (max (p1.x, q1.x), max (p1.y, q1.y), max (p1.z, q1.z));
+        
+        //! broad phase: the segments sharing a grid cell with the box of i grown by the tolerance
+        candidates.clear ();
+        m_index.candidates (lo - vec3 (m_tolerance, m_tolerance, m_tolerance), hi + vec3 (m_tolerance, m_tolerance, m_tolerance), candidates);
+        sort (candidates.begin (), candidates.end ());
+        candidates.erase (unique (candidates.begin (), candidates.end ()), candidates.end ());
+        
+        //! narrow phase: closed form closest approach, each pair is tested once from its lower segment
+        for (vector<size_t>::const_iterator it = upper_bound (candidates.begin (), candidates.end (), i); it != candidates.end (); it++)
+        {
+          double d = vec3SegmentSegmentClosest (p1, q1, m_index.getStart (*it), m_index.getEnd (*it), c1, c2);
+          if (d <= m_tolerance)
+          {
+            P1906MOL_MOTOR_Overlap o;
+            o.segment1 = i;
+            o.segment2 = *it;
+            o.pt = (c1 + c2) * 0.5;
+            o.distance = d;
+            out.push_back (o);
+          }
+        }
+      }
+    }
+  }
+  
+  //! segments per chunk
+  static const size_t chunkSize = 256;
+  
+  const P1906MOL_MOTOR_SegmentIndex & m_index;
+  double m_tolerance;
+  size_t m_nextChunk;
+  vector<vector<P1906MOL_MOTOR_Overlap> > m_results;
+  SystemMutex m_mutex;
+};
+
+//! the segments are binned in a grid whose cells are about one segment long, so each segment is
+//! only tested against its neighbours; the pairs are shared by OverlapThreads threads
+size_t P1906MOL_MOTOR_Field::getAllOverlaps3D(gsl_matrix * tubeMatrix, double tolerance, vector<P1906MOL_MOTOR_Overlap> & overlaps)
 {
   size_t numSegments = tubeMatrix->size1;
-  gsl_vector *segment = gsl_vector_alloc (6);
-  gsl_matrix *tmpPts = gsl_matrix_alloc (numSegments * numSegments, 3);
-  size_t numPts = 0; // totPts = 0;
-  //size_t pp = 0;
-  gsl_vector *tubeSegments = gsl_vector_alloc (numSegments * numSegments);
+  size_t numOverlaps = overlaps.size();
+  double meanLength = 0;
+  P1906MOL_MOTOR_Vec3 p1, p2;
+  
+  if (numSegments == 0)
+    return 0;
   
   for (size_t i = 0; i < numSegments; i++)
   {
-    //! move segment from tubes to segment
-	for (size_t k = 0; k < 6; k++)
-	  gsl_vector_set (segment, k, gsl_matrix_get (tubeMatrix, i, k));
-	//! check for overlap
-    numPts = getOverlap3D(segment, tubeMatrix, tmpPts, tubeSegments);
-	//! store overlapping points
-	for (size_t k = 0; k < numPts; k++)
-	{
-	  P1906MOL_MOTOR_Pos Pos;
-	  Pos.setPos ( gsl_matrix_get (tmpPts, k, 0),
-	               gsl_matrix_get (tmpPts, k, 1),
-	               gsl_matrix_get (tmpPts, k, 2) );
-	  pts.insert(pts.end(), Pos);
-	}
+    line(tubeMatrix, i, p1, p2);
+    meanLength += vec3Norm(p2 - p1) / numSegments;
   }
+  
+  P1906MOL_MOTOR_SegmentIndex index;
+  index.build(tubeMatrix, meanLength + tolerance);
+  
+  P1906MOL_MOTOR_OverlapSweep sweep(index, tolerance);
+  uint32_t numThreads = (uint32_t) min ((size_t) m_overlapThreads, sweep.m_results.size());
+  vector<Ptr<SystemThread> > threads;
+  
+  NS_LOG_FUNCTION (this << numSegments << tolerance << numThreads);
+  //! the calling thread takes part as the last worker
+  for (uint32_t t = 1; t < numThreads; t++)
+  {
+    Ptr<SystemThread> thread = Create<SystemThread> (MakeCallback (&P1906MOL_MOTOR_OverlapSweep::Run, &sweep));
+    thread->Start ();
+    threads.push_back (thread);
+  }
+  sweep.Run ();
+  for (size_t t = 0; t < threads.size (); t++)
+    threads[t]->Join ();
+  
+  //! stream the chunks into the output buffer in segment order
+  for (size_t c = 0; c < sweep.m_results.size(); c++)
+    overlaps.insert(overlaps.end(), sweep.m_results[c].begin(), sweep.m_results[c].end());
+  
+  return overlaps.size() - numOverlaps;
+}
+
+void P1906MOL_MOTOR_Field::setOverlapThreads(uint32_t threads)
+{
+  m_overlapThreads = threads;
+}
+
+uint32_t P1906MOL_MOTOR_Field::getOverlapThreads()
+{
+  return m_overlapThreads;
 }
 
 //! return the number of overlapping points in pts and the index of the tubeMatrix segments overlapped in tubeSegments
+//! the overlaps that do not fit are counted but not stored, so a return value above the capacity tells the caller to grow the output
 int P1906MOL_MOTOR_Field::getOverlap3D(gsl_vector * segment, gsl_matrix * tubeMatrix, gsl_matrix * pts, gsl_vector * tubeSegments)
 {
   /** 
@@ -496,116 +622,43 @@ int P1906MOL_MOTOR_Field::getOverlap3D(gsl_vector * segment, gsl_matrix * tubeMa
 	line A -> B: (a1, a2, a3) -> (b1, b2, b3)
 	line C -> D: (c1, c2, c3) -> (d1, d2, d3)
   
-    solve: 
-    a1 + t * (b1 - a1) == c1 + s * (d1 - c1)
-	a2 + t * (b2 - a2) == c2 + s * (d2 - c2)
-	a3 + t * (b3 - a3) == c3 + s * (d3 - c3)
-
-    A x =  b where x(0) = t and x(1) = s
-	(b1 - a1) * t - (d1 - c1) * s == c1 - a1
-	(b2 - a2) * t - (d2 - c2) * s == c2 - a2
-	(b3 - a3) * t - (d3 - c3) * s == c3 - a3
+    the closest points of the segments are
+	A + t * (B - A) and C + s * (D - C) with 0 <= t, s <= 1
+	
+	minimizing |A + t * (B - A) - C - s * (D - C)|^2 is a 2 x 2 linear system in closed form,
+	solved by vec3SegmentSegmentClosest without any allocation; the segments overlap when 
+	the closest points are within overlapTolerance and the overlapping point is their midpoint
   */
   //! total number of segments in tubeMatrix
   size_t numSegments = tubeMatrix->size1;
-  //! first end point of segment under test
-  double a1 = gsl_vector_get (segment, 0), a2 = gsl_vector_get (segment, 1), a3 = gsl_vector_get (segment, 2);
-  //! second end point of segment under test
-  double b1 = gsl_vector_get (segment, 3), b2 = gsl_vector_get (segment, 4), b3 = gsl_vector_get (segment, 5);
-  //! first end point of tubeMatrix segment 
-  double c1, c2, c3;
-  //! second end point of tubeMatrix segment
-  double d1, d2, d3;
-  
-  gsl_matrix * A = gsl_matrix_alloc (3, 2);
-  gsl_matrix * V = gsl_matrix_alloc (2, 2);
-  gsl_vector * b = gsl_vector_alloc (3);
-  gsl_vector * x = gsl_vector_alloc (2);
-  gsl_vector * S = gsl_vector_alloc (2);
-  gsl_vector * work = gsl_vector_alloc (2);
-  gsl_vector * pt = gsl_vector_alloc (3);
+  //! end points of segment under test
+  P1906MOL_MOTOR_Vec3 a = vec3 (gsl_vector_get (segment, 0), gsl_vector_get (segment, 1), gsl_vector_get (segment, 2));
+  P1906MOL_MOTOR_Vec3 b = vec3 (gsl_vector_get (segment, 3), gsl_vector_get (segment, 4), gsl_vector_get (segment, 5));
+  //! end points of tubeMatrix segment 
+  P1906MOL_MOTOR_Vec3 c, d;
+  //! closest points on each segment
+  P1906MOL_MOTOR_Vec3 cab, ccd;
   size_t numPts = 0;
-  size_t ts = 0;
+  //! number of overlaps the outputs can hold
+  size_t capacity = min (pts->size1, tubeSegments->size);
   
   for(size_t i = 0; i < numSegments; i++)
   {
-    c1 = gsl_matrix_get (tubeMatrix, i, 0), c2 = gsl_matrix_get (tubeMatrix, i, 1), c3 = gsl_matrix_get (tubeMatrix, i, 2);
-    d1 = gsl_matrix_get (tubeMatrix, i, 3), d2 = gsl_matrix_get (tubeMatrix, i, 4), d3 = gsl_matrix_get (tubeMatrix, i, 5);
-    
-	// printf ("a1 = %g, a2 = %g, a3 = %g\n", a1, a2, a3);
-	// printf ("b1 = %g, b2 = %g, b3 = %g\n", b1, b2, b3);
-	// printf ("c1 = %g, c2 = %g, c3 = %g\n", c1, c2, c3);
-	// printf ("d1 = %g, d2 = %g, d3 = %g\n", d1, d2, d3);
-  
-    gsl_matrix_set(A, 0, 0, b1 - a1);
-    gsl_matrix_set(A, 0, 1, - (d1 - c1));
-    gsl_matrix_set(A, 1, 0, b2 - a2);
-    gsl_matrix_set(A, 1, 1, - (d2 - c2));
-	gsl_matrix_set(A, 2, 0, b3 - a3);
-    gsl_matrix_set(A, 2, 1, - (d3 - c3));
-    
-    gsl_vector_set(b, 0, c1 - a1);
-    gsl_vector_set(b, 1, c2 - a2);
-	gsl_vector_set(b, 2, c3 - a3);
-	
-	// printf ("A = %g %g\n    %g %g\n    %g %g\n", 
-	//  gsl_matrix_get(A, 0, 0), gsl_matrix_get(A, 0, 1), 
-	//  gsl_matrix_get(A, 1, 0), gsl_matrix_get(A, 1, 1),
-	//  gsl_matrix_get(A, 2, 0), gsl_matrix_get(A, 2, 1));
-	//printf ("b = %g\n    %g\n    %g\n", 
-	//  gsl_vector_get(b, 0), 
-	//  gsl_vector_get(b, 1),
-	//  gsl_vector_get(b, 2));
-  
-    //! solve A x = b
-    //! A is M x N, work is tmp storage of length N, A is replaced with U, V is N x N, S is M x N
-    gsl_linalg_SV_decomp (A, V, S, work);
-    gsl_linalg_SV_solve (A, V, S, b, x);
-
-    // printf ("x = \n");
-    // gsl_vector_fprintf(stdout, x, "%g");
-	
-	//! if x(0) = t, x(1) = s exist, then substitute and solve for overlapping point
-	
-	gsl_vector_set (pt, 0, a1 + gsl_vector_get(x, 0) * (b1 - a1));
-	gsl_vector_set (pt, 1, a2 + gsl_vector_get(x, 0) * (b2 - a2));
-	gsl_vector_set (pt, 2, a3 + gsl_vector_get(x, 0) * (b3 - a3));
+    line(tubeMatrix, i, c, d);
     
-	// printf ("pt = \n");
-    // gsl_vector_fprintf(stdout, pt, "%g");
-	
-    if(!gsl_isnan (gsl_vector_get(x, 0)) && !gsl_isnan (gsl_vector_get(x, 1)))
-	  //! the segments only overlap if their lengths are long enough to do so
-	  if(
-	    //! A <= x <= B and C <= x <= D
-	    min(a1, b1) <= gsl_vector_get(pt, 0) && 
-		min(a2, b2) <= gsl_vector_get(pt, 1) && 
-		min(a3, b3) <= gsl_vector_get(pt, 2) && 
-		
-		max(a1, b1) >= gsl_vector_get(pt, 0) && 
-		max(a2, b2) >= gsl_vector_get(pt, 1) && 
-		max(a3, b3) >= gsl_vector_get(pt, 2) && 
-		
-		min(c1, d1) <= gsl_vector_get(pt, 0) && 
-		min(c2, d2) <= gsl_vector_get(pt, 1) && 
-		min(c3, d3) <= gsl_vector_get(pt, 2) && 
-		
-		max(c1, d1) >= gsl_vector_get(pt, 0) && 
-		max(c2, d2) >= gsl_vector_get(pt, 1) && 
-		max(c3, d3) >= gsl_vector_get(pt, 2)
-	  )
-	  {
-	    gsl_matrix_set(pts, numPts, 0, gsl_vector_get(pt, 0));
-	    gsl_matrix_set(pts, numPts, 1, gsl_vector_get(pt, 1));
-		gsl_matrix_set(pts, numPts, 2, gsl_vector_get(pt, 2));
-	    // printf ("numPts(%ld) = %g %g %g\n", numPts, 
-		//  gsl_matrix_get(pts, numPts, 0), 
-		//  gsl_matrix_get(pts, numPts, 1),
-		//  gsl_matrix_get(pts, numPts, 2));
-		gsl_vector_set (tubeSegments, ts++, i);
-	    numPts++;
-	  }
-	}
+    if (vec3SegmentSegmentClosest (a, b, c, d, cab, ccd) <= overlapTolerance)
+    {
+      if (numPts < capacity)
+      {
+        P1906MOL_MOTOR_Vec3 pt = (cab + ccd) * 0.5;
+        gsl_matrix_set(pts, numPts, 0, pt.x);
+        gsl_matrix_set(pts, numPts, 1, pt.y);
+        gsl_matrix_set(pts, numPts, 2, pt.z);
+        gsl_vector_set (tubeSegments, numPts, i);
+      }
+      numPts++;
+    }
+  }
   
   return numPts;
 }
@@ -693,17 +746,37 @@ void P1906MOL_MOTOR_Field::findClosestPoint(gsl_vector * pt, gsl_matrix * vf, gs
   //	gsl_vector_get (result, 5));
 }
 
+//! return the location of the vector from vf that is closest to the point pt and put it in result, 
+//! searching the grid of index outward from pt instead of scanning all of vf
+void P1906MOL_MOTOR_Field::findClosestPoint(gsl_vector * pt, gsl_matrix * vf, const P1906MOL_MOTOR_SegmentIndex & index, gsl_vector * result)
+{
+  size_t i = index.nearestStart (vec3 (gsl_vector_get (pt, 0), gsl_vector_get (pt, 1), gsl_vector_get (pt, 2)));
+  
+  //! an index that does not describe vf cannot be trusted
+  if (index.size () != vf->size1 || i == (size_t) -1)
+  {
+    findClosestPoint (pt, vf, result);
+    return;
+  }
+  
+  for (size_t j = 0; j < 6; j++)
+    gsl_vector_set (result, j, gsl_matrix_get (vf, i, j));
+}
+
 //! return the information entropy \f$ H(x) = - sum( P(x) \log P(x) ) \f$ of a tube segment defined by its list of angles in segAngle
-double P1906MOL_MOTOR_Field::sEntropy(gsl_matrix *segAngle)
+double P1906MOL_MOTOR_Field::sEntropy(gsl_matrix *segAngle, size_t bins)
 {
   //! bin the values in order to find P(x)
   //! see gsl_histogram_pdf * gsl_histogram_pdf_alloc (size_t n)
   //! see https://www.gnu.org/software/gsl/manual/html_node/The-histogram-probability-distribution-struct.html
   
-  gsl_histogram * h = gsl_histogram_alloc (100); /* need to determine optimal number of bins */
   //! get the max segAngle
   double minAngle = gsl_matrix_min(segAngle);
   double maxAngle = gsl_matrix_max(segAngle);
+  //! all angles equal (or a single one): a single state, no entropy; gsl cannot bin an empty range
+  if (!(maxAngle > minAngle) || bins == 0)
+    return 0;
+  gsl_histogram * h = gsl_histogram_alloc (bins); /* need to determine optimal number of bins */
   gsl_histogram_set_ranges_uniform (h, minAngle, maxAngle);
 
   for (size_t i = 0; i < segAngle->size1; i++)
@@ -713,11 +786,13 @@ double P1906MOL_MOTOR_Field::sEntropy(gsl_matrix *segAngle)
 	  gsl_histogram_increment (h, gsl_matrix_get (segAngle, i, j));
     }
 
+  //! the total does not change while the bins are read: sum once, not once per bin
   double H = 0;
+  double total = gsl_histogram_sum (h);
   int numBins = gsl_histogram_bins (h);
   for(int i = 0; i < numBins; i++)
   {
-	double p = gsl_histogram_get (h, i) / gsl_histogram_sum(h);
+	double p = gsl_histogram_get (h, i) / total;
 	//! printf("p = %g\n", p);
 	if (p > 0)
 	{
@@ -728,7 +803,7 @@ double P1906MOL_MOTOR_Field::sEntropy(gsl_matrix *segAngle)
 	
   // printf("H = %g\n", H);
   //! gsl_histogram_fprintf (stdout, h, "%g", "%g");
-  //gsl_histogram_free (h);
+  gsl_histogram_free (h);
   
   return H;
 }
@@ -47,9 +47,25 @@ using namespace std;
 #include "ns3/ptr.h"
 #include "ns3/p1906-mol-field.h"
 #include "ns3/p1906-mol-motor-pos.h"
+#include "ns3/p1906-mol-motor-vec3.h"
+#include "ns3/p1906-mol-motor-segment-index.h"
 
 namespace ns3 {
 
+/**
+ * \brief A place where two segments of a tube network come within the overlap tolerance of each other
+ */
+struct P1906MOL_MOTOR_Overlap
+{
+  //! the rows of tubeMatrix holding the two segments, segment1 < segment2
+  size_t segment1;
+  size_t segment2;
+  //! midpoint of the closest approach of the two segments
+  P1906MOL_MOTOR_Vec3 pt;
+  //! length of the closest approach
+  double distance;
+};
+
 /**
  * \ingroup IEEE P1906 framework
  *
@@ -81,8 +97,10 @@ public:
    */
   //! return the location of the vector from vf that is closest to the point pt and put it in result
   static void findClosestPoint(gsl_vector * pt, gsl_matrix * vf, gsl_vector *result);
+  //! as above, visiting only the grid cells of index around pt; index must have been built over the rows of vf
+  static void findClosestPoint(gsl_vector * pt, gsl_matrix * vf, const P1906MOL_MOTOR_SegmentIndex & index, gsl_vector *result);
   //! convert the tube structures to a vector field of the same dimensions as the tubeMatrix
-  void tubes2VectorField(gsl_matrix * tubeMatrix, gsl_matrix * vf);
+  static void tubes2VectorField(gsl_matrix * tubeMatrix, gsl_matrix * vf);
  
   /*
    * Methods implementing unit tests
@@ -107,6 +125,8 @@ public:
   static void displayLine(gsl_vector * line);
   //! set the segment with the given end points
   static void line(gsl_vector * line, P1906MOL_MOTOR_Pos p1, P1906MOL_MOTOR_Pos p2);
+  //! retrieve the end points of segment mp from tubeMatrix
+  static void line(gsl_matrix * tubeMatrix, size_t mp, P1906MOL_MOTOR_Vec3 & p1, P1906MOL_MOTOR_Vec3 & p2);
   //! print the list of 3D points
   void displayPoints(gsl_matrix * pts);
   //! print only the first 3D numPts
@@ -121,8 +141,8 @@ public:
   /*
    * Methods related to computing structural entropy
    */
-  //! return the structural entropy based upon a list of angles
-  double sEntropy(gsl_matrix * segAngle);
+  //! return the structural entropy based upon a list of angles, binned into bins bins
+  static double sEntropy(gsl_matrix * segAngle, size_t bins = 100);
   
   /*
    * Methods related to tube distance and overlap
@@ -131,16 +151,35 @@ public:
   static void cross_product(const gsl_vector * u, const gsl_vector * v, gsl_vector * product);
   //! return the shortest distance in 3D space between the point pt and the segment
   static double distance(gsl_vector * pt, gsl_vector * segment);
+  //! return the shortest distance in 3D space between the point pt and the segment (p1, p2)
+  static double distance(const P1906MOL_MOTOR_Vec3 & pt, const P1906MOL_MOTOR_Vec3 & p1, const P1906MOL_MOTOR_Vec3 & p2);
   //! return all the points where tubes overlap with one another in pts
   void getAllOverlaps3D(gsl_matrix * tubeMatrix, vector<P1906MOL_MOTOR_Pos> & pts);
-  //! return all the points where a segment overlaps with a list of tubes in pts
+  //! append every pair of segments of tubeMatrix closer than tolerance to overlaps, ordered by segment1 then segment2; returns the number appended
+  size_t getAllOverlaps3D(gsl_matrix * tubeMatrix, double tolerance, vector<P1906MOL_MOTOR_Overlap> & overlaps);
+  //! number of threads sharing getAllOverlaps3D (< 2 keeps it on the calling thread)
+  void setOverlapThreads(uint32_t threads);
+  uint32_t getOverlapThreads();
+  //! put the points where a segment overlaps with a list of tubes in pts, and the overlapped segments in tubeSegments;
+  //! return the number of overlaps, which is larger than the rows of pts or tubeSegments when they were too small to hold them all
   int getOverlap3D(gsl_vector * segment, gsl_matrix * tubeMatrix, gsl_matrix * pts, gsl_vector * tubeSegments);
   //! return the nearest segment in tubeMatrix to the point pt that falls within radius from the point, otherwise return -1
   static size_t findNearestTube(gsl_vector * pt, gsl_matrix * tubeMatrix, double radius);  
+  //! return the nearest segment in tubeMatrix to the point pt that falls within radius from the point, otherwise return -1
+  static size_t findNearestTube(const P1906MOL_MOTOR_Vec3 & pt, gsl_matrix * tubeMatrix, double radius);
+  //! return the nearest segment of the network held by index to the point pt that falls within radius from the point, otherwise return -1
+  static size_t findNearestTube(const P1906MOL_MOTOR_Vec3 & pt, const P1906MOL_MOTOR_SegmentIndex & index, double radius);
+   
+  //! segments closer than this (in the units of tubeMatrix) overlap
+  static const double overlapTolerance;
    
   P1906MOL_MOTOR_Field ();
   virtual ~P1906MOL_MOTOR_Field ();
 
+private:
+  //! see the OverlapThreads attribute
+  uint32_t m_overlapThreads;
+
 };
 
 }
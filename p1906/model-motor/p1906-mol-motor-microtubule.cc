@@ -78,6 +78,8 @@
 #include "ns3/log.h"
 #include "ns3/object.h"
 #include "ns3/nstime.h"
+#include "ns3/uinteger.h"
+#include "ns3/system-thread.h"
 #include "ns3/ptr.h"
 
 #include "ns3/p1906-mol-motor-microtubule.h"
@@ -88,6 +90,7 @@
 #include "ns3/p1906-mol-motor-tube.h"
 #include "ns3/p1906-mol-motor-pos.h"
 #include "ns3/p1906-mol-motor-motion.h"
+#include "ns3/p1906-mol-motor-rng-streams.h"
 
 namespace ns3 {
 
@@ -96,7 +99,19 @@ NS_LOG_COMPONENT_DEFINE ("P1906MOL_MOTOR_MicrotubulesField");
 TypeId P1906MOL_MOTOR_MicrotubulesField::GetTypeId (void)
 {
   static TypeId tid = TypeId ("ns3::P1906MOL_MOTOR_MicrotubulesField")
-    .SetParent<P1906MOL_MOTOR_Field> ();
+    .SetParent<P1906MOL_MOTOR_Field> ()
+    .AddAttribute ("Threads",
+                   "Number of threads generating the tubes (< 2 keeps the serial generation)",
+                   UintegerValue (0),
+                   MakeUintegerAccessor (&P1906MOL_MOTOR_MicrotubulesField::setTubeThreads,
+                                         &P1906MOL_MOTOR_MicrotubulesField::getTubeThreads),
+                   MakeUintegerChecker<uint32_t> ())
+    .AddAttribute ("EntropyBins",
+                   "Number of histogram bins of the segment angles when computing the structural entropy",
+                   UintegerValue (100),
+                   MakeUintegerAccessor (&P1906MOL_MOTOR_MicrotubulesField::setEntropyBins,
+                                         &P1906MOL_MOTOR_MicrotubulesField::getEntropyBins),
+                   MakeUintegerChecker<uint32_t> (1));
   return tid;
 }
 
@@ -129,34 +144,35 @@ TypeId P1906MOL_MOTOR_MicrotubulesField::GetTypeId (void)
 */
 P1906MOL_MOTOR_MicrotubulesField::P1906MOL_MOTOR_MicrotubulesField ()
 {
-  P1906MOL_MOTOR_MathematicaHelper mathematica;
-  
   //! allocate and start the random number generator
-  T = gsl_rng_default;
-  r = gsl_rng_alloc (T);
-  gsl_rng_env_setup();
+  T = P1906MOL_MOTOR_RngStreams::GetType ();
+  r = P1906MOL_MOTOR_RngStreams::Create (0, 
+    P1906MOL_MOTOR_RngStreams::NextId (P1906MOL_MOTOR_RngStreams::FieldGeneration), 
+    P1906MOL_MOTOR_RngStreams::FieldGeneration);
+  
+  //! the tubes and the vector field are held by the network Build finds or generates
+  tubeMatrix = NULL;
+  vf = NULL;
+  tubeIndex = NULL;
+  ts.se = 0;
+  m_dirty = true;
+  m_threads = 0;
+  m_entropyBins = 100;
+  m_genChars = NULL;
+  m_genTubes = NULL;
+  m_genStarts = NULL;
+  m_nextTube = 0;
     
-  //! set the microtubule network properties
-  setTubeVolume(25);
-  setTubeLength(100);
-  setTubeIntraAngle(30);
-  setTubeInterAngle(10);
-  setTubeDensity(10);
-  setTubePersistenceLength(50);
-  setTubeSegments(10);
- 
-  //! display all the microtubule network properties
-  displayTubeChars();
-  
-  //! create the microtubules
-  tubeMatrix = gsl_matrix_alloc (ts.numTubes * ts.segPerTube, 6);
-  genTubes();
-  mathematica.tubes2Mma(tubeMatrix, ts.segPerTube, "tubes.mma");
-  printf ("completed tube creation\n");
-
-  //! create the vector field  
-  vf = gsl_matrix_alloc (ts.numTubes * ts.segPerTube, 6);
-  tubes2VectorField(tubeMatrix, vf);
+  //! set the default microtubule network properties; the tubes are only generated by Build, 
+  //! once the caller has set its own
+  ts.volume = 25;
+  ts.mean_tube_length = 100;
+  ts.mean_intra_tube_angle = 30;
+  ts.mean_inter_tube_angle = 10;
+  ts.mean_tube_density = 10;
+  ts.persistenceLength = 50;
+  ts.segPerTube = 10;
+  tubeCharsChanged();
 
   //! test the computation of distance
   //unitTest_Distance();
@@ -192,13 +208,122 @@ P1906MOL_MOTOR_MicrotubulesField::P1906MOL_MOTOR_MicrotubulesField ()
   //! test the FluxMeter
   //unitTest_FluxMeter();
   
-  //! test persistence length versus entropy plot - NB: this test changes the tubeMatrix
+  //! test persistence length versus entropy plot
   //unitTest_PersistenceLengthsVsEntropy();
 
   NS_LOG_FUNCTION (this);
   NS_LOG_FUNCTION (this << "Created P1906MOL_MOTOR_MicrotubulesField");
 }
 
+//! generate the tubes and the vector field if the properties changed since they were last generated
+void P1906MOL_MOTOR_MicrotubulesField::Build()
+{
+  P1906MOL_MOTOR_MathematicaHelper mathematica;
+  
+  if (!m_dirty)
+    return;
+  //! setters that were undone leave the tubes as they are
+  if (tubeMatrix != NULL && sameTubeChars())
+  {
+    m_dirty = false;
+    return;
+  }
+  
+  //! another field of a named environment may already have generated these tubes
+  Ptr<P1906MOL_MOTOR_TubeNetwork> shared = P1906MOL_MOTOR_TubeNetwork::Find (m_environment, ts);
+  if (shared != 0)
+  {
+    NS_LOG_INFO ("sharing the tubes of network " << shared);
+    setTubeNetwork (shared);
+    return;
+  }
+  
+  //! display all the microtubule network properties
+  displayTubeChars();
+  
+  //! create the microtubules and the vector field
+  genTubes();
+  if (tubeMatrix == NULL)
+    return;
+  mathematica.tubes2Mma(tubeMatrix, ts.segPerTube, "tubes.mma");
+  printf ("completed tube creation\n");
+}
+
+gsl_matrix * P1906MOL_MOTOR_MicrotubulesField::getTubeMatrix()
+{
+  Build();
+  return tubeMatrix;
+}
+
+gsl_matrix * P1906MOL_MOTOR_MicrotubulesField::getVectorField()
+{
+  Build();
+  return vf;
+}
+
+const P1906MOL_MOTOR_SegmentIndex & P1906MOL_MOTOR_MicrotubulesField::getTubeIndex()
+{
+  Build();
+  return *tubeIndex;
+}
+
+Ptr<const P1906MOL_MOTOR_TubeNetwork> P1906MOL_MOTOR_MicrotubulesField::getTubeNetwork()
+{
+  Build();
+  return m_network;
+}
+
+//! the properties are taken as they are, so a later setter generating new tubes starts from them
+void P1906MOL_MOTOR_MicrotubulesField::setTubeNetwork(Ptr<const P1906MOL_MOTOR_TubeNetwork> network)
+{
+  ts = network->getTubeChars ();
+  m_builtTs = ts;
+  m_builtEnvironment = m_environment;
+  m_dirty = false;
+  adoptNetwork (network);
+}
+
+void P1906MOL_MOTOR_MicrotubulesField::setEnvironment(const string & environment)
+{
+  if (environment == m_environment)
+    return;
+  m_environment = environment;
+  m_dirty = true;
+}
+
+void P1906MOL_MOTOR_MicrotubulesField::adoptNetwork(Ptr<const P1906MOL_MOTOR_TubeNetwork> network)
+{
+  //! other tubes: the links cached by the medium through this field are out of date
+  if (network != m_network)
+    NotifyParametersChanged ();
+  m_network = network;
+  tubeMatrix = network->getTubeMatrix ();
+  vf = network->getVectorField ();
+  tubeIndex = &network->getTubeIndex ();
+}
+
+//! derive the dependent properties whatever order the setters were called in, and mark the tubes out of date
+void P1906MOL_MOTOR_MicrotubulesField::tubeCharsChanged()
+{
+  ts.segLength = ts.mean_tube_length / 5;
+  ts.numSegments = ts.mean_tube_density * ts.volume;
+  ts.numTubes = ts.segPerTube > 0 ? floor(ts.numSegments / ts.segPerTube) : 0;
+  m_dirty = true;
+}
+
+//! true if the properties the tubes are generated from equal those of the last generation
+bool P1906MOL_MOTOR_MicrotubulesField::sameTubeChars()
+{
+  return m_environment == m_builtEnvironment
+    && ts.volume == m_builtTs.volume
+    && ts.mean_tube_length == m_builtTs.mean_tube_length
+    && ts.mean_intra_tube_angle == m_builtTs.mean_intra_tube_angle
+    && ts.mean_inter_tube_angle == m_builtTs.mean_inter_tube_angle
+    && ts.mean_tube_density == m_builtTs.mean_tube_density
+    && ts.persistenceLength == m_builtTs.persistenceLength
+    && ts.segPerTube == m_builtTs.segPerTube;
+}
+
 //! print tube characteristics to standard output
 void P1906MOL_MOTOR_MicrotubulesField::displayTubeChars()
 {
@@ -214,51 +339,92 @@ void P1906MOL_MOTOR_MicrotubulesField::displayTubeChars()
 //! set the space in which the tube centers will be formed
 void P1906MOL_MOTOR_MicrotubulesField::setTubeVolume(double volume)
 {
+  if (ts.volume == volume)
+    return;
   ts.volume = volume;
+  tubeCharsChanged();
 }
 
 //! set the mean tube length, segment is arbitrarily set to 1/5 the length of a tube
 void P1906MOL_MOTOR_MicrotubulesField::setTubeLength(double mean_tube_length)
 {
+  if (ts.mean_tube_length == mean_tube_length)
+    return;
   ts.mean_tube_length = mean_tube_length;
-  ts.segLength = ts.mean_tube_length / 5;
+  tubeCharsChanged();
 }
 
 //! set the mean angle between segments within a tube
 void P1906MOL_MOTOR_MicrotubulesField::setTubeIntraAngle(double mean_intra_tube_angle)
 {
+  if (ts.mean_intra_tube_angle == mean_intra_tube_angle)
+    return;
   ts.mean_intra_tube_angle = mean_intra_tube_angle;
+  tubeCharsChanged();
 }
 
 //! set the mean angle between tubes
 void P1906MOL_MOTOR_MicrotubulesField::setTubeInterAngle(double mean_inter_tube_angle)
 {
+  if (ts.mean_inter_tube_angle == mean_inter_tube_angle)
+    return;
   ts.mean_inter_tube_angle = mean_inter_tube_angle;
+  tubeCharsChanged();
 }
 
 //! this is really the segment density and also derives and sets the total number of segments based on the volume
 void P1906MOL_MOTOR_MicrotubulesField::setTubeDensity(double mean_tube_density)
 {
+  if (ts.mean_tube_density == mean_tube_density)
+    return;
   ts.mean_tube_density = mean_tube_density;
-  ts.numSegments = ts.mean_tube_density * ts.volume;
+  tubeCharsChanged();
 }
 
 //! set the persistence length of each tube
 void P1906MOL_MOTOR_MicrotubulesField::setTubePersistenceLength(double persistenceLength)
 {
+  if (ts.persistenceLength == persistenceLength)
+    return;
   ts.persistenceLength = persistenceLength;
+  tubeCharsChanged();
 }
 
 //! set the number of segments per tube and also derives and sets the number of tubes
 void P1906MOL_MOTOR_MicrotubulesField::setTubeSegments(size_t segPerTube)
 {
+  if (ts.segPerTube == segPerTube)
+    return;
   ts.segPerTube = segPerTube;
-  ts.numTubes = floor(ts.numSegments / ts.segPerTube);
+  tubeCharsChanged();
+}
+
+//! the tubes do not depend on the number of threads, so this does not mark them out of date
+void P1906MOL_MOTOR_MicrotubulesField::setTubeThreads(uint32_t threads)
+{
+  m_threads = threads;
+}
+
+uint32_t P1906MOL_MOTOR_MicrotubulesField::getTubeThreads() const
+{
+  return m_threads;
+}
+
+//! only the structural entropy depends on the bins, so the tubes are kept; the next generation uses the new count
+void P1906MOL_MOTOR_MicrotubulesField::setEntropyBins(uint32_t bins)
+{
+  m_entropyBins = bins;
+}
+
+uint32_t P1906MOL_MOTOR_MicrotubulesField::getEntropyBins() const
+{
+  return m_entropyBins;
 }
 
 //! return the size of the matrix to allocate
 void P1906MOL_MOTOR_MicrotubulesField::getTubesSize(double * rows, double * cols)
 {
+  Build();
   *rows = tubeMatrix->size1;
   *cols = tubeMatrix->size2;
 }
@@ -266,6 +432,7 @@ void P1906MOL_MOTOR_MicrotubulesField::getTubesSize(double * rows, double * cols
 //! export tubes; copy the object's tubeMatrix into tm for use outside the object
 void P1906MOL_MOTOR_MicrotubulesField::getTubes(gsl_matrix * tm)
 {
+  Build();
   // copy tubeMatrix to tm, but only if tm->size1 and tm->size2 are consistent with tubeMatrix
   if (tm->size1 == tubeMatrix->size1 && tm->size2 == tubeMatrix->size2)
     printf ("(getTubes) sizes not equal tm->size1: %ld tubeMatrix_size1: %ld tm->size2: %ld tubeMatrix->size2: %ld\n", 
@@ -276,9 +443,15 @@ void P1906MOL_MOTOR_MicrotubulesField::getTubes(gsl_matrix * tm)
 //! import tubes; create a local copy of the tube structure tm in tubeMatrix
 void P1906MOL_MOTOR_MicrotubulesField::setTubes(gsl_matrix * tm)
 {
-  //copy tm to tubeMatrix, but only if same size tm->size1 and tm->size2
-  gsl_matrix_memcpy (tubeMatrix, tm);
-  // may need to free and then reallocate if different size
+  gsl_matrix * copy = gsl_matrix_alloc (tm->size1, tm->size2);
+  
+  //! the imported tubes replace any generated ones, so there is nothing left to build; 
+  //! they are not registered, as they need not follow ts
+  gsl_matrix_memcpy (copy, tm);
+  m_builtTs = ts;
+  m_builtEnvironment = m_environment;
+  m_dirty = false;
+  adoptNetwork (Create<P1906MOL_MOTOR_TubeNetwork> (copy, ts));
 }
 
 //! for each of the persistenceLengths in the vector, generate tubes and plot persistence length versus 
@@ -286,31 +459,53 @@ void P1906MOL_MOTOR_MicrotubulesField::setTubes(gsl_matrix * tm)
 void P1906MOL_MOTOR_MicrotubulesField::persistenceVersusEntropy(gsl_vector * persistenceLengths)
 {
   P1906MOL_MOTOR_MathematicaHelper mathematica;
-  char plot_filename[256];
+  vector<double> lengths (persistenceLengths->size);
+  vector<double> entropies;
   //! store the results here
   gsl_matrix * pve = gsl_matrix_alloc (persistenceLengths->size, 2);
   
-  //printf ("(persistenceVersusEntropy) persistenceLengths->size: %ld\n", persistenceLengths->size);
   for (size_t i = 0; i < persistenceLengths->size; i++)
-  {	
-    //printf ("(persistenceVersusEntropy) persistenceLengths(%ld) = %f\n", i, gsl_vector_get (persistenceLengths, i));
-    setTubePersistenceLength (gsl_vector_get (persistenceLengths, i));
-    genTubes();
-	
-	//printf ("(persistenceVersusEntropy) i: %ld\n", i);
-	//printf ("(persistenceVersusEntropy) tubeMatrix: %ld x %ld\n", tubeMatrix->size1, tubeMatrix->size2);
-	//printf ("(persistenceVersusEntropy) segPerTube: %ld\n", ts->segPerTube);
-	//gsl_matrix_fprintf (stdout, tubeMatrix, "%f");
-	
-	//! store the set of tubes
-	sprintf (plot_filename, "tubes_%ld.mma", i);
-    mathematica.tubes2Mma(tubeMatrix, ts.segPerTube, plot_filename);
-	gsl_matrix_set (pve, i, 0, gsl_vector_get (persistenceLengths, i));
-	gsl_matrix_set (pve, i, 1, ts.se);
+    lengths[i] = gsl_vector_get (persistenceLengths, i);
+  persistenceSweep (lengths, entropies, true);
+  
+  for (size_t i = 0; i < persistenceLengths->size; i++)
+  {
+	gsl_matrix_set (pve, i, 0, lengths[i]);
+	gsl_matrix_set (pve, i, 1, entropies[i]);
   }
   
   //! plot the results
   mathematica.plot2Mma(pve, "persistenceVersusEntropy.mma", "persistence length", "structural entropy");
+  gsl_matrix_free (pve);
+}
+
+//! all the tubes of all the networks are generated in one pass over Threads threads; the tubes are only kept 
+//! (and written to tubes_<n>.mma) when writeTubes is set, otherwise each worker overwrites its own scratch rows
+void P1906MOL_MOTOR_MicrotubulesField::persistenceSweep(const vector<double> & persistenceLengths, vector<double> & entropies, bool writeTubes)
+{
+  P1906MOL_MOTOR_MathematicaHelper mathematica;
+  char plot_filename[256];
+  vector<tubeCharacteristcs_t> chars (persistenceLengths.size (), ts);
+  vector<gsl_matrix *> tubes (persistenceLengths.size (), (gsl_matrix *) NULL);
+  
+  for (size_t i = 0; i < persistenceLengths.size (); i++)
+  {
+    chars[i].persistenceLength = persistenceLengths[i];
+    if (writeTubes && ts.numTubes * ts.segPerTube > 0)
+      tubes[i] = gsl_matrix_alloc (ts.numTubes * ts.segPerTube, 6);
+  }
+  
+  genNetworks (chars, tubes, entropies);
+  
+  for (size_t i = 0; i < tubes.size (); i++)
+  {
+    if (tubes[i] == NULL)
+      continue;
+	//! store the set of tubes
+	sprintf (plot_filename, "tubes_%ld.mma", i);
+    mathematica.tubes2Mma(tubes[i], ts.segPerTube, plot_filename);
+    gsl_matrix_free (tubes[i]);
+  }
 }
 
 //! generate a set of tubes comprised of a total of numSegments in volume with segPerTube segments of segLength 
@@ -320,49 +515,125 @@ void P1906MOL_MOTOR_MicrotubulesField::genTubes()
   //! create a given density of tubes of numSegments in given volume
   //! volume starts at 0, 0, 0 to volume^(1/4) in each dimension
   
-  //! don't delete, just refill the tubeMatrix
-  //! free the matrix of any previous allocation
-  //gsl_matrix_free (tubeMatrix);
-  //! re-allocate the tubeMatrix
-  //tubeMatrix = gsl_matrix_alloc (ts->numTubes * ts->segPerTube, 6);
+  //! fill a new matrix: the current one may be shared, and networks are never modified
+  if (ts.numTubes * ts.segPerTube == 0)
+  {
+    NS_LOG_WARN ("the tube properties give no segments, no tubes generated");
+    return;
+  }
+  vector<tubeCharacteristcs_t> chars (1, ts);
+  vector<gsl_matrix *> tubes (1, gsl_matrix_alloc (ts.numTubes * ts.segPerTube, 6));
+  vector<double> entropies;
+  
+  genNetworks (chars, tubes, entropies);
+  
+  ts.se = entropies[0];
+  m_builtTs = ts;
+  m_builtEnvironment = m_environment;
+  m_dirty = false;
+  
+  //! wrap the tubes with their vector field and index, and offer them to the other fields of the environment
+  Ptr<P1906MOL_MOTOR_TubeNetwork> network = Create<P1906MOL_MOTOR_TubeNetwork> (tubes[0], ts);
+  P1906MOL_MOTOR_TubeNetwork::Register (m_environment, network);
+  adoptNetwork (network);
+}
 
-  //! \todo get actual tube graph properties from biologist
-  gsl_vector * startPt = gsl_vector_alloc (3);
-  //! hold the values for a tube comprised of many segments: x_start y_start x_start x_end y_end z_end
-  gsl_matrix * segMatrix = gsl_matrix_alloc (ts.segPerTube, 6);
-  double total_structural_entropy = 0;
+//! the start points and the streams are handed out in network and tube order on this thread, so that neither depends on the threads
+void P1906MOL_MOTOR_MicrotubulesField::genNetworks(const vector<tubeCharacteristcs_t> & chars, vector<gsl_matrix *> & tubes, vector<double> & entropies)
+{
+  size_t numTubes = ts.numTubes;
+  size_t numJobs = chars.size () * numTubes;
   
-  //printf ("(genTubes) tubeMatrix: %ld x %ld\n", tubeMatrix->size1, tubeMatrix->size2);
-  //printf ("(genTubes) numTubes: %ld segPerTube: %ld volume: %f\n", ts->numTubes, ts->segPerTube, ts->volume);
+  entropies.assign (chars.size (), 0);
+  if (numJobs == 0 || ts.segPerTube == 0)
+    return;
   
-  //! volume starts at 0, 0, 0 to volume^(1/4) in each dimension
-  for(size_t i = 0; i < ts.numTubes; i++)
+  //! \todo get actual tube graph properties from biologist
+  m_genStarts = gsl_matrix_alloc (numJobs, 3);
+  m_genIds.resize (numJobs);
+  for(size_t k = 0; k < numJobs; k++)
   {
     //! set the starting location for the tube
-    point (startPt, 
-	  gsl_ran_gaussian (r, pow(ts.volume, (1/4))),
-	  gsl_ran_gaussian (r, pow(ts.volume, (1/4))),
-	  gsl_ran_gaussian (r, pow(ts.volume, (1/4))));
+    //! volume starts at 0, 0, 0 to volume^(1/4) in each dimension
+    const tubeCharacteristcs_t & c = chars[k / numTubes];
+    for(size_t d = 0; d < 3; d++)
+      gsl_matrix_set (m_genStarts, k, d, gsl_ran_gaussian (r, pow(c.volume, (1/4))));
+    m_genIds[k] = P1906MOL_MOTOR_RngStreams::NextId (P1906MOL_MOTOR_RngStreams::TubeGeneration);
+  }
+  m_genChars = &chars;
+  m_genTubes = &tubes;
+  m_genSe.assign (numJobs, 0);
+  m_nextTube = 0;
+  
+  //! the calling thread takes part as the last worker
+  uint32_t numThreads = min ((size_t) m_threads, numJobs);
+  vector<Ptr<SystemThread> > threads;
+  
+  NS_LOG_FUNCTION (this << chars.size () << numTubes << ts.segPerTube << numThreads);
+  for (uint32_t t = 1; t < numThreads; t++)
+  {
+    Ptr<SystemThread> thread = Create<SystemThread> (MakeCallback (&P1906MOL_MOTOR_MicrotubulesField::genTubesWorker, this));
+    thread->Start ();
+    threads.push_back (thread);
+  }
+  genTubesWorker ();
+  for (size_t t = 0; t < threads.size (); t++)
+    threads[t]->Join ();
+  
+  //! sum in tube order, for the same rounding whatever the threads
+  for(size_t k = 0; k < numJobs; k++)
+    entropies[k / numTubes] += m_genSe[k];
+  
+  gsl_matrix_free (m_genStarts);
+  m_genStarts = NULL;
+  m_genChars = NULL;
+  m_genTubes = NULL;
+  m_genSe.clear ();
+}
 
-	//! create a single tube
-    P1906MOL_MOTOR_Tube tube(&ts, startPt);
-	
-    //! create a single tube of many segments
-    //tube.genTube(ts, r, segMatrix, startPt);
-    //printf ("(genTubes) segMatrix\n");
-	//tube.displayTube();
-	total_structural_entropy += (ts.se);
-	
-	tube.getSegmatrix(segMatrix);
-	//! copy tube segments to main tube matrix
-	for(size_t j = 0; j < ts.segPerTube; j++)
-	  for(size_t k = 0; k < 6; k++)
-	  {
-	    gsl_matrix_set(tubeMatrix, i * ts.segPerTube + j, k, gsl_matrix_get(segMatrix, j, k));
-	  }
+//! each worker reuses one generator, one pair of angle matrices and one tube of scratch rows for all of its tubes
+void P1906MOL_MOTOR_MicrotubulesField::genTubesWorker()
+{
+  //! tubes are short; taking a few at a time keeps the threads off the mutex
+  const size_t tubesPerTake = 16;
+  size_t numTubes = ts.numTubes;
+  size_t segPerTube = ts.segPerTube;
+  gsl_matrix * segAngleTheta = gsl_matrix_alloc (segPerTube, 1);
+  gsl_matrix * segAnglePsi = gsl_matrix_alloc (segPerTube, 1);
+  gsl_matrix * segMatrix = gsl_matrix_alloc (segPerTube, 6);
+  gsl_rng * tr = P1906MOL_MOTOR_RngStreams::Create (0, 0, P1906MOL_MOTOR_RngStreams::TubeGeneration);
+  
+  while (true)
+  {
+    size_t first, last;
+    {
+      CriticalSection cs (m_mutex);
+      if (m_nextTube >= m_genSe.size ())
+        break;
+      first = m_nextTube;
+      last = min (first + tubesPerTake, m_genSe.size ());
+      m_nextTube = last;
+    }
+    for (size_t k = first; k < last; k++)
+    {
+      size_t n = k / numTubes;
+      size_t i = k % numTubes;
+      gsl_matrix * tubes = (*m_genTubes)[n];
+      
+      P1906MOL_MOTOR_RngStreams::Select (tr, 0, m_genIds[k], P1906MOL_MOTOR_RngStreams::TubeGeneration);
+      //! the rows of tube i of network n, which no other worker writes
+      gsl_matrix_view rows = gsl_matrix_submatrix (tubes != NULL ? tubes : segMatrix, 
+        tubes != NULL ? i * segPerTube : 0, 0, segPerTube, 6);
+      gsl_vector_const_view startPt = gsl_matrix_const_row (m_genStarts, k);
+      m_genSe[k] = P1906MOL_MOTOR_Tube::genTube ((*m_genChars)[n], tr, &rows.matrix, &startPt.vector, 
+        segAngleTheta, segAnglePsi, m_entropyBins);
+    }
   }
   
-  ts.se = total_structural_entropy;
+  gsl_rng_free (tr);
+  gsl_matrix_free (segAngleTheta);
+  gsl_matrix_free (segAnglePsi);
+  gsl_matrix_free (segMatrix);
 }
 
 //! \todo test the volume surface as a flux meter and later as a compartmentalization volume
@@ -506,7 +777,7 @@ bool P1906MOL_MOTOR_MicrotubulesField::unitTest_VolSurface()
   mathematica.vectorPlotMma (vectors, "volsurfvector2afterreflection.mma");
   
   //! measure flow through surface
-  flux = vs.fluxMeter(tubeMatrix);
+  flux = vs.fluxMeter(getTubeMatrix());
   printf ("(unitTest_VolSurface) flux: %lf\n", flux);
   
   printf ("completed unitTest_VolSurface\n");
@@ -523,6 +794,7 @@ bool P1906MOL_MOTOR_MicrotubulesField::unitTest_ReflectiveBarrier()
   double timePeriod = 100;
   P1906MOL_MOTOR_Pos volCenter;
   P1906MOL_MOTOR_Motion motion;
+  vector<P1906MOL_MOTOR_Vec3> history;
 
   printf ("beginning unitTest_ReflectiveBarrier\n");
   //! start at zero
@@ -543,7 +815,8 @@ bool P1906MOL_MOTOR_MicrotubulesField::unitTest_ReflectiveBarrier()
   motor->setStartingPoint(startPt);
   motion.float2Destination(motor, timePeriod);
   //printf ("(unitTest_MotorMovement) propagation time: %f\n", motor.getTime());
-  mathematica.connectedPoints2Mma(motor->pos_history, "float2destination.mma");
+  motor->trajectory->getPoints(history);
+  mathematica.connectedPoints2Mma(history, "float2destination.mma");
   printf ("completed unitTest_ReflectiveBarrier\n");
   
   return true;
@@ -558,6 +831,7 @@ bool P1906MOL_MOTOR_MicrotubulesField::unitTest_FluxMeter()
   double timePeriod = 100;
   P1906MOL_MOTOR_Pos volCenter;
   P1906MOL_MOTOR_Motion motion;
+  vector<P1906MOL_MOTOR_Vec3> history;
 
   printf ("beginning unitTest_ReflectiveBarrier\n");
   //! start at zero
@@ -578,7 +852,8 @@ bool P1906MOL_MOTOR_MicrotubulesField::unitTest_FluxMeter()
   motor->setStartingPoint(startPt);
   motion.float2Destination(motor, timePeriod);
   //printf ("(unitTest_MotorMovement) propagation time: %f\n", motor.getTime());
-  mathematica.connectedPoints2Mma(motor->pos_history, "float2destination.mma");
+  motor->trajectory->getPoints(history);
+  mathematica.connectedPoints2Mma(history, "float2destination.mma");
   printf ("completed unitTest_ReflectiveBarrier\n");
   
   return true;
@@ -639,7 +914,7 @@ bool P1906MOL_MOTOR_MicrotubulesField::unitTest_AllOverlaps()
   P1906MOL_MOTOR_MathematicaHelper mathematica;
 
   printf ("beginning unitTest_AllOverlaps\n");
-  getAllOverlaps3D(tubeMatrix, pts);
+  getAllOverlaps3D(getTubeMatrix(), pts);
   mathematica.points2Mma(pts, "pfile.mma");
   printf ("completed unitTest_AllOverlaps\n");
   
@@ -667,6 +942,7 @@ bool P1906MOL_MOTOR_MicrotubulesField::unitTest_VectorField()
   P1906MOL_MOTOR_MathematicaHelper mathematica;
 
   printf ("beginning unitTest_VectorField\n");
+  Build();
   mathematica.vectorFieldPlotMma(vf, "vectorField.mma");
   matlab.vectorFieldMeshMATLAB(vf, "vectorField.dat");
   printf ("completed plot of vector field\n");
@@ -682,6 +958,7 @@ bool P1906MOL_MOTOR_MicrotubulesField::unitTest_NoTubeMotion()
   gsl_vector * startPt = gsl_vector_alloc (3);
   double timePeriod = 100;
   P1906MOL_MOTOR_Motion motion;
+  vector<P1906MOL_MOTOR_Vec3> history;
 
   printf ("beginning unitTest_NoTubeMotion\n");
   //! reset the motor's timer
@@ -698,7 +975,8 @@ bool P1906MOL_MOTOR_MicrotubulesField::unitTest_NoTubeMotion()
   motor->setStartingPoint(startPt);
   motion.float2Destination(motor, timePeriod);
   //printf ("(unitTest_MotorMovement) propagation time: %f\n", motor.getTime());
-  mathematica.connectedPoints2Mma(motor->pos_history, "float2destination.mma");
+  motor->trajectory->getPoints(history);
+  mathematica.connectedPoints2Mma(history, "float2destination.mma");
   printf ("completed unitTest_NoTubeMotion\n");
   
   return true;
@@ -712,45 +990,49 @@ bool P1906MOL_MOTOR_MicrotubulesField::unitTest_MotorMovement(vector<P1906MOL_MO
   gsl_vector * startPt = gsl_vector_alloc (3);
   //double timePeriod = 100;
   P1906MOL_MOTOR_Motion motion;
+  vector<P1906MOL_MOTOR_Vec3> history;
 
   printf ("beginning unitTest_MotorMovement\n");
+  Build();
   //! reset the motor's timer
   motor->initTime();
   
   /*
    * move randomly until overlap with tube
    */
-  motor->pos_history.clear();
+  history.clear();
   point (startPt, 
     gsl_matrix_get (tubeMatrix, 0, 0) + 30, //! start 10 nanometers away from the first tube segment
 	gsl_matrix_get (tubeMatrix, 0, 1),
 	gsl_matrix_get (tubeMatrix, 0, 2));
-  motion.float2Tube(motor, r, startPt, motor->pos_history, tubeMatrix, 0.1, motor->vsl);
+  motion.float2Tube(motor, r, startPt, history, tubeMatrix, 0.1, motor->vsl, tubeIndex);
   //printf ("completed float2Tube\n");
   //printf ("(unitTest_MotorMovement) float2Tube propagation time: %f\n", motor.getTime());
-  //printf ("(unitTest_MotorMovement) float2Tube number of positions: %ld\n", motor.pos_history.size());
-  mathematica.connectedPoints2Mma(motor->pos_history, "motion2tube.mma");
+  //printf ("(unitTest_MotorMovement) float2Tube number of positions: %ld\n", history.size());
+  mathematica.connectedPoints2Mma(history, "motion2tube.mma");
   //printf ("completed connectedPoints2Mma\n");
   
   //! start where the motor ended
-  P1906MOL_MOTOR_Pos Pos;
-  Pos = motor->pos_history.back();
-  double x, y, z;
-  Pos.getPos (&x, &y, &z);
-  point(startPt, x, y, z);
+  P1906MOL_MOTOR_Vec3 last = history.back();
+  point(startPt, last.x, last.y, last.z);
   //printf ("(unitTest_MotorMovement) starting point for motor walk near tube\n");
   //displayPoint (startPt);
 
   /*
    * now walk along the tube
    */
-  motor->pos_history.clear();
-  motion.motorWalk(motor, r, startPt, motor->pos_history, tubeMatrix, ts.segPerTube, motor->vsl);
+  history.clear();
+  motion.motorWalk(motor, r, startPt, history, tubeMatrix, ts.segPerTube, motor->vsl, tubeIndex);
   //printf ("(unitTest_MotorMovement) motorWalk propagation time: %f\n", motor.getTime());
-  printf ("(unitTest_MotorMovement) motorWalk number of positions: %ld\n", motor->pos_history.size());
-  mathematica.connectedPoints2Mma(motor->pos_history, "motion2end_of_tube.mma");
+  printf ("(unitTest_MotorMovement) motorWalk number of positions: %ld\n", history.size());
+  mathematica.connectedPoints2Mma(history, "motion2end_of_tube.mma");
   //! append the motor history into pts
-  pts.insert(pts.end(), motor->pos_history.begin(), motor->pos_history.end());
+  for (size_t i = 0; i < history.size(); i++)
+  {
+    P1906MOL_MOTOR_Pos Pos;
+    Pos.setPos (history.at(i));
+    pts.insert(pts.end(), Pos);
+  }
   printf ("completed unitTest_MotorMovement\n");
   
   return true;
@@ -795,22 +1077,29 @@ bool P1906MOL_MOTOR_MicrotubulesField::unitTest_MotorMove2Destination(vector<P19
   gsl_vector * startPt = gsl_vector_alloc (3);
   double timePeriod = 100;
   P1906MOL_MOTOR_Motion motion;
+  vector<P1906MOL_MOTOR_Vec3> history;
 
   printf ("beginning unitTest_MotorMove2Destination\n");
+  Build();
   //! reset the motor's timer
   motor->initTime();
   
   //! start at zero
   point (startPt, 0, 0, 0);
 
-  motor->pos_history.clear(); //! reset the position history
+  history.clear(); //! reset the position history
   motor->setStartingPoint(startPt);
 
-  motion.move2Destination(motor, tubeMatrix, ts.segPerTube, timePeriod, motor->pos_history);
+  motion.move2Destination(motor, tubeMatrix, ts.segPerTube, timePeriod, history, tubeIndex);
   //printf ("(unitTest_MotorMove2Destination) propagation time: %f\n", motor.getTime());
-  mathematica.connectedPoints2Mma(motor->pos_history, "motion2destination.mma");
+  mathematica.connectedPoints2Mma(history, "motion2destination.mma");
   //! append the motor history into pts
-  pts.insert(pts.end(), motor->pos_history.begin(), motor->pos_history.end());
+  for (size_t i = 0; i < history.size(); i++)
+  {
+    P1906MOL_MOTOR_Pos Pos;
+    Pos.setPos (history.at(i));
+    pts.insert(pts.end(), Pos);
+  }
   printf ("completed unitTest_MotorMove2Destination\n");
   
   return true;
@@ -819,6 +1108,8 @@ bool P1906MOL_MOTOR_MicrotubulesField::unitTest_MotorMove2Destination(vector<P19
 P1906MOL_MOTOR_MicrotubulesField::~P1906MOL_MOTOR_MicrotubulesField ()
 {
   NS_LOG_FUNCTION (this);
+  gsl_rng_free (r);
+  //! the tubes go with the last user of m_network
 }
 
 } // namespace ns3
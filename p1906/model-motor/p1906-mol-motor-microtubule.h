@@ -45,10 +45,12 @@ using namespace std;
 #include "ns3/object.h"
 #include "ns3/nstime.h"
 #include "ns3/ptr.h"
+#include "ns3/system-mutex.h"
 #include "ns3/p1906-mol-motor-field.h"
 #include "ns3/p1906-mol-motor-motion.h"
 
 #include "ns3/p1906-mol-motor-tube-characteristics.h"
+#include "ns3/p1906-mol-motor-tube-network.h"
 
 namespace ns3 {
 
@@ -74,6 +76,21 @@ namespace ns3 {
  *  
  * See http://www.gnu.org/software/gsl/manual/html_node/Level-3-GSL-BLAS-Interface.html#Level-3-GSL-BLAS-Interface.
  *
+ * Nothing is generated by the constructor: the tube setters only record the
+ * properties, and the tubes and vector field are generated by Build, which
+ * the accessors call on first use. Build does nothing unless a property
+ * actually changed since the last generation.
+ *
+ * The tubes belong to a P1906MOL_MOTOR_TubeNetwork. Build first looks for a
+ * network already generated in the same environment with the same
+ * properties, so fields of one cytoskeleton share a single network, and
+ * setTubeNetwork shares one explicitly.
+ *
+ * genTubes spreads the tubes over Threads threads. Tube i is drawn from its
+ * own stream, its start point is drawn beforehand on the calling thread, and
+ * it is written straight into its rows of the new tubeMatrix, so the network
+ * is the same whatever the number of threads. persistenceSweep puts the tubes
+ * of many networks into the same pool.
  */
 
 class P1906MOL_MOTOR_MicrotubulesField : public P1906MOL_MOTOR_Field
@@ -82,11 +99,14 @@ public:
   static TypeId GetTypeId (void);
     
   //! create a given density of tubes of numSegments in given volume; default volume starts at origin with length volume^(1/4) in each dimension  
+  //! NULL until built; use getTubeMatrix() from outside the class; owned by the network, do not write
   gsl_matrix * tubeMatrix;
   //! properties of the microtubule network
   tubeCharacteristcs_t ts;
-  //! holds the vector field
+  //! holds the vector field; owned by the network, do not write
   gsl_matrix * vf;
+  //! grid over the segments of tubeMatrix (and rows of vf) answering nearest tube and closest point queries
+  const P1906MOL_MOTOR_SegmentIndex * tubeIndex;
 
   //! random number generation structures and initialization
   const gsl_rng_type * T;
@@ -111,8 +131,26 @@ public:
   void setTubePersistenceLength(double persistenceLength = 50);
   //! set the number of segments per tube
   void setTubeSegments(size_t segPerTube = 10);
+  //! number of threads generating the tubes (< 2 keeps them on the calling thread)
+  void setTubeThreads(uint32_t threads);
+  uint32_t getTubeThreads() const;
+  //! number of histogram bins of the segment angles in the structural entropy
+  void setEntropyBins(uint32_t bins);
+  uint32_t getEntropyBins() const;
   //! display all the microtubule network properties
   void displayTubeChars();
+  //! generate the tubes and the vector field unless they match the current properties
+  void Build();
+  //! the tubes, the vector field and their index, built on first use
+  gsl_matrix * getTubeMatrix();
+  gsl_matrix * getVectorField();
+  const P1906MOL_MOTOR_SegmentIndex & getTubeIndex();
+  //! the network holding the tubes, built on first use, to be shared with other fields and motions
+  Ptr<const P1906MOL_MOTOR_TubeNetwork> getTubeNetwork();
+  //! use network instead of generating tubes; its properties become the field's
+  void setTubeNetwork(Ptr<const P1906MOL_MOTOR_TubeNetwork> network);
+  //! name the cytoskeleton: fields of the same non-empty environment and properties share their tubes; the default "" shares nothing
+  void setEnvironment(const string & environment);
   
   /*
    * Methods related to creating microtubules and analyzing molecular motor transport
@@ -127,6 +165,9 @@ public:
   void genTubes();
   //! plot persistence length versus structural entropy
   void persistenceVersusEntropy(gsl_vector * persistenceLengths);
+  //! structural entropy of a network of the current properties for each of persistenceLengths, the networks being 
+  //! generated concurrently; writeTubes also writes tubes_<n>.mma; the field's own tubes are left as they are
+  void persistenceSweep(const vector<double> & persistenceLengths, vector<double> & entropies, bool writeTubes = false);
 
   /*
    * Methods implementing unit tests
@@ -159,6 +200,42 @@ public:
   
   virtual ~P1906MOL_MOTOR_MicrotubulesField ();
 
+private:
+  //! derive segLength, numSegments and numTubes and mark the tubes out of date
+  void tubeCharsChanged();
+  //! point tubeMatrix, vf and tubeIndex into network
+  void adoptNetwork(Ptr<const P1906MOL_MOTOR_TubeNetwork> network);
+  //! compare ts and m_environment with m_builtTs and m_builtEnvironment
+  bool sameTubeChars();
+  
+  //! generate one network per element of chars, all of ts.numTubes tubes of ts.segPerTube segments, into tubes (kept only 
+  //! where not NULL) and return the structural entropy of each
+  void genNetworks(const vector<tubeCharacteristcs_t> & chars, vector<gsl_matrix *> & tubes, vector<double> & entropies);
+  //! take tubes of the generation in progress until none is left; no logging here, this may run outside the simulator thread
+  void genTubesWorker();
+  
+  //! a setter changed the properties since the tubes were generated or imported
+  bool m_dirty;
+  //! the properties of the tubes in tubeMatrix
+  tubeCharacteristcs_t m_builtTs;
+  //! the tubes in use, shared with whoever else uses them
+  Ptr<const P1906MOL_MOTOR_TubeNetwork> m_network;
+  //! the environment searched by Build and registered by genTubes
+  string m_environment;
+  //! the environment of the tubes in tubeMatrix
+  string m_builtEnvironment;
+  
+  uint32_t m_threads;
+  uint32_t m_entropyBins;
+  //! the generation run by genNetworks: the properties and tubes of each network, the start point and stream id of 
+  //! each tube (network major), the structural entropy of each tube and the next tube to take
+  const vector<tubeCharacteristcs_t> * m_genChars;
+  vector<gsl_matrix *> * m_genTubes;
+  gsl_matrix * m_genStarts;
+  vector<uint32_t> m_genIds;
+  vector<double> m_genSe;
+  size_t m_nextTube;
+  SystemMutex m_mutex;
 };
 
 }
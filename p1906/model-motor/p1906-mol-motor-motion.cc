@@ -49,6 +49,10 @@
 #include "ns3/object.h"
 #include "ns3/nstime.h"
 #include "ns3/ptr.h"
+#include "ns3/enum.h"
+#include "ns3/double.h"
+#include "ns3/uinteger.h"
+#include "ns3/string.h"
 
 #include "ns3/p1906-mol-motor-motion.h"
 #include "ns3/p1906-mol-motor-tube.h"
@@ -64,9 +68,6 @@
 #include "ns3/mobility-model.h"
 #include "ns3/p1906-net-device.h"
 
-//! for ODE test \todo remove before submitting
-#include "ns3/p1906-mol-diffusion.h"
-
 namespace ns3 {
 
 NS_LOG_COMPONENT_DEFINE ("P1906MOL_MOTOR_Motion");
@@ -74,7 +75,60 @@ NS_LOG_COMPONENT_DEFINE ("P1906MOL_MOTOR_Motion");
 TypeId P1906MOL_MOTOR_Motion::GetTypeId (void)
 {
   static TypeId tid = TypeId ("ns3::P1906MOL_MOTOR_Motion")
-    .SetParent<P1906MOLMotion> ();
+    .SetParent<P1906MOLMotion> ()
+    .AddAttribute ("FloatEngine",
+                   "How free-floating motors are moved: fixed Brownian steps, or walk on spheres jumps between the surfaces and tubes",
+                   EnumValue (P1906MOL_MOTOR_Motion::FixedSteps),
+                   MakeEnumAccessor (&P1906MOL_MOTOR_Motion::setFloatEngine,
+                                     &P1906MOL_MOTOR_Motion::getFloatEngine),
+                   MakeEnumChecker (P1906MOL_MOTOR_Motion::FixedSteps, "FixedSteps",
+                                    P1906MOL_MOTOR_Motion::WalkOnSpheres, "WalkOnSpheres"))
+    .AddAttribute ("StepPolicy",
+                   "How Brownian steps are sized: always timePeriod, or adapted to the distance to the nearest surface or tube with Brownian bridge hit detection",
+                   EnumValue (P1906MOL_MOTOR_Motion::FixedStep),
+                   MakeEnumAccessor (&P1906MOL_MOTOR_Motion::setStepPolicy,
+                                     &P1906MOL_MOTOR_Motion::getStepPolicy),
+                   MakeEnumChecker (P1906MOL_MOTOR_Motion::FixedStep, "FixedStep",
+                                    P1906MOL_MOTOR_Motion::AdaptiveStep, "AdaptiveStep"))
+    .AddAttribute ("StepDistanceRatio",
+                   "Root mean square length of an adaptive step over the distance to the nearest surface or tube",
+                   DoubleValue (0.2),
+                   MakeDoubleAccessor (&P1906MOL_MOTOR_Motion::m_stepDistanceRatio),
+                   MakeDoubleChecker<double> (0))
+    .AddAttribute ("MinStepFraction",
+                   "Shortest adaptive step as a fraction of timePeriod",
+                   DoubleValue (0.01),
+                   MakeDoubleAccessor (&P1906MOL_MOTOR_Motion::m_minStepFraction),
+                   MakeDoubleChecker<double> (0))
+    .AddAttribute ("MaxStepFactor",
+                   "Longest adaptive step as a multiple of timePeriod",
+                   DoubleValue (100),
+                   MakeDoubleAccessor (&P1906MOL_MOTOR_Motion::m_maxStepFactor),
+                   MakeDoubleChecker<double> (0))
+    .AddAttribute ("Trajectory",
+                   "What ComputePropagationDelay keeps of each motor trajectory: all of it, nothing, every TrajectoryDecimation-th position, the last TrajectoryRingSize positions, or all of it streamed to TrajectoryFile",
+                   EnumValue (P1906MOL_MOTOR_Motion::RecordAll),
+                   MakeEnumAccessor (&P1906MOL_MOTOR_Motion::m_trajectoryPolicy),
+                   MakeEnumChecker (P1906MOL_MOTOR_Motion::RecordAll, "All",
+                                    P1906MOL_MOTOR_Motion::RecordOff, "Off",
+                                    P1906MOL_MOTOR_Motion::RecordDecimated, "Decimated",
+                                    P1906MOL_MOTOR_Motion::RecordRing, "Ring",
+                                    P1906MOL_MOTOR_Motion::RecordStream, "Stream"))
+    .AddAttribute ("TrajectoryDecimation",
+                   "Positions between two kept ones with the Decimated trajectory",
+                   UintegerValue (100),
+                   MakeUintegerAccessor (&P1906MOL_MOTOR_Motion::m_trajectoryDecimation),
+                   MakeUintegerChecker<uint32_t> (1))
+    .AddAttribute ("TrajectoryRingSize",
+                   "Positions kept with the Ring trajectory",
+                   UintegerValue (1000),
+                   MakeUintegerAccessor (&P1906MOL_MOTOR_Motion::m_trajectoryRingSize),
+                   MakeUintegerChecker<uint32_t> (1))
+    .AddAttribute ("TrajectoryFile",
+                   "Trace file receiving the Stream trajectories of all the motors (see P1906MOL_MOTOR_TrajectoryWriter)",
+                   StringValue ("trajectories.p1906trc"),
+                   MakeStringAccessor (&P1906MOL_MOTOR_Motion::m_trajectoryFile),
+                   MakeStringChecker ());
   return tid;
 }
 
@@ -97,11 +151,21 @@ P1906MOL_MOTOR_Motion::P1906MOL_MOTOR_Motion ()
     
   NS_LOG_FUNCTION (this);
   NS_LOG_FUNCTION (this << "Created MOL Extended Motion Component");
+  m_floatEngine = FixedSteps;
+  m_stepPolicy = FixedStep;
+  m_stepDistanceRatio = 0.2;
+  m_minStepFraction = 0.01;
+  m_maxStepFactor = 100;
+  m_trajectoryPolicy = RecordAll;
+  m_trajectoryDecimation = 100;
+  m_trajectoryRingSize = 1000;
+  m_trajectoryFile = "trajectories.p1906trc";
+  m_trajectories = 0;
 }
 
 //! assumes motor is within radius of a tube, otherwise it simply returns
 //! if the motor is within radius of a tube, motor walks along along the tube until unbound (binding_time) or reaches end of tube
-void P1906MOL_MOTOR_Motion::motorWalk(Ptr<P1906MessageCarrier> carrier, gsl_rng * r, gsl_vector * startPt, vector<P1906MOL_MOTOR_Pos> &pts, gsl_matrix * tubeMatrix, size_t segPerTube, vector<P1906MOL_MOTOR_VolSurface> & vsl)
+void P1906MOL_MOTOR_Motion::motorWalk(Ptr<P1906MessageCarrier> carrier, gsl_rng * r, gsl_vector * startPt, vector<P1906MOL_MOTOR_Vec3> &pts, gsl_matrix * tubeMatrix, size_t segPerTube, vector<P1906MOL_MOTOR_VolSurface> & vsl, const P1906MOL_MOTOR_SegmentIndex * tubeIndex)
 {
   /** 
     See "Movements of Molecular Motors," Reinhard Lipowsky
@@ -109,23 +173,18 @@ void P1906MOL_MOTOR_Motion::motorWalk(Ptr<P1906MessageCarrier> carrier, gsl_rng
 	bound time ~2 sec
 	assumes startPt is on a tube in tubeMatrix
   */
-  gsl_vector * segment = gsl_vector_alloc(6);
-  gsl_vector * pt1 = gsl_vector_alloc(3);
-  gsl_vector * pt2 = gsl_vector_alloc(3);
-  P1906MOL_MOTOR_Pos Pos1;
-  P1906MOL_MOTOR_Pos Pos2;
-  //! tube radius nm
-  double radius = 15; // [nm]
+  P1906MOL_MOTOR_Vec3 segStart, segEnd;
+  //! contact radius of the tubes, the cell edge of their index [nm]
+  double radius = P1906MOL_MOTOR_TubeNetwork::contactRadius;
   //! motor movement rate (nm / sec)
   double movementRate = 1000; // [nm/s]
   //! motor mean binding time (s)
   //! double bindingTime = 2; // [s]
-  double x1, y1, z1;
-  double x2, y2, z2;
   //! motor mean binding probability (default 1.0)
   double binding_probability = 1.0; //! always bind for testing purposes
   //double binding_time = 1.0; //! sec \todo implement binding time
   Ptr<P1906MOL_Motor> motor = carrier->GetObject <P1906MOL_Motor> ();
+  P1906MOL_MOTOR_Vec3 start = vec3 (gsl_vector_get(startPt, 0), gsl_vector_get(startPt, 1), gsl_vector_get(startPt, 2));
   
   //! bind with a given probability
   if (gsl_rng_uniform(r) > binding_probability) //! \todo set realistic binding probability
@@ -135,7 +194,7 @@ void P1906MOL_MOTOR_Motion::motorWalk(Ptr<P1906MessageCarrier> carrier, gsl_rng
   }
   
   //! find the tube the motor is starting on
-  size_t seg = P1906MOL_MOTOR_Field::findNearestTube(startPt, tubeMatrix, radius); //! \todo set tube radius (thickness) globally
+  size_t seg = findNearestTube(start, tubeMatrix, tubeIndex, radius);
   
   //! no tube is within the radius, so exit
   if (seg == ULONG_MAX)
@@ -145,13 +204,7 @@ void P1906MOL_MOTOR_Motion::motorWalk(Ptr<P1906MessageCarrier> carrier, gsl_rng
   }
   
   //! record the current location
-  P1906MOL_MOTOR_Pos Pos;
-  Pos.setPos ( gsl_vector_get(startPt, 0),
-               gsl_vector_get(startPt, 1),
-               gsl_vector_get(startPt, 2) );
-  pts.insert(pts.end(), Pos);
-  //printf ("(motorWalk) recorded first location\n");
-  //Pos.displayPos();
+  pts.push_back(start);
   
   //! walk along tube for distance determined by bound time
   //! segments are sequential in tubeMatrix of length segPerTube
@@ -162,32 +215,13 @@ void P1906MOL_MOTOR_Motion::motorWalk(Ptr<P1906MessageCarrier> carrier, gsl_rng
   for (size_t i = seg; i < (seg + segToGo); i++)
   {
     //! walk to end of segment
-    P1906MOL_MOTOR_Field::line(segment, tubeMatrix, i);
+    P1906MOL_MOTOR_Field::line(tubeMatrix, i, segStart, segEnd);
 
 	//! record the position after moving to the end of the segment
-    P1906MOL_MOTOR_Pos Pos;
-	Pos.setPos ( gsl_vector_get(segment, 3), 
-	             gsl_vector_get(segment, 4), 
-			     gsl_vector_get(segment, 5) );
-	pts.insert(pts.end(), Pos);
-	//printf ("(motorWalk) segment(%ld) recorded position\n", i);
-	//Pos.displayPos();
-	
-	//! get next-to-last point
-	Pos1 = pts.at(pts.size() - 2);
-	Pos1.getPos (&x1, &y1, &z1);
-	P1906MOL_MOTOR_Field::point (pt1, x1, y1, z1);
+	pts.push_back(segEnd);
 	
-	//! get last point
-    Pos2 = pts.at(pts.size() - 1);
-	Pos2.getPos (&x2, &y2, &z2);
-    P1906MOL_MOTOR_Field::point (pt2, x2, y2, z2);
-
-	//printf ("(motorWalk) distance: %f movementRate: %f time: %f\n", 
-	//  P1906MOL_MOTOR_Field::distance(pt1, pt2), 
-	//  movementRate, 
-	//  P1906MOL_MOTOR_Field::distance(pt1, pt2) / movementRate);
-    motor->updateTime(P1906MOL_MOTOR_Field::distance(pt1, pt2) / movementRate);
+	//! time taken from the next-to-last to the last point
+    motor->updateTime(vec3Norm(pts.at(pts.size() - 1) - pts.at(pts.size() - 2)) / movementRate);
   }
 }
 
@@ -203,44 +237,32 @@ void P1906MOL_MOTOR_Motion::displayPos(gsl_vector *pt)
 //! motor is unbound from tube and floats via Brownian motion until it makes contact with a tube
 //!   pts - locations of the motor during its random walk comprised of npts
 //!   startPt - where the motor began its random walk
-//!   timePeriod - length of each step of the walk
+//!   timePeriod - length of each step of the walk (moves are jumps with the WalkOnSpheres FloatEngine)
 //!   returns the index of the contact segment in tubeMatrix
-size_t P1906MOL_MOTOR_Motion::float2Tube(Ptr<P1906MessageCarrier> carrier, gsl_rng * r, gsl_vector * startPt, vector<P1906MOL_MOTOR_Pos> &pts, gsl_matrix * tubeMatrix, double timePeriod, vector<P1906MOL_MOTOR_VolSurface> & vsl)
+size_t P1906MOL_MOTOR_Motion::float2Tube(Ptr<P1906MessageCarrier> carrier, gsl_rng * r, gsl_vector * startPt, vector<P1906MOL_MOTOR_Vec3> &pts, gsl_matrix * tubeMatrix, double timePeriod, vector<P1906MOL_MOTOR_VolSurface> & vsl, const P1906MOL_MOTOR_SegmentIndex * tubeIndex)
 {
-  gsl_vector * currentPos = gsl_vector_alloc (3);
-  gsl_vector * newPos = gsl_vector_alloc (3);
+  P1906MOL_MOTOR_Vec3 currentPos;
   int numPts = 0; //! total number of points traversed
   double timeout = 100; //! stop if no tube found
   int ts; //! nearest tube segment
-  double radius = 15;
+  double radius = P1906MOL_MOTOR_TubeNetwork::contactRadius; //! [nm]
   Ptr<P1906MOL_Motor> motor = carrier->GetObject <P1906MOL_Motor> ();
   double D = 1.0; //! mass diffusivity (default)
+  vector<P1906MOL_MOTOR_Sphere> spheres;
   
   D = GetDiffusionConefficient ();
+  P1906MOL_MOTOR_VolSurface::getSpheres (vsl, spheres);
   
   //! begin at the starting point
-  P1906MOL_MOTOR_Field::point (currentPos, 
-    gsl_vector_get (startPt, 0), 
-	gsl_vector_get (startPt, 1), 
-	gsl_vector_get (startPt, 2));
+  currentPos = vec3 (gsl_vector_get (startPt, 0), gsl_vector_get (startPt, 1), gsl_vector_get (startPt, 2));
 
   //! float to the nearest tube within a given radius
   for (int i = 0; i < timeout; i++)
   {
-    P1906MOL_MOTOR_Pos Pos;
-	Pos.setPos ( gsl_vector_get (currentPos, 0), 
-	             gsl_vector_get (currentPos, 1), 
-			     gsl_vector_get (currentPos, 2) );
-	//printf ("(float2Tube) position\n");
-	//Pos.displayPos ();
-	pts.insert(pts.end(), Pos);
+	pts.push_back(currentPos);
 	numPts++; //! consider starting position the first point
-	brownianMotion(r, currentPos, newPos, timePeriod, D, vsl);
-	motor->updateTime(timePeriod);
-    gsl_vector_set (currentPos, 0, gsl_vector_get (newPos, 0));
-	gsl_vector_set (currentPos, 1, gsl_vector_get (newPos, 1));
-	gsl_vector_set (currentPos, 2, gsl_vector_get (newPos, 2));
-	ts = P1906MOL_MOTOR_Field::findNearestTube(currentPos, tubeMatrix, radius);
+	motor->updateTime(floatMove(r, currentPos, timePeriod, D, spheres, tubeMatrix, tubeIndex, radius));
+	ts = findNearestTube(currentPos, tubeMatrix, tubeIndex, radius);
 	if ( ts !=  -1 )
 	{
 	  printf ("motor contact with segment: %d\n", ts);
@@ -251,100 +273,320 @@ size_t P1906MOL_MOTOR_Motion::float2Tube(Ptr<P1906MessageCarrier> carrier, gsl_r
   return ts;
 }
 
+//! float2Tube tests for contact after every step, so with many tubes the index turns a scan of
+//! every segment into a visit of the few grid cells around the motor
+size_t P1906MOL_MOTOR_Motion::findNearestTube(const P1906MOL_MOTOR_Vec3 & pt, gsl_matrix * tubeMatrix, const P1906MOL_MOTOR_SegmentIndex * tubeIndex, double radius)
+{
+  if (tubeIndex && tubeIndex->size () == tubeMatrix->size1)
+    return P1906MOL_MOTOR_Field::findNearestTube(pt, *tubeIndex, radius);
+  return P1906MOL_MOTOR_Field::findNearestTube(pt, tubeMatrix, radius);
+}
+
+//! with WalkOnSpheres, a motor farther than one step length from every surface and tube jumps to a uniformly
+//! distributed point of the largest empty sphere around it: by symmetry this is where Brownian motion started
+//! at the centre first leaves the sphere, and the time of that exit is drawn from its exact distribution.
+//! closer in, fixed steps handle the reflection and absorption exactly as the step engine does
+//! with AdaptiveStep the step is sized from the same distance: long far from everything, down to
+//! MinStepFraction x timePeriod at the surfaces, where the bridge test catches the hits the step skipped over
+double P1906MOL_MOTOR_Motion::floatMove(gsl_rng * r, P1906MOL_MOTOR_Vec3 & pos, double timePeriod, double D, const vector<P1906MOL_MOTOR_Sphere> & spheres, gsl_matrix * tubeMatrix, const P1906MOL_MOTOR_SegmentIndex * tubeIndex, double contactRadius)
+{
+  P1906MOL_MOTOR_Vec3 newPos;
+  double step = timePeriod;
+  double R = GSL_POSINF;
+  
+  if (m_floatEngine == WalkOnSpheres || m_stepPolicy == AdaptiveStep)
+    R = emptySphereRadius(pos, spheres, tubeMatrix, tubeIndex, contactRadius);
+  
+  if (m_floatEngine == WalkOnSpheres)
+  {
+    //! root mean square length of a fixed step
+    double stepLength = sqrt(6 * D * timePeriod);
+    
+    //! an unbounded sphere has no exit: keep stepping until something is in reach
+    if (R > stepLength && gsl_finite (R))
+    {
+      double dir[3];
+      
+      gsl_ran_dir_3d (r, &dir[0], &dir[1], &dir[2]);
+      pos = pos + vec3 (dir[0], dir[1], dir[2]) * R;
+      return sphereFirstPassageTime(r, R, D);
+    }
+  }
+  
+  if (m_stepPolicy == AdaptiveStep)
+  {
+    //! root mean square step sqrt(6 D step) = StepDistanceRatio x R
+    double ratio = m_stepDistanceRatio * R;
+    step = m_maxStepFactor * timePeriod;
+    if (gsl_finite (R))
+      step = min (step, max (m_minStepFraction * timePeriod, ratio * ratio / (6 * D)));
+    
+    brownianMotion(r, pos, newPos, step, D, spheres);
+    bridgeHit(r, pos, newPos, step, D, spheres, tubeMatrix, tubeIndex, contactRadius);
+  }
+  else
+    brownianMotion(r, pos, newPos, step, D, spheres);
+  
+  pos = newPos;
+  return step;
+}
+
+//! a Brownian path of variance 2 D t per axis conditioned on its end points crosses a plane at distances d0 and d1
+//! from them (on the same side) with probability exp(-d0 d1 / (D t)); the receivers and the tube contact zones
+//! are treated as locally flat. a reflective barrier needs no such test: reflecting the end point of the free step
+//! already gives the exact distribution of the reflected motion
+bool P1906MOL_MOTOR_Motion::bridgeHit(gsl_rng * r, const P1906MOL_MOTOR_Vec3 & pos, P1906MOL_MOTOR_Vec3 & newPos, double timePeriod, double D, const vector<P1906MOL_MOTOR_Sphere> & spheres, gsl_matrix * tubeMatrix, const P1906MOL_MOTOR_SegmentIndex * tubeIndex, double contactRadius)
+{
+  double Dt = D * timePeriod;
+  
+  for (size_t i = 0; i < spheres.size(); i++)
+  {
+    if (spheres[i].type != P1906MOL_MOTOR_VolSurface::Receiver)
+      continue;
+    
+    P1906MOL_MOTOR_Vec3 c = spheres[i].center;
+    double a = spheres[i].radius;
+    double d0 = vec3Norm (pos - c) - a;
+    double d1 = vec3Norm (newPos - c) - a;
+    
+    if (d0 > 0 && d1 > 0 && gsl_rng_uniform (r) < exp (-d0 * d1 / Dt))
+    {
+      //! absorbed: the motor ends just inside the receiver, next to where the step ended
+      newPos = c + (newPos - c) * ((1 - 1e-9) * a / (d1 + a));
+      return true;
+    }
+  }
+  
+  if (tubeMatrix && tubeMatrix->size1 > 0)
+  {
+    //! beyond six standard deviations of the step the crossing probability is below exp(-36)
+    double search = contactRadius + 6 * sqrt(2 * Dt);
+    size_t s;
+    P1906MOL_MOTOR_Vec3 p1, p2;
+    
+    if (tubeIndex && tubeIndex->size () == tubeMatrix->size1)
+      s = P1906MOL_MOTOR_Field::findNearestTube(newPos, *tubeIndex, search);
+    else
+      s = P1906MOL_MOTOR_Field::findNearestTube(newPos, tubeMatrix, search);
+    if (s == (size_t) -1)
+      return false;
+    
+    P1906MOL_MOTOR_Field::line(tubeMatrix, s, p1, p2);
+    P1906MOL_MOTOR_Vec3 q = vec3SegmentClosestPoint (newPos, p1, p2);
+    double d0 = vec3SegmentDistance (pos, p1, p2) - contactRadius;
+    double d1 = vec3Norm (newPos - q) - contactRadius;
+    
+    if (d0 > 0 && d1 > 0 && gsl_rng_uniform (r) < exp (-d0 * d1 / Dt))
+    {
+      //! contact: the motor ends just inside the contact zone of the segment
+      newPos = q + (newPos - q) * ((1 - 1e-9) * contactRadius / (d1 + contactRadius));
+      return true;
+    }
+  }
+  
+  return false;
+}
+
+//! the tubes are searched no farther than the surfaces already allow; with an index the search is
+//! also capped at a few grid cells, the sphere simply staying within the part searched
+double P1906MOL_MOTOR_Motion::emptySphereRadius(const P1906MOL_MOTOR_Vec3 & pt, const vector<P1906MOL_MOTOR_Sphere> & spheres, gsl_matrix * tubeMatrix, const P1906MOL_MOTOR_SegmentIndex * tubeIndex, double contactRadius)
+{
+  double R = GSL_POSINF;
+  
+  for (size_t i = 0; i < spheres.size(); i++)
+  {
+    //! a FluxMeter only counts crossings and does not bound the motion
+    if (spheres[i].type == P1906MOL_MOTOR_VolSurface::FluxMeter)
+      continue;
+    R = min (R, fabs (vec3Norm (spheres[i].center - pt) - spheres[i].radius));
+  }
+  
+  if (tubeMatrix && tubeMatrix->size1 > 0)
+  {
+    double search = R + contactRadius;
+    size_t s;
+    P1906MOL_MOTOR_Vec3 p1, p2;
+    
+    if (tubeIndex && tubeIndex->size () == tubeMatrix->size1)
+    {
+      search = min (search, 8 * tubeIndex->getCellSize ());
+      s = P1906MOL_MOTOR_Field::findNearestTube(pt, *tubeIndex, search);
+    }
+    else
+      s = P1906MOL_MOTOR_Field::findNearestTube(pt, tubeMatrix, search);
+    
+    if (s != (size_t) -1)
+    {
+      P1906MOL_MOTOR_Field::line(tubeMatrix, s, p1, p2);
+      R = min (R, vec3SegmentDistance (pt, p1, p2) - contactRadius);
+    }
+    else
+      R = min (R, search - contactRadius);
+  }
+  
+  return max (R, 0.0);
+}
+
+//! distribution function F of the time T a unit diffusivity Brownian motion takes from the centre to the surface
+//! of the unit sphere; its density is returned in density. Two expansions of the same theta function are used:
+//!   F(t) = 1 - 2 sum_{n>=1} (-1)^(n+1) exp(-n^2 pi^2 t)           (converges fast for large t)
+//!   F(t) = 2 / sqrt(pi t) sum_{k>=0} exp(-(k + 1/2)^2 / t)        (converges fast for small t)
+static double sphereExitCdf (double t, double * density)
+{
+  double F = 0;
+  double f = 0;
+  
+  if (t <= 0)
+  {
+    *density = 0;
+    return 0;
+  }
+  
+  if (t < 0.1)
+  {
+    for (int k = 0; k < 4; k++)
+    {
+      double a = (k + 0.5) * (k + 0.5);
+      double e = 2 * exp (-a / t) / sqrt (M_PI * t);
+      F += e;
+      f += e * (a / (t * t) - 0.5 / t);
+    }
+  }
+  else
+  {
+    F = 1;
+    for (int n = 1; n <= 8; n++)
+    {
+      double e = ((n % 2) ? 2 : -2) * exp (-n * n * M_PI * M_PI * t);
+      F -= e;
+      f += e * n * n * M_PI * M_PI;
+    }
+  }
+  
+  *density = f;
+  return F;
+}
+
+//! invert F for a uniform variate with safeguarded Newton iterations, then scale to the sphere: T R^2 / D
+//! E[T] = 1/6, matching the mean exit time R^2 / (6 D) of the steps of variance 2 D t per axis
+double P1906MOL_MOTOR_Motion::sphereFirstPassageTime(gsl_rng * r, double R, double D)
+{
+  double u = gsl_rng_uniform_pos (r);
+  //! F(hi) > u since 1 - F(t) <= 2 exp(-pi^2 t) once t >= 0.5
+  double lo = 0;
+  double hi = log (2 / (1 - u)) / (M_PI * M_PI) + 0.5;
+  double t = (u > 0.5) ? hi - 0.5 : 0.1;
+  double F, f;
+  
+  for (int i = 0; i < 100; i++)
+  {
+    F = sphereExitCdf (t, &f);
+    if (F < u)
+      lo = t;
+    else
+      hi = t;
+    if (fabs (F - u) < 1e-13)
+      break;
+    
+    double next = t - (F - u) / f;
+    if (!(next > lo && next < hi))
+      next = 0.5 * (lo + hi);
+    if (fabs (next - t) <= 1e-15 * t)
+    {
+      t = next;
+      break;
+    }
+    t = next;
+  }
+  
+  return t * R * R / D;
+}
+
 //! return newPos based upon Brownian motion from currentPos over timePeriod.
 //! distance travelled will be a function of particle diameter, temperature, diffusion coefficient.
 //! for simplicity, the second moment is \f$\bar{x^2} = 2 D t\f$, where \f$D\f$ is the mass diffusivity and \f$t\f$ is time.
 //! note that Brownian motion landing on a receiver is a form of the "narrow escape" problem.
 void P1906MOL_MOTOR_Motion::brownianMotion(gsl_rng * r, gsl_vector * currentPos, gsl_vector * newPos, double timePeriod, double D, vector<P1906MOL_MOTOR_VolSurface> & vsl)
+{
+  P1906MOL_MOTOR_Vec3 np;
+  
+  brownianMotion(r, 
+    vec3 (gsl_vector_get (currentPos, 0), gsl_vector_get (currentPos, 1), gsl_vector_get (currentPos, 2)),
+    np, timePeriod, D, vsl);
+  P1906MOL_MOTOR_Field::point (newPos, np.x, np.y, np.z);
+}
+
+void P1906MOL_MOTOR_Motion::brownianMotion(gsl_rng * r, const P1906MOL_MOTOR_Vec3 & currentPos, P1906MOL_MOTOR_Vec3 & newPos, double timePeriod, double D, vector<P1906MOL_MOTOR_VolSurface> & vsl)
+{
+  vector<P1906MOL_MOTOR_Sphere> spheres;
+  
+  P1906MOL_MOTOR_VolSurface::getSpheres (vsl, spheres);
+  brownianMotion(r, currentPos, newPos, timePeriod, D, spheres);
+}
+
+//! the step itself works on plain 3D points and spheres: no Object, gsl_vector or segment is allocated per step
+void P1906MOL_MOTOR_Motion::brownianMotion(gsl_rng * r, const P1906MOL_MOTOR_Vec3 & currentPos, P1906MOL_MOTOR_Vec3 & newPos, double timePeriod, double D, const vector<P1906MOL_MOTOR_Sphere> & spheres)
 {
   //! the new position is Gaussian with variance proportional to time taken: W_t - W_s ~ N(0, t - s)
   //! sigma is the standard deviation
   double sigma = sqrt(2 * D * timePeriod); /* sigma should be proportional to time */
+  P1906MOL_MOTOR_Vec3 cp = currentPos;
   
-  P1906MOL_MOTOR_Field::point (newPos, 
-    gsl_vector_get (currentPos, 0) + gsl_ran_gaussian (r, sigma), /* x distance */
-    gsl_vector_get (currentPos, 1) + gsl_ran_gaussian (r, sigma), /* y distance */
-    gsl_vector_get (currentPos, 2) + gsl_ran_gaussian (r, sigma)  /* z distance */
-  );
-  
-  //! check for reflection if contact with the volume surface of a P1906MOL_MOTOR_VolSurface::ReflectiveBarrier
-  vector<P1906MOL_MOTOR_Pos> ipt;
-  gsl_vector * segment = gsl_vector_alloc (6);
-  P1906MOL_MOTOR_Pos cp, np;
-  
-  cp.setPos (currentPos);
-  //printf ("(brownianMotion) current position\n");
-  //cp.displayPos ();
-  np.setPos (newPos);
-  //printf ("(brownianMotion) new position\n");
-  //np.displayPos ();
+  double step[3];
   
-  P1906MOL_MOTOR_Field::line (segment, cp, np);
-  //P1906MOL_MOTOR_Field::displayLine (segment);
+  //! the three displacements are drawn as one block
+  P1906MOL_MOTOR_RngStreams::Gaussians (r, sigma, step, 3);
+  newPos.x = cp.x + step[0]; /* x distance */
+  newPos.y = cp.y + step[1]; /* y distance */
+  newPos.z = cp.z + step[2]; /* z distance */
   
-  //printf ("(brownianMotion) vsl.size: %ld\n", vsl.size());
+  //! check for reflection if contact with the volume surface of a P1906MOL_MOTOR_VolSurface::ReflectiveBarrier
+  vector<P1906MOL_MOTOR_Vec3> ipt;
+  P1906MOL_MOTOR_Vec3 np = newPos;
   
   //! there could be more than one reflective surface to check
-  for (size_t i = 0; i < vsl.size(); i++)
+  for (size_t i = 0; i < spheres.size(); i++)
   {
-    //printf ("(brownianMotion) volume surface (%ld) Type: %d ReflectiveBarrier %d\n", i, vsl.at(i).getType(), P1906MOL_MOTOR_VolSurface::ReflectiveBarrier);
-	//vsl.at(i).displayVolSurface();
-	
-    if (vsl.at(i).getType() == P1906MOL_MOTOR_VolSurface::ReflectiveBarrier)
+    if (spheres[i].type == P1906MOL_MOTOR_VolSurface::ReflectiveBarrier)
     {
-      vsl.at(i).sphereIntersections(segment, ipt);
-	  
-	  //printf ("(brownianMotion) ipt.size(): %ld\n", ipt.size());
+      //! the trajectory tested is always the unreflected step
+      spheres[i].intersections(cp, newPos, ipt);
 	  
 	  //! intersection with volume surface
 	  if (ipt.size() != 0)
 	  {
-	    //printf ("(brownianMotion) surface intersection\n");
-	    //ipt.front().displayPos ();
-	  
 	    //! reflect np from surface
-	    vsl.at(i).reflect(cp, np);
-	  
-	    //! update the reflected position
-        np.getPos (newPos);
-        //printf ("(brownianMotion) after reflection\n");
-        //np.displayPos ();
+	    spheres[i].reflect(cp, np);
 	  }
     }
   }
   
-  //printf ("(brownianMotion) End\n");
+  //! update the reflected position
+  newPos = np;
 }
 
 //! implements a motor floating via Brownian motion for time steps with step lengths of timePeriod
-int P1906MOL_MOTOR_Motion::freeFloat(Ptr<P1906MessageCarrier> carrier, gsl_rng * r, gsl_vector * startPt, vector<P1906MOL_MOTOR_Pos> & pts, int time, double timePeriod, vector<P1906MOL_MOTOR_VolSurface> & vsl)
+int P1906MOL_MOTOR_Motion::freeFloat(Ptr<P1906MessageCarrier> carrier, gsl_rng * r, gsl_vector * startPt, vector<P1906MOL_MOTOR_Vec3> & pts, int time, double timePeriod, vector<P1906MOL_MOTOR_VolSurface> & vsl)
 {
   //P1906MOL_MOTOR_Tube tube;
-  gsl_vector * currentPos = gsl_vector_alloc (3);
-  gsl_vector * newPos = gsl_vector_alloc (3);
-  P1906MOL_MOTOR_Field::point (currentPos, 
-    gsl_vector_get (currentPos, 0), 
-	gsl_vector_get (currentPos, 1), 
-	gsl_vector_get (currentPos, 2));
+  P1906MOL_MOTOR_Vec3 currentPos;
+  P1906MOL_MOTOR_Vec3 newPos;
+  currentPos = vec3 (gsl_vector_get (startPt, 0), gsl_vector_get (startPt, 1), gsl_vector_get (startPt, 2));
   int numPts = 0;
   Ptr<P1906MOL_Motor> motor = carrier->GetObject <P1906MOL_Motor> ();
   double D = 1.0; //! mass diffusivity (default)
+  vector<P1906MOL_MOTOR_Sphere> spheres;
    
   D = GetDiffusionConefficient ();
+  P1906MOL_MOTOR_VolSurface::getSpheres (vsl, spheres);
   
   for (int i = 0; i < time; i++)
   {
- 	P1906MOL_MOTOR_Pos Pos;
-	Pos.setPos ( gsl_vector_get (currentPos, 0), 
-	             gsl_vector_get (currentPos, 1), 
-			     gsl_vector_get (currentPos, 2) );
-	pts.insert(pts.end(), Pos);
+	pts.push_back(currentPos);
 	
-	brownianMotion(r, currentPos, newPos, timePeriod, D, vsl);
+	brownianMotion(r, currentPos, newPos, timePeriod, D, spheres);
 	motor->updateTime(timePeriod);
-    gsl_vector_set (currentPos, 0, gsl_vector_get (newPos, 0));
-	gsl_vector_set (currentPos, 1, gsl_vector_get (newPos, 1));
-	gsl_vector_set (currentPos, 2, gsl_vector_get (newPos, 2));
+    currentPos = newPos;
     numPts++;
   }
   
@@ -394,17 +636,11 @@ double P1906MOL_MOTOR_Motion::ComputePropagationDelay (Ptr<P1906CommunicationInt
   gsl_vector * startPt = gsl_vector_alloc (3);
   double timePeriod = 100;
   char plot_filename[256];
+  vector<P1906MOL_MOTOR_Vec3> history;
   //! fix the units used here with those passed in via _RUN_MOTOR_CHANNEL_CAPACITY_
   float distanceMultiplier = pow(10.0, 9); //! convert meters to nanometers
   double D = 1.0; //! mass diffusivity (default)
   
-  //! begin test of ODE - \todo remove before submitting
-  P1906MOL_ExtendedDiffusion dif;
-  dif.displayODE ();
-  dif.unitTest_ODE ();
-  dif.unitTest_diffusion ();
-  //! end test of ODE
-
   NS_LOG_FUNCTION (this << "beginning ComputePropagationDelay");
   
   //! reusing the coefficient from the MOL model that is entered at run time
@@ -424,6 +660,16 @@ double P1906MOL_MOTOR_Motion::ComputePropagationDelay (Ptr<P1906CommunicationInt
  
   //! reset the motor's timer
   motor->initTime();
+  
+  //! with an ensemble, the delay is drawn from the distribution of the link using the motor's own stream
+  if (m_delayEnsemble)
+  {
+    double delay = m_delayEnsemble->getDistribution (this, sv, dv).sample (gsl_rng_uniform (motor->r));
+    motor->updateTime (delay);
+    gsl_vector_free (startPt);
+    NS_LOG_FUNCTION (this << "[sampled propagation time]" << delay);
+    return delay;
+  }
    
   //! Starting position is the transmitting node location
   P1906MOL_MOTOR_Field::point (startPt, sv.x, sv.y, sv.z);
@@ -445,12 +691,18 @@ double P1906MOL_MOTOR_Motion::ComputePropagationDelay (Ptr<P1906CommunicationInt
    * move randomly until destination reached
    */
   motor->setStartingPoint(startPt);
+  gsl_vector_free (startPt);
+  motor->setTrajectory(createTrajectorySink ());
   
   float2Destination(motor, timePeriod);
   
   NS_LOG_FUNCTION (this << "[propagation time]" << motor->getTime());
-  sprintf (plot_filename, "float2destination_%lf_%lf.mma", sv.x, dv.x * distanceMultiplier);
-  mathematica.connectedPoints2Mma(motor->pos_history, plot_filename);
+  //! only a trajectory held in memory is plotted; a streamed one is already in TrajectoryFile
+  if (motor->trajectory->getPoints(history))
+  {
+    sprintf (plot_filename, "float2destination_%lf_%lf.mma", sv.x, dv.x * distanceMultiplier);
+    mathematica.connectedPoints2Mma(history, plot_filename);
+  }
   
   NS_LOG_FUNCTION (this << "completed ComputePropagationDelay");
   
@@ -470,46 +722,105 @@ Ptr<P1906MessageCarrier> P1906MOL_MOTOR_Motion::CalculateReceivedMessageCarrier(
   return motor;
 }
 
+//! motor motion is stochastic: each carrier must be simulated, never memoized by the medium
+bool P1906MOL_MOTOR_Motion::IsCacheable (void)
+{
+  NS_LOG_FUNCTION (this);
+  return false;
+}
+
+//! the worker threads of the medium never share a motor: each receiver floats its own, seeded from stream
+//! drawing from an ensemble is cheap and builds the distributions on first use, so it stays on the simulator thread
+bool P1906MOL_MOTOR_Motion::IsThreadSafe (void)
+{
+  NS_LOG_FUNCTION (this);
+  return !m_delayEnsemble;
+}
+
+//! the transmitted motor is left untouched; the random numbers come from a private generator
+double P1906MOL_MOTOR_Motion::ComputePropagationDelayConcurrent (const Vector &sv,
+                                                                 const Vector &dv,
+                                                                 P1906MessageCarrier *message,
+                                                                 P1906Field *field,
+                                                                 uint64_t stream)
+{
+  //! one stream per transmission (high word) and receiver (low word), so that the result does not depend on the thread schedule
+  return floatDelay (sv, dv, (uint32_t) stream, (uint32_t) (stream >> 32), P1906MOL_MOTOR_RngStreams::ReceiverMotion);
+}
+
+//! same walk as ComputePropagationDelay, without the console output and the .mma trajectory
+//! nothing here creates an Object, takes a Ptr or logs, so it is safe on the worker threads of the medium
+double P1906MOL_MOTOR_Motion::floatDelay (const Vector &sv, const Vector &dv, uint32_t node, uint32_t id, P1906MOL_MOTOR_RngStreams::Purpose purpose)
+{
+  P1906MOL_MOTOR_FloatWalk walk (node, id, purpose);
+  double timePeriod = 100;
+  float distanceMultiplier = pow(10.0, 9); //! convert meters to nanometers
+  double time = 0;
+  P1906MOL_MOTOR_Vec3 currentPos = vec3 (sv.x, sv.y, sv.z);
+  P1906MOL_MOTOR_Sphere receiver, barrier;
+  
+  //! the surfaces ComputePropagationDelay adds to its motor
+  receiver.center = vec3 (dv.x * distanceMultiplier, dv.y, dv.z);
+  receiver.radius = (dv.x * distanceMultiplier)/1.0001;
+  receiver.type = P1906MOL_MOTOR_VolSurface::Receiver;
+  barrier.center = vec3 (sv.x, sv.y, sv.z);
+  barrier.radius = distanceMultiplier * (dv.x + (0.1 * dv.x));
+  barrier.type = P1906MOL_MOTOR_VolSurface::ReflectiveBarrier;
+  walk.spheres.push_back (receiver);
+  walk.spheres.push_back (barrier);
+  
+  while (!walk.inDestination (currentPos))
+    time += floatMove(walk.r, currentPos, timePeriod, m_diffusionCoefficient, walk.spheres);
+  
+  return time;
+}
+
+P1906MOL_MOTOR_FloatWalk::P1906MOL_MOTOR_FloatWalk (uint32_t node, uint32_t id, P1906MOL_MOTOR_RngStreams::Purpose purpose)
+{
+  r = P1906MOL_MOTOR_RngStreams::Create (node, id, purpose);
+}
+
+//! as P1906MOL_Motor::inDestination, without the warning when there is no receiver
+bool P1906MOL_MOTOR_FloatWalk::inDestination (const P1906MOL_MOTOR_Vec3 & pt) const
+{
+  for (size_t i = 0; i < spheres.size(); i++)
+  {
+    if (spheres[i].type == P1906MOL_MOTOR_VolSurface::Receiver && spheres[i].isInside (pt))
+      return true;
+  }
+  return false;
+}
+
+P1906MOL_MOTOR_FloatWalk::~P1906MOL_MOTOR_FloatWalk ()
+{
+  gsl_rng_free (r);
+}
+
 //! motor uses Brownian motion until the destination volume is reached
 void P1906MOL_MOTOR_Motion::float2Destination(Ptr<P1906MessageCarrier> carrier, double timePeriod)
 {
-  gsl_vector * newPos = gsl_vector_alloc (3);
-  P1906MOL_MOTOR_Pos Pos;
+  P1906MOL_MOTOR_Vec3 currentPos;
   Ptr<P1906MOL_Motor> motor = carrier->GetObject <P1906MOL_Motor> ();
   double D = 1.0; //! mass diffusivity (default)
+  vector<P1906MOL_MOTOR_Sphere> spheres;
     
   D = GetDiffusionConefficient ();
+  P1906MOL_MOTOR_VolSurface::getSpheres (motor->vsl, spheres);
   
-  Pos.setPos ( gsl_vector_get (motor->current_location, 0),
-               gsl_vector_get (motor->current_location, 1),
-			   gsl_vector_get (motor->current_location, 2) );
-  motor->pos_history.insert (motor->pos_history.end(), Pos);
+  currentPos = motor->getLocation();
+  motor->recordPosition (currentPos);
   
-  //printf ("(float2Destination) motor location:\n");
-  //displayPos(current_location);
-	
   //! float until in destination volume
   while (!motor->inDestination())
   {
-	brownianMotion(motor->r, motor->current_location, newPos, timePeriod, D, motor->vsl);
-	motor->updateTime(timePeriod);
-    gsl_vector_set (motor->current_location, 0, gsl_vector_get (newPos, 0));
-	gsl_vector_set (motor->current_location, 1, gsl_vector_get (newPos, 1));
-	gsl_vector_set (motor->current_location, 2, gsl_vector_get (newPos, 2));
-	
-    //printf ("(float2Destination) motor location:\n");
-    //displayPos(current_location);
-	
-	P1906MOL_MOTOR_Pos Pos;
-    Pos.setPos ( gsl_vector_get (motor->current_location, 0),
-                 gsl_vector_get (motor->current_location, 1),
-			     gsl_vector_get (motor->current_location, 2) );
-    motor->pos_history.insert (motor->pos_history.end(), Pos);
+	motor->updateTime(floatMove(motor->r, currentPos, timePeriod, D, spheres));
+    motor->setLocation(currentPos);
+    motor->recordPosition (currentPos);
   }
 }
 
 //! use microtubules, if available, Brownian motion otherwise until destination is reached
-void P1906MOL_MOTOR_Motion::move2Destination(Ptr<P1906MessageCarrier> carrier, gsl_matrix * tubeMatrix, size_t segPerTube, double timePeriod, vector<P1906MOL_MOTOR_Pos> & pts)
+void P1906MOL_MOTOR_Motion::move2Destination(Ptr<P1906MessageCarrier> carrier, gsl_matrix * tubeMatrix, size_t segPerTube, double timePeriod, vector<P1906MOL_MOTOR_Vec3> & pts, const P1906MOL_MOTOR_SegmentIndex * tubeIndex)
 {
   int timeout = 100; //! in case motor never reaches destination
   int loops = 0; //! keep track of iterations
@@ -518,13 +829,13 @@ void P1906MOL_MOTOR_Motion::move2Destination(Ptr<P1906MessageCarrier> carrier, g
   while (!motor->inDestination() && (loops < timeout))
   {
     //! returns the index of the segment in tubeMatrix to which the motor is bound 
-    float2Tube(motor, motor->r, motor->current_location, pts, tubeMatrix, timePeriod, motor->vsl);
+    float2Tube(motor, motor->r, motor->current_location, pts, tubeMatrix, timePeriod, motor->vsl, tubeIndex);
 	motor->setLocation(pts.back());
     //printf ("(move2Destination) current location after float2Tube\n");
 	//displayLocation();
 	//pts.back().displayPos();
 	//! walk along tube until end of tube or unbound
-	motorWalk(motor, motor->r, motor->current_location, pts, tubeMatrix, segPerTube, motor->vsl);
+	motorWalk(motor, motor->r, motor->current_location, pts, tubeMatrix, segPerTube, motor->vsl, tubeIndex);
 	motor->setLocation(pts.back());
     //printf ("(move2Destination) current location after motorWalk\n");
 	//pts.back().displayPos();
@@ -533,6 +844,64 @@ void P1906MOL_MOTOR_Motion::move2Destination(Ptr<P1906MessageCarrier> carrier, g
   }
 }
 
+void P1906MOL_MOTOR_Motion::move2Destination(Ptr<P1906MessageCarrier> carrier, Ptr<const P1906MOL_MOTOR_TubeNetwork> network, double timePeriod, vector<P1906MOL_MOTOR_Vec3> & pts)
+{
+  move2Destination(carrier, network->getTubeMatrix (), network->getSegPerTube (), timePeriod, pts, &network->getTubeIndex ());
+}
+
+void P1906MOL_MOTOR_Motion::setDelayEnsemble (Ptr<P1906MOL_MOTOR_DelayEnsemble> ensemble)
+{
+  NS_LOG_FUNCTION (this << ensemble);
+  m_delayEnsemble = ensemble;
+}
+
+Ptr<P1906MOL_MOTOR_DelayEnsemble> P1906MOL_MOTOR_Motion::getDelayEnsemble ()
+{
+  return m_delayEnsemble;
+}
+
+void P1906MOL_MOTOR_Motion::setFloatEngine (FloatEngine engine)
+{
+  NS_LOG_FUNCTION (this << engine);
+  m_floatEngine = engine;
+}
+
+P1906MOL_MOTOR_Motion::FloatEngine P1906MOL_MOTOR_Motion::getFloatEngine () const
+{
+  return m_floatEngine;
+}
+
+//! the Stream writer is opened with the first streamed motor and shared by all the later ones
+Ptr<P1906MOL_MOTOR_TrajectorySink> P1906MOL_MOTOR_Motion::createTrajectorySink ()
+{
+  switch (m_trajectoryPolicy)
+  {
+    case RecordOff:
+      return Create<P1906MOL_MOTOR_TrajectoryOff> ();
+    case RecordDecimated:
+      return Create<P1906MOL_MOTOR_TrajectoryDecimated> (m_trajectoryDecimation);
+    case RecordRing:
+      return Create<P1906MOL_MOTOR_TrajectoryRing> (m_trajectoryRingSize);
+    case RecordStream:
+      if (!m_trajectoryWriter)
+        m_trajectoryWriter = Create<P1906MOL_MOTOR_TrajectoryWriter> (m_trajectoryFile);
+      return Create<P1906MOL_MOTOR_TrajectoryStream> (m_trajectoryWriter, m_trajectories++);
+    default:
+      return Create<P1906MOL_MOTOR_TrajectoryAll> ();
+  }
+}
+
+void P1906MOL_MOTOR_Motion::setStepPolicy (StepPolicy policy)
+{
+  NS_LOG_FUNCTION (this << policy);
+  m_stepPolicy = policy;
+}
+
+P1906MOL_MOTOR_Motion::StepPolicy P1906MOL_MOTOR_Motion::getStepPolicy () const
+{
+  return m_stepPolicy;
+}
+
 P1906MOL_MOTOR_Motion::~P1906MOL_MOTOR_Motion ()
 {
   NS_LOG_FUNCTION (this);
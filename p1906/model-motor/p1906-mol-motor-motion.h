@@ -48,9 +48,39 @@ using namespace std;
 #include "ns3/p1906-mol-motion.h"
 #include "ns3/p1906-mol-motor-pos.h"
 #include "ns3/p1906-mol-motor-vol-surface.h"
+#include "ns3/p1906-mol-motor-vec3.h"
+#include "ns3/p1906-mol-motor-segment-index.h"
+#include "ns3/p1906-mol-motor-tube-network.h"
+#include "ns3/p1906-mol-motor-rng-streams.h"
+#include "ns3/p1906-mol-motor-delay-ensemble.h"
+#include "ns3/p1906-mol-motor-trajectory.h"
 
 namespace ns3 {
 
+/**
+ * \ingroup IEEE P1906 framework
+ *
+ * \brief A free-floating walk run off the simulator thread: a private generator and the surfaces as plain spheres
+ *
+ * It creates no Object and does not log, so P1906MOL_MOTOR_Motion::floatDelay can run on the worker threads of the medium.
+ */
+struct P1906MOL_MOTOR_FloatWalk
+{
+  //! positioned at the start of stream (node, id, purpose)
+  gsl_rng * r;
+  vector<P1906MOL_MOTOR_Sphere> spheres;
+  
+  P1906MOL_MOTOR_FloatWalk (uint32_t node, uint32_t id, P1906MOL_MOTOR_RngStreams::Purpose purpose);
+  ~P1906MOL_MOTOR_FloatWalk ();
+  //! return true if pt is inside a Receiver sphere
+  bool inDestination (const P1906MOL_MOTOR_Vec3 & pt) const;
+
+private:
+  //! the generator is owned, so a walk is not copied
+  P1906MOL_MOTOR_FloatWalk (const P1906MOL_MOTOR_FloatWalk &);
+  P1906MOL_MOTOR_FloatWalk & operator= (const P1906MOL_MOTOR_FloatWalk &);
+};
+
 /**
  * \ingroup IEEE P1906 framework
  *
@@ -76,6 +106,19 @@ class P1906MOL_MOTOR_Motion : public P1906MOLMotion
 {
 public:
   static TypeId GetTypeId (void);
+  
+  //! how a free-floating motor is moved:
+  //! FixedSteps - one Gaussian step of timePeriod per move
+  //! WalkOnSpheres - a jump to the surface of the largest sphere clear of receivers, reflective barriers and tubes, 
+  //!   taking a time drawn from the exact first passage distribution; fixed steps are used within one step length of a surface
+  enum FloatEngine { FixedSteps, WalkOnSpheres };
+  //! how long the Brownian steps are:
+  //! FixedStep - always timePeriod
+  //! AdaptiveStep - the root mean square step is StepDistanceRatio of the distance to the nearest surface or tube, within 
+  //!   [MinStepFraction, MaxStepFactor] x timePeriod; hits of receivers and tubes inside a step are caught by a Brownian bridge test
+  enum StepPolicy { FixedStep, AdaptiveStep };
+  //! what ComputePropagationDelay keeps of the trajectory of each motor, see P1906MOL_MOTOR_TrajectorySink
+  enum TrajectoryPolicy { RecordAll, RecordOff, RecordDecimated, RecordRing, RecordStream };
  
   /*
    * Methods related to tracking motor position
@@ -89,35 +132,102 @@ public:
   //! motor is driven by Brownian motion until the destination is reached, returning the propagation time
   void float2Destination(Ptr<P1906MessageCarrier> carrier, double timePeriod);
   //! motor binds to microtubule and walks and is driven by Brownian motion when unbound to microtubule, returning propagation time
-  void move2Destination(Ptr<P1906MessageCarrier> carrier, gsl_matrix * tubeMatrix, size_t segPerTube, double timePeriod, vector<P1906MOL_MOTOR_Pos> & pts);
+  //! tube contact is looked up in tubeIndex when one built over tubeMatrix is given, otherwise by scanning tubeMatrix
+  void move2Destination(Ptr<P1906MessageCarrier> carrier, gsl_matrix * tubeMatrix, size_t segPerTube, double timePeriod, vector<P1906MOL_MOTOR_Vec3> & pts, const P1906MOL_MOTOR_SegmentIndex * tubeIndex = 0);
+  //! as above over the tubes and index of a shared network, which stays alive while the motor moves
+  void move2Destination(Ptr<P1906MessageCarrier> carrier, Ptr<const P1906MOL_MOTOR_TubeNetwork> network, double timePeriod, vector<P1906MOL_MOTOR_Vec3> & pts);
   //! display all the volume surfaces recognizing the motor
   void displayVolSurfaces();
   //! newPos is Brownian motion from currentPos over timePeriod 
   void brownianMotion(gsl_rng * r, gsl_vector * currentPos, gsl_vector * newPos, double timePeriod, double D, vector<P1906MOL_MOTOR_VolSurface> & vsl);
+  //! newPos is Brownian motion from currentPos over timePeriod
+  void brownianMotion(gsl_rng * r, const P1906MOL_MOTOR_Vec3 & currentPos, P1906MOL_MOTOR_Vec3 & newPos, double timePeriod, double D, vector<P1906MOL_MOTOR_VolSurface> & vsl);
+  //! newPos is Brownian motion from currentPos over timePeriod among the surfaces spheres, computed without any allocation
+  void brownianMotion(gsl_rng * r, const P1906MOL_MOTOR_Vec3 & currentPos, P1906MOL_MOTOR_Vec3 & newPos, double timePeriod, double D, const vector<P1906MOL_MOTOR_Sphere> & spheres);
+  //! move pos by one move of the FloatEngine from pos and return the time it took; tubes (if any) bound the spheres at contactRadius
+  double floatMove(gsl_rng * r, P1906MOL_MOTOR_Vec3 & pos, double timePeriod, double D, const vector<P1906MOL_MOTOR_Sphere> & spheres, gsl_matrix * tubeMatrix = 0, const P1906MOL_MOTOR_SegmentIndex * tubeIndex = 0, double contactRadius = 0);
+  //! radius of the largest sphere around pt clear of the Receiver and ReflectiveBarrier surfaces and of the contactRadius zone of the tubes
+  static double emptySphereRadius(const P1906MOL_MOTOR_Vec3 & pt, const vector<P1906MOL_MOTOR_Sphere> & spheres, gsl_matrix * tubeMatrix, const P1906MOL_MOTOR_SegmentIndex * tubeIndex, double contactRadius);
+  //! with probability that a Brownian bridge of length timePeriod from pos to newPos touched a receiver or a tube contact zone,
+  //! move newPos just inside the surface touched; return true if it was moved
+  static bool bridgeHit(gsl_rng * r, const P1906MOL_MOTOR_Vec3 & pos, P1906MOL_MOTOR_Vec3 & newPos, double timePeriod, double D, const vector<P1906MOL_MOTOR_Sphere> & spheres, gsl_matrix * tubeMatrix, const P1906MOL_MOTOR_SegmentIndex * tubeIndex, double contactRadius);
+  //! time for a motor of diffusivity D starting at the centre of a sphere of radius R to first reach its surface
+  static double sphereFirstPassageTime(gsl_rng * r, double R, double D);
+  //! the nearest segment within radius, looked up in tubeIndex if it is usable, by scanning tubeMatrix otherwise
+  static size_t findNearestTube(const P1906MOL_MOTOR_Vec3 & pt, gsl_matrix * tubeMatrix, const P1906MOL_MOTOR_SegmentIndex * tubeIndex, double radius);
   //! Brownian motion from startPt for length time in timePeriod units; results returned in pts
-  int freeFloat(Ptr<P1906MessageCarrier> carrier, gsl_rng * r, gsl_vector * startPt, vector<P1906MOL_MOTOR_Pos> & pts, int time, double timePeriod, vector<P1906MOL_MOTOR_VolSurface> & vsl);
+  int freeFloat(Ptr<P1906MessageCarrier> carrier, gsl_rng * r, gsl_vector * startPt, vector<P1906MOL_MOTOR_Vec3> & pts, int time, double timePeriod, vector<P1906MOL_MOTOR_VolSurface> & vsl);
   //! free float until intersection with any tube
-  size_t float2Tube(Ptr<P1906MessageCarrier> carrier, gsl_rng * r, gsl_vector * startPt, vector<P1906MOL_MOTOR_Pos> & pts, gsl_matrix * tubeMatrix, double timePeriod,vector<P1906MOL_MOTOR_VolSurface> & vsl);
+  size_t float2Tube(Ptr<P1906MessageCarrier> carrier, gsl_rng * r, gsl_vector * startPt, vector<P1906MOL_MOTOR_Vec3> & pts, gsl_matrix * tubeMatrix, double timePeriod,vector<P1906MOL_MOTOR_VolSurface> & vsl, const P1906MOL_MOTOR_SegmentIndex * tubeIndex = 0);
   //! walk along a specific tube identified by startPt and place result in pts
-  void motorWalk(Ptr<P1906MessageCarrier> carrier, gsl_rng * r, gsl_vector * startPt, vector<P1906MOL_MOTOR_Pos> & pts, gsl_matrix * tubeMatrix, size_t segPerTube, vector<P1906MOL_MOTOR_VolSurface> & vsl);
+  void motorWalk(Ptr<P1906MessageCarrier> carrier, gsl_rng * r, gsl_vector * startPt, vector<P1906MOL_MOTOR_Vec3> & pts, gsl_matrix * tubeMatrix, size_t segPerTube, vector<P1906MOL_MOTOR_VolSurface> & vsl, const P1906MOL_MOTOR_SegmentIndex * tubeIndex = 0);
   
   /*
    * These methods are required to utilize the core IEEE 1906 reference model
    */
   //! return the propagation delay by simulating motor motion from transmitter to receiver.
-  double ComputePropagationDelay (Ptr<P1906CommunicationInterface> src,
+  virtual double ComputePropagationDelay (Ptr<P1906CommunicationInterface> src,
   		                                  Ptr<P1906CommunicationInterface> dst,
   		                                  Ptr<P1906MessageCarrier> message,
   		                                  Ptr<P1906Field> field);
   //! return the proper Message Carrier
-  Ptr<P1906MessageCarrier> CalculateReceivedMessageCarrier(Ptr<P1906CommunicationInterface> src,
+  virtual Ptr<P1906MessageCarrier> CalculateReceivedMessageCarrier(Ptr<P1906CommunicationInterface> src,
   		                                                           Ptr<P1906CommunicationInterface> dst,
   		                                                           Ptr<P1906MessageCarrier> message,
   		                                                           Ptr<P1906Field> field);
+  //! motor motion is stochastic, so the medium must not memoize it
+  virtual bool IsCacheable (void);
+  //! free-floating motors of different receivers can be simulated on worker threads
+  virtual bool IsThreadSafe (void);
+  //! return the propagation delay by simulating a private motor seeded from stream; no trajectory is recorded
+  virtual double ComputePropagationDelayConcurrent (const Vector &srcPosition,
+                                                    const Vector &dstPosition,
+                                                    P1906MessageCarrier *message,
+                                                    P1906Field *field,
+                                                    uint64_t stream);
+  //! float a private walk drawing from stream (node, id, purpose) from sv to dv and return its delay; safe on worker threads
+  double floatDelay (const Vector &sv, const Vector &dv, uint32_t node, uint32_t id, P1906MOL_MOTOR_RngStreams::Purpose purpose);
+  
+  /*
+   * Methods related to delay distributions
+   */
+  //! once set, each packet draws its delay from the ensemble distribution of its link instead of floating a motor; 0 restores the simulation
+  void setDelayEnsemble (Ptr<P1906MOL_MOTOR_DelayEnsemble> ensemble);
+  Ptr<P1906MOL_MOTOR_DelayEnsemble> getDelayEnsemble ();
+  //! select the engine moving free-floating motors
+  void setFloatEngine (FloatEngine engine);
+  FloatEngine getFloatEngine () const;
+  //! select how the Brownian steps are sized, see the StepPolicy, StepDistanceRatio, MinStepFraction and MaxStepFactor attributes
+  void setStepPolicy (StepPolicy policy);
+  StepPolicy getStepPolicy () const;
+  //! a new sink following the Trajectory attributes
+  Ptr<P1906MOL_MOTOR_TrajectorySink> createTrajectorySink ();
   
   P1906MOL_MOTOR_Motion ();
   virtual ~P1906MOL_MOTOR_Motion ();
 
+private:
+  //! see setDelayEnsemble
+  Ptr<P1906MOL_MOTOR_DelayEnsemble> m_delayEnsemble;
+  //! see the FloatEngine attribute
+  FloatEngine m_floatEngine;
+  //! see the StepPolicy attribute
+  StepPolicy m_stepPolicy;
+  //! root mean square adaptive step over the distance to the nearest surface or tube
+  double m_stepDistanceRatio;
+  //! bounds of the adaptive step, relative to timePeriod
+  double m_minStepFraction;
+  double m_maxStepFactor;
+  //! see the Trajectory attributes
+  TrajectoryPolicy m_trajectoryPolicy;
+  uint32_t m_trajectoryDecimation;
+  uint32_t m_trajectoryRingSize;
+  string m_trajectoryFile;
+  //! shared by the Stream sinks, opened on first use
+  Ptr<P1906MOL_MOTOR_TrajectoryWriter> m_trajectoryWriter;
+  //! id of the next streamed motor
+  uint64_t m_trajectories;
+
 };
 
 }
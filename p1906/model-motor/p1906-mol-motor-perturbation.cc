@@ -88,7 +88,7 @@ Ptr<P1906MessageCarrier>
 P1906MOL_MOTOR_Perturbation::CreateMessageCarrier (Ptr<Packet> p)
 {
   NS_LOG_FUNCTION (this);
-  Ptr<P1906MOL_Motor> carrier = CreateObject<P1906MOL_Motor> ();
+  Ptr<P1906MOL_Motor> carrier = AllocateMessageCarrier<P1906MOL_Motor> ();
 
   double duration = m_pulseInterval.GetSeconds () * p->GetSize () * 8;
   double now = Simulator::Now ().GetSeconds ();
@@ -93,6 +93,28 @@ P1906MOL_MOTOR_Pos::P1906MOL_MOTOR_Pos ()
   pos = gsl_vector_alloc (3);
 }
 
+P1906MOL_MOTOR_Pos::P1906MOL_MOTOR_Pos (const P1906MOL_MOTOR_Pos & o)
+  : Object (o),
+    pos_x (o.pos_x),
+    pos_y (o.pos_y),
+    pos_z (o.pos_z)
+{
+  pos = gsl_vector_alloc (3);
+  gsl_vector_memcpy (pos, o.pos);
+}
+
+P1906MOL_MOTOR_Pos & P1906MOL_MOTOR_Pos::operator= (const P1906MOL_MOTOR_Pos & o)
+{
+  if (this != &o)
+  {
+    gsl_vector_memcpy (pos, o.pos);
+    pos_x = gsl_vector_get (pos, 0);
+    pos_y = gsl_vector_get (pos, 1);
+    pos_z = gsl_vector_get (pos, 2);
+  }
+  return *this;
+}
+
 std::ostream& operator<<(std::ostream& out, const P1906MOL_MOTOR_Pos& p)
 {
    return out << gsl_vector_get(p.pos, 0) << " " << gsl_vector_get(p.pos, 1) << " " << gsl_vector_get(p.pos, 2);
@@ -118,6 +140,18 @@ void P1906MOL_MOTOR_Pos::setPos (double x, double y, double z)
   pos_z = z;
 }
 
+//! set the object's position from a plain 3D point
+void P1906MOL_MOTOR_Pos::setPos (const P1906MOL_MOTOR_Vec3 & v)
+{
+  setPos (v.x, v.y, v.z);
+}
+
+//! retrieve the position as a plain 3D point
+P1906MOL_MOTOR_Vec3 P1906MOL_MOTOR_Pos::getVec3 () const
+{
+  return vec3 (gsl_vector_get (pos, 0), gsl_vector_get (pos, 1), gsl_vector_get (pos, 2));
+}
+
 //! retrieve the position into out_pos vector [x y z]
 void P1906MOL_MOTOR_Pos::getPos (gsl_vector * out_pos)
 {
@@ -135,20 +169,10 @@ void P1906MOL_MOTOR_Pos::getPos (double * x, double * y, double * z)
 //! shift point by a scaled vector: new_pos = pos + d v_in
 void P1906MOL_MOTOR_Pos::shiftPos (P1906MOL_MOTOR_Pos v_in, double d)
 {
-  gsl_vector * v = gsl_vector_alloc (3);
-  
   NS_LOG_DEBUG ("original position: " << this);
   
-  //! get the vector
-  v_in.getPos (v);
-  
   //! update pos to pos + d v
-  for (size_t i = 0; i< 3; i++)
-    gsl_vector_set (pos, i, gsl_vector_get(pos, i) + (gsl_vector_get (v, i) * d));
-
-  pos_x = gsl_vector_get (pos, 0);
-  pos_y = gsl_vector_get (pos, 1);
-  pos_z = gsl_vector_get (pos, 2);
+  setPos (getVec3 () + v_in.getVec3 () * d);
 
   NS_LOG_DEBUG ("v_in " << v_in << " d: " << d);
   NS_LOG_DEBUG ("new position: " << this);
@@ -166,6 +190,7 @@ void P1906MOL_MOTOR_Pos::displayPos()
 P1906MOL_MOTOR_Pos::~P1906MOL_MOTOR_Pos ()
 {
   NS_LOG_FUNCTION (this);
+  gsl_vector_free (pos);
 }
 
 } // namespace ns3
@@ -51,6 +51,7 @@ using namespace std;
 #include "ns3/uinteger.h"
 #include "ns3/traced-value.h"
 #include "ns3/trace-source-accessor.h"
+#include "ns3/p1906-mol-motor-vec3.h"
 
 namespace ns3 {
 
@@ -80,6 +81,9 @@ class P1906MOL_MOTOR_Pos : public Object
 public:
   static TypeId GetTypeId (void);
   P1906MOL_MOTOR_Pos ();
+  //! copies own their gsl_vector, so that it can be released by the destructor
+  P1906MOL_MOTOR_Pos (const P1906MOL_MOTOR_Pos & o);
+  P1906MOL_MOTOR_Pos & operator= (const P1906MOL_MOTOR_Pos & o);
 
   gsl_vector * pos;
   TracedValue<double_t> pos_x;
@@ -93,6 +97,8 @@ public:
   void setPos (double x, double y, double z);  
   //! record the object's position from the vector [x y z] 
   void setPos (gsl_vector * in_pos);
+  //! record the position from a plain 3D point
+  void setPos (const P1906MOL_MOTOR_Vec3 & v);
 
   /*
    * Methods related to retrieving the position
@@ -101,6 +107,8 @@ public:
   void getPos (double * x, double * y, double * z);
   //! retrieve the position into out_pos vector [x y z]
   void getPos (gsl_vector * out_pos);
+  //! retrieve the position as a plain 3D point
+  P1906MOL_MOTOR_Vec3 getVec3 () const;
     
   /*
    * Operations on position
@@ -0,0 +1,214 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *  Copyright � 2015 by IEEE.
+ *
+ *  This source file is an essential part of IEEE Std 1906.1,
+ *  Recommended Practice for Nanoscale and Molecular
+ *  Communication Framework.
+ *  Verbatim copies of this source file may be used and
+ *  distributed without restriction. Modifications to this source
+ *  file as permitted in IEEE Std 1906.1 may also be made and
+ *  distributed. All other uses require permission from the IEEE
+ *  Standards Department (stds-ipr@ieee.org). All other rights
+ *  reserved.
+ *
+ *  This source file is provided on an AS IS basis.
+ *  The IEEE disclaims ANY WARRANTY EXPRESS OR IMPLIED INCLUDING
+ *  ANY WARRANTY OF MERCHANTABILITY AND FITNESS FOR USE FOR A
+ *  PARTICULAR PURPOSE.
+ *  The user of the source file shall indemnify and hold
+ *  IEEE harmless from any damages or liability arising out of
+ *  the use thereof.
+ *
+ * Author: Stephen F Bush - GE Global Research
+ *                      bushsf@research.ge.com
+ *                      http://www.amazon.com/author/stephenbush
+ */
+
+/* \details Counter based random number streams
+ *
+ * <pre>
+ *   key     = (seed, run)
+ *   counter = (block, purpose, node, id)
+ *   block n of stream (purpose, node, id) = Philox4x32-10 (key, counter) -> 4 x 32 bits
+ * </pre>
+ */
+
+#include <cmath>
+
+#include "ns3/log.h"
+#include "ns3/rng-seed-manager.h"
+#include "ns3/system-mutex.h"
+#include "ns3/p1906-mol-motor-rng-streams.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("P1906MOL_MOTOR_RngStreams");
+
+//! generator state: the 15 words that replace an MT19937 state
+typedef struct
+{
+  uint32_t key[2];
+  uint32_t counter[4];
+  uint32_t block[4];
+  uint32_t used;
+} p1906_philox_state_t;
+
+//! guards the id counters of NextId, which motors and tubes reach from worker threads
+static SystemMutex g_nextIdMutex;
+//! the next id of each purpose
+static uint32_t g_nextId[P1906MOL_MOTOR_RngStreams::Ensemble + 1] = { 0 };
+
+//! one Philox4x32 round
+static inline void
+PhiloxRound (uint32_t ctr[4], const uint32_t key[2])
+{
+  uint64_t p0 = (uint64_t) 0xD2511F53 * ctr[0];
+  uint64_t p1 = (uint64_t) 0xCD9E8D57 * ctr[2];
+  uint32_t c0 = (uint32_t) (p1 >> 32) ^ ctr[1] ^ key[0];
+  uint32_t c2 = (uint32_t) (p0 >> 32) ^ ctr[3] ^ key[1];
+
+  ctr[0] = c0;
+  ctr[1] = (uint32_t) p1;
+  ctr[2] = c2;
+  ctr[3] = (uint32_t) p0;
+}
+
+//! block = Philox4x32-10 (key, counter)
+static void
+Philox4x32_10 (const uint32_t counter[4], const uint32_t key[2], uint32_t block[4])
+{
+  uint32_t k[2] = { key[0], key[1] };
+
+  for (int i = 0; i < 4; i++)
+    {
+      block[i] = counter[i];
+    }
+  for (int round = 0; round < 10; round++)
+    {
+      if (round > 0)
+        {
+          k[0] += 0x9E3779B9;
+          k[1] += 0xBB67AE85;
+        }
+      PhiloxRound (block, k);
+    }
+}
+
+//! gsl_rng_set: seed becomes the key of stream (0, 0, 0)
+static void
+philox_set (void * vstate, unsigned long int seed)
+{
+  p1906_philox_state_t * state = (p1906_philox_state_t *) vstate;
+
+  state->key[0] = (uint32_t) seed;
+  state->key[1] = (uint32_t) ((uint64_t) seed >> 32);
+  for (int i = 0; i < 4; i++)
+    {
+      state->counter[i] = 0;
+      state->block[i] = 0;
+    }
+  state->used = 4;
+}
+
+static unsigned long int
+philox_get (void * vstate)
+{
+  p1906_philox_state_t * state = (p1906_philox_state_t *) vstate;
+
+  if (state->used == 4)
+    {
+      Philox4x32_10 (state->counter, state->key, state->block);
+      state->counter[0]++;
+      state->used = 0;
+    }
+  return state->block[state->used++];
+}
+
+static double
+philox_get_double (void * vstate)
+{
+  return philox_get (vstate) / 4294967296.0;
+}
+
+static const gsl_rng_type g_philoxType =
+{
+  "p1906_philox4x32_10",        /* name */
+  0xffffffffUL,                 /* RAND_MAX */
+  0,                            /* RAND_MIN */
+  sizeof (p1906_philox_state_t),
+  &philox_set,
+  &philox_get,
+  &philox_get_double
+};
+
+const gsl_rng_type *
+P1906MOL_MOTOR_RngStreams::GetType (void)
+{
+  return &g_philoxType;
+}
+
+gsl_rng *
+P1906MOL_MOTOR_RngStreams::Create (uint32_t node, uint32_t id, Purpose purpose)
+{
+  gsl_rng * r = gsl_rng_alloc (GetType ());
+
+  Select (r, node, id, purpose);
+  return r;
+}
+
+void
+P1906MOL_MOTOR_RngStreams::Select (gsl_rng * r, uint32_t node, uint32_t id, Purpose purpose)
+{
+  p1906_philox_state_t * state = (p1906_philox_state_t *) r->state;
+  uint64_t run = RngSeedManager::GetRun ();
+
+  //! no logging: this runs on worker threads, and ns-3 logging is not thread-safe
+  state->key[0] = RngSeedManager::GetSeed ();
+  state->key[1] = (uint32_t) run ^ (uint32_t) (run >> 32);
+  state->counter[0] = 0;
+  state->counter[1] = (uint32_t) purpose;
+  state->counter[2] = node;
+  state->counter[3] = id;
+  state->used = 4;
+}
+
+uint32_t
+P1906MOL_MOTOR_RngStreams::NextId (Purpose purpose)
+{
+  CriticalSection cs (g_nextIdMutex);
+
+  return g_nextId[purpose]++;
+}
+
+void
+P1906MOL_MOTOR_RngStreams::ResetNextIds (void)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  CriticalSection cs (g_nextIdMutex);
+
+  for (int i = 0; i <= Ensemble; i++)
+    {
+      g_nextId[i] = 0;
+    }
+}
+
+void
+P1906MOL_MOTOR_RngStreams::Gaussians (gsl_rng * r, double sigma, double * out, size_t n)
+{
+  for (size_t i = 0; i < n; i += 2)
+    {
+      //! u1 in (0, 1] so that the logarithm is finite
+      double u1 = 1.0 - gsl_rng_uniform (r);
+      double u2 = gsl_rng_uniform (r);
+      double rho = sigma * std::sqrt (-2.0 * std::log (u1));
+
+      out[i] = rho * std::cos (2 * M_PI * u2);
+      if (i + 1 < n)
+        {
+          out[i + 1] = rho * std::sin (2 * M_PI * u2);
+        }
+    }
+}
+
+} // namespace ns3
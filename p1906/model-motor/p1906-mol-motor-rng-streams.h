@@ -0,0 +1,79 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *  Copyright � 2015 by IEEE.
+ *
+ *  This source file is an essential part of IEEE Std 1906.1,
+ *  Recommended Practice for Nanoscale and Molecular
+ *  Communication Framework.
+ *  Verbatim copies of this source file may be used and
+ *  distributed without restriction. Modifications to this source
+ *  file as permitted in IEEE Std 1906.1 may also be made and
+ *  distributed. All other uses require permission from the IEEE
+ *  Standards Department (stds-ipr@ieee.org). All other rights
+ *  reserved.
+ *
+ *  This source file is provided on an AS IS basis.
+ *  The IEEE disclaims ANY WARRANTY EXPRESS OR IMPLIED INCLUDING
+ *  ANY WARRANTY OF MERCHANTABILITY AND FITNESS FOR USE FOR A
+ *  PARTICULAR PURPOSE.
+ *  The user of the source file shall indemnify and hold
+ *  IEEE harmless from any damages or liability arising out of
+ *  the use thereof.
+ *
+ * Author: Stephen F Bush - GE Global Research
+ *                      bushsf@research.ge.com
+ *                      http://www.amazon.com/author/stephenbush
+ */
+
+#ifndef P1906_MOL_MOTOR_RNG_STREAMS
+#define P1906_MOL_MOTOR_RNG_STREAMS
+
+#include <stdint.h>
+#include <cstddef>
+
+#include <gsl/gsl_rng.h>
+
+namespace ns3 {
+
+/**
+ * \ingroup IEEE P1906 framework
+ *
+ * \class P1906MOL_MOTOR_RngStreams
+ *
+ * \brief Hands out reproducible, independent random number streams to motors, tubes, fields and volume surfaces
+ *
+ * The generators are counter based (Philox4x32-10, Salmon et al., "Parallel
+ * Random Numbers: As Easy as 1, 2, 3", SC 2011): output block n of a stream
+ * is a keyed bijection of the counter (n, purpose, node, id), the key being
+ * the ns-3 seed and run number (RngSeedManager). Any stream can therefore be
+ * selected in constant time, two streams never overlap, and a result depends
+ * only on the stream it was drawn from, not on which thread drew it or in what
+ * order. The state of a generator is 15 words instead of the 2.5 KB of the
+ * default MT19937.
+ *
+ * The generators are ordinary gsl_rng objects, so all of gsl_ran_* can be used
+ * with them; free them with gsl_rng_free.
+ */
+class P1906MOL_MOTOR_RngStreams
+{
+public:
+  //! what the numbers are used for; part of the stream key
+  enum Purpose { MotorMotion = 1, TubeGeneration = 2, FieldGeneration = 3, VolumeSurface = 4, ReceiverMotion = 5, Ensemble = 6 };
+
+  //! the Philox4x32-10 generator as a gsl_rng_type
+  static const gsl_rng_type * GetType (void);
+  //! allocate a generator positioned at the start of stream (node, id, purpose) of the current run
+  static gsl_rng * Create (uint32_t node, uint32_t id, Purpose purpose);
+  //! move a generator of GetType () to the start of stream (node, id, purpose) of the current run; does not log, so it is safe on worker threads
+  static void Select (gsl_rng * r, uint32_t node, uint32_t id, Purpose purpose);
+  //! the next unused id for purpose; thread-safe, but ids are handed out in call order, so they are reproducible only when drawn on the simulator thread
+  static uint32_t NextId (Purpose purpose);
+  //! hand out the ids of every purpose from 0 again, so that a simulation run after another in the same process draws the same streams
+  static void ResetNextIds (void);
+  //! fill out with n Gaussian variates of mean 0 and standard deviation sigma (Box-Muller on pairs of uniforms)
+  static void Gaussians (gsl_rng * r, double sigma, double * out, size_t n);
+};
+
+}
+
+#endif /* P1906_MOL_MOTOR_RNG_STREAMS */
@@ -0,0 +1,203 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *  Copyright � 2015 by IEEE.
+ *
+ *  This source file is an essential part of IEEE Std 1906.1,
+ *  Recommended Practice for Nanoscale and Molecular
+ *  Communication Framework.
+ *  Verbatim copies of this source file may be used and
+ *  distributed without restriction. Modifications to this source
+ *  file as permitted in IEEE Std 1906.1 may also be made and
+ *  distributed. All other uses require permission from the IEEE
+ *  Standards Department (stds-ipr@ieee.org). All other rights
+ *  reserved.
+ *
+ *  This source file is provided on an AS IS basis.
+ *  The IEEE disclaims ANY WARRANTY EXPRESS OR IMPLIED INCLUDING
+ *  ANY WARRANTY OF MERCHANTABILITY AND FITNESS FOR USE FOR A
+ *  PARTICULAR PURPOSE.
+ *  The user of the source file shall indemnify and hold
+ *  IEEE harmless from any damages or liability arising out of
+ *  the use thereof.
+ *
+ * Author: Stephen F Bush - GE Global Research
+ *                      bushsf@research.ge.com
+ *                      http://www.amazon.com/author/stephenbush
+ */
+
+/* \details The batched point to segment distance kernel
+ *
+ * <pre>
+ *   w  = pt - p1
+ *   t  = clamp ((w . d) / |d|^2, 0, 1)
+ *   d2 = |w - t d|^2
+ * </pre>
+ */
+
+#include <cfloat>
+#include <cmath>
+
+//! the vector kernels are compiled for their instruction sets whatever the flags of the build, and picked at run time
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define P1906_SEGMENT_ARRAYS_DISPATCH
+#include <immintrin.h>
+//! AVX-512F has fused multiply-adds, which GCC would otherwise contract the products into, breaking the agreement with vec3SegmentDistance2
+#if defined(__clang__)
+#define P1906_SEGMENT_ARRAYS_TARGET(isa) __attribute__ ((target (isa)))
+#else
+#define P1906_SEGMENT_ARRAYS_TARGET(isa) __attribute__ ((target (isa), optimize ("fp-contract=off")))
+#endif
+#endif
+
+#include "ns3/p1906-mol-motor-segment-arrays.h"
+
+namespace ns3 {
+
+//! padding entries sit so far away that their squared distance overflows to infinity
+static const double g_paddingCoordinate = 1e300;
+
+void P1906MOL_MOTOR_SegmentArrays::resize (size_t n)
+{
+  m_x1.assign (n, g_paddingCoordinate);
+  m_y1.assign (n, g_paddingCoordinate);
+  m_z1.assign (n, g_paddingCoordinate);
+  m_dx.assign (n, 0);
+  m_dy.assign (n, 0);
+  m_dz.assign (n, 0);
+  m_invLen2.assign (n, 0);
+}
+
+void P1906MOL_MOTOR_SegmentArrays::set (size_t i, const P1906MOL_MOTOR_Vec3 & p1, const P1906MOL_MOTOR_Vec3 & p2)
+{
+  P1906MOL_MOTOR_Vec3 d = p2 - p1;
+
+  m_x1[i] = p1.x;
+  m_y1[i] = p1.y;
+  m_z1[i] = p1.z;
+  m_dx[i] = d.x;
+  m_dy[i] = d.y;
+  m_dz[i] = d.z;
+  m_invLen2[i] = vec3InvLength2 (d);
+}
+
+void P1906MOL_MOTOR_SegmentArrays::assign (gsl_matrix * tubeMatrix)
+{
+  assign (tubeMatrix, 0, tubeMatrix->size1);
+}
+
+void P1906MOL_MOTOR_SegmentArrays::assign (gsl_matrix * tubeMatrix, size_t first, size_t count)
+{
+  resize (count);
+  for (size_t i = 0; i < count; i++)
+    {
+      size_t row = first + i;
+      set (i,
+           vec3 (gsl_matrix_get (tubeMatrix, row, 0), gsl_matrix_get (tubeMatrix, row, 1), gsl_matrix_get (tubeMatrix, row, 2)),
+           vec3 (gsl_matrix_get (tubeMatrix, row, 3), gsl_matrix_get (tubeMatrix, row, 4), gsl_matrix_get (tubeMatrix, row, 5)));
+    }
+}
+
+size_t P1906MOL_MOTOR_SegmentArrays::size () const
+{
+  return m_x1.size ();
+}
+
+#ifdef P1906_SEGMENT_ARRAYS_DISPATCH
+//! some GCC versions warn about the deliberately undefined pass-through operand inside _mm512_min_pd and _mm512_max_pd
+#if !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+//! the squared distances of the segments i, i + 1, ... in batches of 8, up to the last full batch; returns the first segment left
+P1906_SEGMENT_ARRAYS_TARGET ("avx512f") static size_t
+Distance2Avx512 (const P1906MOL_MOTOR_Vec3 & pt, const double * x1, const double * y1, const double * z1,
+                 const double * dx, const double * dy, const double * dz, const double * invLen2,
+                 size_t i, size_t begin, size_t end, double * d2)
+{
+  const __m512d px = _mm512_set1_pd (pt.x), py = _mm512_set1_pd (pt.y), pz = _mm512_set1_pd (pt.z);
+  const __m512d zero = _mm512_setzero_pd (), one = _mm512_set1_pd (1.0);
+  for (; i + 8 <= end; i += 8)
+    {
+      __m512d ux = _mm512_loadu_pd (dx + i), uy = _mm512_loadu_pd (dy + i), uz = _mm512_loadu_pd (dz + i);
+      __m512d wx = _mm512_sub_pd (px, _mm512_loadu_pd (x1 + i));
+      __m512d wy = _mm512_sub_pd (py, _mm512_loadu_pd (y1 + i));
+      __m512d wz = _mm512_sub_pd (pz, _mm512_loadu_pd (z1 + i));
+      __m512d dot = _mm512_add_pd (_mm512_add_pd (_mm512_mul_pd (wx, ux), _mm512_mul_pd (wy, uy)), _mm512_mul_pd (wz, uz));
+      __m512d t = _mm512_min_pd (_mm512_max_pd (_mm512_mul_pd (dot, _mm512_loadu_pd (invLen2 + i)), zero), one);
+      __m512d rx = _mm512_sub_pd (wx, _mm512_mul_pd (ux, t));
+      __m512d ry = _mm512_sub_pd (wy, _mm512_mul_pd (uy, t));
+      __m512d rz = _mm512_sub_pd (wz, _mm512_mul_pd (uz, t));
+      _mm512_storeu_pd (d2 + i - begin, _mm512_add_pd (_mm512_add_pd (_mm512_mul_pd (rx, rx), _mm512_mul_pd (ry, ry)), _mm512_mul_pd (rz, rz)));
+    }
+  return i;
+}
+#if !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+//! as Distance2Avx512, in batches of 4
+P1906_SEGMENT_ARRAYS_TARGET ("avx2") static size_t
+Distance2Avx2 (const P1906MOL_MOTOR_Vec3 & pt, const double * x1, const double * y1, const double * z1,
+               const double * dx, const double * dy, const double * dz, const double * invLen2,
+               size_t i, size_t begin, size_t end, double * d2)
+{
+  const __m256d px = _mm256_set1_pd (pt.x), py = _mm256_set1_pd (pt.y), pz = _mm256_set1_pd (pt.z);
+  const __m256d zero = _mm256_setzero_pd (), one = _mm256_set1_pd (1.0);
+  for (; i + 4 <= end; i += 4)
+    {
+      __m256d ux = _mm256_loadu_pd (dx + i), uy = _mm256_loadu_pd (dy + i), uz = _mm256_loadu_pd (dz + i);
+      __m256d wx = _mm256_sub_pd (px, _mm256_loadu_pd (x1 + i));
+      __m256d wy = _mm256_sub_pd (py, _mm256_loadu_pd (y1 + i));
+      __m256d wz = _mm256_sub_pd (pz, _mm256_loadu_pd (z1 + i));
+      __m256d dot = _mm256_add_pd (_mm256_add_pd (_mm256_mul_pd (wx, ux), _mm256_mul_pd (wy, uy)), _mm256_mul_pd (wz, uz));
+      __m256d t = _mm256_min_pd (_mm256_max_pd (_mm256_mul_pd (dot, _mm256_loadu_pd (invLen2 + i)), zero), one);
+      __m256d rx = _mm256_sub_pd (wx, _mm256_mul_pd (ux, t));
+      __m256d ry = _mm256_sub_pd (wy, _mm256_mul_pd (uy, t));
+      __m256d rz = _mm256_sub_pd (wz, _mm256_mul_pd (uz, t));
+      _mm256_storeu_pd (d2 + i - begin, _mm256_add_pd (_mm256_add_pd (_mm256_mul_pd (rx, rx), _mm256_mul_pd (ry, ry)), _mm256_mul_pd (rz, rz)));
+    }
+  return i;
+}
+
+//! 0 until the static initializers have run, so that a distance computed before then takes the scalar path
+enum SegmentArraysKernel { ScalarKernel = 0, Avx2Kernel, Avx512Kernel };
+
+static SegmentArraysKernel
+SelectSegmentArraysKernel (void)
+{
+  __builtin_cpu_init ();
+  if (__builtin_cpu_supports ("avx512f"))
+    return Avx512Kernel;
+  if (__builtin_cpu_supports ("avx2"))
+    return Avx2Kernel;
+  return ScalarKernel;
+}
+
+static const SegmentArraysKernel g_segmentArraysKernel = SelectSegmentArraysKernel ();
+#endif
+
+void P1906MOL_MOTOR_SegmentArrays::distance2 (const P1906MOL_MOTOR_Vec3 & pt, size_t begin, size_t end, double * d2) const
+{
+  const double * x1 = &m_x1[0], * y1 = &m_y1[0], * z1 = &m_z1[0];
+  const double * dx = &m_dx[0], * dy = &m_dy[0], * dz = &m_dz[0];
+  const double * invLen2 = &m_invLen2[0];
+  size_t i = begin;
+
+#ifdef P1906_SEGMENT_ARRAYS_DISPATCH
+  if (g_segmentArraysKernel == Avx512Kernel)
+    i = Distance2Avx512 (pt, x1, y1, z1, dx, dy, dz, invLen2, i, begin, end, d2);
+  if (g_segmentArraysKernel >= Avx2Kernel)
+    i = Distance2Avx2 (pt, x1, y1, z1, dx, dy, dz, invLen2, i, begin, end, d2);
+#endif
+  //! scalar fallback and remainder
+  for (; i < end; i++)
+    {
+      double wx = pt.x - x1[i], wy = pt.y - y1[i], wz = pt.z - z1[i];
+      double t = (wx * dx[i] + wy * dy[i] + wz * dz[i]) * invLen2[i];
+      t = t < 0 ? 0 : (t > 1 ? 1 : t);
+      double rx = wx - dx[i] * t, ry = wy - dy[i] * t, rz = wz - dz[i] * t;
+      d2[i - begin] = rx * rx + ry * ry + rz * rz;
+    }
+}
+
+} // namespace ns3
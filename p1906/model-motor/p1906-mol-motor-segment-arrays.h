@@ -0,0 +1,127 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *  Copyright � 2015 by IEEE.
+ *
+ *  This source file is an essential part of IEEE Std 1906.1,
+ *  Recommended Practice for Nanoscale and Molecular
+ *  Communication Framework.
+ *  Verbatim copies of this source file may be used and
+ *  distributed without restriction. Modifications to this source
+ *  file as permitted in IEEE Std 1906.1 may also be made and
+ *  distributed. All other uses require permission from the IEEE
+ *  Standards Department (stds-ipr@ieee.org). All other rights
+ *  reserved.
+ *
+ *  This source file is provided on an AS IS basis.
+ *  The IEEE disclaims ANY WARRANTY EXPRESS OR IMPLIED INCLUDING
+ *  ANY WARRANTY OF MERCHANTABILITY AND FITNESS FOR USE FOR A
+ *  PARTICULAR PURPOSE.
+ *  The user of the source file shall indemnify and hold
+ *  IEEE harmless from any damages or liability arising out of
+ *  the use thereof.
+ *
+ * Author: Stephen F Bush - GE Global Research
+ *                      bushsf@research.ge.com
+ *                      http://www.amazon.com/author/stephenbush
+ */
+
+#ifndef P1906_MOL_MOTOR_SEGMENT_ARRAYS
+#define P1906_MOL_MOTOR_SEGMENT_ARRAYS
+
+#include <cstdlib>
+#include <new>
+#include <vector>
+using namespace std;
+
+#include <gsl/gsl_matrix.h>
+
+#include "ns3/p1906-mol-motor-vec3.h"
+
+namespace ns3 {
+
+/**
+ * \brief Allocator returning storage aligned for the widest vector loads (64 bytes)
+ */
+template <class T>
+class P1906MOL_MOTOR_AlignedAllocator
+{
+public:
+  typedef T value_type;
+
+  P1906MOL_MOTOR_AlignedAllocator () {}
+  template <class U> P1906MOL_MOTOR_AlignedAllocator (const P1906MOL_MOTOR_AlignedAllocator<U> &) {}
+
+  T * allocate (size_t n)
+  {
+    void * p = 0;
+    if (n == 0)
+      return 0;
+    if (posix_memalign (&p, 64, n * sizeof (T)) != 0)
+      throw std::bad_alloc ();
+    return static_cast<T *> (p);
+  }
+  void deallocate (T * p, size_t)
+  {
+    free (p);
+  }
+
+  template <class U> struct rebind { typedef P1906MOL_MOTOR_AlignedAllocator<U> other; };
+};
+
+template <class T, class U>
+bool operator== (const P1906MOL_MOTOR_AlignedAllocator<T> &, const P1906MOL_MOTOR_AlignedAllocator<U> &) { return true; }
+template <class T, class U>
+bool operator!= (const P1906MOL_MOTOR_AlignedAllocator<T> &, const P1906MOL_MOTOR_AlignedAllocator<U> &) { return false; }
+
+/**
+ * \ingroup IEEE P1906 framework
+ *
+ * \class P1906MOL_MOTOR_SegmentArrays
+ *
+ * \brief Tube segments in structure of arrays layout with a batched point to segment distance kernel
+ *
+ * Segment i is stored as its first end point (x1, y1, z1), its direction
+ * (dx, dy, dz) and 1 / |d|^2, each in its own 64 byte aligned array, so that
+ * the distances from one point to consecutive segments are computed 8 (AVX-512),
+ * 4 (AVX2) or 1 (scalar fallback) at a time. On x86 with GCC or Clang the
+ * vector kernels are always compiled (as target functions) and the widest one
+ * the processor supports is picked at run time, so no -mavx2 or -march flag is
+ * needed; other builds use the scalar kernel.
+ *
+ * The distance is the exact Euclidean distance to the segment, the projection
+ * being clamped to the end points; it performs the same operations in the same
+ * order as vec3SegmentDistance2, so both agree bit for bit unless the compiler
+ * contracts them into fused multiply-adds (e.g. -mfma with -ffp-contract=fast).
+ * Padding entries (see resize) are at infinite distance from any point.
+ */
+class P1906MOL_MOTOR_SegmentArrays
+{
+public:
+  //! widest batch of the kernel; callers may pad ranges to a multiple of it
+  static const size_t lanes = 8;
+
+  //! hold n padding segments
+  void resize (size_t n);
+  //! store the segment (p1, p2) at i
+  void set (size_t i, const P1906MOL_MOTOR_Vec3 & p1, const P1906MOL_MOTOR_Vec3 & p2);
+  //! hold the segments of tubeMatrix
+  void assign (gsl_matrix * tubeMatrix);
+  //! hold the count segments of tubeMatrix from row first on, segment i being row first + i
+  void assign (gsl_matrix * tubeMatrix, size_t first, size_t count);
+  //! number of entries, padding included
+  size_t size () const;
+
+  //! squared distances from pt to the segments begin .. end - 1, stored in d2[0 .. end - begin - 1]
+  void distance2 (const P1906MOL_MOTOR_Vec3 & pt, size_t begin, size_t end, double * d2) const;
+
+private:
+  typedef vector<double, P1906MOL_MOTOR_AlignedAllocator<double> > Lane;
+
+  Lane m_x1, m_y1, m_z1;
+  Lane m_dx, m_dy, m_dz;
+  Lane m_invLen2;
+};
+
+}
+
+#endif /* P1906_MOL_MOTOR_SEGMENT_ARRAYS */
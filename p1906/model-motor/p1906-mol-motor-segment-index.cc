@@ -0,0 +1,375 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *  Copyright � 2015 by IEEE.
+ *
+ *  This source file is an essential part of IEEE Std 1906.1,
+ *  Recommended Practice for Nanoscale and Molecular
+ *  Communication Framework.
+ *  Verbatim copies of this source file may be used and
+ *  distributed without restriction. Modifications to this source
+ *  file as permitted in IEEE Std 1906.1 may also be made and
+ *  distributed. All other uses require permission from the IEEE
+ *  Standards Department (stds-ipr@ieee.org). All other rights
+ *  reserved.
+ *
+ *  This source file is provided on an AS IS basis.
+ *  The IEEE disclaims ANY WARRANTY EXPRESS OR IMPLIED INCLUDING
+ *  ANY WARRANTY OF MERCHANTABILITY AND FITNESS FOR USE FOR A
+ *  PARTICULAR PURPOSE.
+ *  The user of the source file shall indemnify and hold
+ *  IEEE harmless from any damages or liability arising out of
+ *  the use thereof.
+ *
+ * Author: Stephen F Bush - GE Global Research
+ *                      bushsf@research.ge.com
+ *                      http://www.amazon.com/author/stephenbush
+ */
+
+/* \details This class implements a uniform grid over tube segments
+ *
+ * <pre>
+ *   +-----+-----+-----+
+ *   |     |  \  |     |   a segment is listed in every cell its
+ *   |     |   \ |     |   bounding box overlaps; a query at X with
+ *   +-----+----\+-----+   radius r only visits the cells overlapping
+ *   |     |  X  \     |   the box [X - r, X + r]
+ *   |     |     |\    |
+ *   +-----+-----+-----+
+ * </pre>
+ */
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstdlib>
+
+#include <gsl/gsl_math.h>
+
+#include "ns3/log.h"
+#include "ns3/p1906-mol-motor-segment-index.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("P1906MOL_MOTOR_SegmentIndex");
+
+P1906MOL_MOTOR_SegmentIndex::P1906MOL_MOTOR_SegmentIndex ()
+  : m_cellSize (0)
+{
+  clear ();
+}
+
+void P1906MOL_MOTOR_SegmentIndex::build (gsl_matrix * tubeMatrix, double cellSize)
+{
+  NS_LOG_FUNCTION (this << tubeMatrix->size1 << cellSize);
+
+  m_p1.resize (tubeMatrix->size1);
+  m_p2.resize (tubeMatrix->size1);
+  for (size_t i = 0; i < tubeMatrix->size1; i++)
+    {
+      m_p1[i] = vec3 (gsl_matrix_get (tubeMatrix, i, 0), gsl_matrix_get (tubeMatrix, i, 1), gsl_matrix_get (tubeMatrix, i, 2));
+      m_p2[i] = vec3 (gsl_matrix_get (tubeMatrix, i, 3), gsl_matrix_get (tubeMatrix, i, 4), gsl_matrix_get (tubeMatrix, i, 5));
+    }
+  index (cellSize);
+}
+
+void P1906MOL_MOTOR_SegmentIndex::buildFromVectorField (gsl_matrix * vf, double cellSize)
+{
+  NS_LOG_FUNCTION (this << vf->size1 << cellSize);
+
+  m_p1.resize (vf->size1);
+  m_p2.resize (vf->size1);
+  for (size_t i = 0; i < vf->size1; i++)
+    {
+      m_p1[i] = vec3 (gsl_matrix_get (vf, i, 0), gsl_matrix_get (vf, i, 1), gsl_matrix_get (vf, i, 2));
+      m_p2[i] = m_p1[i] + vec3 (gsl_matrix_get (vf, i, 3), gsl_matrix_get (vf, i, 4), gsl_matrix_get (vf, i, 5));
+    }
+  index (cellSize);
+}
+
+void P1906MOL_MOTOR_SegmentIndex::refit (gsl_matrix * tubeMatrix)
+{
+  build (tubeMatrix, m_cellSize);
+}
+
+void P1906MOL_MOTOR_SegmentIndex::clear ()
+{
+  m_p1.clear ();
+  m_p2.clear ();
+  m_segmentStart.assign (1, 0);
+  m_segments.clear ();
+  m_lanes.resize (0);
+  m_startStart.assign (1, 0);
+  m_starts.clear ();
+  for (int a = 0; a < 3; a++)
+    {
+      m_origin[a] = 0;
+      m_dim[a] = 0;
+    }
+}
+
+bool P1906MOL_MOTOR_SegmentIndex::empty () const
+{
+  return m_p1.empty ();
+}
+
+size_t P1906MOL_MOTOR_SegmentIndex::size () const
+{
+  return m_p1.size ();
+}
+
+double P1906MOL_MOTOR_SegmentIndex::getCellSize () const
+{
+  return m_cellSize;
+}
+
+const P1906MOL_MOTOR_Vec3 & P1906MOL_MOTOR_SegmentIndex::getStart (size_t s) const
+{
+  return m_p1[s];
+}
+
+const P1906MOL_MOTOR_Vec3 & P1906MOL_MOTOR_SegmentIndex::getEnd (size_t s) const
+{
+  return m_p2[s];
+}
+
+//! the grid covers the bounding box of all end points; a cell size that is not positive is
+//! derived from that box, and the cell size is doubled until the grid holds at most
+//! max (4096, 8 * segments) cells so that a tiny radius cannot exhaust memory
+void P1906MOL_MOTOR_SegmentIndex::index (double cellSize)
+{
+  size_t n = m_p1.size ();
+  double lo[3] = { DBL_MAX, DBL_MAX, DBL_MAX };
+  double hi[3] = { -DBL_MAX, -DBL_MAX, -DBL_MAX };
+
+  m_segmentStart.assign (1, 0);
+  m_segments.clear ();
+  m_lanes.resize (0);
+  m_startStart.assign (1, 0);
+  m_starts.clear ();
+  m_cellSize = cellSize;
+  if (n == 0)
+    {
+      m_dim[0] = m_dim[1] = m_dim[2] = 0;
+      return;
+    }
+
+  for (size_t i = 0; i < n; i++)
+    {
+      const double c[6] = { m_p1[i].x, m_p1[i].y, m_p1[i].z, m_p2[i].x, m_p2[i].y, m_p2[i].z };
+      for (int a = 0; a < 3; a++)
+        {
+          lo[a] = std::min (lo[a], std::min (c[a], c[a + 3]));
+          hi[a] = std::max (hi[a], std::max (c[a], c[a + 3]));
+        }
+    }
+
+  double extent = std::max (hi[0] - lo[0], std::max (hi[1] - lo[1], hi[2] - lo[2]));
+  if (!(m_cellSize > 0) || !std::isfinite (m_cellSize))
+    {
+      m_cellSize = extent > 0 ? extent / std::cbrt ((double) n) : 1.0;
+    }
+
+  double maxCells = std::max (4096.0, 8.0 * n);
+  double cells;
+  do
+    {
+      cells = 1;
+      for (int a = 0; a < 3; a++)
+        {
+          cells *= std::floor ((hi[a] - lo[a]) / m_cellSize) + 1;
+        }
+      if (cells > maxCells)
+        {
+          m_cellSize *= 2;
+        }
+    }
+  while (cells > maxCells);
+
+  for (int a = 0; a < 3; a++)
+    {
+      m_origin[a] = lo[a];
+      m_dim[a] = (long) std::floor ((hi[a] - lo[a]) / m_cellSize) + 1;
+    }
+
+  //! count, prefix sum and fill: the cells are stored back to back, each padded to a multiple of the kernel lanes
+  size_t numCells = (size_t) cells;
+  m_segmentStart.assign (numCells + 1, 0);
+  m_startStart.assign (numCells + 1, 0);
+
+  for (int pass = 0; pass < 2; pass++)
+    {
+      vector<size_t> segmentFill, startFill;
+      if (pass == 1)
+        {
+          const size_t lanes = P1906MOL_MOTOR_SegmentArrays::lanes;
+          for (size_t c = 0; c < numCells; c++)
+            {
+              m_segmentStart[c + 1] = m_segmentStart[c] + (m_segmentStart[c + 1] + lanes - 1) / lanes * lanes;
+              m_startStart[c + 1] += m_startStart[c];
+            }
+          m_segments.assign (m_segmentStart[numCells], -1);
+          m_lanes.resize (m_segmentStart[numCells]);
+          m_starts.resize (m_startStart[numCells]);
+          segmentFill.assign (m_segmentStart.begin (), m_segmentStart.end () - 1);
+          startFill.assign (m_startStart.begin (), m_startStart.end () - 1);
+        }
+
+      for (size_t s = 0; s < n; s++)
+        {
+          long i0 = cellCoord (std::min (m_p1[s].x, m_p2[s].x), 0), i1 = cellCoord (std::max (m_p1[s].x, m_p2[s].x), 0);
+          long j0 = cellCoord (std::min (m_p1[s].y, m_p2[s].y), 1), j1 = cellCoord (std::max (m_p1[s].y, m_p2[s].y), 1);
+          long k0 = cellCoord (std::min (m_p1[s].z, m_p2[s].z), 2), k1 = cellCoord (std::max (m_p1[s].z, m_p2[s].z), 2);
+
+          for (long i = i0; i <= i1; i++)
+            for (long j = j0; j <= j1; j++)
+              for (long k = k0; k <= k1; k++)
+                {
+                  size_t c = cellOffset (i, j, k);
+                  if (pass == 0)
+                    m_segmentStart[c + 1]++;
+                  else
+                    {
+                      m_lanes.set (segmentFill[c], m_p1[s], m_p2[s]);
+                      m_segments[segmentFill[c]++] = s;
+                    }
+                }
+
+          size_t c = cellOffset (cellCoord (m_p1[s].x, 0), cellCoord (m_p1[s].y, 1), cellCoord (m_p1[s].z, 2));
+          if (pass == 0)
+            m_startStart[c + 1]++;
+          else
+            m_starts[startFill[c]++] = s;
+        }
+    }
+
+  NS_LOG_FUNCTION (this << n << m_cellSize << m_dim[0] << m_dim[1] << m_dim[2] << m_segments.size ());
+}
+
+long P1906MOL_MOTOR_SegmentIndex::cellCoord (double v, int a) const
+{
+  double c = std::floor ((v - m_origin[a]) / m_cellSize);
+
+  if (!(c > 0))
+    return 0;
+  if (c > m_dim[a] - 1)
+    return m_dim[a] - 1;
+  return (long) c;
+}
+
+size_t P1906MOL_MOTOR_SegmentIndex::cellOffset (long i, long j, long k) const
+{
+  return ((size_t) k * m_dim[1] + j) * m_dim[0] + i;
+}
+
+//! only the cells overlapping the box of half edge radius around pt are visited, each by the batched
+//! distance kernel; ties go to the lowest segment number, as with the linear scan in
+//! P1906MOL_MOTOR_Field::findNearestTube
+size_t P1906MOL_MOTOR_SegmentIndex::nearestSegment (const P1906MOL_MOTOR_Vec3 & pt, double radius) const
+{
+  size_t closestSegment = -1;
+  double shortestDistance = GSL_POSINF;
+  double radius2 = radius * radius;
+  const double p[3] = { pt.x, pt.y, pt.z };
+  double d2[64];
+
+  if (empty () || radius < 0)
+    return closestSegment;
+
+  //! the grid is the bounding box of the network: nothing to find if the query box misses it
+  for (int a = 0; a < 3; a++)
+    {
+      if (p[a] + radius < m_origin[a] || p[a] - radius > m_origin[a] + m_dim[a] * m_cellSize)
+        return closestSegment;
+    }
+
+  long i0 = cellCoord (pt.x - radius, 0), i1 = cellCoord (pt.x + radius, 0);
+  long j0 = cellCoord (pt.y - radius, 1), j1 = cellCoord (pt.y + radius, 1);
+  long k0 = cellCoord (pt.z - radius, 2), k1 = cellCoord (pt.z + radius, 2);
+
+  for (long k = k0; k <= k1; k++)
+    for (long j = j0; j <= j1; j++)
+      for (long i = i0; i <= i1; i++)
+        {
+          size_t c = cellOffset (i, j, k);
+          for (size_t b = m_segmentStart[c]; b < m_segmentStart[c + 1]; b += 64)
+            {
+              size_t e1 = std::min (b + 64, m_segmentStart[c + 1]);
+              m_lanes.distance2 (pt, b, e1, d2);
+              for (size_t e = b; e < e1; e++)
+                {
+                  size_t s = m_segments[e];
+                  double d = d2[e - b];
+                  if (d <= radius2 && (d < shortestDistance || (d == shortestDistance && s < closestSegment)))
+                    {
+                      shortestDistance = d;
+                      closestSegment = s;
+                    }
+                }
+            }
+        }
+
+  return closestSegment;
+}
+
+//! cells are visited in shells of growing Chebyshev distance around the cell of pt; a point in shell
+//! k + 1 is at least k cells away, so the search stops once the best distance is below that bound
+size_t P1906MOL_MOTOR_SegmentIndex::nearestStart (const P1906MOL_MOTOR_Vec3 & pt) const
+{
+  size_t closestSegment = -1;
+  double shortestDistance = GSL_POSINF;
+
+  if (empty ())
+    return closestSegment;
+
+  long ci = cellCoord (pt.x, 0), cj = cellCoord (pt.y, 1), ck = cellCoord (pt.z, 2);
+  long maxShell = std::max (m_dim[0], std::max (m_dim[1], m_dim[2]));
+
+  for (long shell = 0; shell <= maxShell; shell++)
+    {
+      for (long k = std::max (0L, ck - shell); k <= std::min (m_dim[2] - 1, ck + shell); k++)
+        for (long j = std::max (0L, cj - shell); j <= std::min (m_dim[1] - 1, cj + shell); j++)
+          for (long i = std::max (0L, ci - shell); i <= std::min (m_dim[0] - 1, ci + shell); i++)
+            {
+              if (std::max (labs (i - ci), std::max (labs (j - cj), labs (k - ck))) != shell)
+                continue;
+
+              size_t c = cellOffset (i, j, k);
+              for (size_t e = m_startStart[c]; e < m_startStart[c + 1]; e++)
+                {
+                  size_t s = m_starts[e];
+                  double d = vec3Norm (pt - m_p1[s]);
+                  if (d < shortestDistance || (d == shortestDistance && s < closestSegment))
+                    {
+                      shortestDistance = d;
+                      closestSegment = s;
+                    }
+                }
+            }
+
+      if (shortestDistance < shell * m_cellSize)
+        break;
+    }
+
+  return closestSegment;
+}
+
+void P1906MOL_MOTOR_SegmentIndex::candidates (const P1906MOL_MOTOR_Vec3 & lo, const P1906MOL_MOTOR_Vec3 & hi, vector<size_t> & result) const
+{
+  if (empty ())
+    return;
+
+  long i0 = cellCoord (lo.x, 0), i1 = cellCoord (hi.x, 0);
+  long j0 = cellCoord (lo.y, 1), j1 = cellCoord (hi.y, 1);
+  long k0 = cellCoord (lo.z, 2), k1 = cellCoord (hi.z, 2);
+
+  for (long k = k0; k <= k1; k++)
+    for (long j = j0; j <= j1; j++)
+      for (long i = i0; i <= i1; i++)
+        {
+          size_t c = cellOffset (i, j, k);
+          for (size_t e = m_segmentStart[c]; e < m_segmentStart[c + 1] && m_segments[e] != (size_t) -1; e++)
+            result.push_back (m_segments[e]);
+        }
+}
+
+} // namespace ns3
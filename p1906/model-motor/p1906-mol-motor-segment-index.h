@@ -0,0 +1,124 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *  Copyright � 2015 by IEEE.
+ *
+ *  This source file is an essential part of IEEE Std 1906.1,
+ *  Recommended Practice for Nanoscale and Molecular
+ *  Communication Framework.
+ *  Verbatim copies of this source file may be used and
+ *  distributed without restriction. Modifications to this source
+ *  file as permitted in IEEE Std 1906.1 may also be made and
+ *  distributed. All other uses require permission from the IEEE
+ *  Standards Department (stds-ipr@ieee.org). All other rights
+ *  reserved.
+ *
+ *  This source file is provided on an AS IS basis.
+ *  The IEEE disclaims ANY WARRANTY EXPRESS OR IMPLIED INCLUDING
+ *  ANY WARRANTY OF MERCHANTABILITY AND FITNESS FOR USE FOR A
+ *  PARTICULAR PURPOSE.
+ *  The user of the source file shall indemnify and hold
+ *  IEEE harmless from any damages or liability arising out of
+ *  the use thereof.
+ *
+ * Author: Stephen F Bush - GE Global Research
+ *                      bushsf@research.ge.com
+ *                      http://www.amazon.com/author/stephenbush
+ */
+
+#ifndef P1906_MOL_MOTOR_SEGMENT_INDEX
+#define P1906_MOL_MOTOR_SEGMENT_INDEX
+
+#include <vector>
+using namespace std;
+
+#include <gsl/gsl_matrix.h>
+
+#include "ns3/p1906-mol-motor-vec3.h"
+#include "ns3/p1906-mol-motor-segment-arrays.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup IEEE P1906 framework
+ *
+ * \class P1906MOL_MOTOR_SegmentIndex
+ *
+ * \brief Uniform grid over the segments of a tube network
+ *
+ * Each segment (row of a tubeMatrix) is registered in every grid cell its
+ * bounding box overlaps, and its first end point in the single cell that
+ * contains it. The cells are stored contiguously (compressed row layout), so a
+ * query only visits the few cells around the query point instead of every
+ * segment of the network. The segments of each cell are also laid out in a
+ * P1906MOL_MOTOR_SegmentArrays, padded to a multiple of its lanes, so the
+ * distances to a whole cell are computed by the batched kernel. With the cell edge set to the tube contact radius, a
+ * "nearest segment within radius" query touches at most 27 cells.
+ *
+ * Row i of the index is row i of the matrix it was built from, so it also backs
+ * findClosestPoint on the vector field produced by tubes2VectorField.
+ * The index holds a copy of the end points: it must be rebuilt whenever the
+ * tube matrix changes.
+ */
+class P1906MOL_MOTOR_SegmentIndex
+{
+public:
+  P1906MOL_MOTOR_SegmentIndex ();
+
+  //! index the segments ((x1, y1, z1), (x2, y2, z2)) of tubeMatrix using cells of edge cellSize
+  void build (gsl_matrix * tubeMatrix, double cellSize);
+  //! index a vector field ((x, y, z), (u, v, w)) as the segments from (x, y, z) to (x + u, y + v, z + w)
+  void buildFromVectorField (gsl_matrix * vf, double cellSize);
+  //! re-index tubeMatrix keeping the current cell size
+  void refit (gsl_matrix * tubeMatrix);
+  //! forget all segments
+  void clear ();
+
+  //! true if no segment is indexed
+  bool empty () const;
+  //! number of indexed segments
+  size_t size () const;
+  //! edge of the grid cells
+  double getCellSize () const;
+
+  //! return the segment closest to pt within radius, otherwise return -1
+  size_t nearestSegment (const P1906MOL_MOTOR_Vec3 & pt, double radius) const;
+  //! return the segment whose first end point is the closest to pt, otherwise return -1
+  size_t nearestStart (const P1906MOL_MOTOR_Vec3 & pt) const;
+  //! append the segments binned in the cells overlapping the box [lo, hi] to result; a segment may be appended more than once
+  void candidates (const P1906MOL_MOTOR_Vec3 & lo, const P1906MOL_MOTOR_Vec3 & hi, vector<size_t> & result) const;
+
+  //! first end point of segment s
+  const P1906MOL_MOTOR_Vec3 & getStart (size_t s) const;
+  //! second end point of segment s
+  const P1906MOL_MOTOR_Vec3 & getEnd (size_t s) const;
+
+private:
+  //! bin the segments held in m_p1 and m_p2
+  void index (double cellSize);
+  //! grid coordinate of v along axis a, clamped to the grid
+  long cellCoord (double v, int a) const;
+  //! offset of cell (i, j, k) in the cell arrays
+  size_t cellOffset (long i, long j, long k) const;
+
+  //! the end points of each segment
+  vector<P1906MOL_MOTOR_Vec3> m_p1;
+  vector<P1906MOL_MOTOR_Vec3> m_p2;
+
+  //! grid geometry
+  double m_cellSize;
+  double m_origin[3];
+  long m_dim[3];
+
+  //! segments overlapping each cell: m_segments[m_segmentStart[c] .. m_segmentStart[c + 1]), -1 for padding
+  vector<size_t> m_segmentStart;
+  vector<size_t> m_segments;
+  //! the segment of each entry of m_segments
+  P1906MOL_MOTOR_SegmentArrays m_lanes;
+  //! segments whose first end point is in each cell
+  vector<size_t> m_startStart;
+  vector<size_t> m_starts;
+};
+
+}
+
+#endif /* P1906_MOL_MOTOR_SEGMENT_INDEX */
@@ -0,0 +1,334 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *  Copyright � 2015 by IEEE.
+ *
+ *  This source file is an essential part of IEEE Std 1906.1,
+ *  Recommended Practice for Nanoscale and Molecular
+ *  Communication Framework.
+ *  Verbatim copies of this source file may be used and
+ *  distributed without restriction. Modifications to this source
+ *  file as permitted in IEEE Std 1906.1 may also be made and
+ *  distributed. All other uses require permission from the IEEE
+ *  Standards Department (stds-ipr@ieee.org). All other rights
+ *  reserved.
+ *
+ *  This source file is provided on an AS IS basis.
+ *  The IEEE disclaims ANY WARRANTY EXPRESS OR IMPLIED INCLUDING
+ *  ANY WARRANTY OF MERCHANTABILITY AND FITNESS FOR USE FOR A
+ *  PARTICULAR PURPOSE.
+ *  The user of the source file shall indemnify and hold
+ *  IEEE harmless from any damages or liability arising out of
+ *  the use thereof.
+ *
+ * Author: Stephen F Bush - GE Global Research
+ *                      bushsf@research.ge.com
+ *                      http://www.amazon.com/author/stephenbush
+ */
+
+
+/* \details Binary trace files: tables of doubles stored by columns
+ *
+ * <pre>
+ *   MathematicaHelper / MATLABHelper --+
+ *   TrajectoryWriter thread -----------+--> TraceWriter --stdio buffer--> *.p1906trc
+ *
+ *   *.p1906trc --mmap--> TraceReader --> motor-trace-converter --> *.mma, *.dat, *.csv
+ * </pre>
+ */
+
+#include <cstring>
+#include <map>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "ns3/log.h"
+#include "ns3/p1906-mol-motor-trace.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("P1906MOL_MOTOR_Trace");
+
+const char P1906MOL_MOTOR_Trace::magic[8] = { 'P', '1', '9', '0', '6', 'T', 'R', 'C' };
+
+//! fixed part of a trace file and of each of its chunks, see P1906MOL_MOTOR_Trace
+struct P1906MOL_MOTOR_TraceFileHeader
+{
+  char magic[8];
+  uint32_t version;
+  uint32_t reserved;
+};
+
+struct P1906MOL_MOTOR_TraceChunkHeader
+{
+  uint32_t kind;
+  uint32_t columns;
+  uint64_t rows;
+  uint64_t tag;
+  uint32_t labelLength;
+  uint32_t style;
+};
+
+//! the label is padded so that the columns stay aligned on doubles
+static size_t paddedLength (size_t labelLength)
+{
+  return (labelLength + 7) & ~((size_t) 7);
+}
+
+const char * P1906MOL_MOTOR_Trace::kindName (uint32_t kind)
+{
+  switch (kind)
+  {
+    case Trajectory: return "trajectory";
+    case Points: return "points";
+    case Path: return "path";
+    case Tubes: return "tubes";
+    case VectorField: return "vector field";
+    case Series: return "series";
+    case Sphere: return "sphere";
+  }
+  return "unknown";
+}
+
+const char * P1906MOL_MOTOR_Trace::columnName (uint32_t kind, uint32_t c, char buffer[16])
+{
+  static const char * trajectory[] = { "t", "x", "y", "z" };
+  static const char * points[] = { "x", "y", "z" };
+  static const char * tubes[] = { "x1", "y1", "z1", "x2", "y2", "z2" };
+  static const char * vectorField[] = { "x", "y", "z", "u", "v", "w" };
+  static const char * series[] = { "x", "y" };
+  static const char * sphere[] = { "x", "y", "z", "radius" };
+  
+  switch (kind)
+  {
+    case Trajectory: if (c < 4) return trajectory[c]; break;
+    case Points:
+    case Path: if (c < 3) return points[c]; break;
+    case Tubes: if (c < 6) return tubes[c]; break;
+    case VectorField: if (c < 6) return vectorField[c]; break;
+    case Series: if (c < 2) return series[c]; break;
+    case Sphere: if (c < 4) return sphere[c]; break;
+  }
+  snprintf (buffer, 16, "c%u", c);
+  return buffer;
+}
+
+P1906MOL_MOTOR_TraceWriter::P1906MOL_MOTOR_TraceWriter (FILE * file)
+  : m_file (file),
+    m_buffer (bufferSize)
+{
+  setvbuf (m_file, &m_buffer[0], _IOFBF, m_buffer.size ());
+  
+  P1906MOL_MOTOR_TraceFileHeader h;
+  memcpy (h.magic, P1906MOL_MOTOR_Trace::magic, sizeof (h.magic));
+  h.version = P1906MOL_MOTOR_Trace::version;
+  h.reserved = 0;
+  fwrite (&h, sizeof (h), 1, m_file);
+}
+
+P1906MOL_MOTOR_TraceWriter::~P1906MOL_MOTOR_TraceWriter ()
+{
+  fclose (m_file);
+}
+
+//! files are truncated once per process; later Gets append to the same writer
+Ptr<P1906MOL_MOTOR_TraceWriter> P1906MOL_MOTOR_TraceWriter::Get (const string & fileName)
+{
+  static map<string, Ptr<P1906MOL_MOTOR_TraceWriter> > open;
+  static SystemMutex openMutex;
+  
+  CriticalSection cs (openMutex);
+  map<string, Ptr<P1906MOL_MOTOR_TraceWriter> >::iterator it = open.find (fileName);
+  if (it != open.end ())
+    return it->second;
+  
+  FILE * file = fopen (fileName.c_str (), "wb");
+  if (!file)
+  {
+    NS_LOG_WARN ("cannot create the trace file " << fileName);
+    return 0;
+  }
+  Ptr<P1906MOL_MOTOR_TraceWriter> writer = Ptr<P1906MOL_MOTOR_TraceWriter> (new P1906MOL_MOTOR_TraceWriter (file), false);
+  open[fileName] = writer;
+  return writer;
+}
+
+void P1906MOL_MOTOR_TraceWriter::writeHeader (uint32_t kind, uint32_t style, uint64_t tag, const string & label, uint32_t columns, uint64_t rows)
+{
+  static const char zeros[8] = { 0 };
+  P1906MOL_MOTOR_TraceChunkHeader h;
+  
+  h.kind = kind;
+  h.columns = columns;
+  h.rows = rows;
+  h.tag = tag;
+  h.labelLength = label.size ();
+  h.style = style;
+  fwrite (&h, sizeof (h), 1, m_file);
+  fwrite (label.data (), 1, label.size (), m_file);
+  fwrite (zeros, 1, paddedLength (label.size ()) - label.size (), m_file);
+}
+
+bool P1906MOL_MOTOR_TraceWriter::write (uint32_t kind, uint32_t style, uint64_t tag, const string & label, const vector<const double *> & columns, uint64_t rows)
+{
+  CriticalSection cs (m_mutex);
+  
+  writeHeader (kind, style, tag, label, columns.size (), rows);
+  for (size_t c = 0; c < columns.size () && rows > 0; c++)
+    fwrite (columns[c], sizeof (double), rows, m_file);
+  return !ferror (m_file);
+}
+
+bool P1906MOL_MOTOR_TraceWriter::write (uint32_t kind, uint32_t style, uint64_t tag, const string & label, const gsl_matrix * m)
+{
+  CriticalSection cs (m_mutex);
+  
+  writeHeader (kind, style, tag, label, m->size2, m->size1);
+  m_column.resize (m->size1);
+  for (size_t c = 0; c < m->size2 && m->size1 > 0; c++)
+  {
+    for (size_t i = 0; i < m->size1; i++)
+      m_column[i] = gsl_matrix_get (m, i, c);
+    fwrite (&m_column[0], sizeof (double), m->size1, m_file);
+  }
+  return !ferror (m_file);
+}
+
+void P1906MOL_MOTOR_TraceWriter::flush ()
+{
+  CriticalSection cs (m_mutex);
+  fflush (m_file);
+}
+
+P1906MOL_MOTOR_TraceReader::P1906MOL_MOTOR_TraceReader ()
+  : m_mapping (0),
+    m_mappingSize (0),
+    m_truncated (false)
+{
+}
+
+P1906MOL_MOTOR_TraceReader::~P1906MOL_MOTOR_TraceReader ()
+{
+  if (m_mapping)
+    munmap (m_mapping, m_mappingSize);
+}
+
+Ptr<P1906MOL_MOTOR_TraceReader> P1906MOL_MOTOR_TraceReader::Load (const string & fileName)
+{
+  NS_LOG_FUNCTION (fileName);
+  
+  int fd = open (fileName.c_str (), O_RDONLY);
+  if (fd < 0)
+  {
+    NS_LOG_WARN ("cannot open the trace file " << fileName);
+    return 0;
+  }
+  struct stat st;
+  if (fstat (fd, &st) != 0 || (size_t) st.st_size < sizeof (P1906MOL_MOTOR_TraceFileHeader))
+  {
+    NS_LOG_WARN ("the trace file " << fileName << " is too short");
+    close (fd);
+    return 0;
+  }
+  size_t size = st.st_size;
+  void * mapping = mmap (0, size, PROT_READ, MAP_SHARED, fd, 0);
+  close (fd);
+  if (mapping == MAP_FAILED)
+  {
+    NS_LOG_WARN ("cannot map the trace file " << fileName);
+    return 0;
+  }
+  
+  const char * base = (const char *) mapping;
+  P1906MOL_MOTOR_TraceFileHeader fh;
+  memcpy (&fh, base, sizeof (fh));
+  if (memcmp (fh.magic, P1906MOL_MOTOR_Trace::magic, sizeof (fh.magic)) != 0 || fh.version != P1906MOL_MOTOR_Trace::version)
+  {
+    NS_LOG_WARN (fileName << " is not a trace file");
+    munmap (mapping, size);
+    return 0;
+  }
+  
+  Ptr<P1906MOL_MOTOR_TraceReader> reader = Ptr<P1906MOL_MOTOR_TraceReader> (new P1906MOL_MOTOR_TraceReader (), false);
+  reader->m_mapping = mapping;
+  reader->m_mappingSize = size;
+  
+  //! sizes are checked against what is left of the file before anything is added, so a corrupt count cannot overflow
+  size_t offset = sizeof (fh);
+  while (offset < size)
+  {
+    P1906MOL_MOTOR_TraceChunkHeader h;
+    size_t left = size - offset;
+    
+    if (left < sizeof (h))
+    {
+      reader->m_truncated = true;
+      break;
+    }
+    memcpy (&h, base + offset, sizeof (h));
+    left -= sizeof (h);
+    size_t label = paddedLength (h.labelLength);
+    if (h.labelLength > left || label > left 
+        || (h.columns > 0 && h.rows > (left - label) / sizeof (double) / h.columns))
+    {
+      reader->m_truncated = true;
+      break;
+    }
+    
+    Chunk c;
+    const char * text = base + offset + sizeof (h);
+    c.kind = h.kind;
+    c.style = h.style;
+    c.tag = h.tag;
+    c.columns = h.columns;
+    c.rows = h.rows;
+    c.data = (const double *) (text + label);
+    for (size_t start = 0; start <= h.labelLength; )
+    {
+      size_t end = start;
+      while (end < h.labelLength && text[end] != '\n')
+        end++;
+      c.labels.push_back (string (text + start, end - start));
+      start = end + 1;
+    }
+    reader->m_chunks.push_back (c);
+    offset += sizeof (h) + label + sizeof (double) * h.columns * h.rows;
+  }
+  if (reader->m_truncated)
+    NS_LOG_WARN (fileName << " ends inside a chunk, " << reader->m_chunks.size () << " complete chunks read");
+  
+  return reader;
+}
+
+size_t P1906MOL_MOTOR_TraceReader::getNumChunks () const
+{
+  return m_chunks.size ();
+}
+
+const P1906MOL_MOTOR_TraceReader::Chunk & P1906MOL_MOTOR_TraceReader::getChunk (size_t i) const
+{
+  return m_chunks[i];
+}
+
+bool P1906MOL_MOTOR_TraceReader::isTruncated () const
+{
+  return m_truncated;
+}
+
+gsl_matrix * P1906MOL_MOTOR_TraceReader::toMatrix (const Chunk & chunk)
+{
+  if (chunk.rows == 0 || chunk.columns == 0)
+    return 0;
+  
+  gsl_matrix * m = gsl_matrix_alloc (chunk.rows, chunk.columns);
+  for (uint32_t c = 0; c < chunk.columns; c++)
+  {
+    const double * column = chunk.column (c);
+    for (uint64_t i = 0; i < chunk.rows; i++)
+      gsl_matrix_set (m, i, c, column[i]);
+  }
+  return m;
+}
+
+} // namespace ns3
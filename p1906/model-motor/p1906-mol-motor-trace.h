@@ -0,0 +1,205 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *  Copyright � 2015 by IEEE.
+ *
+ *  This source file is an essential part of IEEE Std 1906.1,
+ *  Recommended Practice for Nanoscale and Molecular
+ *  Communication Framework.
+ *  Verbatim copies of this source file may be used and
+ *  distributed without restriction. Modifications to this source
+ *  file as permitted in IEEE Std 1906.1 may also be made and
+ *  distributed. All other uses require permission from the IEEE
+ *  Standards Department (stds-ipr@ieee.org). All other rights
+ *  reserved.
+ *
+ *  This source file is provided on an AS IS basis.
+ *  The IEEE disclaims ANY WARRANTY EXPRESS OR IMPLIED INCLUDING
+ *  ANY WARRANTY OF MERCHANTABILITY AND FITNESS FOR USE FOR A
+ *  PARTICULAR PURPOSE.
+ *  The user of the source file shall indemnify and hold
+ *  IEEE harmless from any damages or liability arising out of
+ *  the use thereof.
+ *
+ * Author: Stephen F Bush - GE Global Research
+ *                      bushsf@research.ge.com
+ *                      http://www.amazon.com/author/stephenbush
+ */
+
+
+#ifndef P1906_MOL_MOTOR_TRACE
+#define P1906_MOL_MOTOR_TRACE
+
+#include <stdint.h>
+#include <cstdio>
+#include <string>
+#include <vector>
+using namespace std;
+
+#include <gsl/gsl_matrix.h>
+
+#include "ns3/ptr.h"
+#include "ns3/simple-ref-count.h"
+#include "ns3/system-mutex.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup IEEE P1906 framework
+ *
+ * \class P1906MOL_MOTOR_Trace
+ *
+ * \brief Layout of the binary trace files holding tubes, trajectories, vector fields and metric series
+ *
+ * A trace file is a sequence of chunks, each a table of doubles stored by
+ * columns, so that a reader maps the file and uses the columns in place.
+ * All the fields are stored in the native byte order:
+ * <pre>
+ *  offset  size          field
+ *  0       8             magic "P1906TRC"
+ *  8       4             format version (1)
+ *  12      4             reserved
+ *  then, for each chunk:
+ *  0       4             kind (Kind)
+ *  4       4             number of columns (C)
+ *  8       8             number of rows (R)
+ *  16      8             tag: motor id of a Trajectory, segments per tube of Tubes, 0 otherwise
+ *  24      4             label length (L)
+ *  28      4             style (Style)
+ *  32      L             label, padded with zeros to a multiple of 8 bytes
+ *  32+L'   8 * C * R     the C columns of R doubles, one after the other
+ * </pre>
+ * The label is the name of the text file the chunk would have been written
+ * to; a Series adds its x and y axis labels to it, separated by '\n'.
+ * Chunks are only ever appended, so a file cut short by an interrupted run
+ * still holds all its complete chunks.
+ */
+class P1906MOL_MOTOR_Trace
+{
+public:
+  enum Kind
+  {
+    //! columns t, x, y, z of one motor
+    Trajectory = 1,
+    //! columns x, y, z
+    Points = 2,
+    //! columns x, y, z of points connected in order
+    Path = 3,
+    //! columns x1, y1, z1, x2, y2, z2 of tube segments
+    Tubes = 4,
+    //! columns x, y, z, u, v, w of vectors at locations
+    VectorField = 5,
+    //! columns x, y of a metric plotted against a parameter
+    Series = 6,
+    //! columns x, y, z, radius
+    Sphere = 7
+  };
+  
+  //! how the text file of the chunk was laid out
+  enum Style
+  {
+    Default = 0,
+    //! a VectorField drawn as arrows rather than by ListVectorPlot3D
+    Arrows = 1,
+    //! rows of numbers loadable by MATLAB
+    MATLABRows = 2
+  };
+  
+  //! name of kind, or "unknown"
+  static const char * kindName (uint32_t kind);
+  //! name of column c of kind, or "c<c>" when the kind does not name it; buffer holds the latter
+  static const char * columnName (uint32_t kind, uint32_t c, char buffer[16]);
+  
+  static const char magic[8];
+  static const uint32_t version = 1;
+};
+
+/**
+ * \ingroup IEEE P1906 framework
+ *
+ * \class P1906MOL_MOTOR_TraceWriter
+ *
+ * \brief Appends chunks to a trace file through one large stdio buffer
+ *
+ * There is one writer per file name and process, shared by every component
+ * tracing to that file and safe to use from several threads; the file is
+ * created on the first Get and closed when the process exits.
+ */
+class P1906MOL_MOTOR_TraceWriter : public SimpleRefCount<P1906MOL_MOTOR_TraceWriter>
+{
+public:
+  //! the writer of fileName, or 0 if the file cannot be created
+  static Ptr<P1906MOL_MOTOR_TraceWriter> Get (const string & fileName);
+  //! flush and close the file
+  ~P1906MOL_MOTOR_TraceWriter ();
+  
+  //! append a chunk of rows rows; columns[c] points to the rows values of column c
+  bool write (uint32_t kind, uint32_t style, uint64_t tag, const string & label, const vector<const double *> & columns, uint64_t rows);
+  //! append the rows of m as a chunk of m->size2 columns
+  bool write (uint32_t kind, uint32_t style, uint64_t tag, const string & label, const gsl_matrix * m);
+  //! hand the buffered chunks to the operating system
+  void flush ();
+  
+  //! size of the stdio buffer
+  static const size_t bufferSize = 1 << 20;
+  
+private:
+  P1906MOL_MOTOR_TraceWriter (FILE * file);
+  //! write the chunk header and the padded label
+  void writeHeader (uint32_t kind, uint32_t style, uint64_t tag, const string & label, uint32_t columns, uint64_t rows);
+  
+  FILE * m_file;
+  vector<char> m_buffer;
+  //! one column of a gsl_matrix being written
+  vector<double> m_column;
+  SystemMutex m_mutex;
+};
+
+/**
+ * \ingroup IEEE P1906 framework
+ *
+ * \class P1906MOL_MOTOR_TraceReader
+ *
+ * \brief Maps a trace file and lists its chunks, whose columns are read in place
+ */
+class P1906MOL_MOTOR_TraceReader : public SimpleRefCount<P1906MOL_MOTOR_TraceReader>
+{
+public:
+  struct Chunk
+  {
+    uint32_t kind;
+    uint32_t style;
+    uint64_t tag;
+    //! the label split at '\n'; labels[0] is the name of the chunk
+    vector<string> labels;
+    uint32_t columns;
+    uint64_t rows;
+    //! the columns, one after the other, inside the mapping
+    const double * data;
+    
+    const double * column (uint32_t c) const { return data + c * rows; }
+    double get (uint64_t row, uint32_t c) const { return data[c * rows + row]; }
+  };
+  
+  //! the chunks of fileName, or 0 if the file cannot be mapped or is not a trace file
+  static Ptr<P1906MOL_MOTOR_TraceReader> Load (const string & fileName);
+  ~P1906MOL_MOTOR_TraceReader ();
+  
+  size_t getNumChunks () const;
+  const Chunk & getChunk (size_t i) const;
+  //! true if the file ends inside a chunk, which is then left out
+  bool isTruncated () const;
+  //! copy the rows of chunk into a newly allocated rows x columns matrix, 0 for an empty chunk
+  static gsl_matrix * toMatrix (const Chunk & chunk);
+  
+private:
+  P1906MOL_MOTOR_TraceReader ();
+  
+  void * m_mapping;
+  size_t m_mappingSize;
+  vector<Chunk> m_chunks;
+  bool m_truncated;
+};
+
+}
+
+#endif /* P1906_MOL_MOTOR_TRACE */
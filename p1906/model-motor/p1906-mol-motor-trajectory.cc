@@ -0,0 +1,277 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *  Copyright � 2015 by IEEE.
+ *
+ *  This source file is an essential part of IEEE Std 1906.1,
+ *  Recommended Practice for Nanoscale and Molecular
+ *  Communication Framework.
+ *  Verbatim copies of this source file may be used and
+ *  distributed without restriction. Modifications to this source
+ *  file as permitted in IEEE Std 1906.1 may also be made and
+ *  distributed. All other uses require permission from the IEEE
+ *  Standards Department (stds-ipr@ieee.org). All other rights
+ *  reserved.
+ *
+ *  This source file is provided on an AS IS basis.
+ *  The IEEE disclaims ANY WARRANTY EXPRESS OR IMPLIED INCLUDING
+ *  ANY WARRANTY OF MERCHANTABILITY AND FITNESS FOR USE FOR A
+ *  PARTICULAR PURPOSE.
+ *  The user of the source file shall indemnify and hold
+ *  IEEE harmless from any damages or liability arising out of
+ *  the use thereof.
+ *
+ * Author: Stephen F Bush - GE Global Research
+ *                      bushsf@research.ge.com
+ *                      http://www.amazon.com/author/stephenbush
+ */
+
+/* \details Trajectory sinks: what is kept of the positions of a motor
+ *
+ * <pre>
+ *   motor --record (pt, t)--> sink --+--> nothing                      (Off)
+ *                                    +--> every / every n-th position  (All, Decimated)
+ *                                    +--> last k positions             (Ring)
+ *                                    +--> chunk --queue--> writer thread --> trace file  (Stream)
+ * </pre>
+ */
+
+#include "ns3/log.h"
+#include "ns3/p1906-mol-motor-trajectory.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("P1906MOL_MOTOR_Trajectory");
+
+P1906MOL_MOTOR_TrajectorySink::~P1906MOL_MOTOR_TrajectorySink ()
+{
+}
+
+void P1906MOL_MOTOR_TrajectorySink::clear ()
+{
+}
+
+bool P1906MOL_MOTOR_TrajectorySink::getPoints (vector<P1906MOL_MOTOR_Vec3> & pts) const
+{
+  pts.clear ();
+  return false;
+}
+
+void P1906MOL_MOTOR_TrajectoryAll::record (const P1906MOL_MOTOR_Vec3 & pt, double t)
+{
+  m_points.push_back (pt);
+}
+
+void P1906MOL_MOTOR_TrajectoryAll::clear ()
+{
+  m_points.clear ();
+}
+
+bool P1906MOL_MOTOR_TrajectoryAll::getPoints (vector<P1906MOL_MOTOR_Vec3> & pts) const
+{
+  pts = m_points;
+  return true;
+}
+
+void P1906MOL_MOTOR_TrajectoryOff::record (const P1906MOL_MOTOR_Vec3 & pt, double t)
+{
+}
+
+P1906MOL_MOTOR_TrajectoryDecimated::P1906MOL_MOTOR_TrajectoryDecimated (uint32_t n)
+  : m_n (n > 0 ? n : 1),
+    m_count (0)
+{
+}
+
+void P1906MOL_MOTOR_TrajectoryDecimated::record (const P1906MOL_MOTOR_Vec3 & pt, double t)
+{
+  if (m_count++ % m_n == 0)
+    m_points.push_back (pt);
+}
+
+void P1906MOL_MOTOR_TrajectoryDecimated::clear ()
+{
+  m_count = 0;
+  m_points.clear ();
+}
+
+bool P1906MOL_MOTOR_TrajectoryDecimated::getPoints (vector<P1906MOL_MOTOR_Vec3> & pts) const
+{
+  pts = m_points;
+  return true;
+}
+
+//! the ring is allocated once, so recording never allocates
+P1906MOL_MOTOR_TrajectoryRing::P1906MOL_MOTOR_TrajectoryRing (uint32_t k)
+  : m_points (k > 0 ? k : 1),
+    m_size (0),
+    m_next (0)
+{
+}
+
+void P1906MOL_MOTOR_TrajectoryRing::record (const P1906MOL_MOTOR_Vec3 & pt, double t)
+{
+  m_points[m_next] = pt;
+  m_next = (m_next + 1) % m_points.size ();
+  if (m_size < m_points.size ())
+    m_size++;
+}
+
+void P1906MOL_MOTOR_TrajectoryRing::clear ()
+{
+  m_size = 0;
+  m_next = 0;
+}
+
+bool P1906MOL_MOTOR_TrajectoryRing::getPoints (vector<P1906MOL_MOTOR_Vec3> & pts) const
+{
+  size_t first = (m_next + m_points.size () - m_size) % m_points.size ();
+  
+  pts.clear ();
+  for (size_t i = 0; i < m_size; i++)
+    pts.push_back (m_points[(first + i) % m_points.size ()]);
+  return true;
+}
+
+P1906MOL_MOTOR_TrajectoryWriter::P1906MOL_MOTOR_TrajectoryWriter (const string & fileName)
+  : m_trace (P1906MOL_MOTOR_TraceWriter::Get (fileName)),
+    m_stop (false)
+{
+  NS_LOG_FUNCTION (this << fileName);
+  
+  if (!m_trace)
+  {
+    NS_LOG_WARN ("cannot create the trajectory file " << fileName << ", trajectories are dropped");
+    return;
+  }
+  
+  m_thread = Create<SystemThread> (MakeCallback (&P1906MOL_MOTOR_TrajectoryWriter::run, this));
+  m_thread->Start ();
+}
+
+P1906MOL_MOTOR_TrajectoryWriter::~P1906MOL_MOTOR_TrajectoryWriter ()
+{
+  NS_LOG_FUNCTION (this);
+  
+  if (!m_trace)
+    return;
+  
+  {
+    P1906Monitor::Guard g (m_monitor);
+    m_stop = true;
+    m_monitor.Broadcast ();
+  }
+  m_thread->Join ();
+}
+
+bool P1906MOL_MOTOR_TrajectoryWriter::isOpen () const
+{
+  return m_trace != 0;
+}
+
+void P1906MOL_MOTOR_TrajectoryWriter::write (Chunk & chunk)
+{
+  if (!m_trace || chunk.t.empty ())
+  {
+    chunk.t.clear ();
+    chunk.x.clear ();
+    chunk.y.clear ();
+    chunk.z.clear ();
+    return;
+  }
+  
+  //! wait for room; the writer broadcasts after every batch it takes
+  P1906Monitor::Guard g (m_monitor);
+  while (m_queue.size () >= maxQueued)
+    m_monitor.Wait ();
+  
+  m_queue.push_back (Chunk ());
+  Chunk & queued = m_queue.back ();
+  queued.motor = chunk.motor;
+  queued.t.swap (chunk.t);
+  queued.x.swap (chunk.x);
+  queued.y.swap (chunk.y);
+  queued.z.swap (chunk.z);
+  m_monitor.Broadcast ();
+}
+
+//! no logging here: this runs outside the simulator thread
+void P1906MOL_MOTOR_TrajectoryWriter::run (void)
+{
+  deque<Chunk> batch;
+  vector<const double *> columns (4);
+  
+  while (true)
+  {
+    bool stop;
+    
+    {
+      P1906Monitor::Guard g (m_monitor);
+      while (m_queue.empty () && !m_stop)
+        m_monitor.Wait ();
+      batch.swap (m_queue);
+      stop = m_stop;
+      m_monitor.Broadcast ();
+    }
+    
+    for (size_t i = 0; i < batch.size (); i++)
+    {
+      const Chunk & c = batch[i];
+      
+      columns[0] = &c.t[0];
+      columns[1] = &c.x[0];
+      columns[2] = &c.y[0];
+      columns[3] = &c.z[0];
+      m_trace->write (P1906MOL_MOTOR_Trace::Trajectory, P1906MOL_MOTOR_Trace::Default, c.motor, "", columns, c.t.size ());
+    }
+    batch.clear ();
+    
+    if (stop)
+    {
+      m_trace->flush ();
+      return;
+    }
+  }
+}
+
+//! the columns are reserved once and handed over by swapping, so a motor only ever holds one chunk
+P1906MOL_MOTOR_TrajectoryStream::P1906MOL_MOTOR_TrajectoryStream (Ptr<P1906MOL_MOTOR_TrajectoryWriter> writer, uint64_t motor, uint32_t chunkSize)
+  : m_writer (writer),
+    m_chunkSize (chunkSize > 0 ? chunkSize : 1)
+{
+  m_chunk.motor = motor;
+}
+
+P1906MOL_MOTOR_TrajectoryStream::~P1906MOL_MOTOR_TrajectoryStream ()
+{
+  flush ();
+}
+
+void P1906MOL_MOTOR_TrajectoryStream::record (const P1906MOL_MOTOR_Vec3 & pt, double t)
+{
+  if (m_chunk.t.empty ())
+  {
+    m_chunk.t.reserve (m_chunkSize);
+    m_chunk.x.reserve (m_chunkSize);
+    m_chunk.y.reserve (m_chunkSize);
+    m_chunk.z.reserve (m_chunkSize);
+  }
+  m_chunk.t.push_back (t);
+  m_chunk.x.push_back (pt.x);
+  m_chunk.y.push_back (pt.y);
+  m_chunk.z.push_back (pt.z);
+  
+  if (m_chunk.t.size () >= m_chunkSize)
+    flush ();
+}
+
+void P1906MOL_MOTOR_TrajectoryStream::clear ()
+{
+  flush ();
+}
+
+void P1906MOL_MOTOR_TrajectoryStream::flush ()
+{
+  m_writer->write (m_chunk);
+}
+
+} // namespace ns3
@@ -0,0 +1,195 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *  Copyright � 2015 by IEEE.
+ *
+ *  This source file is an essential part of IEEE Std 1906.1,
+ *  Recommended Practice for Nanoscale and Molecular
+ *  Communication Framework.
+ *  Verbatim copies of this source file may be used and
+ *  distributed without restriction. Modifications to this source
+ *  file as permitted in IEEE Std 1906.1 may also be made and
+ *  distributed. All other uses require permission from the IEEE
+ *  Standards Department (stds-ipr@ieee.org). All other rights
+ *  reserved.
+ *
+ *  This source file is provided on an AS IS basis.
+ *  The IEEE disclaims ANY WARRANTY EXPRESS OR IMPLIED INCLUDING
+ *  ANY WARRANTY OF MERCHANTABILITY AND FITNESS FOR USE FOR A
+ *  PARTICULAR PURPOSE.
+ *  The user of the source file shall indemnify and hold
+ *  IEEE harmless from any damages or liability arising out of
+ *  the use thereof.
+ *
+ * Author: Stephen F Bush - GE Global Research
+ *                      bushsf@research.ge.com
+ *                      http://www.amazon.com/author/stephenbush
+ */
+
+#ifndef P1906_MOL_MOTOR_TRAJECTORY
+#define P1906_MOL_MOTOR_TRAJECTORY
+
+#include <stdint.h>
+#include <deque>
+#include <string>
+#include <vector>
+using namespace std;
+
+#include "ns3/ptr.h"
+#include "ns3/simple-ref-count.h"
+#include "ns3/system-thread.h"
+#include "ns3/p1906-monitor.h"
+#include "ns3/p1906-mol-motor-vec3.h"
+#include "ns3/p1906-mol-motor-trace.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup IEEE P1906 framework
+ *
+ * \class P1906MOL_MOTOR_TrajectorySink
+ *
+ * \brief Receives the positions of a motor as it moves
+ *
+ * A motor hands every position it reaches to its sink, which decides what is
+ * kept: everything (P1906MOL_MOTOR_TrajectoryAll, the historical behaviour),
+ * nothing (P1906MOL_MOTOR_TrajectoryOff), every n-th position
+ * (P1906MOL_MOTOR_TrajectoryDecimated), the last k positions
+ * (P1906MOL_MOTOR_TrajectoryRing) or everything, streamed in chunks to a file
+ * by a background P1906MOL_MOTOR_TrajectoryWriter (P1906MOL_MOTOR_TrajectoryStream).
+ * Except for TrajectoryAll and TrajectoryDecimated, the memory held per motor is bounded.
+ */
+class P1906MOL_MOTOR_TrajectorySink : public SimpleRefCount<P1906MOL_MOTOR_TrajectorySink>
+{
+public:
+  virtual ~P1906MOL_MOTOR_TrajectorySink ();
+  
+  //! the motor reached pt at time t
+  virtual void record (const P1906MOL_MOTOR_Vec3 & pt, double t) = 0;
+  //! the motor starts a new trajectory
+  virtual void clear ();
+  //! copy the positions held in memory, oldest first, to pts; returns false if the sink holds none
+  virtual bool getPoints (vector<P1906MOL_MOTOR_Vec3> & pts) const;
+};
+
+//! keeps every position
+class P1906MOL_MOTOR_TrajectoryAll : public P1906MOL_MOTOR_TrajectorySink
+{
+public:
+  virtual void record (const P1906MOL_MOTOR_Vec3 & pt, double t);
+  virtual void clear ();
+  virtual bool getPoints (vector<P1906MOL_MOTOR_Vec3> & pts) const;
+  
+private:
+  vector<P1906MOL_MOTOR_Vec3> m_points;
+};
+
+//! keeps nothing
+class P1906MOL_MOTOR_TrajectoryOff : public P1906MOL_MOTOR_TrajectorySink
+{
+public:
+  virtual void record (const P1906MOL_MOTOR_Vec3 & pt, double t);
+};
+
+//! keeps the first position and every n-th after it
+class P1906MOL_MOTOR_TrajectoryDecimated : public P1906MOL_MOTOR_TrajectorySink
+{
+public:
+  P1906MOL_MOTOR_TrajectoryDecimated (uint32_t n);
+  virtual void record (const P1906MOL_MOTOR_Vec3 & pt, double t);
+  virtual void clear ();
+  virtual bool getPoints (vector<P1906MOL_MOTOR_Vec3> & pts) const;
+  
+private:
+  uint32_t m_n;
+  uint64_t m_count;
+  vector<P1906MOL_MOTOR_Vec3> m_points;
+};
+
+//! keeps the last k positions
+class P1906MOL_MOTOR_TrajectoryRing : public P1906MOL_MOTOR_TrajectorySink
+{
+public:
+  P1906MOL_MOTOR_TrajectoryRing (uint32_t k);
+  virtual void record (const P1906MOL_MOTOR_Vec3 & pt, double t);
+  virtual void clear ();
+  virtual bool getPoints (vector<P1906MOL_MOTOR_Vec3> & pts) const;
+  
+private:
+  //! m_points[m_next] is the oldest position once the ring is full
+  vector<P1906MOL_MOTOR_Vec3> m_points;
+  size_t m_size;
+  size_t m_next;
+};
+
+/**
+ * \ingroup IEEE P1906 framework
+ *
+ * \class P1906MOL_MOTOR_TrajectoryWriter
+ *
+ * \brief Writes the chunks of trajectories of any number of motors to one trace file on a background thread
+ *
+ * Each chunk becomes a P1906MOL_MOTOR_Trace::Trajectory chunk tagged with the
+ * motor id and holding the columns t, x, y and z. The chunks of a motor appear
+ * in order; those of different motors may interleave.
+ *
+ * At most maxQueued chunks wait for the disk: a motor producing faster than
+ * the file is written blocks until the writer catches up.
+ */
+class P1906MOL_MOTOR_TrajectoryWriter : public SimpleRefCount<P1906MOL_MOTOR_TrajectoryWriter>
+{
+public:
+  struct Chunk
+  {
+    uint64_t motor;
+    vector<double> t;
+    vector<double> x;
+    vector<double> y;
+    vector<double> z;
+  };
+  
+  //! start the writer thread on the trace file fileName; isOpen () tells if the file could be created
+  P1906MOL_MOTOR_TrajectoryWriter (const string & fileName);
+  //! write the chunks still queued and stop the thread
+  ~P1906MOL_MOTOR_TrajectoryWriter ();
+  
+  bool isOpen () const;
+  //! queue the chunk for writing; its columns are taken, leaving chunk empty
+  void write (Chunk & chunk);
+  
+  //! chunks waiting for the disk
+  static const size_t maxQueued = 64;
+  
+private:
+  //! the background thread
+  void run (void);
+  
+  Ptr<P1906MOL_MOTOR_TraceWriter> m_trace;
+  //! m_queue and m_stop are guarded by m_monitor, broadcast when a chunk is queued, the queue is taken or a stop requested
+  P1906Monitor m_monitor;
+  deque<Chunk> m_queue;
+  bool m_stop;
+  Ptr<SystemThread> m_thread;
+};
+
+//! buffers the positions of one motor and hands them to a P1906MOL_MOTOR_TrajectoryWriter in chunks of chunkSize
+class P1906MOL_MOTOR_TrajectoryStream : public P1906MOL_MOTOR_TrajectorySink
+{
+public:
+  P1906MOL_MOTOR_TrajectoryStream (Ptr<P1906MOL_MOTOR_TrajectoryWriter> writer, uint64_t motor, uint32_t chunkSize = 1024);
+  //! hands the last, partial chunk to the writer
+  virtual ~P1906MOL_MOTOR_TrajectoryStream ();
+  virtual void record (const P1906MOL_MOTOR_Vec3 & pt, double t);
+  //! the trajectory so far is already on its way to the file: flush it
+  virtual void clear ();
+  //! hands the positions buffered so far to the writer
+  void flush ();
+  
+private:
+  Ptr<P1906MOL_MOTOR_TrajectoryWriter> m_writer;
+  uint32_t m_chunkSize;
+  P1906MOL_MOTOR_TrajectoryWriter::Chunk m_chunk;
+};
+
+}
+
+#endif /* P1906_MOL_MOTOR_TRAJECTORY */
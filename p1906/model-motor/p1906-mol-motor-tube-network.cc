@@ -0,0 +1,160 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *  Copyright � 2015 by IEEE.
+ *
+ *  This source file is an essential part of IEEE Std 1906.1,
+ *  Recommended Practice for Nanoscale and Molecular
+ *  Communication Framework.
+ *  Verbatim copies of this source file may be used and
+ *  distributed without restriction. Modifications to this source
+ *  file as permitted in IEEE Std 1906.1 may also be made and
+ *  distributed. All other uses require permission from the IEEE
+ *  Standards Department (stds-ipr@ieee.org). All other rights
+ *  reserved.
+ *
+ *  This source file is provided on an AS IS basis.
+ *  The IEEE disclaims ANY WARRANTY EXPRESS OR IMPLIED INCLUDING
+ *  ANY WARRANTY OF MERCHANTABILITY AND FITNESS FOR USE FOR A
+ *  PARTICULAR PURPOSE.
+ *  The user of the source file shall indemnify and hold
+ *  IEEE harmless from any damages or liability arising out of
+ *  the use thereof.
+ *
+ * Author: Stephen F Bush - GE Global Research
+ *                      bushsf@research.ge.com
+ *                      http://www.amazon.com/author/stephenbush
+ */
+
+
+/* \details A microtubule network shared by the fields, motions and motors of one environment
+ *
+ * <pre>
+ *   field 1 --+
+ *   field 2 --+--> Ptr<TubeNetwork> --> tubeMatrix, vector field, segment index
+ *   motion  --+         ^
+ *                       | Find (environment, tube properties)
+ *                   registry
+ * </pre>
+ */
+
+#include "ns3/log.h"
+#include "ns3/system-mutex.h"
+#include "ns3/p1906-mol-motor-tube-network.h"
+#include "ns3/p1906-mol-motor-field.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("P1906MOL_MOTOR_TubeNetwork");
+
+//! guards the registry, shared by all the fields of the process
+static SystemMutex g_tubeNetworksMutex;
+
+//! tube radius (thickness) [nm], for every tube
+const double P1906MOL_MOTOR_TubeNetwork::contactRadius = 15;
+
+P1906MOL_MOTOR_TubeNetwork::P1906MOL_MOTOR_TubeNetwork (gsl_matrix * tubeMatrix, const tubeCharacteristcs_t & ts)
+  : m_tubeMatrix (tubeMatrix),
+    m_vf (gsl_matrix_alloc (tubeMatrix->size1, 6)),
+    m_ts (ts)
+{
+  NS_LOG_FUNCTION (this << tubeMatrix->size1);
+  
+  P1906MOL_MOTOR_Field::tubes2VectorField (m_tubeMatrix, m_vf);
+  //! a contact query visits at most 3 x 3 x 3 cells
+  m_index.build (m_tubeMatrix, contactRadius);
+}
+
+P1906MOL_MOTOR_TubeNetwork::~P1906MOL_MOTOR_TubeNetwork ()
+{
+  NS_LOG_FUNCTION (this);
+  
+  gsl_matrix_free (m_tubeMatrix);
+  gsl_matrix_free (m_vf);
+}
+
+gsl_matrix * P1906MOL_MOTOR_TubeNetwork::getTubeMatrix () const
+{
+  return m_tubeMatrix;
+}
+
+gsl_matrix * P1906MOL_MOTOR_TubeNetwork::getVectorField () const
+{
+  return m_vf;
+}
+
+const P1906MOL_MOTOR_SegmentIndex & P1906MOL_MOTOR_TubeNetwork::getTubeIndex () const
+{
+  return m_index;
+}
+
+const tubeCharacteristcs_t & P1906MOL_MOTOR_TubeNetwork::getTubeChars () const
+{
+  return m_ts;
+}
+
+size_t P1906MOL_MOTOR_TubeNetwork::getSegPerTube () const
+{
+  return m_ts.segPerTube;
+}
+
+//! derived properties (segment length and counts) and the entropy of the result are left out
+P1906MOL_MOTOR_TubeNetwork::Key P1906MOL_MOTOR_TubeNetwork::makeKey (const string & environment, const tubeCharacteristcs_t & ts)
+{
+  vector<double> p;
+  
+  p.push_back (ts.volume);
+  p.push_back (ts.mean_tube_length);
+  p.push_back (ts.mean_intra_tube_angle);
+  p.push_back (ts.mean_inter_tube_angle);
+  p.push_back (ts.mean_tube_density);
+  p.push_back (ts.persistenceLength);
+  p.push_back (ts.segPerTube);
+  return Key (environment, p);
+}
+
+//! the map holds references, so a network cannot be freed while another field looks it up
+map<P1906MOL_MOTOR_TubeNetwork::Key, Ptr<P1906MOL_MOTOR_TubeNetwork> > & P1906MOL_MOTOR_TubeNetwork::registry ()
+{
+  static map<Key, Ptr<P1906MOL_MOTOR_TubeNetwork> > networks;
+  return networks;
+}
+
+Ptr<P1906MOL_MOTOR_TubeNetwork> P1906MOL_MOTOR_TubeNetwork::Find (const string & environment, const tubeCharacteristcs_t & ts)
+{
+  if (environment.empty ())
+    return 0;
+  
+  CriticalSection cs (g_tubeNetworksMutex);
+  map<Key, Ptr<P1906MOL_MOTOR_TubeNetwork> >::iterator it = registry ().find (makeKey (environment, ts));
+  
+  if (it == registry ().end ())
+    return 0;
+  return it->second;
+}
+
+void P1906MOL_MOTOR_TubeNetwork::Register (const string & environment, Ptr<P1906MOL_MOTOR_TubeNetwork> network)
+{
+  if (environment.empty ())
+    return;
+  NS_LOG_FUNCTION (environment << network);
+  
+  CriticalSection cs (g_tubeNetworksMutex);
+  registry ()[makeKey (environment, network->m_ts)] = network;
+}
+
+void P1906MOL_MOTOR_TubeNetwork::Unregister (const string & environment)
+{
+  NS_LOG_FUNCTION (environment);
+  
+  CriticalSection cs (g_tubeNetworksMutex);
+  map<Key, Ptr<P1906MOL_MOTOR_TubeNetwork> >::iterator it = registry ().begin ();
+  while (it != registry ().end ())
+  {
+    if (it->first.first == environment)
+      registry ().erase (it++);
+    else
+      it++;
+  }
+}
+
+} // namespace ns3
@@ -0,0 +1,100 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *  Copyright � 2015 by IEEE.
+ *
+ *  This source file is an essential part of IEEE Std 1906.1,
+ *  Recommended Practice for Nanoscale and Molecular
+ *  Communication Framework.
+ *  Verbatim copies of this source file may be used and
+ *  distributed without restriction. Modifications to this source
+ *  file as permitted in IEEE Std 1906.1 may also be made and
+ *  distributed. All other uses require permission from the IEEE
+ *  Standards Department (stds-ipr@ieee.org). All other rights
+ *  reserved.
+ *
+ *  This source file is provided on an AS IS basis.
+ *  The IEEE disclaims ANY WARRANTY EXPRESS OR IMPLIED INCLUDING
+ *  ANY WARRANTY OF MERCHANTABILITY AND FITNESS FOR USE FOR A
+ *  PARTICULAR PURPOSE.
+ *  The user of the source file shall indemnify and hold
+ *  IEEE harmless from any damages or liability arising out of
+ *  the use thereof.
+ *
+ * Author: Stephen F Bush - GE Global Research
+ *                      bushsf@research.ge.com
+ *                      http://www.amazon.com/author/stephenbush
+ */
+
+
+#ifndef P1906_MOL_MOTOR_TUBE_NETWORK
+#define P1906_MOL_MOTOR_TUBE_NETWORK
+
+#include <map>
+#include <string>
+#include <vector>
+using namespace std;
+
+#include <gsl/gsl_matrix.h>
+
+#include "ns3/ptr.h"
+#include "ns3/simple-ref-count.h"
+#include "ns3/p1906-mol-motor-segment-index.h"
+#include "ns3/p1906-mol-motor-tube-characteristics.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup IEEE P1906 framework
+ *
+ * \class P1906MOL_MOTOR_TubeNetwork
+ *
+ * \brief A read-only microtubule network, its vector field and its segment index, shared by reference
+ *
+ * The network is never modified once constructed, so any number of
+ * P1906MOL_MOTOR_MicrotubulesField, P1906MOL_MOTOR_Motion and motors may
+ * point to it; it is freed with the last of them. Sharing between fields
+ * that generate their own tubes is opt-in: fields given a non-empty
+ * environment look the network up by environment and tube properties first,
+ * so that nodes of the same cytoskeleton pay for one network. The registry
+ * holds its networks until their environment is unregistered.
+ */
+class P1906MOL_MOTOR_TubeNetwork : public SimpleRefCount<P1906MOL_MOTOR_TubeNetwork>
+{
+public:
+  //! take tubeMatrix, made of tubes of ts.segPerTube segments, and build its vector field and index
+  P1906MOL_MOTOR_TubeNetwork (gsl_matrix * tubeMatrix, const tubeCharacteristcs_t & ts);
+  ~P1906MOL_MOTOR_TubeNetwork ();
+  
+  //! the matrices must not be written; they are not const only because the motion methods take gsl_matrix *
+  gsl_matrix * getTubeMatrix () const;
+  gsl_matrix * getVectorField () const;
+  const P1906MOL_MOTOR_SegmentIndex & getTubeIndex () const;
+  const tubeCharacteristcs_t & getTubeChars () const;
+  size_t getSegPerTube () const;
+  
+  //! the network registered for environment and the properties ts; 0 if there is none or environment is empty
+  static Ptr<P1906MOL_MOTOR_TubeNetwork> Find (const string & environment, const tubeCharacteristcs_t & ts);
+  //! make network the one Find returns for environment and its properties; an empty environment shares nothing
+  static void Register (const string & environment, Ptr<P1906MOL_MOTOR_TubeNetwork> network);
+  //! drop the networks registered for environment; the fields using them keep them
+  static void Unregister (const string & environment);
+  
+  //! edge of the index cells: the contact radius used by P1906MOL_MOTOR_Motion::float2Tube and motorWalk
+  static const double contactRadius;
+  
+private:
+  typedef pair<string, vector<double> > Key;
+  //! the properties the tubes are generated from
+  static Key makeKey (const string & environment, const tubeCharacteristcs_t & ts);
+  //! the registered networks, guarded by g_tubeNetworksMutex
+  static map<Key, Ptr<P1906MOL_MOTOR_TubeNetwork> > & registry ();
+  
+  gsl_matrix * m_tubeMatrix;
+  gsl_matrix * m_vf;
+  P1906MOL_MOTOR_SegmentIndex m_index;
+  tubeCharacteristcs_t m_ts;
+};
+
+}
+
+#endif /* P1906_MOL_MOTOR_TUBE_NETWORK */
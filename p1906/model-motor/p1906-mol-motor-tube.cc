@@ -51,6 +51,7 @@
 #include "ns3/p1906-mol-motor-tube.h"
 
 #include "ns3/p1906-mol-motor-tube-characteristics.h"
+#include "ns3/p1906-mol-motor-rng-streams.h"
 
 namespace ns3 {
 
@@ -81,10 +82,11 @@ P1906MOL_MOTOR_Tube::P1906MOL_MOTOR_Tube (struct tubeCharacteristcs_t * ts, gsl_
 	  
   */
   
-  T = gsl_rng_default;
-  r = gsl_rng_alloc (T);  
-  gsl_rng_env_setup();
-  gsl_rng_set (r, rand());
+  //! each tube draws from its own stream
+  T = P1906MOL_MOTOR_RngStreams::GetType ();
+  r = P1906MOL_MOTOR_RngStreams::Create (0, 
+    P1906MOL_MOTOR_RngStreams::NextId (P1906MOL_MOTOR_RngStreams::TubeGeneration), 
+    P1906MOL_MOTOR_RngStreams::TubeGeneration);
   
   //! hold the values for a tube comprised of many segments: x_start y_start x_start x_end y_end z_end
   segMatrix = gsl_matrix_alloc (ts->segPerTube, 6);
@@ -101,6 +103,21 @@ void P1906MOL_MOTOR_Tube::getSegmatrix(gsl_matrix * sm)
 //! create and return a microtubule of given persistence length in segMatrix and its structural entropy in se
 //! \todo randomize initial tube orientations
 int P1906MOL_MOTOR_Tube::genTube(struct tubeCharacteristcs_t * ts, gsl_rng *r, gsl_matrix *segMatrix, gsl_vector *startPt)
+{
+  //! one angle per segment of this tube
+  gsl_matrix * segAngleTheta = gsl_matrix_alloc (ts->segPerTube, 1);
+  gsl_matrix * segAnglePsi = gsl_matrix_alloc (ts->segPerTube, 1);
+  
+  ts->se = genTube(*ts, r, segMatrix, startPt, segAngleTheta, segAnglePsi);
+  
+  gsl_matrix_free (segAngleTheta);
+  gsl_matrix_free (segAnglePsi);
+  return 0;
+}
+
+//! the angles of segment i are in row i of segAngleTheta and segAnglePsi; startPt and ts are only read
+double P1906MOL_MOTOR_Tube::genTube(const tubeCharacteristcs_t & ts, gsl_rng * r, gsl_matrix * segMatrix, const gsl_vector * startPt, 
+  gsl_matrix * segAngleTheta, gsl_matrix * segAnglePsi, size_t entropyBins)
 {
   /**
     for 3D there are two angles per tube: \theta and \psi in spherical coordinates, length is already specified 
@@ -110,9 +127,6 @@ int P1906MOL_MOTOR_Tube::genTube(struct tubeCharacteristcs_t * ts, gsl_rng *r, g
 	
   */
    
-  gsl_matrix * segAngleTheta = gsl_matrix_alloc (ts->numSegments, 1);
-  gsl_matrix * segAnglePsi = gsl_matrix_alloc (ts->numSegments, 1);
-
   //printf ("(genTube) startX = %g startY = %g startZ = %g numSegments = %ld segLength = %g persistenceLength = %g\n", 
   //  gsl_vector_get (startPt, 0), 
   //  gsl_vector_get (startPt, 1),  
@@ -121,10 +135,10 @@ int P1906MOL_MOTOR_Tube::genTube(struct tubeCharacteristcs_t * ts, gsl_rng *r, g
   //  ts->segLength, 
   //  ts->persistenceLength);
   
-  genPersistenceLength(r, segAngleTheta, ts->segLength, ts->persistenceLength);
-  genPersistenceLength(r, segAnglePsi, ts->segLength, ts->persistenceLength);
+  genPersistenceLength(r, segAngleTheta, ts.segLength, ts.persistenceLength);
+  genPersistenceLength(r, segAnglePsi, ts.segLength, ts.persistenceLength);
   
-  ts->se = sEntropy (segAngleTheta) + sEntropy (segAnglePsi);
+  double se = sEntropy (segAngleTheta, entropyBins) + sEntropy (segAnglePsi, entropyBins);
   
   //for (size_t i = 0; i < ts->numSegments; i++)
   //  for (size_t j = 0; j < 1; j++)
@@ -135,7 +149,7 @@ int P1906MOL_MOTOR_Tube::genTube(struct tubeCharacteristcs_t * ts, gsl_rng *r, g
 	
   //printf ("(genTube) segments allocated %ld %ld numSegments %ld\n", segMatrix->size1, segMatrix->size2, ts->numSegments);
   
-  for (size_t i = 0; i < ts->segPerTube; i++)
+  for (size_t i = 0; i < ts.segPerTube; i++)
   {
     //! set the start points of the segment
     if(i == 0)
@@ -151,15 +165,15 @@ int P1906MOL_MOTOR_Tube::genTube(struct tubeCharacteristcs_t * ts, gsl_rng *r, g
 	  gsl_matrix_set(segMatrix, i, 2, gsl_matrix_get(segMatrix, i - 1, 5));
     }
 	//! set the end points of the segment
-	double x = ts->segLength * sin(gsl_matrix_get(segAngleTheta, i, 0)) * cos(gsl_matrix_get(segAnglePsi, i, 0));
-	double y = ts->segLength * sin(gsl_matrix_get(segAngleTheta, i, 0)) * sin(gsl_matrix_get(segAnglePsi, i, 0));
-	double z = ts->segLength * cos(gsl_matrix_get(segAngleTheta, i, 0));
+	double x = ts.segLength * sin(gsl_matrix_get(segAngleTheta, i, 0)) * cos(gsl_matrix_get(segAnglePsi, i, 0));
+	double y = ts.segLength * sin(gsl_matrix_get(segAngleTheta, i, 0)) * sin(gsl_matrix_get(segAnglePsi, i, 0));
+	double z = ts.segLength * cos(gsl_matrix_get(segAngleTheta, i, 0));
 	gsl_matrix_set(segMatrix, i, 3, x + gsl_matrix_get(segMatrix, i, 0));
     gsl_matrix_set(segMatrix, i, 4, y + gsl_matrix_get(segMatrix, i, 1));
 	gsl_matrix_set(segMatrix, i, 5, z + gsl_matrix_get(segMatrix, i, 2));
   }
   
-  return 0;
+  return se;
 }
 
 //! generate angles for a structure with the given persistence length and segment length and return the angles in setAngle
@@ -210,8 +224,6 @@ double P1906MOL_MOTOR_Tube::genPersistenceLength(gsl_rng * r, gsl_matrix * segAn
 	//printf ("(genPersistenceLength) angle(%ld) = %g\n", i, angle * 180.00 / M_PI);
     gsl_matrix_set(segAngle, i, 0, angle);
   }
-    
-  sEntropy(segAngle);
   
   return 0;
 }
@@ -241,6 +253,8 @@ void P1906MOL_MOTOR_Tube::displayTube()
 P1906MOL_MOTOR_Tube::~P1906MOL_MOTOR_Tube ()
 {
   NS_LOG_FUNCTION (this);
+  gsl_rng_free (r);
+  gsl_matrix_free (segMatrix);
 }
 
 } // namespace ns3
@@ -92,12 +92,17 @@ public:
   P1906MOL_MOTOR_Tube (struct tubeCharacteristcs_t * ts, gsl_vector * startPt);
   //! return the microtubule in segMatrix of a given persistence length starting at position startPt and its structural entropy in se
   int genTube(struct tubeCharacteristcs_t * ts, gsl_rng * r, gsl_matrix * segMatrix, gsl_vector * startPt);
+  //! as above, into segMatrix of ts.segPerTube rows (may be a view into a tubeMatrix), with segAngleTheta and segAnglePsi 
+  //! of ts.segPerTube x 1 as scratch; return the structural entropy over entropyBins bins; touches nothing else, so tubes 
+  //! can be generated in parallel
+  static double genTube(const tubeCharacteristcs_t & ts, gsl_rng * r, gsl_matrix * segMatrix, const gsl_vector * startPt, 
+    gsl_matrix * segAngleTheta, gsl_matrix * segAnglePsi, size_t entropyBins = 100);
 
   /*
    * Methods related to the tube's persistence length
    */
   //! generate tube structure with a given segment and persistence length
-  double genPersistenceLength(gsl_rng * r, gsl_matrix * segAngle, double segLength, double persistenceLength); 
+  static double genPersistenceLength(gsl_rng * r, gsl_matrix * segAngle, double segLength, double persistenceLength); 
   //! compute the persistence length of a set of segments
   double getPersistenceLength();
   
@@ -0,0 +1,202 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *  Copyright � 2015 by IEEE.
+ *
+ *  This source file is an essential part of IEEE Std 1906.1,
+ *  Recommended Practice for Nanoscale and Molecular
+ *  Communication Framework.
+ *  Verbatim copies of this source file may be used and
+ *  distributed without restriction. Modifications to this source
+ *  file as permitted in IEEE Std 1906.1 may also be made and
+ *  distributed. All other uses require permission from the IEEE
+ *  Standards Department (stds-ipr@ieee.org). All other rights
+ *  reserved.
+ *
+ *  This source file is provided on an AS IS basis.
+ *  The IEEE disclaims ANY WARRANTY EXPRESS OR IMPLIED INCLUDING
+ *  ANY WARRANTY OF MERCHANTABILITY AND FITNESS FOR USE FOR A
+ *  PARTICULAR PURPOSE.
+ *  The user of the source file shall indemnify and hold
+ *  IEEE harmless from any damages or liability arising out of
+ *  the use thereof.
+ *
+ * Author: Stephen F Bush - GE Global Research
+ *                      bushsf@research.ge.com
+ *                      http://www.amazon.com/author/stephenbush
+ */
+
+#ifndef P1906_MOL_MOTOR_VEC3
+#define P1906_MOL_MOTOR_VEC3
+
+#include <cmath>
+
+namespace ns3 {
+
+/**
+ * \ingroup IEEE P1906 framework
+ *
+ * \brief Plain 3D point or vector used by the motor, field and volume surface math
+ *
+ * Unlike P1906MOL_MOTOR_Pos, which is an ns-3 Object with trace sources and a
+ * heap allocated gsl_vector, this is a POD that can be copied, stored in
+ * contiguous arrays and passed by value at no cost. P1906MOL_MOTOR_Pos
+ * remains the traceable façade of the public API.
+ */
+struct P1906MOL_MOTOR_Vec3
+{
+  double x;
+  double y;
+  double z;
+};
+
+//! build a P1906MOL_MOTOR_Vec3 from its coordinates
+inline P1906MOL_MOTOR_Vec3 vec3 (double x, double y, double z)
+{
+  P1906MOL_MOTOR_Vec3 v = { x, y, z };
+  return v;
+}
+
+inline P1906MOL_MOTOR_Vec3 operator+ (const P1906MOL_MOTOR_Vec3 &a, const P1906MOL_MOTOR_Vec3 &b)
+{
+  return vec3 (a.x + b.x, a.y + b.y, a.z + b.z);
+}
+
+inline P1906MOL_MOTOR_Vec3 operator- (const P1906MOL_MOTOR_Vec3 &a, const P1906MOL_MOTOR_Vec3 &b)
+{
+  return vec3 (a.x - b.x, a.y - b.y, a.z - b.z);
+}
+
+inline P1906MOL_MOTOR_Vec3 operator* (const P1906MOL_MOTOR_Vec3 &a, double s)
+{
+  return vec3 (a.x * s, a.y * s, a.z * s);
+}
+
+//! dot product
+inline double vec3Dot (const P1906MOL_MOTOR_Vec3 &a, const P1906MOL_MOTOR_Vec3 &b)
+{
+  return a.x * b.x + a.y * b.y + a.z * b.z;
+}
+
+//! cross product
+inline P1906MOL_MOTOR_Vec3 vec3Cross (const P1906MOL_MOTOR_Vec3 &a, const P1906MOL_MOTOR_Vec3 &b)
+{
+  return vec3 (a.y * b.z - a.z * b.y,
+               a.z * b.x - a.x * b.z,
+               a.x * b.y - a.y * b.x);
+}
+
+//! Euclidean norm
+inline double vec3Norm (const P1906MOL_MOTOR_Vec3 &a)
+{
+  return std::sqrt (vec3Dot (a, a));
+}
+
+//! sum of the absolute values of the components (gsl_blas_dasum)
+inline double vec3Asum (const P1906MOL_MOTOR_Vec3 &a)
+{
+  return std::fabs (a.x) + std::fabs (a.y) + std::fabs (a.z);
+}
+
+//! 1 / |d|^2, or 0 for a zero length (or too short to invert) d
+inline double vec3InvLength2 (const P1906MOL_MOTOR_Vec3 &d)
+{
+  double inv = 1 / vec3Dot (d, d);
+
+  return std::isfinite (inv) ? inv : 0;
+}
+
+//! squared Euclidean distance from pt to the closest point of the segment (p1, p2), the projection being clamped to the end points;
+//! P1906MOL_MOTOR_SegmentArrays::distance2 performs the same operations on many segments at once
+inline double vec3SegmentDistance2 (const P1906MOL_MOTOR_Vec3 &pt, const P1906MOL_MOTOR_Vec3 &p1, const P1906MOL_MOTOR_Vec3 &p2)
+{
+  P1906MOL_MOTOR_Vec3 d = p2 - p1;
+  P1906MOL_MOTOR_Vec3 w = pt - p1;
+  double t = vec3Dot (w, d) * vec3InvLength2 (d);
+
+  t = t < 0 ? 0 : (t > 1 ? 1 : t);
+  P1906MOL_MOTOR_Vec3 r = w - d * t;
+  return vec3Dot (r, r);
+}
+
+//! the point of the segment (p1, p2) closest to pt
+inline P1906MOL_MOTOR_Vec3 vec3SegmentClosestPoint (const P1906MOL_MOTOR_Vec3 &pt, const P1906MOL_MOTOR_Vec3 &p1, const P1906MOL_MOTOR_Vec3 &p2)
+{
+  P1906MOL_MOTOR_Vec3 d = p2 - p1;
+  double t = vec3Dot (pt - p1, d) * vec3InvLength2 (d);
+
+  t = t < 0 ? 0 : (t > 1 ? 1 : t);
+  return p1 + d * t;
+}
+
+//! Euclidean distance from pt to the closest point of the segment (p1, p2), the projection being clamped to the end points
+inline double vec3SegmentDistance (const P1906MOL_MOTOR_Vec3 &pt, const P1906MOL_MOTOR_Vec3 &p1, const P1906MOL_MOTOR_Vec3 &p2)
+{
+  return std::sqrt (vec3SegmentDistance2 (pt, p1, p2));
+}
+
+//! closest approach of the segments (p1, q1) and (p2, q2): returns the distance and the closest points c1 and c2
+//! (closed form with the parameters clamped to [0, 1], see Ericson, Real-Time Collision Detection, 5.1.9)
+inline double vec3SegmentSegmentClosest (const P1906MOL_MOTOR_Vec3 &p1, const P1906MOL_MOTOR_Vec3 &q1,
+                                         const P1906MOL_MOTOR_Vec3 &p2, const P1906MOL_MOTOR_Vec3 &q2,
+                                         P1906MOL_MOTOR_Vec3 &c1, P1906MOL_MOTOR_Vec3 &c2)
+{
+  P1906MOL_MOTOR_Vec3 d1 = q1 - p1;
+  P1906MOL_MOTOR_Vec3 d2 = q2 - p2;
+  P1906MOL_MOTOR_Vec3 r = p1 - p2;
+  double a = vec3Dot (d1, d1);
+  double e = vec3Dot (d2, d2);
+  double f = vec3Dot (d2, r);
+  double s = 0;
+  double t = 0;
+
+  if (a <= 0 && e <= 0)
+    {
+      //! both segments are points
+    }
+  else if (a <= 0)
+    {
+      t = f / e;
+      t = t < 0 ? 0 : (t > 1 ? 1 : t);
+    }
+  else
+    {
+      double c = vec3Dot (d1, r);
+      if (e <= 0)
+        {
+          s = -c / a;
+          s = s < 0 ? 0 : (s > 1 ? 1 : s);
+        }
+      else
+        {
+          double b = vec3Dot (d1, d2);
+          double denom = a * e - b * b;
+          //! parallel segments have no unique closest pair: start from s = 0
+          if (denom > 0)
+            {
+              s = (b * f - c * e) / denom;
+              s = s < 0 ? 0 : (s > 1 ? 1 : s);
+            }
+          t = (b * s + f) / e;
+          if (t < 0)
+            {
+              t = 0;
+              s = -c / a;
+              s = s < 0 ? 0 : (s > 1 ? 1 : s);
+            }
+          else if (t > 1)
+            {
+              t = 1;
+              s = (b - c) / a;
+              s = s < 0 ? 0 : (s > 1 ? 1 : s);
+            }
+        }
+    }
+
+  c1 = p1 + d1 * s;
+  c2 = p2 + d2 * t;
+  return vec3Norm (c1 - c2);
+}
+
+}
+
+#endif /* P1906_MOL_MOTOR_VEC3 */
@@ -54,6 +54,8 @@
 #include "ns3/p1906-mol-motor-field.h"
 #include "ns3/p1906-mol-motor-tube.h"
 #include "ns3/p1906-mol-motor-pos.h"
+#include "ns3/p1906-mol-motor-segment-arrays.h"
+#include "ns3/p1906-mol-motor-rng-streams.h"
 
 namespace ns3 {
 
@@ -92,9 +94,33 @@ P1906MOL_MOTOR_VolSurface::P1906MOL_MOTOR_VolSurface ()
 	  
   */
   
-  T = gsl_rng_default;
-  r = gsl_rng_alloc (T);  
-  gsl_rng_env_setup();  
+  T = P1906MOL_MOTOR_RngStreams::GetType ();
+  r = P1906MOL_MOTOR_RngStreams::Create (0, 
+    P1906MOL_MOTOR_RngStreams::NextId (P1906MOL_MOTOR_RngStreams::VolumeSurface), 
+    P1906MOL_MOTOR_RngStreams::VolumeSurface);
+}
+
+P1906MOL_MOTOR_VolSurface::P1906MOL_MOTOR_VolSurface (const P1906MOL_MOTOR_VolSurface & o)
+  : P1906MOL_MOTOR_Field (o),
+    T (o.T),
+    r (gsl_rng_clone (o.r)),
+    center (o.center),
+    radius (o.radius),
+    volType (o.volType)
+{
+}
+
+P1906MOL_MOTOR_VolSurface & P1906MOL_MOTOR_VolSurface::operator= (const P1906MOL_MOTOR_VolSurface & o)
+{
+  if (this != &o)
+  {
+    P1906MOL_MOTOR_Field::operator= (o);
+    gsl_rng_memcpy (r, o.r);
+    center = o.center;
+    radius = o.radius;
+    volType = o.volType;
+  }
+  return *this;
 }
 
 std::ostream& operator<<(std::ostream& out, const P1906MOL_MOTOR_VolSurface& vs)
@@ -132,6 +158,23 @@ P1906MOL_MOTOR_VolSurface::typeOfVolume P1906MOL_MOTOR_VolSurface::getType ()
   return volType;
 }
 
+P1906MOL_MOTOR_Sphere P1906MOL_MOTOR_VolSurface::getSphere ()
+{
+  P1906MOL_MOTOR_Sphere sphere;
+  
+  sphere.center = center.getVec3 ();
+  sphere.radius = radius;
+  sphere.type = volType;
+  return sphere;
+}
+
+void P1906MOL_MOTOR_VolSurface::getSpheres (vector<P1906MOL_MOTOR_VolSurface> & vsl, vector<P1906MOL_MOTOR_Sphere> & spheres)
+{
+  spheres.clear ();
+  for (size_t i = 0; i < vsl.size(); i++)
+    spheres.push_back (vsl.at(i).getSphere ());
+}
+
 //! reflect a particle from the surface given the last and current positions
 //! if outside the volume, adjust the current position given a reflection back into the volume
 /* <pre>
@@ -152,102 +195,60 @@ P1906MOL_MOTOR_VolSurface::typeOfVolume P1906MOL_MOTOR_VolSurface::getType ()
 */
 void P1906MOL_MOTOR_VolSurface::reflect(P1906MOL_MOTOR_Pos last_pos, P1906MOL_MOTOR_Pos & current_pos)
 {
-  vector<P1906MOL_MOTOR_Pos> intersection;
-  gsl_vector * trajectory = gsl_vector_alloc (6);
-  gsl_vector * ext_traj = gsl_vector_alloc (6);
-  gsl_vector * int_traj = gsl_vector_alloc (6);
-  gsl_vector * vol_radius = gsl_vector_alloc (6);
-  gsl_vector * rad_vec = gsl_vector_alloc (3);
-  gsl_vector * lp = gsl_vector_alloc (3);
-  gsl_vector * ip = gsl_vector_alloc (3);
-  gsl_matrix * vectors = gsl_matrix_alloc (2, 6);
-
-  //printf ("(reflect) Begin\n");
-  NS_LOG_DEBUG ("last_pos: " << last_pos << " current_pos: " << current_pos);
+  P1906MOL_MOTOR_Vec3 cp = current_pos.getVec3 ();
+  
+  reflect (last_pos.getVec3 (), cp);
+  current_pos.setPos (cp);
+}
+
+//! reflect a particle from the surface given the last and current positions
+//! if outside the volume, adjust the current position given a reflection back into the volume
+void P1906MOL_MOTOR_VolSurface::reflect(const P1906MOL_MOTOR_Vec3 & last_pos, P1906MOL_MOTOR_Vec3 & current_pos)
+{
+  if (!getSphere ().reflect (last_pos, current_pos))
+  {
+      printf ("(reflect) motor did not pass through surface\n");
+	  NS_LOG_DEBUG ("motor did not pass through surface");
+	  return;
+  }
   
+  NS_LOG_DEBUG ("reflected current_pos: " << current_pos.x << " " << current_pos.y << " " << current_pos.z);
+}
+
+//! the reflection itself, without the console output and logging of P1906MOL_MOTOR_VolSurface::reflect
+bool P1906MOL_MOTOR_Sphere::reflect (const P1906MOL_MOTOR_Vec3 & last_pos, P1906MOL_MOTOR_Vec3 & current_pos) const
+{
+  vector<P1906MOL_MOTOR_Vec3> intersection;
+
   //! x_1' - x_0 = v - 2 (v . n) n
   //! This works, but it reflects off the radius instead of the sphere.
   //! Need to reflect off line tangent to the sphere at the intersection point.
   //! So just reverse the vector direction, multiply by -1
   //! x_1' = - (v - 2 (v . n) n) + x_0
-  
-  //printf ("(reflect) current_pos before reflection\n");
-  //current_pos.displayPos();
 
   //! x_1' - x_0 = v  - 2 (v . n)    n where n is the unit vector for the radius
   //!              ^vec      ^scalar ^vec
   //! x_1 is M and last_pos, x_1' is M', n is rad_vec, x_0 is the intersection point
     
-  //! check if the particle passed through the surface  
-  line (trajectory, last_pos, current_pos);
-
   //! did the particle's trajectory pass through the surface?
-  sphereIntersections(trajectory, intersection);
-  //printf ("(reflect) intersection size: %ld\n", intersection.size());
+  intersections(last_pos, current_pos, intersection);
   if (intersection.size() == 0)
-  {
-      printf ("(reflect) motor did not pass through surface\n");
-	  NS_LOG_DEBUG ("motor did not pass through surface");
-  }
-  
-  //! segment CR is the radius of the volume
-  getRadiusLine(vol_radius, intersection.front());
-  //! convert radius segment into vector n
-  gsl_vector_set (rad_vec, 0, gsl_vector_get (vol_radius, 3) - gsl_vector_get (vol_radius, 0));
-  gsl_vector_set (rad_vec, 1, gsl_vector_get (vol_radius, 4) - gsl_vector_get (vol_radius, 1));
-  gsl_vector_set (rad_vec, 2, gsl_vector_get (vol_radius, 5) - gsl_vector_get (vol_radius, 2));
+    return false;
   
-  //! n is rad_vec, convert to a unit vector
-  double s_norm = gsl_blas_dnrm2 (rad_vec);
-  gsl_vector_scale (rad_vec, 1.0 / s_norm);
+  P1906MOL_MOTOR_Vec3 ip = intersection.front();
   
-  //! segment RM'' is the trajectory outside the volume
-  line (ext_traj, intersection.front(), current_pos);
-  //! segment MR is the trajectory inside the volume
-  line (int_traj, last_pos, intersection.front());
-
-  //! save for display and debugging
-  insertVector(vectors, 0, ext_traj);
-  insertVector(vectors, 1, vol_radius);
+  //! segment CR is the radius of the volume, n is its unit vector
+  P1906MOL_MOTOR_Vec3 rad_vec = ip - center;
+  rad_vec = rad_vec * (1.0 / vec3Norm (rad_vec));
   
-  last_pos.getPos (lp);
-  intersection.front().getPos (ip);
-  //! lp is now (x_1 - x_0) == v
-  gsl_vector_sub (lp, ip);
-  //printf ("(reflect) lp: %lf %lf %lf\n",
-  //  gsl_vector_get (lp, 0),
-  //  gsl_vector_get (lp, 1),
-  //  gsl_vector_get (lp, 2)
-  //);
-  double dot;
+  //! lp is (x_1 - x_0) == v
+  P1906MOL_MOTOR_Vec3 lp = last_pos - ip;
   //! (x_1 - x_0) . n = v . n
-  gsl_blas_ddot (lp, rad_vec, &dot);
-  //printf ("(reflect) dot: %lf\n", dot);
-  //! 2 n [(x_1 - x_0) . n]
-  gsl_vector_scale (rad_vec, 2.0 * dot);
-  //printf ("(reflect) rad_vec: %lf %lf %lf\n",
-  //  gsl_vector_get (rad_vec, 0),
-  //  gsl_vector_get (rad_vec, 1),
-  //  gsl_vector_get (rad_vec, 2)
-  //); 
+  double dot = vec3Dot (lp, rad_vec);
     
-  //! v - 2 (v . n) n
-  gsl_vector_sub (lp, rad_vec);
-  
-  //! reverse the direction of the vector
-  gsl_vector_scale (lp, -1.0);
-  
-  //! x_1' = v - 2 (v . n) n + x_0
-  gsl_vector_add (lp, ip);
-  
-  //! update the current position with the reflected position
-  current_pos.setPos (lp);
-  //printf ("(reflect) current_pos after reflection\n");
-  //current_pos.displayPos();
-  
-  NS_LOG_DEBUG ("reflected current_pos: " << current_pos);
-  
-  //printf ("(reflect) End\n");
+  //! x_1' = - (v - 2 (v . n) n) + x_0
+  current_pos = (lp - rad_vec * (2.0 * dot)) * -1.0 + ip;
+  return true;
 }
 
 //! return radius line segment from center to a point on the surface
@@ -317,24 +318,42 @@ double P1906MOL_MOTOR_VolSurface::fluxMeter(gsl_matrix * tubeMatrix)
 {
   //! the total flux
   double flux = 0;
-  //! all intersection points
-  vector<P1906MOL_MOTOR_Pos> ipts;
-  //! the current segment
-  gsl_vector * segment = gsl_vector_alloc (6);
-  
-  for (size_t s = 0; s < tubeMatrix->size1; s++)
+  //! number of points where the tubes cross the surface
+  size_t crossings = 0;
+  //! the end points of the current segment
+  P1906MOL_MOTOR_Vec3 p1, p2;
+  P1906MOL_MOTOR_Vec3 c = center.getVec3 ();
+  double r2 = radius * radius;
+  //! the tubes in structure of arrays layout and a block of squared distances from the center
+  P1906MOL_MOTOR_SegmentArrays segments;
+  double d2[256];
+  
+  segments.assign (tubeMatrix);
+  for (size_t b = 0; b < segments.size (); b += 256)
   {
-    //! get the segment
-    line (segment, tubeMatrix, s);
-	//! find the intersecting points with surface volume
-    sphereIntersections(segment, ipts);
+    size_t e = min (b + 256, segments.size ());
+    segments.distance2 (c, b, e, d2);
+    for (size_t s = b; s < e; s++)
+    {
+      //! the segment does not reach the sphere
+      if (d2[s - b] > r2)
+        continue;
+      //! otherwise it crosses the surface once per end point outside, or touches it
+      line (tubeMatrix, s, p1, p2);
+      bool out1 = vec3Dot (p1 - c, p1 - c) > r2;
+      bool out2 = vec3Dot (p2 - c, p2 - c) > r2;
+      if (out1 != out2)
+        crossings += 1;
+      else if (out1 && out2)
+        crossings += (d2[s - b] == r2) ? 1 : 2;
+    }
 	//! would like to know whether segment is pointing in or out of the tube
-	//printf ("(fluxMeter) %ld points\n", ipts.size());
+	//printf ("(fluxMeter) %ld points\n", crossings);
   }
     
   //! use the total number of intersecting tubes for now
   //! \todo incorporate direction and motor rate along tube
-  flux += ipts.size();
+  flux += crossings;
   
   return flux;
 }
@@ -342,23 +361,20 @@ double P1906MOL_MOTOR_VolSurface::fluxMeter(gsl_matrix * tubeMatrix)
 //! return true if the point is inside the volume surface
 bool P1906MOL_MOTOR_VolSurface::isInsideVolSurf(P1906MOL_MOTOR_Pos pt)
 {
-  bool isInside = false;
-  double norm = 0;
-  gsl_vector * C = gsl_vector_alloc (3);
-  gsl_vector * P = gsl_vector_alloc (3);
-  
+  return isInsideVolSurf (pt.getVec3 ());
+}
+
+//! return true if the point is inside the volume surface
+bool P1906MOL_MOTOR_VolSurface::isInsideVolSurf(const P1906MOL_MOTOR_Vec3 & pt)
+{
+  return getSphere ().isInside (pt);
+}
+
+//! return true if the point is inside the sphere
+bool P1906MOL_MOTOR_Sphere::isInside (const P1906MOL_MOTOR_Vec3 & pt) const
+{
   //! simply check if distance from center is less than radius
-  center.getPos (C);
-  pt.getPos (P);
-  //! vector from point to center
-  gsl_vector_sub (C, P);
-  //! magnitude of the vector from point to center
-  norm = gsl_blas_dnrm2 (C);
-  
-  if (norm < radius)
-    isInside = true;
-  
-  return isInside;
+  return vec3Norm (center - pt) < radius;
 }
 
 //! find the intersecting point(s) ipt that intersect the volume surface:
@@ -367,9 +383,31 @@ bool P1906MOL_MOTOR_VolSurface::isInsideVolSurf(P1906MOL_MOTOR_Pos pt)
 //! (3)if two intersections, then ipt has two intersection points
 void P1906MOL_MOTOR_VolSurface::sphereIntersections(gsl_vector * segment, vector<P1906MOL_MOTOR_Pos> & ipt)
 {
-  P1906MOL_MOTOR_Pos o, l, c;
-  double d, r;
-  gsl_vector * lv = gsl_vector_alloc (3);
+  vector<P1906MOL_MOTOR_Vec3> v;
+  
+  sphereIntersections(
+    vec3 (gsl_vector_get (segment, 0), gsl_vector_get (segment, 1), gsl_vector_get (segment, 2)),
+    vec3 (gsl_vector_get (segment, 3), gsl_vector_get (segment, 4), gsl_vector_get (segment, 5)),
+    v);
+  
+  for (size_t i = 0; i < v.size(); i++)
+  {
+    P1906MOL_MOTOR_Pos Pos;
+    Pos.setPos (v.at(i));
+    ipt.insert(ipt.end(), Pos);
+  }
+}
+
+//! append the point(s) where the segment from p1 to p2 intersects the volume surface to ipt
+void P1906MOL_MOTOR_VolSurface::sphereIntersections(const P1906MOL_MOTOR_Vec3 & p1, const P1906MOL_MOTOR_Vec3 & p2, vector<P1906MOL_MOTOR_Vec3> & ipt)
+{
+  getSphere ().intersections (p1, p2, ipt);
+}
+
+//! append the point(s) where the segment from p1 to p2 intersects the sphere to ipt
+void P1906MOL_MOTOR_Sphere::intersections (const P1906MOL_MOTOR_Vec3 & p1, const P1906MOL_MOTOR_Vec3 & p2, vector<P1906MOL_MOTOR_Vec3> & ipt) const
+{
+  double d;
   
   //! find all the tube segments intersecting with the surface: equation for surface as function of x, y, z == equation for segment
   //! sphere = x^2 + y^2 + z^2 = r^2
@@ -378,67 +416,26 @@ void P1906MOL_MOTOR_VolSurface::sphereIntersections(gsl_vector * segment, vector
   //! 
   //! find the direction of flow of each tube: tubes always flow from lower index to higher index in tubeMatrix
   //! flux
-  
-  //printf ("(sphereIntersections) Begin\n");
 	
   //! sphere equation: |x - c|^2 = r^2 where c (3D) is the center, r (scalar) is the radius, 
   //! and x (3D) is points on the sphere  
-  c = center;
-  r = radius;
 
   //! line equation: x = o + d l where o (3D) is the starting point, d (scalar) is distance, 
   //! l (3D) is direction (unit vector), and x (3D) is points on the line
-  o.setPos (
-	gsl_vector_get (segment, 0),
-	gsl_vector_get (segment, 1),
-	gsl_vector_get (segment, 2)
-  );
+  P1906MOL_MOTOR_Vec3 o = p1;
   
-  //printf ("(sphereIntersections) segment start:\n");
-  //o.displayPos ();
-	
-  //! convert segment into a vector
-  l.setPos (
-	gsl_vector_get (segment, 3) - gsl_vector_get (segment, 0),
-	gsl_vector_get (segment, 4) - gsl_vector_get (segment, 1),
-	gsl_vector_get (segment, 5) - gsl_vector_get (segment, 2)
-  );
-  //printf ("(sphereIntersections) segment vector:\n");
-  //l.displayPos ();
-  
-  //! convert the segment vector into a unit vector; divide by length
-  l.getPos (lv);
-  double segMag = gsl_blas_dnrm2 (lv);
-  gsl_vector_scale (lv, 1.0 / segMag);
-  l.setPos (lv);
-  //printf ("(sphereIntersections) segment unit vector:\n");
-  //l.displayPos ();
+  //! convert the segment into a unit vector; divide by length
+  P1906MOL_MOTOR_Vec3 l = p2 - p1;
+  double segMag = vec3Norm (l);
+  l = l * (1.0 / segMag);
   
   //! d = -l * (o - c) +/- sqrt((l * (o - c))^2 - |o - c|^2 + r^2)
   //! B = l * (o - c), 4AC = |o - c|^2 + r^2, -B +/- sqrt(B^2 - 4AC)/2A
-  double B;
-  double AC;
-  gsl_vector * O = gsl_vector_alloc (3);
-  gsl_vector * C = gsl_vector_alloc (3);
-  
-  o.getPos (O);
-  center.getPos (C);
-  //printf ("(sphereIntersections) C and O:\n");
-  //center.displayPos ();
-  //o.displayPos ();
-  
+  P1906MOL_MOTOR_Vec3 O = o - center;
   //! B = l . (o - c)
-  gsl_vector_sub (O, C);
-  //printf ("(sphereIntersections) 0 - C: %lf %lf %lf\n", gsl_vector_get (O, 0), gsl_vector_get (O, 1), gsl_vector_get (O, 2));
-  gsl_blas_ddot (lv, O, &B);
-  //printf ("(sphereIntersections) lv: %lf %lf %lf\n", gsl_vector_get (lv, 0), gsl_vector_get (lv, 1), gsl_vector_get (lv, 2));
-  //printf ("(sphereIntersections) B = l . (o - c): %lf\n", B);
-  
+  double B = vec3Dot (l, O);
   //! AC = |o - c|^2 + r^2
-  double norm = gsl_blas_dnrm2 (O);
-  //printf ("(sphereIntersections) |o - c|^2: %lf\n", norm);
-  AC = norm + pow(r, 2);
-  //printf ("(sphereIntersections) AC = |o - c|^2 + r^2: %lf\n", AC);
+  double AC = vec3Norm (O) + pow(radius, 2);
   
   //! it looks like a pow(B, 2) term should be added to AC
   
@@ -453,71 +450,37 @@ void P1906MOL_MOTOR_VolSurface::sphereIntersections(gsl_vector * segment, vector
   {
     //! only do this if d is <= length of tube
 	d = -B;
-	if (abs(d) <= segMag)
+	if (fabs(d) <= segMag)
 	{
-		//printf ("(sphereIntersections) AC == 0 d: %lf segMag: %lf\n", d, segMag);
-		//printf ("(sphereIntersections) l:\n");
-		//l.displayPos();
-		//printf ("(sphereIntersections) o:\n");
-		//o.displayPos ();
 		//! x = o + d l
-		o.shiftPos (l, d);
-		//printf ("(sphereIntersections) o shifted:\n");
-		//o.displayPos ();
-		ipt.insert(ipt.end(), o);
+		ipt.insert(ipt.end(), o + l * d);
     }
   }
   
   //! if B^2 - 4AC > 0, then two intersections
   if (AC > 0)
   {
-    P1906MOL_MOTOR_Pos tmp;
-	gsl_vector * v_tmp = gsl_vector_alloc (3);
-	
-	//printf ("(sphereIntersections) AC: %lf\n", AC);
-	
-	//! set the tmp position with the same value as o
-	o.getPos (v_tmp);
-	tmp.setPos (v_tmp);
-	
 	//! only do this if d is <= length of tube
 	d = -B + sqrt(AC);
-    if (abs(d) <= segMag)
+    if (fabs(d) <= segMag)
 	{	
-		//printf ("(sphereIntersections) AC > 0 and d = -B + sqrt(AC) d: %lf segMag: %lf\n", d, segMag);
-		//printf ("(sphereIntersections) l:\n");
-		//l.displayPos();
-		//printf ("(sphereIntersections) o:\n");
-		//o.displayPos ();
 		//! x = o + d l
-		o.shiftPos (l, d);
-		//printf ("(sphereIntersections) o shifted:\n");
-		//o.displayPos ();
-		ipt.insert(ipt.end(), o);
+		ipt.insert(ipt.end(), o + l * d);
     }	
 	//! only do this if d is <= length of tube
 	d = -B - sqrt(AC);
-	if (abs(d) <= segMag)
+	if (fabs(d) <= segMag)
 	{
-		//printf ("(sphereIntersections) AC > 0 and d = -B - sqrt(AC) d: %lf segMag: %lf\n", d, segMag);
-		//printf ("(sphereIntersections) l:\n");
-		//l.displayPos();
-		//printf ("(sphereIntersections) tmp:\n");
-		//tmp.displayPos ();
 		//! x = o + d l
-		tmp.shiftPos (l, d);
-		//printf ("(sphereIntersections) tmp shifted:\n");
-		//tmp.displayPos ();
-		ipt.insert(ipt.end(), tmp);
+		ipt.insert(ipt.end(), o + l * d);
 	}
   }
-  	
-  //printf ("(sphereIntersections) End\n");
 }
 
 P1906MOL_MOTOR_VolSurface::~P1906MOL_MOTOR_VolSurface ()
 {
   NS_LOG_FUNCTION (this);
+  gsl_rng_free (r);
 }
 
 } // namespace ns3
@@ -49,6 +49,8 @@ using namespace std;
 
 namespace ns3 {
 
+struct P1906MOL_MOTOR_Sphere;
+
 /**
  * \ingroup IEEE P1906 framework
  *
@@ -94,12 +96,19 @@ public:
    */  
   //! the constructor to build a sphere surface
   P1906MOL_MOTOR_VolSurface ();
+  //! copies own a copy of the random number generator
+  P1906MOL_MOTOR_VolSurface (const P1906MOL_MOTOR_VolSurface & o);
+  P1906MOL_MOTOR_VolSurface & operator= (const P1906MOL_MOTOR_VolSurface & o);
   //! set enum FluxMeter, ReflectiveBarrier, Receiver
   void setType (typeOfVolume st);
   //! return enum FluxMeter, ReflectiveBarrier, Receiver
   typeOfVolume getType ();
   //! set the location and size of the volume sphere
   void setVolume(P1906MOL_MOTOR_Pos v_center, double v_radius);
+  //! the sphere and type as a plain value
+  P1906MOL_MOTOR_Sphere getSphere ();
+  //! the spheres of all the surfaces of vsl, in order
+  static void getSpheres (vector<P1906MOL_MOTOR_VolSurface> & vsl, vector<P1906MOL_MOTOR_Sphere> & spheres);
   
   /*
    * Methods related to accessing and displaying a volume surface
@@ -112,6 +121,8 @@ public:
    */
   //! return true if the point is inside the volume surface
   bool isInsideVolSurf(P1906MOL_MOTOR_Pos pt);
+  //! return true if the point is inside the volume surface
+  bool isInsideVolSurf(const P1906MOL_MOTOR_Vec3 & pt);
   //! return the angle between two vectors
   double vectorAngle(gsl_vector * seg1, gsl_vector * seg2);
   //! return radius line segment from center to a point on the surface
@@ -124,11 +135,15 @@ public:
   //! reflect a particle from the surface given the last and current positions
   //! adjust the current position given a reflection
   void reflect(P1906MOL_MOTOR_Pos last_pos, P1906MOL_MOTOR_Pos & current_pos);
+  //! reflect a particle from the surface given the last and current positions
+  void reflect(const P1906MOL_MOTOR_Vec3 & last_pos, P1906MOL_MOTOR_Vec3 & current_pos);
   //! find the intersecting point(s) ipt that intersect the sphere:
   //! (1) if no intersection, then ipt has zero values
   //! (2) if one intersection, then ipt has one intersection point
   //! (3) if two intersections, then ipt has two intersection points
   void sphereIntersections(gsl_vector * segment, vector<P1906MOL_MOTOR_Pos> & ipt);
+  //! append the point(s) where the segment (p1, p2) intersects the sphere to ipt
+  void sphereIntersections(const P1906MOL_MOTOR_Vec3 & p1, const P1906MOL_MOTOR_Vec3 & p2, vector<P1906MOL_MOTOR_Vec3> & ipt);
   
   /*
    * Methods related to flow through the volume surface
@@ -142,6 +157,28 @@ public:
 
 std::ostream& operator<<(std::ostream& out, const P1906MOL_MOTOR_VolSurface& vs);
 
+/**
+ * \ingroup IEEE P1906 framework
+ *
+ * \brief The geometry of a volume surface as a plain value
+ *
+ * It holds no Object, generator or log component, so it can be copied freely and used on worker threads.
+ * P1906MOL_MOTOR_VolSurface intersects and reflects through it, so both give the same results.
+ */
+struct P1906MOL_MOTOR_Sphere
+{
+  P1906MOL_MOTOR_Vec3 center;
+  double radius;
+  P1906MOL_MOTOR_VolSurface::typeOfVolume type;
+  
+  //! return true if the point is inside the sphere
+  bool isInside (const P1906MOL_MOTOR_Vec3 & pt) const;
+  //! append the point(s) where the segment (p1, p2) intersects the sphere to ipt
+  void intersections (const P1906MOL_MOTOR_Vec3 & p1, const P1906MOL_MOTOR_Vec3 & p2, vector<P1906MOL_MOTOR_Vec3> & ipt) const;
+  //! reflect current_pos from the sphere given the last position; false, leaving current_pos alone, if the step did not cross it
+  bool reflect (const P1906MOL_MOTOR_Vec3 & last_pos, P1906MOL_MOTOR_Vec3 & current_pos) const;
+};
+
 }
 
 #endif /*  P1906_MOL_MOTOR_VOLSURFACE */
\ No newline at end of file
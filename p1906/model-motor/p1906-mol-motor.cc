@@ -43,6 +43,7 @@
  */
 
 #include "ns3/log.h"
+#include "ns3/simulator.h"
 
 #include "ns3/p1906-mol-motor.h"
 
@@ -97,12 +98,14 @@ P1906MOL_Motor::P1906MOL_Motor ()
   current_location = gsl_vector_alloc (3);
     
   //! start with an empty record of for tracking position
-  pos_history.clear();
+  trajectory = Create<P1906MOL_MOTOR_TrajectoryAll> ();
   
   //! random number generation structures and initialization
-  T = gsl_rng_default;
-  r = gsl_rng_alloc (T);
-  gsl_rng_env_setup();
+  //! every motor gets its own stream, keyed by the node whose event created it
+  T = P1906MOL_MOTOR_RngStreams::GetType ();
+  r = P1906MOL_MOTOR_RngStreams::Create (Simulator::GetContext (), 
+    P1906MOL_MOTOR_RngStreams::NextId (P1906MOL_MOTOR_RngStreams::MotorMotion), 
+    P1906MOL_MOTOR_RngStreams::MotorMotion);
   
 }
 
@@ -136,6 +139,17 @@ void P1906MOL_Motor::setStartingPoint(gsl_vector * pt)
   start_z = gsl_vector_get (pt, 2);
 }
 
+void P1906MOL_Motor::recordPosition(const P1906MOL_MOTOR_Vec3 & pt)
+{
+  trajectory->record (pt, t.time);
+}
+
+void P1906MOL_Motor::setTrajectory(Ptr<P1906MOL_MOTOR_TrajectorySink> sink)
+{
+  NS_LOG_FUNCTION (this);
+  trajectory = sink;
+}
+
 //! display all the volume surfaces recognizing the motor
 void P1906MOL_Motor::displayVolSurfaces()
 {
@@ -147,8 +161,7 @@ void P1906MOL_Motor::displayVolSurfaces()
 bool P1906MOL_Motor::inDestination()
 {
   bool inDest = false;
-  P1906MOL_MOTOR_Pos cl;
-  cl.setPos (current_location);
+  P1906MOL_MOTOR_Vec3 cl = getLocation ();
   size_t numDest = 0;
   
   //! find the Receiver space(s)
@@ -190,6 +203,20 @@ void P1906MOL_Motor::setLocation(double x, double y, double z)
   gsl_vector_set (current_location, 2, z);
 }
 
+//! set the current location to the 3D point pt
+void P1906MOL_Motor::setLocation(const P1906MOL_MOTOR_Vec3 & pt)
+{
+  setLocation (pt.x, pt.y, pt.z);
+}
+
+//! return the current location as a 3D point
+P1906MOL_MOTOR_Vec3 P1906MOL_Motor::getLocation()
+{
+  return vec3 (gsl_vector_get (current_location, 0),
+               gsl_vector_get (current_location, 1),
+               gsl_vector_get (current_location, 2));
+}
+
 //! print the current motor location
 void P1906MOL_Motor::displayLocation()
 {
@@ -224,9 +251,31 @@ double P1906MOL_Motor::propagationDelay()
   return getTime();
 }
 
+//! recycle the motor: clear the history, volume surfaces and time, keeping the GSL allocations
+//! the random number generator moves to a fresh stream, so a recycled motor behaves as a newly created one
+void P1906MOL_Motor::Reset (void)
+{
+  NS_LOG_FUNCTION (this);
+  P1906MOLMessageCarrier::Reset ();
+  gsl_vector_set_zero (current_location);
+  start_x = start_y = start_z = 0;
+  trajectory->clear();
+  vsl.clear();
+  initTime();
+  SetStream (Simulator::GetContext (), P1906MOL_MOTOR_RngStreams::NextId (P1906MOL_MOTOR_RngStreams::MotorMotion));
+}
+
+void P1906MOL_Motor::SetStream (uint32_t node, uint32_t id, P1906MOL_MOTOR_RngStreams::Purpose purpose)
+{
+  NS_LOG_FUNCTION (this << node << id << purpose);
+  P1906MOL_MOTOR_RngStreams::Select (r, node, id, purpose);
+}
+
 P1906MOL_Motor::~P1906MOL_Motor ()
 {
   NS_LOG_FUNCTION (this);
+  gsl_vector_free (current_location);
+  gsl_rng_free (r);
 }
 
 } // namespace ns3
@@ -51,6 +51,9 @@ using namespace std;
 #include "ns3/p1906-mol-message-carrier.h"
 #include "ns3/p1906-mol-motor-pos.h"
 #include "ns3/p1906-mol-motor-vol-surface.h"
+#include "ns3/p1906-mol-motor-vec3.h"
+#include "ns3/p1906-mol-motor-rng-streams.h"
+#include "ns3/p1906-mol-motor-trajectory.h"
 
 #include "ns3/double.h"
 #include "ns3/traced-value.h"
@@ -91,8 +94,8 @@ public:
   double start_y;
   double start_z;
 
-  //! a record of the position of the motor throughout its lifetime
-  vector<P1906MOL_MOTOR_Pos> pos_history;
+  //! receives the positions of the motor as it floats; keeps all of them unless replaced
+  Ptr<P1906MOL_MOTOR_TrajectorySink> trajectory;
   
   //! simulated time structure anticipating other fields that may be required for time management
   struct simtime_t
@@ -113,7 +116,7 @@ public:
   //! return the elapsed time since the motor was created
   double propagationDelay();
 
-  //! randomness for the motor  
+  //! randomness for the motor: a counter based stream of P1906MOL_MOTOR_RngStreams
   const gsl_rng_type * T;
   gsl_rng * r;
   
@@ -139,10 +142,23 @@ public:
   void setLocation(P1906MOL_MOTOR_Pos pt);
   //! set the current location
   void setLocation(double x, double y, double z);
+  //! set the current location
+  void setLocation(const P1906MOL_MOTOR_Vec3 & pt);
+  //! return the current location
+  P1906MOL_MOTOR_Vec3 getLocation();
   //! return true if motor is in the destination volume, false otherwise
   bool inDestination();
   //! this is where the motor starts, for example, location of the transmitter
   void setStartingPoint(gsl_vector * pt);
+  //! hand the position pt, reached at the current motor time, to the trajectory sink
+  void recordPosition(const P1906MOL_MOTOR_Vec3 & pt);
+  //! replace the trajectory sink; the positions held by the previous one are not carried over
+  void setTrajectory(Ptr<P1906MOL_MOTOR_TrajectorySink> sink);
+  
+  //! recycle the motor: clear the history, volume surfaces and time, keeping the GSL allocations
+  virtual void Reset (void);
+  //! draw the motor's random numbers from stream (node, id) of the given purpose
+  void SetStream (uint32_t node, uint32_t id, P1906MOL_MOTOR_RngStreams::Purpose purpose = P1906MOL_MOTOR_RngStreams::MotorMotion);
   
   virtual ~P1906MOL_Motor ();
 
@@ -0,0 +1,463 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *  Copyright � 2014 by IEEE.
+ *
+ *  This source file is an essential part of IEEE P1906.1,
+ *  Recommended Practice for Nanoscale and Molecular
+ *  Communication Framework.
+ *  Verbatim copies of this source file may be used and
+ *  distributed without restriction. Modifications to this source
+ *  file as permitted in IEEE P1906.1 may also be made and
+ *  distributed. All other uses require permission from the IEEE
+ *  Standards Department (stds-ipr@ieee.org). All other rights
+ *  reserved.
+ *
+ *  This source file is provided on an AS IS basis.
+ *  The IEEE disclaims ANY WARRANTY EXPRESS OR IMPLIED INCLUDING
+ *  ANY WARRANTY OF MERCHANTABILITY AND FITNESS FOR USE FOR A
+ *  PARTICULAR PURPOSE.
+ *  The user of the source file shall indemnify and hold
+ *  IEEE harmless from any damages or liability arising out of
+ *  the use thereof.
+ *
+ * Author: Giuseppe Piro - Telematics Lab Research Group
+ *                         Politecnico di Bari
+ *                         giuseppe.piro@poliba.it
+ *                         telematics.poliba.it/piro
+ */
+
+/* \details Tests of the P1906Medium
+ *
+ * <pre>
+ *   worker pool reuse, parallel Motion evaluation against the serial one
+ *   link cache: hit, invalidation on course change and field change, no hit on a recreated field
+ * </pre>
+ */
+
+#include <cmath>
+#include <vector>
+
+#include "ns3/test.h"
+#include "ns3/simulator.h"
+#include "ns3/node.h"
+#include "ns3/packet.h"
+#include "ns3/system-mutex.h"
+#include "ns3/constant-position-mobility-model.h"
+#include "ns3/p1906-helper.h"
+#include "ns3/p1906-medium.h"
+#include "ns3/p1906-worker-pool.h"
+#include "ns3/p1906-net-device.h"
+#include "ns3/p1906-field.h"
+#include "ns3/p1906-perturbation.h"
+#include "ns3/p1906-specificity.h"
+#include "ns3/p1906-communication-interface.h"
+#include "ns3/p1906-message-carrier.h"
+#include "ns3/p1906-mol-message-carrier.h"
+#include "ns3/p1906-mol-motion.h"
+
+using namespace ns3;
+
+/**
+ * \ingroup IEEE P1906 framework
+ *
+ * \brief Fick's law Motion counting its serial evaluations
+ */
+class P1906MediumTestMotion : public P1906MOLMotion
+{
+public:
+  P1906MediumTestMotion ();
+  virtual double ComputePropagationDelay (Ptr<P1906CommunicationInterface> src,
+                                          Ptr<P1906CommunicationInterface> dst,
+                                          Ptr<P1906MessageCarrier> message,
+                                          Ptr<P1906Field> field);
+
+  //! calls of ComputePropagationDelay
+  uint32_t m_serialCalls;
+};
+
+P1906MediumTestMotion::P1906MediumTestMotion ()
+  : m_serialCalls (0)
+{
+}
+
+double
+P1906MediumTestMotion::ComputePropagationDelay (Ptr<P1906CommunicationInterface> src,
+                                                Ptr<P1906CommunicationInterface> dst,
+                                                Ptr<P1906MessageCarrier> message,
+                                                Ptr<P1906Field> field)
+{
+  m_serialCalls++;
+  return P1906MOLMotion::ComputePropagationDelay (src, dst, message, field);
+}
+
+/**
+ * \ingroup IEEE P1906 framework
+ *
+ * \brief Field whose parameters can be changed by the tests
+ */
+class P1906MediumTestField : public P1906Field
+{
+public:
+  //! notifies a change of the field parameters
+  void Change (void);
+};
+
+void
+P1906MediumTestField::Change (void)
+{
+  NotifyParametersChanged ();
+}
+
+/**
+ * \ingroup IEEE P1906 framework
+ *
+ * \brief Specificity logging the receptions, in the order they happen
+ */
+class P1906MediumTestSpecificity : public P1906Specificity
+{
+public:
+  virtual bool CheckRxCompatibility (Ptr<P1906CommunicationInterface> src,
+                                     Ptr<P1906CommunicationInterface> dst,
+                                     Ptr<P1906MessageCarrier> message);
+
+  //! receiver of each reception
+  std::vector<P1906CommunicationInterface *> m_receivers;
+  //! time [s] of each reception
+  std::vector<double> m_times;
+};
+
+bool
+P1906MediumTestSpecificity::CheckRxCompatibility (Ptr<P1906CommunicationInterface> src,
+                                                  Ptr<P1906CommunicationInterface> dst,
+                                                  Ptr<P1906MessageCarrier> message)
+{
+  m_receivers.push_back (PeekPointer (dst));
+  m_times.push_back (Simulator::Now ().GetSeconds ());
+  return false;
+}
+
+/**
+ * \ingroup IEEE P1906 framework
+ *
+ * \brief Nodes at fixed positions sharing a medium, a field and a logging specificity
+ */
+class P1906MediumTestNetwork
+{
+public:
+  P1906MediumTestNetwork (const std::vector<Vector> &positions);
+  ~P1906MediumTestNetwork ();
+
+  //! sends a carrier from node src through field (the shared one by default) and runs the simulation until all of it is received
+  void Transmit (uint32_t src, Ptr<P1906Field> field = 0);
+  //! index of the node of each logged reception
+  std::vector<uint32_t> GetReceivers (void);
+
+  Ptr<P1906Medium> m_medium;
+  Ptr<P1906MediumTestMotion> m_motion;
+  Ptr<P1906MediumTestField> m_field;
+  Ptr<P1906MediumTestSpecificity> m_specificity;
+  std::vector<Ptr<Node> > m_nodes;
+  std::vector<Ptr<P1906CommunicationInterface> > m_interfaces;
+};
+
+P1906MediumTestNetwork::P1906MediumTestNetwork (const std::vector<Vector> &positions)
+{
+  P1906Helper helper;
+  m_medium = CreateObject<P1906Medium> ();
+  m_motion = CreateObject<P1906MediumTestMotion> ();
+  m_motion->SetDiffusionCoefficient (1e-9);
+  m_medium->SetP1906Motion (m_motion);
+  m_field = CreateObject<P1906MediumTestField> ();
+  m_specificity = CreateObject<P1906MediumTestSpecificity> ();
+
+  for (uint32_t i = 0; i < positions.size (); i++)
+    {
+      Ptr<Node> n = CreateObject<Node> ();
+      Ptr<ConstantPositionMobilityModel> mobility = CreateObject<ConstantPositionMobilityModel> ();
+      mobility->SetPosition (positions[i]);
+      n->AggregateObject (mobility);
+      Ptr<P1906CommunicationInterface> c = CreateObject<P1906CommunicationInterface> ();
+      helper.Connect (n, CreateObject<P1906NetDevice> (), m_medium, c, m_field,
+                      CreateObject<P1906Perturbation> (), m_specificity);
+      m_nodes.push_back (n);
+      m_interfaces.push_back (c);
+    }
+}
+
+P1906MediumTestNetwork::~P1906MediumTestNetwork ()
+{
+  m_medium->Dispose ();
+  Simulator::Destroy ();
+}
+
+void
+P1906MediumTestNetwork::Transmit (uint32_t src, Ptr<P1906Field> field)
+{
+  //! a carrier with a signature, so that the link cache can serve it
+  Ptr<P1906MOLMessageCarrier> carrier = CreateObject<P1906MOLMessageCarrier> ();
+  carrier->SetMessage (Create<Packet> (1));
+  carrier->SetMolecules (1000);
+  m_medium->HandleTransmission (m_interfaces[src], carrier, field ? field : Ptr<P1906Field> (m_field));
+  Simulator::Run ();
+}
+
+std::vector<uint32_t>
+P1906MediumTestNetwork::GetReceivers (void)
+{
+  std::vector<uint32_t> receivers;
+  for (uint32_t k = 0; k < m_specificity->m_receivers.size (); k++)
+    {
+      for (uint32_t i = 0; i < m_interfaces.size (); i++)
+        {
+          if (PeekPointer (m_interfaces[i]) == m_specificity->m_receivers[k])
+            {
+              receivers.push_back (i);
+            }
+        }
+    }
+  return receivers;
+}
+
+/**
+ * \ingroup IEEE P1906 framework
+ *
+ * \brief Job of the worker pool test: takes items from a shared counter
+ */
+class P1906WorkerPoolTestJob
+{
+public:
+  P1906WorkerPoolTestJob (uint32_t items);
+  void Run (void);
+
+  std::vector<uint32_t> m_done;
+  uint32_t m_next;
+  SystemMutex m_mutex;
+};
+
+P1906WorkerPoolTestJob::P1906WorkerPoolTestJob (uint32_t items)
+  : m_done (items, 0),
+    m_next (0)
+{
+}
+
+void
+P1906WorkerPoolTestJob::Run (void)
+{
+  while (true)
+    {
+      uint32_t i;
+      {
+        CriticalSection cs (m_mutex);
+        if (m_next >= m_done.size ())
+          {
+            return;
+          }
+        i = m_next++;
+      }
+      m_done[i]++;
+    }
+}
+
+/**
+ * \ingroup IEEE P1906 framework
+ *
+ * \brief The workers of a P1906WorkerPool run every job once, across many runs
+ */
+class P1906WorkerPoolTestCase : public TestCase
+{
+public:
+  P1906WorkerPoolTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+P1906WorkerPoolTestCase::P1906WorkerPoolTestCase ()
+  : TestCase ("the worker pool completes every run, whatever the thread schedule")
+{
+}
+
+void
+P1906WorkerPoolTestCase::DoRun (void)
+{
+  P1906WorkerPool pool;
+  const uint32_t threads[3] = { 1, 4, 3 };
+
+  //! back-to-back runs are where a lost wakeup would hang
+  for (uint32_t t = 0; t < 3; t++)
+    {
+      pool.SetThreads (threads[t]);
+      for (uint32_t r = 0; r < 200; r++)
+        {
+          P1906WorkerPoolTestJob job (r % 7);
+          pool.Run (MakeCallback (&P1906WorkerPoolTestJob::Run, &job));
+          uint32_t wrong = 0;
+          for (uint32_t i = 0; i < job.m_done.size (); i++)
+            {
+              wrong += (job.m_done[i] != 1);
+            }
+          NS_TEST_ASSERT_MSG_EQ (wrong, 0, "every item is done once, threads " << threads[t] << " run " << r);
+        }
+    }
+  pool.Stop ();
+
+  //! a stopped pool starts again on the next run
+  P1906WorkerPoolTestJob job (5);
+  pool.Run (MakeCallback (&P1906WorkerPoolTestJob::Run, &job));
+  NS_TEST_ASSERT_MSG_EQ (job.m_next, 5, "all the items are taken after a restart");
+}
+
+/**
+ * \ingroup IEEE P1906 framework
+ *
+ * \brief MotionThreads does not change the delays nor the order of the receptions
+ */
+class P1906MediumMotionThreadsTestCase : public TestCase
+{
+public:
+  P1906MediumMotionThreadsTestCase ();
+
+private:
+  virtual void DoRun (void);
+  //! positions of a transmitter at the origin and receivers at irregular distances, some equal
+  static std::vector<Vector> GetPositions (void);
+};
+
+P1906MediumMotionThreadsTestCase::P1906MediumMotionThreadsTestCase ()
+  : TestCase ("parallel and serial Motion evaluation give the same receptions")
+{
+}
+
+std::vector<Vector>
+P1906MediumMotionThreadsTestCase::GetPositions (void)
+{
+  std::vector<Vector> positions;
+  positions.push_back (Vector (0, 0, 0));
+  for (uint32_t i = 1; i < 24; i++)
+    {
+      double r = 1e-6 * ((i * 7) % 11 + 1);
+      positions.push_back (Vector (r * std::cos (i), r * std::sin (i), 0));
+    }
+  return positions;
+}
+
+void
+P1906MediumMotionThreadsTestCase::DoRun (void)
+{
+  std::vector<Vector> positions = GetPositions ();
+  std::vector<uint32_t> receivers[2];
+  std::vector<double> times[2];
+  uint32_t serialCalls[2];
+  const uint32_t threads[2] = { 1, 4 };
+
+  for (uint32_t t = 0; t < 2; t++)
+    {
+      P1906MediumTestNetwork net (positions);
+      net.m_medium->SetMotionThreads (threads[t]);
+      //! two transmissions: the second one reuses the workers of the first one
+      net.Transmit (0);
+      net.Transmit (0);
+      receivers[t] = net.GetReceivers ();
+      times[t] = net.m_specificity->m_times;
+      serialCalls[t] = net.m_motion->m_serialCalls;
+    }
+
+  NS_TEST_ASSERT_MSG_EQ (serialCalls[0], 2 * (positions.size () - 1), "MotionThreads 1 evaluates every link serially");
+  NS_TEST_ASSERT_MSG_EQ (serialCalls[1], 0, "MotionThreads 4 evaluates every link on the workers");
+
+  NS_TEST_ASSERT_MSG_EQ (receivers[0].size (), 2 * (positions.size () - 1), "every receiver gets both carriers");
+  NS_TEST_ASSERT_MSG_EQ ((receivers[0] == receivers[1]), true, "the receptions happen in the same order");
+  NS_TEST_ASSERT_MSG_EQ ((times[0] == times[1]), true, "the receptions happen at the same times");
+
+  //! Fick's law: d^2 / 6D, for the first transmission sent at 0, up to the ns resolution
+  for (uint32_t k = 0; k < positions.size () - 1; k++)
+    {
+      uint32_t i = receivers[1][k];
+      double d2 = positions[i].x * positions[i].x + positions[i].y * positions[i].y;
+      NS_TEST_ASSERT_MSG_EQ_TOL (times[1][k], d2 / 6e-9, 1e-9, "delay of receiver " << i);
+    }
+}
+
+/**
+ * \ingroup IEEE P1906 framework
+ *
+ * \brief The link cache serves unchanged links, and only them
+ */
+class P1906MediumLinkCacheTestCase : public TestCase
+{
+public:
+  P1906MediumLinkCacheTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+P1906MediumLinkCacheTestCase::P1906MediumLinkCacheTestCase ()
+  : TestCase ("the link cache is invalidated by course changes, field changes and recreated fields")
+{
+}
+
+void
+P1906MediumLinkCacheTestCase::DoRun (void)
+{
+  std::vector<Vector> positions;
+  for (uint32_t i = 0; i < 4; i++)
+    {
+      positions.push_back (Vector (1e-6 * i, 0, 0));
+    }
+  const uint32_t links = positions.size () - 1;
+  P1906MediumTestNetwork net (positions);
+  net.m_medium->SetLinkCacheEnabled (true);
+
+  net.Transmit (0);
+  NS_TEST_ASSERT_MSG_EQ (net.m_motion->m_serialCalls, links, "the first transmission computes every link");
+  net.Transmit (0);
+  NS_TEST_ASSERT_MSG_EQ (net.m_motion->m_serialCalls, links, "the second transmission is served by the cache");
+  NS_TEST_ASSERT_MSG_EQ (net.m_specificity->m_times.size (), 2 * links, "every receiver gets both carriers");
+
+  //! a course change drops the links of the node moved, and only them
+  net.m_nodes[3]->GetObject<MobilityModel> ()->SetPosition (Vector (4e-6, 0, 0));
+  double sent = Simulator::Now ().GetSeconds ();
+  net.Transmit (0);
+  NS_TEST_ASSERT_MSG_EQ (net.m_motion->m_serialCalls, links + 1, "only the link to the node moved is computed");
+  NS_TEST_ASSERT_MSG_EQ_TOL (net.m_specificity->m_times.back () - sent, 16e-12 / 6e-9, 1e-9, "the delay follows the node moved");
+
+  //! a change of the field parameters recomputes the links through it
+  net.m_field->Change ();
+  net.Transmit (0);
+  NS_TEST_ASSERT_MSG_EQ (net.m_motion->m_serialCalls, 2 * links + 1, "every link is computed after a field change");
+  net.Transmit (0);
+  NS_TEST_ASSERT_MSG_EQ (net.m_motion->m_serialCalls, 2 * links + 1, "the recomputed links are cached");
+
+  //! a field created after another one is destroyed, possibly at the same
+  //! address and with the same parameters version, does not hit its links
+  Ptr<P1906MediumTestField> other = CreateObject<P1906MediumTestField> ();
+  net.Transmit (0, other);
+  NS_TEST_ASSERT_MSG_EQ (net.m_motion->m_serialCalls, 3 * links + 1, "the links through another field are computed");
+  other = 0;
+  other = CreateObject<P1906MediumTestField> ();
+  net.Transmit (0, other);
+  NS_TEST_ASSERT_MSG_EQ (net.m_motion->m_serialCalls, 4 * links + 1, "the links through a new field are computed");
+}
+
+/**
+ * \ingroup IEEE P1906 framework
+ *
+ * \brief The P1906Medium test suite
+ */
+class P1906MediumTestSuite : public TestSuite
+{
+public:
+  P1906MediumTestSuite ();
+};
+
+P1906MediumTestSuite::P1906MediumTestSuite ()
+  : TestSuite ("p1906-medium", UNIT)
+{
+  AddTestCase (new P1906WorkerPoolTestCase, TestCase::QUICK);
+  AddTestCase (new P1906MediumMotionThreadsTestCase, TestCase::QUICK);
+  AddTestCase (new P1906MediumLinkCacheTestCase, TestCase::QUICK);
+}
+
+//! registers the suite with the test runner
+static P1906MediumTestSuite g_p1906MediumTestSuite;
@@ -0,0 +1,244 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *  Copyright � 2015 by IEEE.
+ *
+ *  This source file is an essential part of IEEE Std 1906.1,
+ *  Recommended Practice for Nanoscale and Molecular
+ *  Communication Framework.
+ *  Verbatim copies of this source file may be used and
+ *  distributed without restriction. Modifications to this source
+ *  file as permitted in IEEE Std 1906.1 may also be made and
+ *  distributed. All other uses require permission from the IEEE
+ *  Standards Department (stds-ipr@ieee.org). All other rights
+ *  reserved.
+ *
+ *  This source file is provided on an AS IS basis.
+ *  The IEEE disclaims ANY WARRANTY EXPRESS OR IMPLIED INCLUDING
+ *  ANY WARRANTY OF MERCHANTABILITY AND FITNESS FOR USE FOR A
+ *  PARTICULAR PURPOSE.
+ *  The user of the source file shall indemnify and hold
+ *  IEEE harmless from any damages or liability arising out of
+ *  the use thereof.
+ *
+ * Author: Stephen F Bush - GE Global Research
+ *                      bushsf@research.ge.com
+ *                      http://www.amazon.com/author/stephenbush
+ */
+
+/* \details Tests of the finite volume convection-diffusion grid
+ *
+ * <pre>
+ *   total amount conserved, concentrations non negative
+ *   mean displaced by u t, variance grown by 2 D t along an axis without drift
+ *   the same concentrations whatever the number of threads
+ * </pre>
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "ns3/test.h"
+#include "ns3/p1906-mol-motor-pos.h"
+#include "ns3/p1906-mol-motor-vol-surface.h"
+#include "ns3/p1906-mol-diffusion-grid.h"
+
+using namespace ns3;
+
+//! cells per edge of the test grids
+static const size_t g_cells = 48;
+
+//! a g_cells^3 grid of unit cells with D = 1 and a drift along x and z, holding 1000 in its center cell
+static void
+SetUp (P1906MOL_DiffusionGrid & grid, uint32_t threads)
+{
+  size_t cell;
+
+  grid.setGrid (vec3 (0, 0, 0), 1, g_cells, g_cells, g_cells);
+  grid.setTransport (1, vec3 (0.4, 0, -0.25));
+  grid.setThreads (threads);
+  grid.cellOf (vec3 (g_cells / 2 + 0.5, g_cells / 2 + 0.5, g_cells / 2 + 0.5), cell);
+  grid.deposit (cell, 1000);
+}
+
+/**
+ * \ingroup IEEE P1906 framework
+ *
+ * \brief Conservation and moments of a release spreading in the grid
+ */
+class P1906MOL_DiffusionGridTestCase : public TestCase
+{
+public:
+  P1906MOL_DiffusionGridTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+P1906MOL_DiffusionGridTestCase::P1906MOL_DiffusionGridTestCase ()
+  : TestCase ("the grid conserves the release and moves its moments as expected")
+{
+}
+
+void
+P1906MOL_DiffusionGridTestCase::DoRun (void)
+{
+  P1906MOL_DiffusionGrid grid;
+  SetUp (grid, 0);
+  NS_TEST_ASSERT_MSG_EQ (grid.size (), g_cells * g_cells * g_cells, "number of cells");
+  NS_TEST_ASSERT_MSG_EQ_TOL (grid.total (), 1000, 1e-12, "the release");
+
+  size_t cell;
+  NS_TEST_ASSERT_MSG_EQ (grid.cellOf (vec3 (-0.5, 1, 1), cell), false, "a point outside the grid has no cell");
+  NS_TEST_ASSERT_MSG_EQ (grid.cellOf (vec3 (3.5, 2.5, 1.5), cell), true, "a point inside the grid has a cell");
+  P1906MOL_MOTOR_Vec3 c = grid.center (cell);
+  NS_TEST_ASSERT_MSG_EQ ((c.x == 3.5 && c.y == 2.5 && c.z == 1.5), true, "the center of the cell holding a center");
+
+  //! about 7 standard deviations from the walls, so that the reflections do not show
+  const double duration = 6;
+  grid.advance (duration);
+
+  double total = 0;
+  double mean[3] = { 0, 0, 0 };
+  double y2 = 0;
+  double lowest = 0;
+  for (size_t n = 0; n < grid.size (); n++)
+    {
+      double amount = grid.concentration (n);
+      P1906MOL_MOTOR_Vec3 p = grid.center (n) - vec3 (g_cells / 2 + 0.5, g_cells / 2 + 0.5, g_cells / 2 + 0.5);
+      total += amount;
+      mean[0] += amount * p.x;
+      mean[1] += amount * p.y;
+      mean[2] += amount * p.z;
+      y2 += amount * p.y * p.y;
+      lowest = std::min (lowest, amount);
+    }
+  NS_TEST_ASSERT_MSG_EQ_TOL (grid.total (), 1000, 1e-9, "the amount is conserved");
+  NS_TEST_ASSERT_MSG_EQ (lowest, 0, "no concentration is negative");
+
+  //! upwind convection moves the mean by exactly u t, and the explicit diffusion adds 2 D t to the variance
+  NS_TEST_ASSERT_MSG_EQ_TOL (mean[0] / total, 0.4 * duration, 1e-6, "mean along x");
+  NS_TEST_ASSERT_MSG_EQ_TOL (mean[1] / total, 0, 1e-6, "mean along y");
+  NS_TEST_ASSERT_MSG_EQ_TOL (mean[2] / total, -0.25 * duration, 1e-6, "mean along z");
+  NS_TEST_ASSERT_MSG_EQ_TOL (y2 / total, 2 * duration, 1e-6, "variance along y");
+
+  grid.clear ();
+  NS_TEST_ASSERT_MSG_EQ (grid.total (), 0, "an empty grid");
+}
+
+/**
+ * \ingroup IEEE P1906 framework
+ *
+ * \brief A release inside a reflective barrier stays inside it
+ */
+class P1906MOL_DiffusionGridBarrierTestCase : public TestCase
+{
+public:
+  P1906MOL_DiffusionGridBarrierTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+P1906MOL_DiffusionGridBarrierTestCase::P1906MOL_DiffusionGridBarrierTestCase ()
+  : TestCase ("reflective barriers close the cells outside them")
+{
+}
+
+void
+P1906MOL_DiffusionGridBarrierTestCase::DoRun (void)
+{
+  P1906MOL_DiffusionGrid grid;
+  SetUp (grid, 0);
+
+  //! a sphere much smaller than the grid, the release being at its center
+  P1906MOL_MOTOR_Pos center;
+  center.setPos (g_cells / 2, g_cells / 2, g_cells / 2);
+  std::vector<P1906MOL_MOTOR_VolSurface> vsl (1);
+  vsl[0].setVolume (center, 8);
+  vsl[0].setType (P1906MOL_MOTOR_VolSurface::ReflectiveBarrier);
+  grid.setBarriers (vsl);
+
+  size_t corner;
+  grid.cellOf (vec3 (0.5, 0.5, 0.5), corner);
+  NS_TEST_ASSERT_MSG_EQ (grid.isOpen (corner), false, "a cell outside the barrier is closed");
+  bool deposited = grid.deposit (corner, 1);
+  NS_TEST_ASSERT_MSG_EQ (deposited, false, "nothing is deposited in a closed cell");
+  NS_TEST_ASSERT_MSG_EQ_TOL (grid.total (), 1000, 1e-12, "the release is inside the barrier");
+
+  //! long enough for the release to fill the sphere
+  grid.advance (100);
+  NS_TEST_ASSERT_MSG_EQ_TOL (grid.total (), 1000, 1e-9, "the barrier reflects every molecule");
+  for (size_t n = 0; n < grid.size (); n++)
+    {
+      if (!grid.isOpen (n))
+        {
+          NS_TEST_ASSERT_MSG_EQ (grid.concentration (n), 0, "nothing leaks into closed cell " << n);
+        }
+    }
+}
+
+/**
+ * \ingroup IEEE P1906 framework
+ *
+ * \brief The same steps on 0 to 5 threads
+ */
+class P1906MOL_DiffusionGridThreadsTestCase : public TestCase
+{
+public:
+  P1906MOL_DiffusionGridThreadsTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+P1906MOL_DiffusionGridThreadsTestCase::P1906MOL_DiffusionGridThreadsTestCase ()
+  : TestCase ("the concentrations do not depend on the number of threads")
+{
+}
+
+void
+P1906MOL_DiffusionGridThreadsTestCase::DoRun (void)
+{
+  P1906MOL_DiffusionGrid serial;
+  SetUp (serial, 0);
+  serial.advance (1);
+  serial.advance (2);
+
+  const uint32_t threads[] = { 2, 3, 5 };
+  for (size_t k = 0; k < sizeof (threads) / sizeof (threads[0]); k++)
+    {
+      P1906MOL_DiffusionGrid threaded;
+      SetUp (threaded, threads[k]);
+      threaded.advance (1);
+      //! the running threads are stopped and others started by the next step
+      threaded.setThreads (threads[k] + 1);
+      threaded.advance (2);
+      for (size_t n = 0; n < serial.size (); n++)
+        {
+          NS_TEST_ASSERT_MSG_EQ (threaded.concentration (n), serial.concentration (n), "cell " << n << " on " << threads[k] << " threads");
+        }
+    }
+}
+
+/**
+ * \ingroup IEEE P1906 framework
+ *
+ * \brief The P1906MOL_DiffusionGrid test suite
+ */
+class P1906MOL_DiffusionGridTestSuite : public TestSuite
+{
+public:
+  P1906MOL_DiffusionGridTestSuite ();
+};
+
+P1906MOL_DiffusionGridTestSuite::P1906MOL_DiffusionGridTestSuite ()
+  : TestSuite ("p1906-mol-diffusion-grid", UNIT)
+{
+  AddTestCase (new P1906MOL_DiffusionGridTestCase, TestCase::QUICK);
+  AddTestCase (new P1906MOL_DiffusionGridBarrierTestCase, TestCase::QUICK);
+  AddTestCase (new P1906MOL_DiffusionGridThreadsTestCase, TestCase::QUICK);
+}
+
+//! registers the suite with the test runner
+static P1906MOL_DiffusionGridTestSuite g_p1906MolDiffusionGridTestSuite;
@@ -0,0 +1,280 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *  Copyright � 2015 by IEEE.
+ *
+ *  This source file is an essential part of IEEE Std 1906.1,
+ *  Recommended Practice for Nanoscale and Molecular
+ *  Communication Framework.
+ *  Verbatim copies of this source file may be used and
+ *  distributed without restriction. Modifications to this source
+ *  file as permitted in IEEE Std 1906.1 may also be made and
+ *  distributed. All other uses require permission from the IEEE
+ *  Standards Department (stds-ipr@ieee.org). All other rights
+ *  reserved.
+ *
+ *  This source file is provided on an AS IS basis.
+ *  The IEEE disclaims ANY WARRANTY EXPRESS OR IMPLIED INCLUDING
+ *  ANY WARRANTY OF MERCHANTABILITY AND FITNESS FOR USE FOR A
+ *  PARTICULAR PURPOSE.
+ *  The user of the source file shall indemnify and hold
+ *  IEEE harmless from any damages or liability arising out of
+ *  the use thereof.
+ *
+ * Author: Stephen F Bush - GE Global Research
+ *                      bushsf@research.ge.com
+ *                      http://www.amazon.com/author/stephenbush
+ */
+
+/* \details Tests of the batched diffusion wave superposition
+ *
+ * <pre>
+ *   kernel == c0 (4 pi D dt)^(-3/2) exp (-r^2 / (4 D dt))
+ *   concentration == sum of the contributions of the waves
+ *   cull drops exactly the waves whose peak is below the threshold
+ * </pre>
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "ns3/test.h"
+#include "ns3/p1906-mol-motor-rng-streams.h"
+#include "ns3/p1906-mol-diffusion-waves.h"
+
+using namespace ns3;
+
+//! add n random waves released over [0, 1) s in a 10 um box to waves; their t0, D and c0 are appended to t0, D and c0
+static void
+DrawWaves (gsl_rng * r, size_t n, P1906MOL_ExtendedDiffusionWaves & waves, std::vector<double> & t0, std::vector<double> & D, std::vector<double> & c0)
+{
+  for (size_t i = 0; i < n; i++)
+    {
+      t0.push_back (gsl_rng_uniform (r));
+      D.push_back (1e-10 * (1 + 9 * gsl_rng_uniform (r)));
+      c0.push_back (std::pow (10.0, 3 + 3 * gsl_rng_uniform (r)));
+      P1906MOL_MOTOR_Vec3 x = vec3 (1e-5 * gsl_rng_uniform (r), 1e-5 * gsl_rng_uniform (r), 1e-5 * gsl_rng_uniform (r));
+      waves.add (t0.back (), D.back (), c0.back (), x);
+    }
+}
+
+/**
+ * \ingroup IEEE P1906 framework
+ *
+ * \brief The kernel against the closed form, and the batched sum against the contributions
+ */
+class P1906MOL_ExtendedDiffusionWavesTestCase : public TestCase
+{
+public:
+  P1906MOL_ExtendedDiffusionWavesTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+P1906MOL_ExtendedDiffusionWavesTestCase::P1906MOL_ExtendedDiffusionWavesTestCase ()
+  : TestCase ("the batched concentration is the sum of the diffusion waves")
+{
+}
+
+void
+P1906MOL_ExtendedDiffusionWavesTestCase::DoRun (void)
+{
+  //! the kernel and its exponential against the C library
+  const double r2s[] = { 0, 1e-12, 1e-10, 4e-9, 1e-7 };
+  const double dts[] = { 1e-3, 0.1, 1, 30 };
+  for (size_t i = 0; i < sizeof (r2s) / sizeof (r2s[0]); i++)
+    {
+      for (size_t j = 0; j < sizeof (dts) / sizeof (dts[0]); j++)
+        {
+          double s = 4 * 1e-9 * dts[j];
+          double expected = 1e5 * std::pow (M_PI * s, -1.5) * std::exp (-r2s[i] / s);
+          double k = P1906MOL_ExtendedDiffusionWaves::kernel (1e5, 1e-9, dts[j], r2s[i]);
+          NS_TEST_ASSERT_MSG_EQ_TOL (k, expected, 1e-13 * expected, "kernel at r^2 = " << r2s[i] << ", dt = " << dts[j]);
+        }
+    }
+  NS_TEST_ASSERT_MSG_EQ (P1906MOL_ExtendedDiffusionWaves::kernel (1e5, 1e-9, 0, 0), 0, "nothing at the release time");
+  NS_TEST_ASSERT_MSG_EQ (P1906MOL_ExtendedDiffusionWaves::kernel (1e5, 1e-9, -1, 0), 0, "nothing before the release");
+
+  //! not a multiple of the lanes, so that the last batch holds padding
+  const size_t n = 8 * P1906MOL_ExtendedDiffusionWaves::lanes + 3;
+  gsl_rng * r = P1906MOL_MOTOR_RngStreams::Create (0, 0, P1906MOL_MOTOR_RngStreams::FieldGeneration);
+  P1906MOL_ExtendedDiffusionWaves waves;
+  std::vector<double> t0, D, c0;
+  DrawWaves (r, n, waves, t0, D, c0);
+  NS_TEST_ASSERT_MSG_EQ (waves.size (), n, "one wave per release");
+
+  const size_t queries = 20;
+  std::vector<P1906MOL_MOTOR_Vec3> receivers (queries);
+  std::vector<double> times (queries);
+  std::vector<double> batch (queries);
+  for (size_t q = 0; q < queries; q++)
+    {
+      receivers[q] = vec3 (2e-5 * gsl_rng_uniform (r), 2e-5 * gsl_rng_uniform (r), 2e-5 * gsl_rng_uniform (r));
+      //! some queries come before the last releases
+      times[q] = 0.5 + 1.5 * gsl_rng_uniform (r);
+    }
+  gsl_rng_free (r);
+  waves.concentration (&receivers[0], &times[0], queries, &batch[0]);
+
+  for (size_t q = 0; q < queries; q++)
+    {
+      //! wave i goes to partial sum i % lanes, whatever the kernel
+      double partial[P1906MOL_ExtendedDiffusionWaves::lanes] = { 0 };
+      double inOrder = 0;
+      for (size_t i = 0; i < n; i++)
+        {
+          double c = waves.contribution (i, receivers[q], times[q]);
+          partial[i % P1906MOL_ExtendedDiffusionWaves::lanes] += c;
+          inOrder += c;
+        }
+      double expected = 0;
+      for (size_t j = 0; j < P1906MOL_ExtendedDiffusionWaves::lanes; j++)
+        {
+          expected += partial[j];
+        }
+      //! equal bit for bit unless the scalar path is contracted into fused multiply-adds
+      NS_TEST_ASSERT_MSG_EQ_TOL (batch[q], expected, 1e-14 * expected, "batched concentration of query " << q);
+      NS_TEST_ASSERT_MSG_EQ_TOL (batch[q], inOrder, 1e-12 * inOrder, "concentration of query " << q << " summed in order");
+      NS_TEST_ASSERT_MSG_EQ (waves.concentration (receivers[q], times[q]), batch[q], "single query " << q);
+    }
+  NS_TEST_ASSERT_MSG_EQ (waves.size (), n, "no threshold, no culling");
+
+  waves.clear ();
+  NS_TEST_ASSERT_MSG_EQ (waves.size (), 0, "no waves after clear");
+  NS_TEST_ASSERT_MSG_EQ (waves.concentration (receivers[0], times[0]), 0, "no concentration without waves");
+}
+
+/**
+ * \ingroup IEEE P1906 framework
+ *
+ * \brief Culling of the waves that can no longer exceed the threshold
+ */
+class P1906MOL_ExtendedDiffusionWavesCullTestCase : public TestCase
+{
+public:
+  P1906MOL_ExtendedDiffusionWavesCullTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+P1906MOL_ExtendedDiffusionWavesCullTestCase::P1906MOL_ExtendedDiffusionWavesCullTestCase ()
+  : TestCase ("culling drops exactly the waves below the threshold everywhere")
+{
+}
+
+void
+P1906MOL_ExtendedDiffusionWavesCullTestCase::DoRun (void)
+{
+  const size_t n = 200;
+  const double horizon = 0.8;
+  gsl_rng * r = P1906MOL_MOTOR_RngStreams::Create (0, 1, P1906MOL_MOTOR_RngStreams::FieldGeneration);
+  P1906MOL_ExtendedDiffusionWaves all;
+  std::vector<double> t0, D, c0;
+  DrawWaves (r, n, all, t0, D, c0);
+  P1906MOL_MOTOR_Vec3 receiver = vec3 (5e-6, 5e-6, 5e-6);
+  gsl_rng_free (r);
+
+  //! a wave is everywhere at most its peak c0 (4 pi D dt)^(-3/2); the threshold lies between two peaks at the horizon
+  std::vector<double> peaks;
+  for (size_t i = 0; i < n; i++)
+    {
+      if (horizon > t0[i])
+        {
+          peaks.push_back (c0[i] * std::pow (4 * M_PI * D[i] * (horizon - t0[i]), -1.5));
+        }
+    }
+  std::sort (peaks.begin (), peaks.end ());
+  const double threshold = 0.5 * (peaks[peaks.size () / 2 - 1] + peaks[peaks.size () / 2]);
+
+  std::vector<bool> keep (n, true);
+  size_t dropped = 0;
+  for (size_t i = 0; i < n; i++)
+    {
+      double dt = horizon - t0[i];
+      if (dt > 0 && c0[i] * std::pow (4 * M_PI * D[i] * dt, -1.5) < threshold)
+        {
+          keep[i] = false;
+          dropped++;
+        }
+    }
+
+  P1906MOL_ExtendedDiffusionWaves waves = all;
+  size_t culled = waves.cull (horizon);
+  NS_TEST_ASSERT_MSG_EQ (culled, 0, "no threshold, no culling");
+  waves.setCullThreshold (threshold);
+  NS_TEST_ASSERT_MSG_EQ (waves.getCullThreshold (), threshold, "the cull threshold");
+  culled = waves.cull (horizon);
+  NS_TEST_ASSERT_MSG_EQ (culled, dropped, "the waves whose peak is below the threshold at the horizon");
+  NS_TEST_ASSERT_MSG_EQ (waves.size (), n - dropped, "the other waves are kept");
+  culled = waves.cull (horizon);
+  NS_TEST_ASSERT_MSG_EQ (culled, 0, "culling twice at the same horizon drops nothing more");
+  //! later queries would cull more: keep the remaining waves for the comparisons below
+  waves.setCullThreshold (0);
+
+  //! the kept waves are in release order, and the dropped ones are below the threshold everywhere
+  const double times[] = { horizon, 1.0, 3.0 };
+  for (size_t k = 0; k < sizeof (times) / sizeof (times[0]); k++)
+    {
+      double kept = 0;
+      double lost = 0;
+      for (size_t i = 0, j = 0; i < n; i++)
+        {
+          double c = all.contribution (i, receiver, times[k]);
+          if (keep[i])
+            {
+              NS_TEST_ASSERT_MSG_EQ (waves.contribution (j, receiver, times[k]), c, "kept wave " << i);
+              j++;
+              kept += c;
+            }
+          else
+            {
+              NS_TEST_ASSERT_MSG_LT (c, threshold, "dropped wave " << i << " at " << times[k] << " s");
+              lost += c;
+            }
+        }
+      NS_TEST_ASSERT_MSG_EQ_TOL (waves.concentration (receiver, times[k]), kept, 1e-12 * kept, "concentration of the kept waves at " << times[k] << " s");
+      NS_TEST_ASSERT_MSG_EQ_TOL (all.concentration (receiver, times[k]), kept + lost, 1e-12 * (kept + lost), "concentration of all the waves at " << times[k] << " s");
+    }
+
+  //! a batch culls at its earliest time
+  P1906MOL_ExtendedDiffusionWaves batch = all;
+  batch.setCullThreshold (threshold);
+  P1906MOL_MOTOR_Vec3 receivers[2] = { receiver, vec3 (0, 0, 0) };
+  double batchTimes[2] = { 2.0, horizon };
+  double c[2];
+  batch.concentration (receivers, batchTimes, 2, c);
+  NS_TEST_ASSERT_MSG_EQ (batch.size (), n - dropped, "a batch culls at its earliest time");
+
+  //! removeBelow drops what contributes less than min at one receiver
+  size_t small = 0;
+  for (size_t i = 0; i < n; i++)
+    {
+      small += all.contribution (i, receiver, 1.0) < threshold ? 1 : 0;
+    }
+  size_t removed = all.removeBelow (receiver, 1.0, threshold);
+  NS_TEST_ASSERT_MSG_EQ (removed, small, "the waves below min at the receiver");
+  NS_TEST_ASSERT_MSG_EQ (all.size (), n - small, "the other waves are kept");
+}
+
+/**
+ * \ingroup IEEE P1906 framework
+ *
+ * \brief The P1906MOL_ExtendedDiffusionWaves test suite
+ */
+class P1906MOL_ExtendedDiffusionWavesTestSuite : public TestSuite
+{
+public:
+  P1906MOL_ExtendedDiffusionWavesTestSuite ();
+};
+
+P1906MOL_ExtendedDiffusionWavesTestSuite::P1906MOL_ExtendedDiffusionWavesTestSuite ()
+  : TestSuite ("p1906-mol-diffusion-waves", UNIT)
+{
+  AddTestCase (new P1906MOL_ExtendedDiffusionWavesTestCase, TestCase::QUICK);
+  AddTestCase (new P1906MOL_ExtendedDiffusionWavesCullTestCase, TestCase::QUICK);
+}
+
+//! registers the suite with the test runner
+static P1906MOL_ExtendedDiffusionWavesTestSuite g_p1906MolExtendedDiffusionWavesTestSuite;
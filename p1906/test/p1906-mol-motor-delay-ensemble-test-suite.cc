@@ -0,0 +1,160 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *  Copyright � 2015 by IEEE.
+ *
+ *  This source file is an essential part of IEEE Std 1906.1,
+ *  Recommended Practice for Nanoscale and Molecular
+ *  Communication Framework.
+ *  Verbatim copies of this source file may be used and
+ *  distributed without restriction. Modifications to this source
+ *  file as permitted in IEEE Std 1906.1 may also be made and
+ *  distributed. All other uses require permission from the IEEE
+ *  Standards Department (stds-ipr@ieee.org). All other rights
+ *  reserved.
+ *
+ *  This source file is provided on an AS IS basis.
+ *  The IEEE disclaims ANY WARRANTY EXPRESS OR IMPLIED INCLUDING
+ *  ANY WARRANTY OF MERCHANTABILITY AND FITNESS FOR USE FOR A
+ *  PARTICULAR PURPOSE.
+ *  The user of the source file shall indemnify and hold
+ *  IEEE harmless from any damages or liability arising out of
+ *  the use thereof.
+ *
+ * Author: Stephen F Bush - GE Global Research
+ *                      bushsf@research.ge.com
+ *                      http://www.amazon.com/author/stephenbush
+ */
+
+/* \details Tests of the Monte Carlo ensembles of motor propagation delays
+ *
+ * <pre>
+ *   same ensemble streams on 1 and N threads -> the same delays
+ *   sorted delays -> min <= quantiles <= max, mean == sum / n, cdf and histogram consistent
+ * </pre>
+ */
+
+#include <vector>
+
+#include "ns3/test.h"
+#include "ns3/vector.h"
+#include "ns3/p1906-mol-motor-motion.h"
+#include "ns3/p1906-mol-motor-rng-streams.h"
+#include "ns3/p1906-mol-motor-delay-ensemble.h"
+
+using namespace ns3;
+
+/**
+ * \ingroup IEEE P1906 framework
+ *
+ * \brief An ensemble gives the same delays on any number of threads, and consistent statistics
+ */
+class P1906MOL_MOTOR_DelayEnsembleTestCase : public TestCase
+{
+public:
+  P1906MOL_MOTOR_DelayEnsembleTestCase ();
+
+private:
+  virtual void DoRun (void);
+  //! the delays of the first ensemble run on threads threads
+  static P1906MOL_MOTOR_DelayDistribution Run (uint32_t threads);
+};
+
+P1906MOL_MOTOR_DelayEnsembleTestCase::P1906MOL_MOTOR_DelayEnsembleTestCase ()
+  : TestCase ("delay ensembles do not depend on the number of threads")
+{
+}
+
+P1906MOL_MOTOR_DelayDistribution
+P1906MOL_MOTOR_DelayEnsembleTestCase::Run (uint32_t threads)
+{
+  //! the same ensemble id, hence the same motor streams, for every run
+  P1906MOL_MOTOR_RngStreams::ResetNextIds ();
+  Ptr<P1906MOL_MOTOR_Motion> motion = CreateObject<P1906MOL_MOTOR_Motion> ();
+  Ptr<P1906MOL_MOTOR_DelayEnsemble> ensemble = CreateObject<P1906MOL_MOTOR_DelayEnsemble> ();
+  P1906MOL_MOTOR_DelayDistribution result;
+
+  motion->SetDiffusionCoefficient (1);
+  ensemble->setMotors (64);
+  ensemble->setHistogramBins (8);
+  ensemble->setThreads (threads);
+  ensemble->run (PeekPointer (motion), Vector (0, 0, 0), Vector (1e-6, 0, 0), result);
+  return result;
+}
+
+void
+P1906MOL_MOTOR_DelayEnsembleTestCase::DoRun (void)
+{
+  P1906MOL_MOTOR_DelayDistribution serial = Run (1);
+  const std::vector<double> & delays = serial.getDelays ();
+  NS_TEST_ASSERT_MSG_EQ (serial.size (), 64, "one delay per motor");
+
+  //! motor k draws from stream (ensemble, k) whatever thread floats it
+  const uint32_t threads[2] = { 4, 3 };
+  for (uint32_t t = 0; t < 2; t++)
+    {
+      P1906MOL_MOTOR_DelayDistribution threaded = Run (threads[t]);
+      NS_TEST_ASSERT_MSG_EQ ((threaded.getDelays () == delays), true, "the same delays on " << threads[t] << " threads");
+      NS_TEST_ASSERT_MSG_EQ (threaded.getMean (), serial.getMean (), "the same mean on " << threads[t] << " threads");
+      NS_TEST_ASSERT_MSG_EQ ((threaded.getBinCounts () == serial.getBinCounts ()), true, "the same histogram on " << threads[t] << " threads");
+    }
+
+  //! statistics of the sorted delays
+  double sum = 0;
+  for (size_t i = 0; i < delays.size (); i++)
+    {
+      NS_TEST_ASSERT_MSG_GT (delays[i], 0, "a motor takes time to arrive");
+      if (i > 0)
+        {
+          NS_TEST_ASSERT_MSG_EQ ((delays[i - 1] <= delays[i]), true, "the delays are sorted");
+        }
+      sum += delays[i];
+    }
+  NS_TEST_ASSERT_MSG_EQ_TOL (serial.getMean (), sum / delays.size (), 1e-9 * serial.getMean (), "the mean is the average of the delays");
+  NS_TEST_ASSERT_MSG_EQ ((serial.getMin () <= serial.getMean () && serial.getMean () <= serial.getMax ()), true, "the mean is within the range");
+  NS_TEST_ASSERT_MSG_EQ ((serial.getVariance () >= 0), true, "the variance is not negative");
+
+  NS_TEST_ASSERT_MSG_EQ (serial.getQuantile (0), serial.getMin (), "the 0 quantile is the minimum");
+  NS_TEST_ASSERT_MSG_EQ (serial.getQuantile (1), serial.getMax (), "the 1 quantile is the maximum");
+  const double p[4] = { 0.1, 0.5, 0.9, 0.99 };
+  double previous = serial.getMin ();
+  for (uint32_t k = 0; k < 4; k++)
+    {
+      double q = serial.getQuantile (p[k]);
+      NS_TEST_ASSERT_MSG_EQ ((previous <= q && q <= serial.getMax ()), true, "the " << p[k] << " quantile is ordered");
+      //! the quantile interpolates between two delays, so the cdf may miss p by less than one motor
+      NS_TEST_ASSERT_MSG_EQ ((serial.getCdf (q) > p[k] - 1.0 / delays.size ()), true, "a fraction " << p[k] << " of the motors arrived by the " << p[k] << " quantile");
+      previous = q;
+    }
+  NS_TEST_ASSERT_MSG_EQ (serial.getCdf (serial.getMax ()), 1, "every motor arrived by the maximum");
+  NS_TEST_ASSERT_MSG_EQ (serial.sample (0), serial.getMin (), "the lowest variate draws the minimum");
+  NS_TEST_ASSERT_MSG_EQ (serial.sample (0.999999), serial.getMax (), "the highest variate draws the maximum");
+
+  size_t counted = 0;
+  for (size_t b = 0; b < serial.getBinCounts ().size (); b++)
+    {
+      counted += serial.getBinCounts ()[b];
+    }
+  NS_TEST_ASSERT_MSG_EQ (counted, serial.size (), "the histogram holds every delay");
+  NS_TEST_ASSERT_MSG_EQ (serial.getBinEdges ().front (), serial.getMin (), "the histogram starts at the minimum");
+  NS_TEST_ASSERT_MSG_EQ (serial.getBinEdges ().back (), serial.getMax (), "the histogram ends at the maximum");
+}
+
+/**
+ * \ingroup IEEE P1906 framework
+ *
+ * \brief The delay ensemble test suite
+ */
+class P1906MOL_MOTOR_DelayEnsembleTestSuite : public TestSuite
+{
+public:
+  P1906MOL_MOTOR_DelayEnsembleTestSuite ();
+};
+
+P1906MOL_MOTOR_DelayEnsembleTestSuite::P1906MOL_MOTOR_DelayEnsembleTestSuite ()
+  : TestSuite ("p1906-mol-motor-delay-ensemble", UNIT)
+{
+  AddTestCase (new P1906MOL_MOTOR_DelayEnsembleTestCase, TestCase::QUICK);
+}
+
+//! registers the suite with the test runner
+static P1906MOL_MOTOR_DelayEnsembleTestSuite g_p1906MolMotorDelayEnsembleTestSuite;
@@ -0,0 +1,247 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *  Copyright � 2015 by IEEE.
+ *
+ *  This source file is an essential part of IEEE Std 1906.1,
+ *  Recommended Practice for Nanoscale and Molecular
+ *  Communication Framework.
+ *  Verbatim copies of this source file may be used and
+ *  distributed without restriction. Modifications to this source
+ *  file as permitted in IEEE Std 1906.1 may also be made and
+ *  distributed. All other uses require permission from the IEEE
+ *  Standards Department (stds-ipr@ieee.org). All other rights
+ *  reserved.
+ *
+ *  This source file is provided on an AS IS basis.
+ *  The IEEE disclaims ANY WARRANTY EXPRESS OR IMPLIED INCLUDING
+ *  ANY WARRANTY OF MERCHANTABILITY AND FITNESS FOR USE FOR A
+ *  PARTICULAR PURPOSE.
+ *  The user of the source file shall indemnify and hold
+ *  IEEE harmless from any damages or liability arising out of
+ *  the use thereof.
+ *
+ * Author: Stephen F Bush - GE Global Research
+ *                      bushsf@research.ge.com
+ *                      http://www.amazon.com/author/stephenbush
+ */
+
+/* \details Tests of the structural entropy of tube networks
+ *
+ * <pre>
+ *   sEntropy == - sum (p log p) over a histogram of the angles counted by hand
+ *   persistenceSweep entropies do not depend on the number of threads
+ * </pre>
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "ns3/test.h"
+#include "ns3/ptr.h"
+#include "ns3/object.h"
+#include "ns3/p1906-mol-motor-rng-streams.h"
+#include "ns3/p1906-mol-motor-field.h"
+#include "ns3/p1906-mol-motor-microtubule.h"
+
+using namespace ns3;
+
+/**
+ * \ingroup IEEE P1906 framework
+ *
+ * \brief sEntropy against a histogram counted by hand
+ */
+class P1906MOL_MOTOR_EntropyTestCase : public TestCase
+{
+public:
+  P1906MOL_MOTOR_EntropyTestCase ();
+
+private:
+  virtual void DoRun (void);
+  //! the entropy of the values binned over [min, max), the maximum itself being left out as by gsl_histogram
+  static double Reference (const std::vector<double> & values, size_t bins);
+  //! a column matrix holding values
+  static gsl_matrix * Column (const std::vector<double> & values);
+};
+
+P1906MOL_MOTOR_EntropyTestCase::P1906MOL_MOTOR_EntropyTestCase ()
+  : TestCase ("sEntropy is the entropy of the histogram of the angles")
+{
+}
+
+double
+P1906MOL_MOTOR_EntropyTestCase::Reference (const std::vector<double> & values, size_t bins)
+{
+  double lo = values[0];
+  double hi = values[0];
+  for (size_t i = 1; i < values.size (); i++)
+    {
+      lo = std::min (lo, values[i]);
+      hi = std::max (hi, values[i]);
+    }
+
+  //! the same bin edges as gsl_histogram_set_ranges_uniform
+  std::vector<double> edges (bins + 1);
+  for (size_t b = 0; b <= bins; b++)
+    {
+      edges[b] = lo + ((double) b / (double) bins) * (hi - lo);
+    }
+  std::vector<double> counts (bins, 0);
+  double total = 0;
+  for (size_t i = 0; i < values.size (); i++)
+    {
+      for (size_t b = 0; b < bins; b++)
+        {
+          if (edges[b] <= values[i] && values[i] < edges[b + 1])
+            {
+              counts[b]++;
+              total++;
+              break;
+            }
+        }
+    }
+
+  double H = 0;
+  for (size_t b = 0; b < bins; b++)
+    {
+      if (counts[b] > 0)
+        {
+          H -= counts[b] / total * std::log (counts[b] / total);
+        }
+    }
+  return H;
+}
+
+gsl_matrix *
+P1906MOL_MOTOR_EntropyTestCase::Column (const std::vector<double> & values)
+{
+  gsl_matrix * m = gsl_matrix_alloc (values.size (), 1);
+  for (size_t i = 0; i < values.size (); i++)
+    {
+      gsl_matrix_set (m, i, 0, values[i]);
+    }
+  return m;
+}
+
+void
+P1906MOL_MOTOR_EntropyTestCase::DoRun (void)
+{
+  //! bins [0, 1) [1, 2) [2, 3) [3, 4) hold 2, 1, 2 and 0 angles; 4 is the maximum and is not counted
+  const double angles[] = { 0, 0.5, 1.5, 2.5, 2.5, 4 };
+  std::vector<double> values (angles, angles + sizeof (angles) / sizeof (angles[0]));
+  gsl_matrix * m = Column (values);
+  double expected = - 2 * 0.4 * std::log (0.4) - 0.2 * std::log (0.2);
+  NS_TEST_ASSERT_MSG_EQ_TOL (P1906MOL_MOTOR_Field::sEntropy (m, 4), expected, 1e-12, "entropy of 4 bins counted by hand");
+  NS_TEST_ASSERT_MSG_EQ_TOL (Reference (values, 4), expected, 1e-12, "the reference histogram");
+  gsl_matrix_free (m);
+
+  //! a single state, or no bins, has no entropy
+  m = Column (std::vector<double> (10, 30.0));
+  NS_TEST_ASSERT_MSG_EQ (P1906MOL_MOTOR_Field::sEntropy (m), 0, "entropy of equal angles");
+  gsl_matrix_free (m);
+  m = Column (values);
+  NS_TEST_ASSERT_MSG_EQ (P1906MOL_MOTOR_Field::sEntropy (m, 0), 0, "entropy over no bins");
+  gsl_matrix_free (m);
+
+  //! angles of random tubes, over several numbers of bins
+  gsl_rng * r = P1906MOL_MOTOR_RngStreams::Create (0, 3, P1906MOL_MOTOR_RngStreams::TubeGeneration);
+  values.resize (1000);
+  for (size_t i = 0; i < values.size (); i++)
+    {
+      values[i] = 180 * gsl_rng_uniform (r) * gsl_rng_uniform (r);
+    }
+  gsl_rng_free (r);
+  m = Column (values);
+  const size_t bins[] = { 1, 7, 100, 2000 };
+  for (size_t k = 0; k < sizeof (bins) / sizeof (bins[0]); k++)
+    {
+      double H = P1906MOL_MOTOR_Field::sEntropy (m, bins[k]);
+      NS_TEST_ASSERT_MSG_EQ_TOL (H, Reference (values, bins[k]), 1e-12, "entropy over " << bins[k] << " bins");
+      NS_TEST_ASSERT_MSG_LT (H, std::log ((double) bins[k]) + 1e-12, "entropy over " << bins[k] << " bins is at most log bins");
+    }
+  gsl_matrix_free (m);
+}
+
+/**
+ * \ingroup IEEE P1906 framework
+ *
+ * \brief The entropies of persistenceSweep with and without worker threads
+ */
+class P1906MOL_MOTOR_PersistenceSweepTestCase : public TestCase
+{
+public:
+  P1906MOL_MOTOR_PersistenceSweepTestCase ();
+
+private:
+  virtual void DoRun (void);
+  //! the entropies of a sweep over lengths by a new field generating its tubes on threads threads
+  static std::vector<double> Sweep (const std::vector<double> & lengths, uint32_t threads);
+};
+
+P1906MOL_MOTOR_PersistenceSweepTestCase::P1906MOL_MOTOR_PersistenceSweepTestCase ()
+  : TestCase ("persistenceSweep does not depend on the number of threads")
+{
+}
+
+std::vector<double>
+P1906MOL_MOTOR_PersistenceSweepTestCase::Sweep (const std::vector<double> & lengths, uint32_t threads)
+{
+  //! the same ids, hence the same streams, for every sweep
+  P1906MOL_MOTOR_RngStreams::ResetNextIds ();
+  Ptr<P1906MOL_MOTOR_MicrotubulesField> field = CreateObject<P1906MOL_MOTOR_MicrotubulesField> ();
+  std::vector<double> entropies;
+
+  field->setTubeThreads (threads);
+  field->persistenceSweep (lengths, entropies);
+  return entropies;
+}
+
+void
+P1906MOL_MOTOR_PersistenceSweepTestCase::DoRun (void)
+{
+  std::vector<double> lengths;
+  lengths.push_back (10);
+  lengths.push_back (50);
+  lengths.push_back (200);
+
+  std::vector<double> serial = Sweep (lengths, 0);
+  NS_TEST_ASSERT_MSG_EQ (serial.size (), lengths.size (), "one entropy per persistence length");
+  for (size_t i = 0; i < serial.size (); i++)
+    {
+      NS_TEST_ASSERT_MSG_GT (serial[i], 0, "entropy of the network of persistence length " << lengths[i]);
+    }
+  NS_TEST_ASSERT_MSG_EQ ((Sweep (lengths, 0) == serial), true, "the same streams give the same entropies");
+
+  //! tubes are drawn from their own streams and the entropies summed in tube order
+  const uint32_t threads[] = { 2, 3, 8 };
+  for (size_t k = 0; k < sizeof (threads) / sizeof (threads[0]); k++)
+    {
+      std::vector<double> threaded = Sweep (lengths, threads[k]);
+      NS_TEST_ASSERT_MSG_EQ (threaded.size (), serial.size (), "one entropy per persistence length on " << threads[k] << " threads");
+      for (size_t i = 0; i < serial.size (); i++)
+        {
+          NS_TEST_ASSERT_MSG_EQ (threaded[i], serial[i], "entropy of persistence length " << lengths[i] << " on " << threads[k] << " threads");
+        }
+    }
+}
+
+/**
+ * \ingroup IEEE P1906 framework
+ *
+ * \brief The structural entropy test suite
+ */
+class P1906MOL_MOTOR_EntropyTestSuite : public TestSuite
+{
+public:
+  P1906MOL_MOTOR_EntropyTestSuite ();
+};
+
+P1906MOL_MOTOR_EntropyTestSuite::P1906MOL_MOTOR_EntropyTestSuite ()
+  : TestSuite ("p1906-mol-motor-entropy", UNIT)
+{
+  AddTestCase (new P1906MOL_MOTOR_EntropyTestCase, TestCase::QUICK);
+  AddTestCase (new P1906MOL_MOTOR_PersistenceSweepTestCase, TestCase::QUICK);
+}
+
+//! registers the suite with the test runner
+static P1906MOL_MOTOR_EntropyTestSuite g_p1906MolMotorEntropyTestSuite;
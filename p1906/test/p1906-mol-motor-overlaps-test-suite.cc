@@ -0,0 +1,254 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *  Copyright � 2015 by IEEE.
+ *
+ *  This source file is an essential part of IEEE Std 1906.1,
+ *  Recommended Practice for Nanoscale and Molecular
+ *  Communication Framework.
+ *  Verbatim copies of this source file may be used and
+ *  distributed without restriction. Modifications to this source
+ *  file as permitted in IEEE Std 1906.1 may also be made and
+ *  distributed. All other uses require permission from the IEEE
+ *  Standards Department (stds-ipr@ieee.org). All other rights
+ *  reserved.
+ *
+ *  This source file is provided on an AS IS basis.
+ *  The IEEE disclaims ANY WARRANTY EXPRESS OR IMPLIED INCLUDING
+ *  ANY WARRANTY OF MERCHANTABILITY AND FITNESS FOR USE FOR A
+ *  PARTICULAR PURPOSE.
+ *  The user of the source file shall indemnify and hold
+ *  IEEE harmless from any damages or liability arising out of
+ *  the use thereof.
+ *
+ * Author: Stephen F Bush - GE Global Research
+ *                      bushsf@research.ge.com
+ *                      http://www.amazon.com/author/stephenbush
+ */
+
+/* \details Tests of the search for overlapping tube segments
+ *
+ * <pre>
+ *   getAllOverlaps3D == every pair of segments tested in closed form, for any number of threads
+ *   getOverlap3D counts the overlaps that do not fit in its outputs
+ * </pre>
+ */
+
+#include <vector>
+
+#include "ns3/test.h"
+#include "ns3/ptr.h"
+#include "ns3/object.h"
+#include "ns3/p1906-mol-motor-rng-streams.h"
+#include "ns3/p1906-mol-motor-field.h"
+
+using namespace ns3;
+
+/**
+ * \ingroup IEEE P1906 framework
+ *
+ * \brief The grid based overlap search against an exhaustive test of every pair of segments
+ */
+class P1906MOL_MOTOR_OverlapsTestCase : public TestCase
+{
+public:
+  P1906MOL_MOTOR_OverlapsTestCase ();
+
+private:
+  virtual void DoRun (void);
+  //! end points of the segment in row s of tubeMatrix
+  static void Segment (gsl_matrix * tubeMatrix, size_t s, P1906MOL_MOTOR_Vec3 & p, P1906MOL_MOTOR_Vec3 & q);
+  //! every pair of segments of tubeMatrix closer than tolerance, ordered by segment1 then segment2
+  static std::vector<P1906MOL_MOTOR_Overlap> Exhaustive (gsl_matrix * tubeMatrix, double tolerance);
+  //! check that found lists the same overlaps as expected
+  void Compare (const std::vector<P1906MOL_MOTOR_Overlap> & found, const std::vector<P1906MOL_MOTOR_Overlap> & expected, const char * what);
+};
+
+P1906MOL_MOTOR_OverlapsTestCase::P1906MOL_MOTOR_OverlapsTestCase ()
+  : TestCase ("getAllOverlaps3D finds every pair of overlapping segments")
+{
+}
+
+void
+P1906MOL_MOTOR_OverlapsTestCase::Segment (gsl_matrix * tubeMatrix, size_t s, P1906MOL_MOTOR_Vec3 & p, P1906MOL_MOTOR_Vec3 & q)
+{
+  p = vec3 (gsl_matrix_get (tubeMatrix, s, 0), gsl_matrix_get (tubeMatrix, s, 1), gsl_matrix_get (tubeMatrix, s, 2));
+  q = vec3 (gsl_matrix_get (tubeMatrix, s, 3), gsl_matrix_get (tubeMatrix, s, 4), gsl_matrix_get (tubeMatrix, s, 5));
+}
+
+std::vector<P1906MOL_MOTOR_Overlap>
+P1906MOL_MOTOR_OverlapsTestCase::Exhaustive (gsl_matrix * tubeMatrix, double tolerance)
+{
+  std::vector<P1906MOL_MOTOR_Overlap> overlaps;
+  P1906MOL_MOTOR_Vec3 p1, q1, p2, q2, c1, c2;
+
+  for (size_t i = 0; i < tubeMatrix->size1; i++)
+    {
+      Segment (tubeMatrix, i, p1, q1);
+      for (size_t j = i + 1; j < tubeMatrix->size1; j++)
+        {
+          Segment (tubeMatrix, j, p2, q2);
+          double d = vec3SegmentSegmentClosest (p1, q1, p2, q2, c1, c2);
+          if (d <= tolerance)
+            {
+              P1906MOL_MOTOR_Overlap o;
+              o.segment1 = i;
+              o.segment2 = j;
+              o.pt = (c1 + c2) * 0.5;
+              o.distance = d;
+              overlaps.push_back (o);
+            }
+        }
+    }
+  return overlaps;
+}
+
+void
+P1906MOL_MOTOR_OverlapsTestCase::Compare (const std::vector<P1906MOL_MOTOR_Overlap> & found, const std::vector<P1906MOL_MOTOR_Overlap> & expected, const char * what)
+{
+  NS_TEST_ASSERT_MSG_EQ (found.size (), expected.size (), what << ": number of overlaps");
+  for (size_t k = 0; k < found.size (); k++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (found[k].segment1, expected[k].segment1, what << ": first segment of overlap " << k);
+      NS_TEST_ASSERT_MSG_EQ (found[k].segment2, expected[k].segment2, what << ": second segment of overlap " << k);
+      //! both evaluate the same closed form on the same end points
+      NS_TEST_ASSERT_MSG_EQ (found[k].distance, expected[k].distance, what << ": distance of overlap " << k);
+      NS_TEST_ASSERT_MSG_EQ (found[k].pt.x, expected[k].pt.x, what << ": x of overlap " << k);
+      NS_TEST_ASSERT_MSG_EQ (found[k].pt.y, expected[k].pt.y, what << ": y of overlap " << k);
+      NS_TEST_ASSERT_MSG_EQ (found[k].pt.z, expected[k].pt.z, what << ": z of overlap " << k);
+    }
+}
+
+void
+P1906MOL_MOTOR_OverlapsTestCase::DoRun (void)
+{
+  //! more than one chunk of the sweep, so that threads share the segments
+  const size_t n = 700;
+  gsl_rng * r = P1906MOL_MOTOR_RngStreams::Create (0, 2, P1906MOL_MOTOR_RngStreams::TubeGeneration);
+  gsl_matrix * tubeMatrix = gsl_matrix_alloc (n, 6);
+
+  //! segments of very different lengths, a few of them of zero length
+  for (size_t s = 0; s < n; s++)
+    {
+      double length = (s % 50 == 0) ? 0 : (s % 10 == 0 ? 30 : 3);
+      for (size_t c = 0; c < 3; c++)
+        {
+          double x = 100 * gsl_rng_uniform (r);
+          gsl_matrix_set (tubeMatrix, s, c, x);
+          gsl_matrix_set (tubeMatrix, s, c + 3, x + length * (2 * gsl_rng_uniform (r) - 1));
+        }
+    }
+
+  Ptr<P1906MOL_MOTOR_Field> field = CreateObject<P1906MOL_MOTOR_Field> ();
+  //! tolerances below and well above the mean segment length
+  const double tolerances[] = { P1906MOL_MOTOR_Field::overlapTolerance, 0.5, 8 };
+  for (size_t k = 0; k < sizeof (tolerances) / sizeof (tolerances[0]); k++)
+    {
+      std::vector<P1906MOL_MOTOR_Overlap> expected = Exhaustive (tubeMatrix, tolerances[k]);
+
+      field->setOverlapThreads (0);
+      std::vector<P1906MOL_MOTOR_Overlap> serial;
+      size_t found = field->getAllOverlaps3D (tubeMatrix, tolerances[k], serial);
+      NS_TEST_ASSERT_MSG_EQ (found, expected.size (), "number of overlaps returned");
+      Compare (serial, expected, "serial");
+
+      //! results are appended after what the vector already holds
+      field->setOverlapThreads (3);
+      std::vector<P1906MOL_MOTOR_Overlap> threaded (1);
+      threaded[0].segment1 = n;
+      field->getAllOverlaps3D (tubeMatrix, tolerances[k], threaded);
+      NS_TEST_ASSERT_MSG_EQ (threaded[0].segment1, n, "the overlaps already held are kept");
+      threaded.erase (threaded.begin ());
+      Compare (threaded, expected, "3 threads");
+    }
+  NS_TEST_ASSERT_MSG_GT (Exhaustive (tubeMatrix, 0.5).size (), 0, "the network has overlaps to find");
+
+  gsl_matrix_free (tubeMatrix);
+  gsl_rng_free (r);
+}
+
+/**
+ * \ingroup IEEE P1906 framework
+ *
+ * \brief getOverlap3D fills its outputs up to their size and reports every overlap
+ */
+class P1906MOL_MOTOR_OverlapCapacityTestCase : public TestCase
+{
+public:
+  P1906MOL_MOTOR_OverlapCapacityTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+P1906MOL_MOTOR_OverlapCapacityTestCase::P1906MOL_MOTOR_OverlapCapacityTestCase ()
+  : TestCase ("getOverlap3D reports the overlaps its outputs can not hold")
+{
+}
+
+void
+P1906MOL_MOTOR_OverlapCapacityTestCase::DoRun (void)
+{
+  //! a segment along x crossed by the tube segments 0, 2 and 3, and missed by segment 1
+  const double crossings[4] = { 2, -1, 4, 6 };
+  gsl_vector * segment = gsl_vector_alloc (6);
+  gsl_matrix * tubeMatrix = gsl_matrix_alloc (4, 6);
+  gsl_vector_set_zero (segment);
+  gsl_vector_set (segment, 3, 10);
+  gsl_matrix_set_zero (tubeMatrix);
+  for (size_t s = 0; s < 4; s++)
+    {
+      double x = crossings[s] < 0 ? 5 : crossings[s];
+      double z = crossings[s] < 0 ? 5 : 0;
+      gsl_matrix_set (tubeMatrix, s, 0, x);
+      gsl_matrix_set (tubeMatrix, s, 1, -1);
+      gsl_matrix_set (tubeMatrix, s, 2, z);
+      gsl_matrix_set (tubeMatrix, s, 3, x);
+      gsl_matrix_set (tubeMatrix, s, 4, 1);
+      gsl_matrix_set (tubeMatrix, s, 5, z);
+    }
+
+  Ptr<P1906MOL_MOTOR_Field> field = CreateObject<P1906MOL_MOTOR_Field> ();
+  const size_t expected[3] = { 0, 2, 3 };
+  const size_t capacities[2] = { 2, 4 };
+  for (size_t k = 0; k < 2; k++)
+    {
+      gsl_matrix * pts = gsl_matrix_alloc (capacities[k], 3);
+      gsl_vector * tubeSegments = gsl_vector_alloc (capacities[k]);
+      int numPts = field->getOverlap3D (segment, tubeMatrix, pts, tubeSegments);
+
+      NS_TEST_ASSERT_MSG_EQ (numPts, 3, "every overlap is counted, capacity " << capacities[k]);
+      for (size_t i = 0; i < 3 && i < capacities[k]; i++)
+        {
+          size_t s = expected[i];
+          NS_TEST_ASSERT_MSG_EQ ((size_t) gsl_vector_get (tubeSegments, i), s, "segment of overlap " << i << ", capacity " << capacities[k]);
+          NS_TEST_ASSERT_MSG_EQ_TOL (gsl_matrix_get (pts, i, 0), crossings[s], 1e-12, "x of overlap " << i << ", capacity " << capacities[k]);
+          NS_TEST_ASSERT_MSG_EQ_TOL (gsl_matrix_get (pts, i, 1), 0, 1e-12, "y of overlap " << i << ", capacity " << capacities[k]);
+        }
+      gsl_vector_free (tubeSegments);
+      gsl_matrix_free (pts);
+    }
+
+  gsl_matrix_free (tubeMatrix);
+  gsl_vector_free (segment);
+}
+
+/**
+ * \ingroup IEEE P1906 framework
+ *
+ * \brief The tube overlap test suite
+ */
+class P1906MOL_MOTOR_OverlapsTestSuite : public TestSuite
+{
+public:
+  P1906MOL_MOTOR_OverlapsTestSuite ();
+};
+
+P1906MOL_MOTOR_OverlapsTestSuite::P1906MOL_MOTOR_OverlapsTestSuite ()
+  : TestSuite ("p1906-mol-motor-overlaps", UNIT)
+{
+  AddTestCase (new P1906MOL_MOTOR_OverlapsTestCase, TestCase::QUICK);
+  AddTestCase (new P1906MOL_MOTOR_OverlapCapacityTestCase, TestCase::QUICK);
+}
+
+//! registers the suite with the test runner
+static P1906MOL_MOTOR_OverlapsTestSuite g_p1906MolMotorOverlapsTestSuite;
@@ -0,0 +1,179 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *  Copyright � 2015 by IEEE.
+ *
+ *  This source file is an essential part of IEEE Std 1906.1,
+ *  Recommended Practice for Nanoscale and Molecular
+ *  Communication Framework.
+ *  Verbatim copies of this source file may be used and
+ *  distributed without restriction. Modifications to this source
+ *  file as permitted in IEEE Std 1906.1 may also be made and
+ *  distributed. All other uses require permission from the IEEE
+ *  Standards Department (stds-ipr@ieee.org). All other rights
+ *  reserved.
+ *
+ *  This source file is provided on an AS IS basis.
+ *  The IEEE disclaims ANY WARRANTY EXPRESS OR IMPLIED INCLUDING
+ *  ANY WARRANTY OF MERCHANTABILITY AND FITNESS FOR USE FOR A
+ *  PARTICULAR PURPOSE.
+ *  The user of the source file shall indemnify and hold
+ *  IEEE harmless from any damages or liability arising out of
+ *  the use thereof.
+ *
+ * Author: Stephen F Bush - GE Global Research
+ *                      bushsf@research.ge.com
+ *                      http://www.amazon.com/author/stephenbush
+ */
+
+/* \details Tests of the counter based random number streams
+ *
+ * <pre>
+ *   Philox4x32-10 known answer, stream reproducibility, stream independence, Gaussians
+ * </pre>
+ */
+
+#include <cmath>
+#include <vector>
+
+#include "ns3/test.h"
+#include "ns3/p1906-mol-motor-rng-streams.h"
+
+using namespace ns3;
+
+/**
+ * \ingroup IEEE P1906 framework
+ *
+ * \brief Known answer of the generator and reproducibility of the streams
+ */
+class P1906MOL_MOTOR_RngStreamsTestCase : public TestCase
+{
+public:
+  P1906MOL_MOTOR_RngStreamsTestCase ();
+
+private:
+  virtual void DoRun (void);
+  //! the first n words of stream (node, id, purpose)
+  static std::vector<unsigned long> Draw (uint32_t node, uint32_t id, P1906MOL_MOTOR_RngStreams::Purpose purpose, size_t n);
+};
+
+P1906MOL_MOTOR_RngStreamsTestCase::P1906MOL_MOTOR_RngStreamsTestCase ()
+  : TestCase ("Philox4x32-10 streams are exact, reproducible and distinct")
+{
+}
+
+std::vector<unsigned long>
+P1906MOL_MOTOR_RngStreamsTestCase::Draw (uint32_t node, uint32_t id, P1906MOL_MOTOR_RngStreams::Purpose purpose, size_t n)
+{
+  gsl_rng * r = P1906MOL_MOTOR_RngStreams::Create (node, id, purpose);
+  std::vector<unsigned long> words;
+
+  for (size_t i = 0; i < n; i++)
+    {
+      words.push_back (gsl_rng_get (r));
+    }
+  gsl_rng_free (r);
+  return words;
+}
+
+void
+P1906MOL_MOTOR_RngStreamsTestCase::DoRun (void)
+{
+  //! key 0, counter 0: the known answer of Random123 for Philox4x32-10
+  gsl_rng * r = gsl_rng_alloc (P1906MOL_MOTOR_RngStreams::GetType ());
+  gsl_rng_set (r, 0);
+  const unsigned long known[4] = { 0x6627e8d5UL, 0xe169c58dUL, 0xbc57ac4cUL, 0x9b00dbd8UL };
+  for (int i = 0; i < 4; i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (gsl_rng_get (r), known[i], "Philox4x32-10 known answer, word " << i);
+    }
+
+  //! Select goes back to the start of a stream, whatever was drawn before
+  P1906MOL_MOTOR_RngStreams::Select (r, 7, 3, P1906MOL_MOTOR_RngStreams::MotorMotion);
+  std::vector<unsigned long> selected;
+  for (int i = 0; i < 10; i++)
+    {
+      selected.push_back (gsl_rng_get (r));
+    }
+  gsl_rng_free (r);
+
+  std::vector<unsigned long> a = Draw (7, 3, P1906MOL_MOTOR_RngStreams::MotorMotion, 10);
+  std::vector<unsigned long> b = Draw (7, 3, P1906MOL_MOTOR_RngStreams::MotorMotion, 10);
+  NS_TEST_ASSERT_MSG_EQ ((a == b), true, "the same stream gives the same words");
+  NS_TEST_ASSERT_MSG_EQ ((a == selected), true, "Select and Create start the same stream");
+
+  //! any change of node, id or purpose gives another stream
+  NS_TEST_ASSERT_MSG_EQ ((a == Draw (8, 3, P1906MOL_MOTOR_RngStreams::MotorMotion, 10)), false, "streams of different nodes differ");
+  NS_TEST_ASSERT_MSG_EQ ((a == Draw (7, 4, P1906MOL_MOTOR_RngStreams::MotorMotion, 10)), false, "streams of different ids differ");
+  NS_TEST_ASSERT_MSG_EQ ((a == Draw (7, 3, P1906MOL_MOTOR_RngStreams::TubeGeneration, 10)), false, "streams of different purposes differ");
+
+  //! ids are handed out in order
+  uint32_t id = P1906MOL_MOTOR_RngStreams::NextId (P1906MOL_MOTOR_RngStreams::Ensemble);
+  NS_TEST_ASSERT_MSG_EQ (P1906MOL_MOTOR_RngStreams::NextId (P1906MOL_MOTOR_RngStreams::Ensemble), id + 1, "NextId counts up");
+}
+
+/**
+ * \ingroup IEEE P1906 framework
+ *
+ * \brief Moments of the Gaussian variates drawn from a stream
+ */
+class P1906MOL_MOTOR_RngStreamsGaussiansTestCase : public TestCase
+{
+public:
+  P1906MOL_MOTOR_RngStreamsGaussiansTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+P1906MOL_MOTOR_RngStreamsGaussiansTestCase::P1906MOL_MOTOR_RngStreamsGaussiansTestCase ()
+  : TestCase ("Gaussians have the requested mean and standard deviation")
+{
+}
+
+void
+P1906MOL_MOTOR_RngStreamsGaussiansTestCase::DoRun (void)
+{
+  const size_t n = 100001;
+  const double sigma = 2.5;
+  std::vector<double> g (n);
+  gsl_rng * r = P1906MOL_MOTOR_RngStreams::Create (1, 1, P1906MOL_MOTOR_RngStreams::FieldGeneration);
+
+  //! an odd count fills the last value from half a pair
+  P1906MOL_MOTOR_RngStreams::Gaussians (r, sigma, &g[0], n);
+  gsl_rng_free (r);
+
+  double sum = 0;
+  double sum2 = 0;
+  for (size_t i = 0; i < n; i++)
+    {
+      sum += g[i];
+      sum2 += g[i] * g[i];
+    }
+  double mean = sum / n;
+  double sd = std::sqrt (sum2 / n - mean * mean);
+
+  //! about 5 standard errors
+  NS_TEST_ASSERT_MSG_EQ_TOL (mean, 0, 5 * sigma / std::sqrt ((double) n), "mean of the Gaussians");
+  NS_TEST_ASSERT_MSG_EQ_TOL (sd, sigma, 5 * sigma / std::sqrt (2.0 * n), "standard deviation of the Gaussians");
+}
+
+/**
+ * \ingroup IEEE P1906 framework
+ *
+ * \brief The P1906MOL_MOTOR_RngStreams test suite
+ */
+class P1906MOL_MOTOR_RngStreamsTestSuite : public TestSuite
+{
+public:
+  P1906MOL_MOTOR_RngStreamsTestSuite ();
+};
+
+P1906MOL_MOTOR_RngStreamsTestSuite::P1906MOL_MOTOR_RngStreamsTestSuite ()
+  : TestSuite ("p1906-mol-motor-rng-streams", UNIT)
+{
+  AddTestCase (new P1906MOL_MOTOR_RngStreamsTestCase, TestCase::QUICK);
+  AddTestCase (new P1906MOL_MOTOR_RngStreamsGaussiansTestCase, TestCase::QUICK);
+}
+
+//! registers the suite with the test runner
+static P1906MOL_MOTOR_RngStreamsTestSuite g_p1906MolMotorRngStreamsTestSuite;
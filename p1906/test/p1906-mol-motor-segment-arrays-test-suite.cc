@@ -0,0 +1,172 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *  Copyright � 2015 by IEEE.
+ *
+ *  This source file is an essential part of IEEE Std 1906.1,
+ *  Recommended Practice for Nanoscale and Molecular
+ *  Communication Framework.
+ *  Verbatim copies of this source file may be used and
+ *  distributed without restriction. Modifications to this source
+ *  file as permitted in IEEE Std 1906.1 may also be made and
+ *  distributed. All other uses require permission from the IEEE
+ *  Standards Department (stds-ipr@ieee.org). All other rights
+ *  reserved.
+ *
+ *  This source file is provided on an AS IS basis.
+ *  The IEEE disclaims ANY WARRANTY EXPRESS OR IMPLIED INCLUDING
+ *  ANY WARRANTY OF MERCHANTABILITY AND FITNESS FOR USE FOR A
+ *  PARTICULAR PURPOSE.
+ *  The user of the source file shall indemnify and hold
+ *  IEEE harmless from any damages or liability arising out of
+ *  the use thereof.
+ *
+ * Author: Stephen F Bush - GE Global Research
+ *                      bushsf@research.ge.com
+ *                      http://www.amazon.com/author/stephenbush
+ */
+
+/* \details Tests of the batched point to segment distance kernel
+ *
+ * <pre>
+ *   P1906MOL_MOTOR_SegmentArrays::distance2 == vec3SegmentDistance2, for every range and lane width
+ * </pre>
+ */
+
+#include <cmath>
+#include <vector>
+
+#include "ns3/test.h"
+#include "ns3/p1906-mol-motor-rng-streams.h"
+#include "ns3/p1906-mol-motor-segment-arrays.h"
+
+using namespace ns3;
+
+/**
+ * \ingroup IEEE P1906 framework
+ *
+ * \brief The batched kernel against the scalar distance of each segment
+ */
+class P1906MOL_MOTOR_SegmentArraysTestCase : public TestCase
+{
+public:
+  P1906MOL_MOTOR_SegmentArraysTestCase ();
+
+private:
+  virtual void DoRun (void);
+  //! a point uniformly drawn in [-size, size]^3
+  static P1906MOL_MOTOR_Vec3 Draw (gsl_rng * r, double size);
+};
+
+P1906MOL_MOTOR_SegmentArraysTestCase::P1906MOL_MOTOR_SegmentArraysTestCase ()
+  : TestCase ("segment arrays distances equal the scalar segment distances")
+{
+}
+
+P1906MOL_MOTOR_Vec3
+P1906MOL_MOTOR_SegmentArraysTestCase::Draw (gsl_rng * r, double size)
+{
+  double x = (2 * gsl_rng_uniform (r) - 1) * size;
+  double y = (2 * gsl_rng_uniform (r) - 1) * size;
+  double z = (2 * gsl_rng_uniform (r) - 1) * size;
+  return vec3 (x, y, z);
+}
+
+void
+P1906MOL_MOTOR_SegmentArraysTestCase::DoRun (void)
+{
+  //! not a multiple of the lanes, so that every kernel has a remainder
+  const size_t n = 8 * P1906MOL_MOTOR_SegmentArrays::lanes + 5;
+  gsl_rng * r = P1906MOL_MOTOR_RngStreams::Create (0, 0, P1906MOL_MOTOR_RngStreams::TubeGeneration);
+  gsl_matrix * tubeMatrix = gsl_matrix_alloc (n, 6);
+  std::vector<P1906MOL_MOTOR_Vec3> p1 (n), p2 (n);
+
+  for (size_t i = 0; i < n; i++)
+    {
+      p1[i] = Draw (r, 100);
+      //! every seventh segment has zero length
+      p2[i] = (i % 7 == 3) ? p1[i] : p1[i] + Draw (r, 10);
+      gsl_matrix_set (tubeMatrix, i, 0, p1[i].x);
+      gsl_matrix_set (tubeMatrix, i, 1, p1[i].y);
+      gsl_matrix_set (tubeMatrix, i, 2, p1[i].z);
+      gsl_matrix_set (tubeMatrix, i, 3, p2[i].x);
+      gsl_matrix_set (tubeMatrix, i, 4, p2[i].y);
+      gsl_matrix_set (tubeMatrix, i, 5, p2[i].z);
+    }
+
+  P1906MOL_MOTOR_SegmentArrays arrays;
+  arrays.assign (tubeMatrix);
+  NS_TEST_ASSERT_MSG_EQ (arrays.size (), n, "one entry per row of the tube matrix");
+
+  //! ranges starting and ending inside a batch, a single segment and the whole matrix
+  const size_t ranges[][2] = { { 0, n }, { 1, n - 1 }, { 3, 4 }, { 5, 21 }, { 8, 16 }, { n - 3, n } };
+  std::vector<double> d2 (n);
+  for (int q = 0; q < 50; q++)
+    {
+      //! points near the segments as well as far from them
+      P1906MOL_MOTOR_Vec3 pt = Draw (r, q % 2 ? 20 : 200);
+      for (size_t k = 0; k < sizeof (ranges) / sizeof (ranges[0]); k++)
+        {
+          size_t begin = ranges[k][0];
+          size_t end = ranges[k][1];
+          arrays.distance2 (pt, begin, end, &d2[0]);
+          for (size_t i = begin; i < end; i++)
+            {
+              double expected = vec3SegmentDistance2 (pt, p1[i], p2[i]);
+              //! equal bit for bit unless the build contracts the arithmetic into fused multiply-adds
+              NS_TEST_ASSERT_MSG_EQ_TOL (d2[i - begin], expected, 1e-12 * expected, "distance to segment " << i << " in range [" << begin << ", " << end << ")");
+            }
+        }
+    }
+
+  //! a partial matrix holds its rows from first on
+  P1906MOL_MOTOR_SegmentArrays part;
+  part.assign (tubeMatrix, 10, 7);
+  NS_TEST_ASSERT_MSG_EQ (part.size (), 7, "count entries");
+  P1906MOL_MOTOR_Vec3 pt = Draw (r, 50);
+  part.distance2 (pt, 0, 7, &d2[0]);
+  for (size_t i = 0; i < 7; i++)
+    {
+      double expected = vec3SegmentDistance2 (pt, p1[10 + i], p2[10 + i]);
+      NS_TEST_ASSERT_MSG_EQ_TOL (d2[i], expected, 1e-12 * expected, "distance to row " << 10 + i);
+    }
+
+  //! padding is never the nearest segment
+  P1906MOL_MOTOR_SegmentArrays padded;
+  padded.resize (P1906MOL_MOTOR_SegmentArrays::lanes);
+  padded.set (2, p1[0], p2[0]);
+  padded.distance2 (p1[0], 0, P1906MOL_MOTOR_SegmentArrays::lanes, &d2[0]);
+  for (size_t i = 0; i < P1906MOL_MOTOR_SegmentArrays::lanes; i++)
+    {
+      if (i == 2)
+        {
+          NS_TEST_ASSERT_MSG_EQ (d2[i], 0, "distance to an end point of the segment");
+        }
+      else
+        {
+          NS_TEST_ASSERT_MSG_EQ (std::isinf (d2[i]), true, "padding entry " << i << " is at infinite distance");
+        }
+    }
+
+  gsl_matrix_free (tubeMatrix);
+  gsl_rng_free (r);
+}
+
+/**
+ * \ingroup IEEE P1906 framework
+ *
+ * \brief The P1906MOL_MOTOR_SegmentArrays test suite
+ */
+class P1906MOL_MOTOR_SegmentArraysTestSuite : public TestSuite
+{
+public:
+  P1906MOL_MOTOR_SegmentArraysTestSuite ();
+};
+
+P1906MOL_MOTOR_SegmentArraysTestSuite::P1906MOL_MOTOR_SegmentArraysTestSuite ()
+  : TestSuite ("p1906-mol-motor-segment-arrays", UNIT)
+{
+  AddTestCase (new P1906MOL_MOTOR_SegmentArraysTestCase, TestCase::QUICK);
+}
+
+//! registers the suite with the test runner
+static P1906MOL_MOTOR_SegmentArraysTestSuite g_p1906MolMotorSegmentArraysTestSuite;
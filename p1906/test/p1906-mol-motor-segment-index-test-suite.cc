@@ -0,0 +1,212 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *  Copyright � 2015 by IEEE.
+ *
+ *  This source file is an essential part of IEEE Std 1906.1,
+ *  Recommended Practice for Nanoscale and Molecular
+ *  Communication Framework.
+ *  Verbatim copies of this source file may be used and
+ *  distributed without restriction. Modifications to this source
+ *  file as permitted in IEEE Std 1906.1 may also be made and
+ *  distributed. All other uses require permission from the IEEE
+ *  Standards Department (stds-ipr@ieee.org). All other rights
+ *  reserved.
+ *
+ *  This source file is provided on an AS IS basis.
+ *  The IEEE disclaims ANY WARRANTY EXPRESS OR IMPLIED INCLUDING
+ *  ANY WARRANTY OF MERCHANTABILITY AND FITNESS FOR USE FOR A
+ *  PARTICULAR PURPOSE.
+ *  The user of the source file shall indemnify and hold
+ *  IEEE harmless from any damages or liability arising out of
+ *  the use thereof.
+ *
+ * Author: Stephen F Bush - GE Global Research
+ *                      bushsf@research.ge.com
+ *                      http://www.amazon.com/author/stephenbush
+ */
+
+/* \details Tests of the uniform grid over the segments of a tube network
+ *
+ * <pre>
+ *   nearestSegment, nearestStart == exhaustive search over every segment
+ *   the linear findNearestTube, used without an index, == the same exhaustive search
+ * </pre>
+ */
+
+#include <cmath>
+#include <vector>
+
+#include "ns3/test.h"
+#include "ns3/p1906-mol-motor-rng-streams.h"
+#include "ns3/p1906-mol-motor-segment-index.h"
+#include "ns3/p1906-mol-motor-field.h"
+
+using namespace ns3;
+
+/**
+ * \ingroup IEEE P1906 framework
+ *
+ * \brief The nearest segment and the nearest start found through the grid against an exhaustive search
+ */
+class P1906MOL_MOTOR_SegmentIndexTestCase : public TestCase
+{
+public:
+  P1906MOL_MOTOR_SegmentIndexTestCase ();
+
+private:
+  virtual void DoRun (void);
+  //! a point uniformly drawn in [-size, size]^3
+  static P1906MOL_MOTOR_Vec3 Draw (gsl_rng * r, double size);
+  //! squared distance from pt to the segment in row s of tubeMatrix
+  static double Distance2 (const P1906MOL_MOTOR_Vec3 & pt, gsl_matrix * tubeMatrix, size_t s);
+  //! check nearestSegment and nearestStart of index, and the linear findNearestTube, against every row of tubeMatrix
+  void Check (const P1906MOL_MOTOR_SegmentIndex & index, gsl_matrix * tubeMatrix, const P1906MOL_MOTOR_Vec3 & pt, double radius);
+};
+
+P1906MOL_MOTOR_SegmentIndexTestCase::P1906MOL_MOTOR_SegmentIndexTestCase ()
+  : TestCase ("segment index queries agree with an exhaustive search")
+{
+}
+
+P1906MOL_MOTOR_Vec3
+P1906MOL_MOTOR_SegmentIndexTestCase::Draw (gsl_rng * r, double size)
+{
+  double x = (2 * gsl_rng_uniform (r) - 1) * size;
+  double y = (2 * gsl_rng_uniform (r) - 1) * size;
+  double z = (2 * gsl_rng_uniform (r) - 1) * size;
+  return vec3 (x, y, z);
+}
+
+double
+P1906MOL_MOTOR_SegmentIndexTestCase::Distance2 (const P1906MOL_MOTOR_Vec3 & pt, gsl_matrix * tubeMatrix, size_t s)
+{
+  P1906MOL_MOTOR_Vec3 p1 = vec3 (gsl_matrix_get (tubeMatrix, s, 0), gsl_matrix_get (tubeMatrix, s, 1), gsl_matrix_get (tubeMatrix, s, 2));
+  P1906MOL_MOTOR_Vec3 p2 = vec3 (gsl_matrix_get (tubeMatrix, s, 3), gsl_matrix_get (tubeMatrix, s, 4), gsl_matrix_get (tubeMatrix, s, 5));
+  return vec3SegmentDistance2 (pt, p1, p2);
+}
+
+void
+P1906MOL_MOTOR_SegmentIndexTestCase::Check (const P1906MOL_MOTOR_SegmentIndex & index, gsl_matrix * tubeMatrix, const P1906MOL_MOTOR_Vec3 & pt, double radius)
+{
+  size_t nearest = (size_t) -1;
+  double nearest2 = radius * radius;
+  size_t start = (size_t) -1;
+  double startDistance = 0;
+
+  for (size_t s = 0; s < tubeMatrix->size1; s++)
+    {
+      double d2 = Distance2 (pt, tubeMatrix, s);
+      if (d2 <= nearest2 && (nearest == (size_t) -1 || d2 < nearest2))
+        {
+          nearest = s;
+          nearest2 = d2;
+        }
+      P1906MOL_MOTOR_Vec3 p1 = vec3 (gsl_matrix_get (tubeMatrix, s, 0), gsl_matrix_get (tubeMatrix, s, 1), gsl_matrix_get (tubeMatrix, s, 2));
+      double d = vec3Norm (pt - p1);
+      if (start == (size_t) -1 || d < startDistance)
+        {
+          start = s;
+          startDistance = d;
+        }
+    }
+
+  //! ties between segments are broken differently by a few ulps under fused multiply-adds: compare the distances
+  size_t found = index.nearestSegment (pt, radius);
+  NS_TEST_ASSERT_MSG_EQ ((found == (size_t) -1), (nearest == (size_t) -1), "a segment within " << radius << " is found exactly when one exists");
+  if (found != (size_t) -1 && nearest != (size_t) -1)
+    {
+      NS_TEST_ASSERT_MSG_EQ_TOL (Distance2 (pt, tubeMatrix, found), nearest2, 1e-12 * nearest2, "distance to the nearest segment within " << radius);
+    }
+
+  found = P1906MOL_MOTOR_Field::findNearestTube (pt, tubeMatrix, radius);
+  NS_TEST_ASSERT_MSG_EQ ((found == (size_t) -1), (nearest == (size_t) -1), "the linear search finds a segment within " << radius << " exactly when one exists");
+  if (found != (size_t) -1 && nearest != (size_t) -1)
+    {
+      NS_TEST_ASSERT_MSG_EQ_TOL (Distance2 (pt, tubeMatrix, found), nearest2, 1e-12 * nearest2, "distance to the nearest segment within " << radius << " by the linear search");
+    }
+
+  found = index.nearestStart (pt);
+  NS_TEST_ASSERT_MSG_EQ ((found == (size_t) -1), false, "a nearest start always exists");
+  P1906MOL_MOTOR_Vec3 p1 = vec3 (gsl_matrix_get (tubeMatrix, found, 0), gsl_matrix_get (tubeMatrix, found, 1), gsl_matrix_get (tubeMatrix, found, 2));
+  NS_TEST_ASSERT_MSG_EQ_TOL (vec3Norm (pt - p1), startDistance, 1e-12 * startDistance, "distance to the nearest start");
+}
+
+void
+P1906MOL_MOTOR_SegmentIndexTestCase::DoRun (void)
+{
+  const size_t n = 400;
+  const double cellSize = 5;
+  gsl_rng * r = P1906MOL_MOTOR_RngStreams::Create (0, 1, P1906MOL_MOTOR_RngStreams::TubeGeneration);
+  gsl_matrix * tubeMatrix = gsl_matrix_alloc (n, 6);
+
+  //! segments longer than the cells, so that most of them span several cells
+  for (size_t s = 0; s < n; s++)
+    {
+      P1906MOL_MOTOR_Vec3 p1 = Draw (r, 50);
+      P1906MOL_MOTOR_Vec3 p2 = p1 + Draw (r, 12);
+      gsl_matrix_set (tubeMatrix, s, 0, p1.x);
+      gsl_matrix_set (tubeMatrix, s, 1, p1.y);
+      gsl_matrix_set (tubeMatrix, s, 2, p1.z);
+      gsl_matrix_set (tubeMatrix, s, 3, p2.x);
+      gsl_matrix_set (tubeMatrix, s, 4, p2.y);
+      gsl_matrix_set (tubeMatrix, s, 5, p2.z);
+    }
+
+  P1906MOL_MOTOR_SegmentIndex index;
+  NS_TEST_ASSERT_MSG_EQ ((index.nearestSegment (vec3 (0, 0, 0), 10) == (size_t) -1), true, "nothing is found in an empty index");
+  index.build (tubeMatrix, cellSize);
+  NS_TEST_ASSERT_MSG_EQ (index.size (), n, "one segment per row of the tube matrix");
+
+  //! radii below, at and above the cell edge, and points inside as well as outside the network
+  const double radii[] = { 0.5, cellSize, 3 * cellSize };
+  for (int q = 0; q < 200; q++)
+    {
+      P1906MOL_MOTOR_Vec3 pt = Draw (r, q % 4 ? 55 : 90);
+      for (size_t k = 0; k < sizeof (radii) / sizeof (radii[0]); k++)
+        {
+          Check (index, tubeMatrix, pt, radii[k]);
+        }
+    }
+
+  //! a point on a segment is at distance 0 from it
+  P1906MOL_MOTOR_Vec3 mid = (index.getStart (17) + index.getEnd (17)) * 0.5;
+  size_t found = index.nearestSegment (mid, 0.5);
+  NS_TEST_ASSERT_MSG_EQ_TOL (Distance2 (mid, tubeMatrix, found), 0, 1e-20, "a point on a segment");
+
+  //! after the tubes move, refit follows the new matrix
+  for (size_t s = 0; s < n; s++)
+    {
+      for (size_t c = 0; c < 6; c++)
+        {
+          gsl_matrix_set (tubeMatrix, s, c, 0.5 * gsl_matrix_get (tubeMatrix, s, c) + 10);
+        }
+    }
+  index.refit (tubeMatrix);
+  for (int q = 0; q < 100; q++)
+    {
+      Check (index, tubeMatrix, Draw (r, 40) + vec3 (10, 10, 10), cellSize);
+    }
+
+  gsl_matrix_free (tubeMatrix);
+  gsl_rng_free (r);
+}
+
+/**
+ * \ingroup IEEE P1906 framework
+ *
+ * \brief The P1906MOL_MOTOR_SegmentIndex test suite
+ */
+class P1906MOL_MOTOR_SegmentIndexTestSuite : public TestSuite
+{
+public:
+  P1906MOL_MOTOR_SegmentIndexTestSuite ();
+};
+
+P1906MOL_MOTOR_SegmentIndexTestSuite::P1906MOL_MOTOR_SegmentIndexTestSuite ()
+  : TestSuite ("p1906-mol-motor-segment-index", UNIT)
+{
+  AddTestCase (new P1906MOL_MOTOR_SegmentIndexTestCase, TestCase::QUICK);
+}
+
+//! registers the suite with the test runner
+static P1906MOL_MOTOR_SegmentIndexTestSuite g_p1906MolMotorSegmentIndexTestSuite;
@@ -0,0 +1,237 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *  Copyright � 2015 by IEEE.
+ *
+ *  This source file is an essential part of IEEE Std 1906.1,
+ *  Recommended Practice for Nanoscale and Molecular
+ *  Communication Framework.
+ *  Verbatim copies of this source file may be used and
+ *  distributed without restriction. Modifications to this source
+ *  file as permitted in IEEE Std 1906.1 may also be made and
+ *  distributed. All other uses require permission from the IEEE
+ *  Standards Department (stds-ipr@ieee.org). All other rights
+ *  reserved.
+ *
+ *  This source file is provided on an AS IS basis.
+ *  The IEEE disclaims ANY WARRANTY EXPRESS OR IMPLIED INCLUDING
+ *  ANY WARRANTY OF MERCHANTABILITY AND FITNESS FOR USE FOR A
+ *  PARTICULAR PURPOSE.
+ *  The user of the source file shall indemnify and hold
+ *  IEEE harmless from any damages or liability arising out of
+ *  the use thereof.
+ *
+ * Author: Stephen F Bush - GE Global Research
+ *                      bushsf@research.ge.com
+ *                      http://www.amazon.com/author/stephenbush
+ */
+
+/* \details Tests of the binary trace files
+ *
+ * <pre>
+ *   TraceWriter -> file -> TraceReader == the chunks written; a file cut short keeps its complete chunks
+ * </pre>
+ */
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "ns3/test.h"
+#include "ns3/p1906-mol-motor-trace.h"
+
+using namespace ns3;
+
+/**
+ * \ingroup IEEE P1906 framework
+ *
+ * \brief Chunks read back from a trace file, whole and cut short
+ */
+class P1906MOL_MOTOR_TraceTestCase : public TestCase
+{
+public:
+  P1906MOL_MOTOR_TraceTestCase ();
+
+private:
+  virtual void DoRun (void);
+  //! the bytes of fileName
+  static std::vector<char> ReadFile (const std::string & fileName);
+  //! write the first size bytes of data to fileName
+  static void WriteFile (const std::string & fileName, const std::vector<char> & data, size_t size);
+};
+
+P1906MOL_MOTOR_TraceTestCase::P1906MOL_MOTOR_TraceTestCase ()
+  : TestCase ("trace chunks survive a write and read round trip")
+{
+}
+
+std::vector<char>
+P1906MOL_MOTOR_TraceTestCase::ReadFile (const std::string & fileName)
+{
+  std::vector<char> data;
+  FILE * file = fopen (fileName.c_str (), "rb");
+  if (file)
+    {
+      char buffer[4096];
+      size_t n;
+      while ((n = fread (buffer, 1, sizeof (buffer), file)) > 0)
+        {
+          data.insert (data.end (), buffer, buffer + n);
+        }
+      fclose (file);
+    }
+  return data;
+}
+
+void
+P1906MOL_MOTOR_TraceTestCase::WriteFile (const std::string & fileName, const std::vector<char> & data, size_t size)
+{
+  FILE * file = fopen (fileName.c_str (), "wb");
+  if (file)
+    {
+      fwrite (&data[0], 1, size, file);
+      fclose (file);
+    }
+}
+
+void
+P1906MOL_MOTOR_TraceTestCase::DoRun (void)
+{
+  std::string fileName = CreateTempDirFilename ("p1906-mol-motor-trace.bin");
+  Ptr<P1906MOL_MOTOR_TraceWriter> writer = P1906MOL_MOTOR_TraceWriter::Get (fileName);
+  NS_TEST_ASSERT_MSG_EQ ((writer != 0), true, "the trace file is created");
+  NS_TEST_ASSERT_MSG_EQ ((P1906MOL_MOTOR_TraceWriter::Get (fileName) == writer), true, "one writer per file name");
+
+  //! a trajectory written from separate columns
+  const uint64_t steps = 37;
+  std::vector<double> t (steps), x (steps), y (steps), z (steps);
+  for (uint64_t i = 0; i < steps; i++)
+    {
+      t[i] = 0.5 * i;
+      x[i] = i * 1.25;
+      y[i] = -1.0 / (i + 1);
+      z[i] = 1e-9 * i * i;
+    }
+  std::vector<const double *> columns;
+  columns.push_back (&t[0]);
+  columns.push_back (&x[0]);
+  columns.push_back (&y[0]);
+  columns.push_back (&z[0]);
+  bool written = writer->write (P1906MOL_MOTOR_Trace::Trajectory, P1906MOL_MOTOR_Trace::Default, 42, "motor42.txt", columns, steps);
+  NS_TEST_ASSERT_MSG_EQ (written, true, "write the trajectory");
+
+  //! a series from a matrix, with its axis labels
+  gsl_matrix * series = gsl_matrix_alloc (5, 2);
+  for (size_t i = 0; i < 5; i++)
+    {
+      gsl_matrix_set (series, i, 0, i);
+      gsl_matrix_set (series, i, 1, 10.0 * i + 0.125);
+    }
+  written = writer->write (P1906MOL_MOTOR_Trace::Series, P1906MOL_MOTOR_Trace::MATLABRows, 0, "s.txt\nx\ny", series);
+  NS_TEST_ASSERT_MSG_EQ (written, true, "write the series");
+
+  //! an empty chunk
+  std::vector<const double *> none;
+  written = writer->write (P1906MOL_MOTOR_Trace::Points, P1906MOL_MOTOR_Trace::Default, 0, "", none, 0);
+  NS_TEST_ASSERT_MSG_EQ (written, true, "write an empty chunk");
+  writer->flush ();
+
+  Ptr<P1906MOL_MOTOR_TraceReader> reader = P1906MOL_MOTOR_TraceReader::Load (fileName);
+  NS_TEST_ASSERT_MSG_EQ ((reader != 0), true, "the trace file is read");
+  NS_TEST_ASSERT_MSG_EQ (reader->isTruncated (), false, "a flushed file is complete");
+  NS_TEST_ASSERT_MSG_EQ (reader->getNumChunks (), 3, "every chunk is read");
+
+  const P1906MOL_MOTOR_TraceReader::Chunk & trajectory = reader->getChunk (0);
+  NS_TEST_ASSERT_MSG_EQ (trajectory.kind, (uint32_t) P1906MOL_MOTOR_Trace::Trajectory, "kind of the trajectory");
+  NS_TEST_ASSERT_MSG_EQ (trajectory.style, (uint32_t) P1906MOL_MOTOR_Trace::Default, "style of the trajectory");
+  NS_TEST_ASSERT_MSG_EQ (trajectory.tag, 42, "tag of the trajectory");
+  NS_TEST_ASSERT_MSG_EQ (trajectory.labels.size (), 1, "labels of the trajectory");
+  NS_TEST_ASSERT_MSG_EQ (trajectory.labels[0], "motor42.txt", "label of the trajectory");
+  NS_TEST_ASSERT_MSG_EQ (trajectory.columns, 4, "columns of the trajectory");
+  NS_TEST_ASSERT_MSG_EQ (trajectory.rows, steps, "rows of the trajectory");
+  for (uint64_t i = 0; i < steps; i++)
+    {
+      //! the doubles are stored as they are, so they come back bit for bit
+      NS_TEST_ASSERT_MSG_EQ (trajectory.get (i, 0), t[i], "t of row " << i);
+      NS_TEST_ASSERT_MSG_EQ (trajectory.get (i, 1), x[i], "x of row " << i);
+      NS_TEST_ASSERT_MSG_EQ (trajectory.get (i, 2), y[i], "y of row " << i);
+      NS_TEST_ASSERT_MSG_EQ (trajectory.column (3)[i], z[i], "z of row " << i);
+    }
+
+  const P1906MOL_MOTOR_TraceReader::Chunk & s = reader->getChunk (1);
+  NS_TEST_ASSERT_MSG_EQ (s.kind, (uint32_t) P1906MOL_MOTOR_Trace::Series, "kind of the series");
+  NS_TEST_ASSERT_MSG_EQ (s.style, (uint32_t) P1906MOL_MOTOR_Trace::MATLABRows, "style of the series");
+  NS_TEST_ASSERT_MSG_EQ (s.labels.size (), 3, "name and axis labels of the series");
+  NS_TEST_ASSERT_MSG_EQ (s.labels[0], "s.txt", "name of the series");
+  NS_TEST_ASSERT_MSG_EQ (s.labels[1], "x", "x axis label");
+  NS_TEST_ASSERT_MSG_EQ (s.labels[2], "y", "y axis label");
+  gsl_matrix * m = P1906MOL_MOTOR_TraceReader::toMatrix (s);
+  NS_TEST_ASSERT_MSG_EQ ((m != 0), true, "the series is copied into a matrix");
+  NS_TEST_ASSERT_MSG_EQ (m->size1, 5, "rows of the matrix");
+  NS_TEST_ASSERT_MSG_EQ (m->size2, 2, "columns of the matrix");
+  for (size_t i = 0; i < 5; i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (gsl_matrix_get (m, i, 0), gsl_matrix_get (series, i, 0), "x of row " << i);
+      NS_TEST_ASSERT_MSG_EQ (gsl_matrix_get (m, i, 1), gsl_matrix_get (series, i, 1), "y of row " << i);
+    }
+  gsl_matrix_free (m);
+  gsl_matrix_free (series);
+
+  const P1906MOL_MOTOR_TraceReader::Chunk & empty = reader->getChunk (2);
+  NS_TEST_ASSERT_MSG_EQ (empty.kind, (uint32_t) P1906MOL_MOTOR_Trace::Points, "kind of the empty chunk");
+  NS_TEST_ASSERT_MSG_EQ (empty.rows, 0, "rows of the empty chunk");
+  NS_TEST_ASSERT_MSG_EQ ((P1906MOL_MOTOR_TraceReader::toMatrix (empty) == 0), true, "an empty chunk has no matrix");
+
+  //! a run interrupted inside the series keeps the trajectory only
+  std::vector<char> data = ReadFile (fileName);
+  std::string cutName = CreateTempDirFilename ("p1906-mol-motor-trace-cut.bin");
+  //! file header, chunk header, label padded to 16 bytes, then 4 columns
+  const size_t fileHeader = 16;
+  const size_t seriesStart = fileHeader + 32 + 16 + 8 * 4 * steps;
+  //! inside the chunk header, the label and the columns of the series
+  const size_t cuts[] = { seriesStart + 1, seriesStart + 40, seriesStart + 32 + 16 + 8 };
+  for (size_t k = 0; k < sizeof (cuts) / sizeof (cuts[0]); k++)
+    {
+      WriteFile (cutName, data, cuts[k]);
+      Ptr<P1906MOL_MOTOR_TraceReader> cut = P1906MOL_MOTOR_TraceReader::Load (cutName);
+      NS_TEST_ASSERT_MSG_EQ ((cut != 0), true, "a file cut short is read");
+      NS_TEST_ASSERT_MSG_EQ (cut->isTruncated (), true, "a file cut at " << cuts[k] << " is truncated");
+      NS_TEST_ASSERT_MSG_EQ (cut->getNumChunks (), 1, "only the complete chunks of a file cut at " << cuts[k]);
+      NS_TEST_ASSERT_MSG_EQ (cut->getChunk (0).get (steps - 1, 1), x[steps - 1], "the complete chunk is intact");
+    }
+
+  //! a file holding the header only is complete and empty
+  WriteFile (cutName, data, fileHeader);
+  Ptr<P1906MOL_MOTOR_TraceReader> header = P1906MOL_MOTOR_TraceReader::Load (cutName);
+  NS_TEST_ASSERT_MSG_EQ ((header != 0), true, "a file with no chunk is read");
+  NS_TEST_ASSERT_MSG_EQ (header->isTruncated (), false, "a file with no chunk is complete");
+  NS_TEST_ASSERT_MSG_EQ (header->getNumChunks (), 0, "a file with no chunk");
+
+  //! anything else is refused
+  data[0] = 'X';
+  WriteFile (cutName, data, data.size ());
+  NS_TEST_ASSERT_MSG_EQ ((P1906MOL_MOTOR_TraceReader::Load (cutName) == 0), true, "a file without the magic is not a trace file");
+  WriteFile (cutName, data, 3);
+  NS_TEST_ASSERT_MSG_EQ ((P1906MOL_MOTOR_TraceReader::Load (cutName) == 0), true, "a file shorter than the header is not a trace file");
+
+  remove (cutName.c_str ());
+}
+
+/**
+ * \ingroup IEEE P1906 framework
+ *
+ * \brief The P1906MOL_MOTOR_Trace test suite
+ */
+class P1906MOL_MOTOR_TraceTestSuite : public TestSuite
+{
+public:
+  P1906MOL_MOTOR_TraceTestSuite ();
+};
+
+P1906MOL_MOTOR_TraceTestSuite::P1906MOL_MOTOR_TraceTestSuite ()
+  : TestSuite ("p1906-mol-motor-trace", UNIT)
+{
+  AddTestCase (new P1906MOL_MOTOR_TraceTestCase, TestCase::QUICK);
+}
+
+//! registers the suite with the test runner
+static P1906MOL_MOTOR_TraceTestSuite g_p1906MolMotorTraceTestSuite;
@@ -0,0 +1,237 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *  Copyright � 2015 by IEEE.
+ *
+ *  This source file is an essential part of IEEE Std 1906.1,
+ *  Recommended Practice for Nanoscale and Molecular
+ *  Communication Framework.
+ *  Verbatim copies of this source file may be used and
+ *  distributed without restriction. Modifications to this source
+ *  file as permitted in IEEE Std 1906.1 may also be made and
+ *  distributed. All other uses require permission from the IEEE
+ *  Standards Department (stds-ipr@ieee.org). All other rights
+ *  reserved.
+ *
+ *  This source file is provided on an AS IS basis.
+ *  The IEEE disclaims ANY WARRANTY EXPRESS OR IMPLIED INCLUDING
+ *  ANY WARRANTY OF MERCHANTABILITY AND FITNESS FOR USE FOR A
+ *  PARTICULAR PURPOSE.
+ *  The user of the source file shall indemnify and hold
+ *  IEEE harmless from any damages or liability arising out of
+ *  the use thereof.
+ *
+ * Author: Stephen F Bush - GE Global Research
+ *                      bushsf@research.ge.com
+ *                      http://www.amazon.com/author/stephenbush
+ */
+
+/* \details Tests of the trajectory writer
+ *
+ * <pre>
+ *   motors --Stream sinks--> TrajectoryWriter --> file -> TraceReader == every position recorded
+ * </pre>
+ */
+
+#include <string>
+#include <vector>
+
+#include "ns3/test.h"
+#include "ns3/system-thread.h"
+#include "ns3/p1906-mol-motor-trace.h"
+#include "ns3/p1906-mol-motor-trajectory.h"
+
+using namespace ns3;
+
+/**
+ * \ingroup IEEE P1906 framework
+ *
+ * \brief A motor recording a known trajectory through its own Stream sink
+ *
+ * The sink holds a reference to the writer, whose count is not atomic, so it
+ * is created and destroyed on the calling thread; only Run is called from
+ * another one.
+ */
+class P1906MOL_MOTOR_TrajectoryTestMotor
+{
+public:
+  P1906MOL_MOTOR_TrajectoryTestMotor (Ptr<P1906MOL_MOTOR_TrajectoryWriter> writer, uint64_t motor, uint32_t points);
+  //! record all the points
+  void Run (void);
+  //! position number i of motor
+  static P1906MOL_MOTOR_Vec3 Position (uint64_t motor, uint32_t i);
+
+  //! a chunk size that does not divide the number of points leaves a partial chunk to the sink destructor
+  P1906MOL_MOTOR_TrajectoryStream m_sink;
+  uint64_t m_motor;
+  uint32_t m_points;
+};
+
+P1906MOL_MOTOR_TrajectoryTestMotor::P1906MOL_MOTOR_TrajectoryTestMotor (Ptr<P1906MOL_MOTOR_TrajectoryWriter> writer, uint64_t motor, uint32_t points)
+  : m_sink (writer, motor, 7),
+    m_motor (motor),
+    m_points (points)
+{
+}
+
+P1906MOL_MOTOR_Vec3
+P1906MOL_MOTOR_TrajectoryTestMotor::Position (uint64_t motor, uint32_t i)
+{
+  return vec3 (motor, i, 0.5 * i);
+}
+
+void
+P1906MOL_MOTOR_TrajectoryTestMotor::Run (void)
+{
+  for (uint32_t i = 0; i < m_points; i++)
+    {
+      m_sink.record (Position (m_motor, i), i);
+    }
+}
+
+/**
+ * \ingroup IEEE P1906 framework
+ *
+ * \brief Every position streamed by several motors at once reaches the file, in order
+ */
+class P1906MOL_MOTOR_TrajectoryStreamTestCase : public TestCase
+{
+public:
+  P1906MOL_MOTOR_TrajectoryStreamTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+P1906MOL_MOTOR_TrajectoryStreamTestCase::P1906MOL_MOTOR_TrajectoryStreamTestCase ()
+  : TestCase ("the Stream sinks write every position")
+{
+}
+
+void
+P1906MOL_MOTOR_TrajectoryStreamTestCase::DoRun (void)
+{
+  std::string fileName = CreateTempDirFilename ("p1906-mol-motor-trajectory.bin");
+  const uint32_t motors = 4;
+  //! about 4 times maxQueued chunks per motor, so that the motors wait for room
+  const uint32_t points = 7 * 4 * P1906MOL_MOTOR_TrajectoryWriter::maxQueued + 3;
+
+  {
+    Ptr<P1906MOL_MOTOR_TrajectoryWriter> writer = Create<P1906MOL_MOTOR_TrajectoryWriter> (fileName);
+    NS_TEST_ASSERT_MSG_EQ (writer->isOpen (), true, "the trajectory file is created");
+
+    std::vector<P1906MOL_MOTOR_TrajectoryTestMotor *> m;
+    std::vector<Ptr<SystemThread> > threads;
+    for (uint32_t k = 0; k < motors; k++)
+      {
+        m.push_back (new P1906MOL_MOTOR_TrajectoryTestMotor (writer, k, points));
+        Ptr<SystemThread> t = Create<SystemThread> (MakeCallback (&P1906MOL_MOTOR_TrajectoryTestMotor::Run, m[k]));
+        t->Start ();
+        threads.push_back (t);
+      }
+    for (uint32_t k = 0; k < motors; k++)
+      {
+        threads[k]->Join ();
+        delete m[k];
+      }
+    //! the last reference: the destructor writes what is still queued and flushes the file
+  }
+
+  Ptr<P1906MOL_MOTOR_TraceReader> reader = P1906MOL_MOTOR_TraceReader::Load (fileName);
+  NS_TEST_ASSERT_MSG_EQ ((reader != 0), true, "the trajectory file is read");
+  NS_TEST_ASSERT_MSG_EQ (reader->isTruncated (), false, "the file is complete");
+
+  std::vector<uint32_t> next (motors, 0);
+  uint32_t wrong = 0;
+  for (size_t c = 0; c < reader->getNumChunks (); c++)
+    {
+      const P1906MOL_MOTOR_TraceReader::Chunk & chunk = reader->getChunk (c);
+      NS_TEST_ASSERT_MSG_EQ (chunk.kind, (uint32_t) P1906MOL_MOTOR_Trace::Trajectory, "kind of chunk " << c);
+      NS_TEST_ASSERT_MSG_EQ ((chunk.tag < motors), true, "motor of chunk " << c);
+      NS_TEST_ASSERT_MSG_EQ (chunk.columns, 4, "columns of chunk " << c);
+      //! the chunks of a motor come in order, so its positions are numbered on
+      for (uint64_t r = 0; r < chunk.rows; r++)
+        {
+          uint32_t i = next[chunk.tag]++;
+          P1906MOL_MOTOR_Vec3 p = P1906MOL_MOTOR_TrajectoryTestMotor::Position (chunk.tag, i);
+          wrong += (chunk.get (r, 0) != i || chunk.get (r, 1) != p.x || chunk.get (r, 2) != p.y || chunk.get (r, 3) != p.z);
+        }
+    }
+  NS_TEST_ASSERT_MSG_EQ (wrong, 0, "every row holds the expected position");
+  for (uint32_t k = 0; k < motors; k++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (next[k], points, "every position of motor " << k << " is written");
+    }
+}
+
+/**
+ * \ingroup IEEE P1906 framework
+ *
+ * \brief The writer is destroyed with a full queue and its thread busy writing
+ */
+class P1906MOL_MOTOR_TrajectoryWriterStopTestCase : public TestCase
+{
+public:
+  P1906MOL_MOTOR_TrajectoryWriterStopTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+P1906MOL_MOTOR_TrajectoryWriterStopTestCase::P1906MOL_MOTOR_TrajectoryWriterStopTestCase ()
+  : TestCase ("the writer destructor returns while writes are in flight")
+{
+}
+
+void
+P1906MOL_MOTOR_TrajectoryWriterStopTestCase::DoRun (void)
+{
+  std::string fileName = CreateTempDirFilename ("p1906-mol-motor-trajectory-stop.bin");
+  const uint32_t chunks = 3 * P1906MOL_MOTOR_TrajectoryWriter::maxQueued;
+  const uint32_t rows = 1000;
+
+  //! repeated, since where the writer thread is when the stop comes is up to the schedule
+  for (uint32_t run = 0; run < 10; run++)
+    {
+      Ptr<P1906MOL_MOTOR_TrajectoryWriter> writer = Create<P1906MOL_MOTOR_TrajectoryWriter> (fileName);
+      for (uint32_t c = 0; c < chunks; c++)
+        {
+          P1906MOL_MOTOR_TrajectoryWriter::Chunk chunk;
+          chunk.motor = c;
+          chunk.t.assign (rows, c);
+          chunk.x.assign (rows, 1);
+          chunk.y.assign (rows, 2);
+          chunk.z.assign (rows, 3);
+          writer->write (chunk);
+          NS_TEST_ASSERT_MSG_EQ (chunk.t.empty (), true, "the chunk is taken by the writer");
+        }
+      //! returns only once the thread has written the queue and stopped
+      writer = 0;
+    }
+
+  //! the runs share the TraceWriter of the file name, so their chunks add up
+  Ptr<P1906MOL_MOTOR_TraceReader> reader = P1906MOL_MOTOR_TraceReader::Load (fileName);
+  NS_TEST_ASSERT_MSG_EQ ((reader != 0), true, "the trajectory file is read");
+  NS_TEST_ASSERT_MSG_EQ (reader->isTruncated (), false, "the queued chunks are written before the destructor returns");
+  NS_TEST_ASSERT_MSG_EQ (reader->getNumChunks (), 10 * chunks, "every chunk queued before the destructor is written");
+}
+
+/**
+ * \ingroup IEEE P1906 framework
+ *
+ * \brief The P1906MOL_MOTOR_TrajectoryWriter test suite
+ */
+class P1906MOL_MOTOR_TrajectoryTestSuite : public TestSuite
+{
+public:
+  P1906MOL_MOTOR_TrajectoryTestSuite ();
+};
+
+P1906MOL_MOTOR_TrajectoryTestSuite::P1906MOL_MOTOR_TrajectoryTestSuite ()
+  : TestSuite ("p1906-mol-motor-trajectory", UNIT)
+{
+  AddTestCase (new P1906MOL_MOTOR_TrajectoryStreamTestCase, TestCase::QUICK);
+  AddTestCase (new P1906MOL_MOTOR_TrajectoryWriterStopTestCase, TestCase::QUICK);
+}
+
+//! registers the suite with the test runner
+static P1906MOL_MOTOR_TrajectoryTestSuite g_p1906MolMotorTrajectoryTestSuite;
@@ -0,0 +1,283 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *  Copyright © 2014 by IEEE.
+ *
+ *  This source file is an essential part of IEEE Std 1906.1,
+ *  Recommended Practice for Nanoscale and Molecular
+ *  Communication Framework.
+ *  Verbatim copies of this source file may be used and
+ *  distributed without restriction. Modifications to this source
+ *  file as permitted in IEEE Std 1906.1 may also be made and
+ *  distributed. All other uses require permission from the IEEE
+ *  Standards Department (stds-ipr@ieee.org). All other rights
+ *  reserved.
+ *
+ *  This source file is provided on an AS IS basis.
+ *  The IEEE disclaims ANY WARRANTY EXPRESS OR IMPLIED INCLUDING
+ *  ANY WARRANTY OF MERCHANTABILITY AND FITNESS FOR USE FOR A
+ *  PARTICULAR PURPOSE.
+ *  The user of the source file shall indemnify and hold
+ *  IEEE harmless from any damages or liability arising out of
+ *  the use thereof.
+ *
+ * Author: Giuseppe Piro - Telematics Lab Research Group
+ *                         Politecnico di Bari
+ *                         giuseppe.piro@poliba.it
+ *                         telematics.poliba.it/piro
+ */
+
+/* \details Tests of the inter-symbol interference detection of P1906MOLSpecificity
+ *
+ * <pre>
+ *   pulse train from one transmitter -> interference at each reception == sum of the Gaussian waves kept
+ *   kept: peak bound >= InterferenceFloor * signal, at most MaxReleases
+ * </pre>
+ */
+
+#include <cmath>
+#include <vector>
+
+#include "ns3/test.h"
+#include "ns3/simulator.h"
+#include "ns3/node.h"
+#include "ns3/constant-position-mobility-model.h"
+#include "ns3/p1906-net-device.h"
+#include "ns3/p1906-communication-interface.h"
+#include "ns3/p1906-mol-message-carrier.h"
+#include "ns3/p1906-mol-specificity.h"
+
+using namespace ns3;
+
+/**
+ * \ingroup IEEE P1906 framework
+ *
+ * \brief A train of pulses from one node received by another one, with the
+ * signal, the interference and the releases kept logged at each reception
+ */
+class P1906MOLSpecificityTestTrain
+{
+public:
+  P1906MOLSpecificityTestTrain (double interferenceFloor, uint32_t maxReleases);
+  ~P1906MOLSpecificityTestTrain ();
+  //! release pulses pulses, one every period, each received delay after its release
+  void Run (uint32_t pulses);
+  //! the concentration [molecules/m^3] of a release at the receiver dt after it
+  static double Wave (double dt);
+
+  //! molecules per pulse, transmitter-receiver distance [m], diffusion coefficient [m^2/s], period and delay [s]
+  static const double molecules;
+  static const double distance;
+  static const double diffusion;
+  static const double period;
+  static const double delay;
+
+  Ptr<P1906MOLSpecificity> m_specificity;
+  std::vector<double> m_signal;
+  std::vector<double> m_interference;
+  std::vector<uint32_t> m_releases;
+
+private:
+  void Receive (uint32_t k);
+  Ptr<P1906CommunicationInterface> Build (double x);
+
+  Ptr<P1906CommunicationInterface> m_tx;
+  Ptr<P1906CommunicationInterface> m_rx;
+};
+
+const double P1906MOLSpecificityTestTrain::molecules = 1e6;
+const double P1906MOLSpecificityTestTrain::distance = 1e-5;
+const double P1906MOLSpecificityTestTrain::diffusion = 1e-9;
+const double P1906MOLSpecificityTestTrain::period = 0.01;
+const double P1906MOLSpecificityTestTrain::delay = 0.02;
+
+P1906MOLSpecificityTestTrain::P1906MOLSpecificityTestTrain (double interferenceFloor, uint32_t maxReleases)
+{
+  m_specificity = CreateObject<P1906MOLSpecificity> ();
+  m_specificity->SetDetection (P1906MOLSpecificity::InterSymbolInterference);
+  m_specificity->SetDiffusionCoefficient (diffusion);
+  m_specificity->SetInterferenceFloor (interferenceFloor);
+  m_specificity->SetMaxReleases (maxReleases);
+  m_tx = Build (0);
+  m_rx = Build (distance);
+}
+
+P1906MOLSpecificityTestTrain::~P1906MOLSpecificityTestTrain ()
+{
+  Simulator::Destroy ();
+}
+
+Ptr<P1906CommunicationInterface>
+P1906MOLSpecificityTestTrain::Build (double x)
+{
+  Ptr<Node> n = CreateObject<Node> ();
+  Ptr<ConstantPositionMobilityModel> mobility = CreateObject<ConstantPositionMobilityModel> ();
+  mobility->SetPosition (Vector (x, 0, 0));
+  n->AggregateObject (mobility);
+  Ptr<P1906NetDevice> dev = CreateObject<P1906NetDevice> ();
+  dev->SetNode (n);
+  Ptr<P1906CommunicationInterface> c = CreateObject<P1906CommunicationInterface> ();
+  c->SetP1906NetDevice (dev);
+  return c;
+}
+
+double
+P1906MOLSpecificityTestTrain::Wave (double dt)
+{
+  return molecules / std::pow (4 * M_PI * diffusion * dt, 1.5) * std::exp (-distance * distance / (4 * diffusion * dt));
+}
+
+void
+P1906MOLSpecificityTestTrain::Run (uint32_t pulses)
+{
+  for (uint32_t k = 0; k < pulses; k++)
+    {
+      Simulator::Schedule (Seconds (k * period + delay), &P1906MOLSpecificityTestTrain::Receive, this, k);
+    }
+  Simulator::Run ();
+}
+
+void
+P1906MOLSpecificityTestTrain::Receive (uint32_t k)
+{
+  Ptr<P1906MOLMessageCarrier> m = CreateObject<P1906MOLMessageCarrier> ();
+  m->SetStartTime (Seconds (k * period));
+  m->SetMolecules (molecules);
+  m_specificity->CheckRxCompatibility (m_tx, m_rx, m);
+  m_signal.push_back (m_specificity->GetLastSignal ());
+  m_interference.push_back (m_specificity->GetLastInterference ());
+  m_releases.push_back (m_specificity->GetNReleases ());
+}
+
+/**
+ * \ingroup IEEE P1906 framework
+ *
+ * \brief With no pruning the interference is the sum of the waves of all the earlier pulses
+ */
+class P1906MOLSpecificityInterferenceTestCase : public TestCase
+{
+public:
+  P1906MOLSpecificityInterferenceTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+P1906MOLSpecificityInterferenceTestCase::P1906MOLSpecificityInterferenceTestCase ()
+  : TestCase ("the inter-symbol interference matches the closed form")
+{
+}
+
+void
+P1906MOLSpecificityInterferenceTestCase::DoRun (void)
+{
+  const uint32_t pulses = 40;
+  P1906MOLSpecificityTestTrain train (0, 0);
+  train.Run (pulses);
+
+  NS_TEST_ASSERT_MSG_EQ (train.m_signal.size (), pulses, "every pulse is received");
+  double signal = P1906MOLSpecificityTestTrain::Wave (P1906MOLSpecificityTestTrain::delay);
+  for (uint32_t k = 0; k < pulses; k++)
+    {
+      //! pulse j was released (k - j) periods before pulse k
+      double interference = 0;
+      for (uint32_t j = 0; j < k; j++)
+        {
+          interference += P1906MOLSpecificityTestTrain::Wave ((k - j) * P1906MOLSpecificityTestTrain::period + P1906MOLSpecificityTestTrain::delay);
+        }
+      NS_TEST_ASSERT_MSG_EQ_TOL (train.m_signal[k], signal, 1e-9 * signal, "signal of pulse " << k);
+      NS_TEST_ASSERT_MSG_EQ_TOL (train.m_interference[k], interference, 1e-9 * signal, "interference at pulse " << k);
+      NS_TEST_ASSERT_MSG_EQ (train.m_releases[k], k + 1, "every release is kept without pruning");
+    }
+}
+
+/**
+ * \ingroup IEEE P1906 framework
+ *
+ * \brief The releases faded below the floor, or beyond the cap, are dropped
+ */
+class P1906MOLSpecificityPruningTestCase : public TestCase
+{
+public:
+  P1906MOLSpecificityPruningTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+P1906MOLSpecificityPruningTestCase::P1906MOLSpecificityPruningTestCase ()
+  : TestCase ("old releases are dropped and the history stays bounded")
+{
+}
+
+void
+P1906MOLSpecificityPruningTestCase::DoRun (void)
+{
+  const uint32_t pulses = 400;
+  const double floor = 0.1;
+  double period = P1906MOLSpecificityTestTrain::period;
+  double delay = P1906MOLSpecificityTestTrain::delay;
+  double signal = P1906MOLSpecificityTestTrain::Wave (delay);
+
+  //! a release is kept while its peak N / (4 pi D dt)^(3/2) is at least floor * signal
+  uint32_t kept = 0;
+  for (uint32_t age = 1; age < pulses; age++)
+    {
+      double peak = P1906MOLSpecificityTestTrain::molecules / std::pow (4 * M_PI * P1906MOLSpecificityTestTrain::diffusion * (age * period + delay), 1.5);
+      if (peak >= floor * signal)
+        {
+          kept++;
+        }
+    }
+  NS_TEST_ASSERT_MSG_EQ ((kept + 1 < pulses / 2), true, "the floor is high enough to prune this train");
+
+  P1906MOLSpecificityTestTrain relative (floor, 0);
+  relative.Run (pulses);
+  NS_TEST_ASSERT_MSG_EQ (relative.m_releases[pulses - 1], kept + 1, "the releases below the floor are dropped");
+  double interference = 0;
+  double dropped = 0;
+  for (uint32_t age = 1; age < pulses; age++)
+    {
+      double w = P1906MOLSpecificityTestTrain::Wave (age * period + delay);
+      interference += (age <= kept) ? w : 0;
+      dropped += (age <= kept) ? 0 : w;
+    }
+  NS_TEST_ASSERT_MSG_EQ_TOL (relative.m_interference[pulses - 1], interference, 1e-9 * signal, "interference of the releases kept");
+  NS_TEST_ASSERT_MSG_EQ ((dropped < floor * signal * pulses), true, "each release dropped adds less than the floor");
+
+  //! the cap keeps the last MaxReleases releases received
+  const uint32_t cap = 5;
+  P1906MOLSpecificityTestTrain capped (0, cap);
+  capped.Run (pulses);
+  interference = 0;
+  for (uint32_t age = 1; age <= cap; age++)
+    {
+      interference += P1906MOLSpecificityTestTrain::Wave (age * period + delay);
+    }
+  NS_TEST_ASSERT_MSG_EQ (capped.m_releases[pulses - 1], cap, "at most MaxReleases releases are kept");
+  NS_TEST_ASSERT_MSG_EQ_TOL (capped.m_interference[pulses - 1], interference, 1e-9 * signal, "interference of the last MaxReleases releases");
+
+  //! and ClearReleases forgets them all
+  capped.m_specificity->ClearReleases ();
+  NS_TEST_ASSERT_MSG_EQ (capped.m_specificity->GetNReleases (), 0, "no release is left");
+}
+
+/**
+ * \ingroup IEEE P1906 framework
+ *
+ * \brief The P1906MOLSpecificity test suite
+ */
+class P1906MOLSpecificityTestSuite : public TestSuite
+{
+public:
+  P1906MOLSpecificityTestSuite ();
+};
+
+P1906MOLSpecificityTestSuite::P1906MOLSpecificityTestSuite ()
+  : TestSuite ("p1906-mol-specificity", UNIT)
+{
+  AddTestCase (new P1906MOLSpecificityInterferenceTestCase, TestCase::QUICK);
+  AddTestCase (new P1906MOLSpecificityPruningTestCase, TestCase::QUICK);
+}
+
+//! registers the suite with the test runner
+static P1906MOLSpecificityTestSuite g_p1906MolSpecificityTestSuite;
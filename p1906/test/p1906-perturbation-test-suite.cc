@@ -0,0 +1,203 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *  Copyright © 2014 by IEEE.
+ *
+ *  This source file is an essential part of IEEE Std 1906.1,
+ *  Recommended Practice for Nanoscale and Molecular
+ *  Communication Framework.
+ *  Verbatim copies of this source file may be used and
+ *  distributed without restriction. Modifications to this source
+ *  file as permitted in IEEE Std 1906.1 may also be made and
+ *  distributed. All other uses require permission from the IEEE
+ *  Standards Department (stds-ipr@ieee.org). All other rights
+ *  reserved.
+ *
+ *  This source file is provided on an AS IS basis.
+ *  The IEEE disclaims ANY WARRANTY EXPRESS OR IMPLIED INCLUDING
+ *  ANY WARRANTY OF MERCHANTABILITY AND FITNESS FOR USE FOR A
+ *  PARTICULAR PURPOSE.
+ *  The user of the source file shall indemnify and hold
+ *  IEEE harmless from any damages or liability arising out of
+ *  the use thereof.
+ *
+ * Author: Giuseppe Piro - Telematics Lab Research Group
+ *                         Politecnico di Bari
+ *                         giuseppe.piro@poliba.it
+ *                         telematics.poliba.it/piro
+ */
+
+/* \details Tests of the message carrier recycling of P1906Perturbation
+ *
+ * <pre>
+ *   CarrierPoolSize 0 (default) -> a new carrier at every allocation
+ *   CarrierPoolSize n           -> a carrier is reused only once the pool holds its only reference,
+ *                                  and comes back as a newly created one (Reset)
+ * </pre>
+ */
+
+#include "ns3/test.h"
+#include "ns3/nstime.h"
+#include "ns3/packet.h"
+#include "ns3/spectrum-value.h"
+#include "ns3/p1906-perturbation.h"
+#include "ns3/p1906-mol-message-carrier.h"
+#include "ns3/p1906-em-message-carrier.h"
+
+using namespace ns3;
+
+/**
+ * \ingroup IEEE P1906 framework
+ *
+ * \brief A perturbation exposing the carrier allocation to the tests
+ */
+class P1906PerturbationTestPool : public P1906Perturbation
+{
+public:
+  template <typename T>
+  Ptr<T> Allocate (void)
+  {
+    return AllocateMessageCarrier<T> ();
+  }
+};
+
+/**
+ * \ingroup IEEE P1906 framework
+ *
+ * \brief Check that the carriers are not recycled unless a pool is configured
+ */
+class P1906PerturbationNoPoolTestCase : public TestCase
+{
+public:
+  P1906PerturbationNoPoolTestCase ();
+private:
+  virtual void DoRun (void);
+};
+
+P1906PerturbationNoPoolTestCase::P1906PerturbationNoPoolTestCase ()
+  : TestCase ("Message carriers are not recycled by default")
+{
+}
+
+void
+P1906PerturbationNoPoolTestCase::DoRun (void)
+{
+  Ptr<P1906PerturbationTestPool> perturbation = CreateObject<P1906PerturbationTestPool> ();
+  NS_TEST_ASSERT_MSG_EQ (perturbation->GetCarrierPoolSize (), 0, "recycling is opt-in");
+
+  //! the perturbation keeps no reference to the carriers it hands out
+  Ptr<P1906MOLMessageCarrier> first = perturbation->Allocate<P1906MOLMessageCarrier> ();
+  first->SetMolecules (1000);
+  NS_TEST_ASSERT_MSG_EQ (first->GetReferenceCount (), 1, "the carrier is not pooled");
+  Ptr<P1906MOLMessageCarrier> second = perturbation->Allocate<P1906MOLMessageCarrier> ();
+  NS_TEST_ASSERT_MSG_EQ (second->GetReferenceCount (), 1, "the carrier is not pooled");
+  NS_TEST_ASSERT_MSG_EQ (first->GetMolecules (), 1000, "a carrier is never reset");
+}
+
+/**
+ * \ingroup IEEE P1906 framework
+ *
+ * \brief Check that a pooled carrier is reused only when the pool holds the
+ * only reference to it, and that it comes back cleared
+ */
+class P1906PerturbationPoolTestCase : public TestCase
+{
+public:
+  P1906PerturbationPoolTestCase ();
+private:
+  virtual void DoRun (void);
+};
+
+P1906PerturbationPoolTestCase::P1906PerturbationPoolTestCase ()
+  : TestCase ("Pooled message carriers are reused once released, and reset")
+{
+}
+
+void
+P1906PerturbationPoolTestCase::DoRun (void)
+{
+  Ptr<P1906PerturbationTestPool> perturbation = CreateObject<P1906PerturbationTestPool> ();
+  perturbation->SetCarrierPoolSize (2);
+
+  //! MOL carriers: both pooled carriers are held by a receiver
+  Ptr<P1906MOLMessageCarrier> a = perturbation->Allocate<P1906MOLMessageCarrier> ();
+  Ptr<P1906MOLMessageCarrier> b = perturbation->Allocate<P1906MOLMessageCarrier> ();
+  a->SetMessage (Create<Packet> (10));
+  a->SetDuration (Seconds (1));
+  a->SetPulseInterval (Seconds (0.1));
+  a->SetStartTime (Seconds (2));
+  a->SetMolecules (1000);
+  NS_TEST_ASSERT_MSG_NE (a, b, "a carrier in use is not handed out twice");
+
+  Ptr<P1906MOLMessageCarrier> c = perturbation->Allocate<P1906MOLMessageCarrier> ();
+  NS_TEST_ASSERT_MSG_NE (c, a, "a carrier in use is not reused");
+  NS_TEST_ASSERT_MSG_NE (c, b, "a carrier in use is not reused");
+  NS_TEST_ASSERT_MSG_EQ (a->GetMolecules (), 1000, "a carrier in use is not reset");
+  NS_TEST_ASSERT_MSG_EQ ((a->GetMessage () != 0), true, "a carrier in use keeps its message");
+
+  //! once its receiver releases it, the carrier is recycled as a new one
+  P1906MOLMessageCarrier *released = PeekPointer (a);
+  a = 0;
+  Ptr<P1906MOLMessageCarrier> d = perturbation->Allocate<P1906MOLMessageCarrier> ();
+  NS_TEST_ASSERT_MSG_EQ (PeekPointer (d), released, "a released carrier is reused");
+  NS_TEST_ASSERT_MSG_EQ ((d->GetMessage () == 0), true, "the message is cleared");
+  NS_TEST_ASSERT_MSG_EQ (d->GetDuration (), Seconds (0), "the duration is cleared");
+  NS_TEST_ASSERT_MSG_EQ (d->GetPulseInterval (), Seconds (0), "the pulse interval is cleared");
+  NS_TEST_ASSERT_MSG_EQ (d->GetStartTime (), Seconds (0), "the start time is cleared");
+  NS_TEST_ASSERT_MSG_EQ (d->GetMolecules (), 0, "the molecules are cleared");
+
+  //! EM carriers, in a pool of their own
+  perturbation = CreateObject<P1906PerturbationTestPool> ();
+  perturbation->SetCarrierPoolSize (1);
+  Ptr<P1906EMMessageCarrier> e = perturbation->Allocate<P1906EMMessageCarrier> ();
+  Ptr<const SpectrumModel> model = Create<SpectrumModel> (std::vector<double> (1, 1e12));
+  e->SetMessage (Create<Packet> (10));
+  e->SetSpectrumValue (Create<SpectrumValue> (model));
+  e->SetDuration (Seconds (1));
+  e->SetPulseDuration (Seconds (0.01));
+  e->SetPulseInterval (Seconds (0.1));
+  e->SetStartTime (Seconds (2));
+  e->SetCentralFrequency (1e12);
+  e->SetBandwidth (1e9);
+  e->SetSubChannel (1);
+
+  Ptr<P1906EMMessageCarrier> f = perturbation->Allocate<P1906EMMessageCarrier> ();
+  NS_TEST_ASSERT_MSG_NE (f, e, "a carrier in use is not reused");
+  NS_TEST_ASSERT_MSG_EQ ((e->GetSpectrumValue () != 0), true, "a carrier in use keeps its PSD");
+
+  P1906EMMessageCarrier *pooled = PeekPointer (e);
+  e = 0;
+  Ptr<P1906EMMessageCarrier> g = perturbation->Allocate<P1906EMMessageCarrier> ();
+  NS_TEST_ASSERT_MSG_EQ (PeekPointer (g), pooled, "a released carrier is reused");
+  NS_TEST_ASSERT_MSG_EQ ((g->GetMessage () == 0), true, "the message is cleared");
+  NS_TEST_ASSERT_MSG_EQ ((g->GetSpectrumValue () == 0), true, "the PSD is cleared");
+  NS_TEST_ASSERT_MSG_EQ (g->GetDuration (), Seconds (0), "the duration is cleared");
+  NS_TEST_ASSERT_MSG_EQ (g->GetPulseDuration (), Seconds (0), "the pulse duration is cleared");
+  NS_TEST_ASSERT_MSG_EQ (g->GetPulseInterval (), Seconds (0), "the pulse interval is cleared");
+  NS_TEST_ASSERT_MSG_EQ (g->GetStartTime (), Seconds (0), "the start time is cleared");
+  NS_TEST_ASSERT_MSG_EQ (g->GetCentralFrequency (), 0, "the central frequency is cleared");
+  NS_TEST_ASSERT_MSG_EQ (g->GetBandwidth (), 0, "the bandwidth is cleared");
+  NS_TEST_ASSERT_MSG_EQ (g->GetSubChannel (), 0, "the sub-channel is cleared");
+
+  perturbation->Dispose ();
+}
+
+/**
+ * \ingroup IEEE P1906 framework
+ *
+ * \brief The P1906Perturbation test suite
+ */
+class P1906PerturbationTestSuite : public TestSuite
+{
+public:
+  P1906PerturbationTestSuite ();
+};
+
+P1906PerturbationTestSuite::P1906PerturbationTestSuite ()
+  : TestSuite ("p1906-perturbation", UNIT)
+{
+  AddTestCase (new P1906PerturbationNoPoolTestCase, TestCase::QUICK);
+  AddTestCase (new P1906PerturbationPoolTestCase, TestCase::QUICK);
+}
+
+//! registers the suite with the test runner
+static P1906PerturbationTestSuite g_p1906PerturbationTestSuite;